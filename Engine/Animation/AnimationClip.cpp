@@ -1,19 +1,45 @@
 #include "AnimationClip.h"
 #include "Skeleton.h"
+#include "CompressedAnimation.h"
+#include "Pose.h"
 #include <algorithm>
 
 namespace UnoEngine {
 
 namespace {
 
+// キーが2つ以上ある前提。time < keys[i + 1].time となる最小のi（無ければ最後の区間）
 template<typename T>
 size_t FindKeyIndex(const std::vector<Keyframe<T>>& keys, float time) {
-    for (size_t i = 0; i < keys.size() - 1; ++i) {
-        if (time < keys[i + 1].time) {
-            return i;
+    auto it = std::upper_bound(keys.begin() + 1, keys.end() - 1, time,
+        [](float t, const Keyframe<T>& key) { return t < key.time; });
+    return static_cast<size_t>(it - keys.begin()) - 1;
+}
+
+// 前回のキー位置から探索する版（結果はFindKeyIndexと同じ）
+// 順再生では数キー進めるだけで見つかる。巻き戻しや大きなシークは二分探索に切り替える
+template<typename T>
+size_t FindKeyIndex(const std::vector<Keyframe<T>>& keys, float time, uint32& cursor) {
+    constexpr uint32 MAX_FORWARD_STEPS = 4;
+
+    const size_t lastIndex = keys.size() - 2;
+    size_t index = (std::min)(static_cast<size_t>(cursor), lastIndex);
+
+    if (index > 0 && time < keys[index].time) {
+        index = FindKeyIndex(keys, time);
+    } else {
+        uint32 steps = 0;
+        while (index < lastIndex && !(time < keys[index + 1].time)) {
+            if (++steps > MAX_FORWARD_STEPS) {
+                index = FindKeyIndex(keys, time);
+                break;
+            }
+            ++index;
         }
     }
-    return keys.size() - 2;
+
+    cursor = static_cast<uint32>(index);
+    return index;
 }
 
 float CalculateBlendFactor(float time, float t0, float t1) {
@@ -24,63 +50,110 @@ float CalculateBlendFactor(float time, float t0, float t1) {
     return (time - t0) / delta;
 }
 
-} // anonymous namespace
-
-Vector3 BoneAnimation::InterpolatePosition(float time) const {
-    if (positionKeys.empty()) {
-        return Vector3(0.0f, 0.0f, 0.0f);
+Vector3 SampleVector(const std::vector<Keyframe<Vector3>>& keys, float time, uint32& cursor, const Vector3& defaultValue) {
+    if (keys.empty()) {
+        return defaultValue;
     }
-    if (positionKeys.size() == 1) {
-        return positionKeys[0].value;
+    if (keys.size() == 1) {
+        return keys[0].value;
     }
 
-    size_t index = FindKeyIndex(positionKeys, time);
-    float factor = CalculateBlendFactor(time, positionKeys[index].time, positionKeys[index + 1].time);
+    size_t index = FindKeyIndex(keys, time, cursor);
+    float factor = CalculateBlendFactor(time, keys[index].time, keys[index + 1].time);
 
-    return Vector3::Lerp(positionKeys[index].value, positionKeys[index + 1].value, factor);
+    return Vector3::Lerp(keys[index].value, keys[index + 1].value, factor);
 }
 
-Quaternion BoneAnimation::InterpolateRotation(float time) const {
-    if (rotationKeys.empty()) {
+Quaternion SampleRotation(const std::vector<Keyframe<Quaternion>>& keys, float time, uint32& cursor) {
+    if (keys.empty()) {
         return Quaternion::Identity();
     }
-    if (rotationKeys.size() == 1) {
-        return rotationKeys[0].value;
+    if (keys.size() == 1) {
+        return keys[0].value;
     }
 
-    size_t index = FindKeyIndex(rotationKeys, time);
-    float factor = CalculateBlendFactor(time, rotationKeys[index].time, rotationKeys[index + 1].time);
+    size_t index = FindKeyIndex(keys, time, cursor);
+    float factor = CalculateBlendFactor(time, keys[index].time, keys[index + 1].time);
+
+    return Quaternion::Slerp(keys[index].value, keys[index + 1].value, factor);
+}
+
+Matrix4x4 ComposeLocalTransform(const Vector3& position, const Quaternion& rotation, const Vector3& scale) {
+    // DirectXMath: S * R * T の順序で構築（意図）
+    Matrix4x4 S = Matrix4x4::CreateScale(scale);
+    Matrix4x4 R = Matrix4x4::CreateFromQuaternion(rotation);
+    Matrix4x4 T = Matrix4x4::CreateTranslation(position);
+
+    return S * R * T;
+}
 
-    return Quaternion::Slerp(rotationKeys[index].value, rotationKeys[index + 1].value, factor);
+} // anonymous namespace
+
+Vector3 BoneAnimation::InterpolatePosition(float time) const {
+    uint32 cursor = 0;
+    return SampleVector(positionKeys, time, cursor, Vector3(0.0f, 0.0f, 0.0f));
+}
+
+Quaternion BoneAnimation::InterpolateRotation(float time) const {
+    uint32 cursor = 0;
+    return SampleRotation(rotationKeys, time, cursor);
 }
 
 Vector3 BoneAnimation::InterpolateScale(float time) const {
-    if (scaleKeys.empty()) {
-        return Vector3(1.0f, 1.0f, 1.0f);
+    uint32 cursor = 0;
+    return SampleVector(scaleKeys, time, cursor, Vector3(1.0f, 1.0f, 1.0f));
+}
+
+float AnimationCurve::Evaluate(float time) const {
+    if (keys.empty()) {
+        return 0.0f;
     }
-    if (scaleKeys.size() == 1) {
-        return scaleKeys[0].value;
+    if (keys.size() == 1) {
+        return keys[0].value;
     }
 
-    size_t index = FindKeyIndex(scaleKeys, time);
-    float factor = CalculateBlendFactor(time, scaleKeys[index].time, scaleKeys[index + 1].time);
-
-    return Vector3::Lerp(scaleKeys[index].value, scaleKeys[index + 1].value, factor);
+    const size_t index = FindKeyIndex(keys, time);
+    const float factor = std::clamp(CalculateBlendFactor(time, keys[index].time, keys[index + 1].time), 0.0f, 1.0f);
+    return keys[index].value + (keys[index + 1].value - keys[index].value) * factor;
 }
 
 Matrix4x4 BoneAnimation::GetLocalTransform(float time) const {
-    Vector3 position = InterpolatePosition(time);
-    Quaternion rotation = InterpolateRotation(time);
-    Vector3 scale = InterpolateScale(time);
+    Cursor cursor;
+    return GetLocalTransform(time, cursor);
+}
 
-    // DirectXMath: S * R * T の順序で構築（意図）
-    Matrix4x4 S = Matrix4x4::CreateScale(scale);
-    Matrix4x4 R = Matrix4x4::CreateFromQuaternion(rotation);
-    Matrix4x4 T = Matrix4x4::CreateTranslation(position);
+Matrix4x4 BoneAnimation::GetLocalTransform(float time, Cursor& cursor) const {
+    Vector3 position;
+    Quaternion rotation;
+    Vector3 scale;
+    Sample(time, cursor, position, rotation, scale);
+    return ComposeLocalTransform(position, rotation, scale);
+}
 
-    return S * R * T;
+void BoneAnimation::Sample(float time, Cursor& cursor, Vector3& outPosition, Quaternion& outRotation, Vector3& outScale) const {
+    outPosition = SampleVector(positionKeys, time, cursor.position, Vector3(0.0f, 0.0f, 0.0f));
+    outRotation = SampleRotation(rotationKeys, time, cursor.rotation);
+    outScale = SampleVector(scaleKeys, time, cursor.scale, Vector3(1.0f, 1.0f, 1.0f));
 }
 
+AnimationBinding::AnimationBinding(const AnimationClip& clip, const Skeleton& skeleton)
+    : clip_(&clip)
+    , skeleton_(&skeleton) {
+    const auto& bones = skeleton.GetBones();
+    const auto& boneAnimations = clip.GetBoneAnimations();
+
+    boneToChannel_.resize(bones.size(), INVALID_CHANNEL);
+    for (size_t i = 0; i < bones.size(); ++i) {
+        const BoneAnimation* anim = clip.GetBoneAnimation(bones[i].name);
+        if (anim) {
+            boneToChannel_[i] = static_cast<uint32>(anim - boneAnimations.data());
+        }
+    }
+}
+
+AnimationClip::AnimationClip() = default;
+AnimationClip::~AnimationClip() = default;
+
 void AnimationClip::AddBoneAnimation(const BoneAnimation& boneAnim) {
     boneNameToAnimIndex_[boneAnim.boneName] = boneAnimations_.size();
     boneAnimations_.push_back(boneAnim);
@@ -94,6 +167,74 @@ const BoneAnimation* AnimationClip::GetBoneAnimation(const std::string& boneName
     return nullptr;
 }
 
+void AnimationClip::AddEvent(const AnimationEvent& event) {
+    auto it = std::upper_bound(events_.begin(), events_.end(), event.time,
+        [](float time, const AnimationEvent& e) { return time < e.time; });
+    events_.insert(it, event);
+}
+
+void AnimationClip::FindEvents(float lo, float hi, bool includeLo, bool includeHi, uint32& cursor,
+                               uint32& outBegin, uint32& outEnd) const {
+    constexpr uint32 MAX_FORWARD_STEPS = 4;
+    const uint32 count = static_cast<uint32>(events_.size());
+
+    // イベントがtimeより後にあるか（inclusiveならtimeちょうども含む）
+    auto isAfter = [](const AnimationEvent& e, float time, bool inclusive) {
+        return inclusive ? !(e.time < time) : time < e.time;
+    };
+    // isAfterを満たす最初のイベントの番号
+    auto search = [&](float time, bool inclusive) {
+        auto it = std::partition_point(events_.begin(), events_.end(),
+            [&](const AnimationEvent& e) { return !isAfter(e, time, inclusive); });
+        return static_cast<uint32>(it - events_.begin());
+    };
+
+    // 前回の終端がそのまま今回の始端になっていれば探索しない
+    uint32 begin = (std::min)(cursor, count);
+    const bool beginValid = (begin == count || isAfter(events_[begin], lo, includeLo)) &&
+                            (begin == 0 || !isAfter(events_[begin - 1], lo, includeLo));
+    if (!beginValid) {
+        begin = search(lo, includeLo);
+    }
+
+    // 終端はhiを超える最初のイベント（hiを含めない場合はhiちょうどのイベントも超えたとみなす）
+    uint32 end = begin;
+    uint32 steps = 0;
+    while (end < count && !isAfter(events_[end], hi, !includeHi)) {
+        if (++steps > MAX_FORWARD_STEPS) {
+            end = search(hi, !includeHi);
+            break;
+        }
+        ++end;
+    }
+
+    cursor = end;
+    outBegin = begin;
+    outEnd = end;
+}
+
+void AnimationClip::AddCurve(const AnimationCurve& curve) {
+    AnimationCurve sorted = curve;
+    std::stable_sort(sorted.keys.begin(), sorted.keys.end(),
+        [](const Keyframe<float>& a, const Keyframe<float>& b) { return a.time < b.time; });
+
+    auto it = curveNameToIndex_.find(curve.name);
+    if (it != curveNameToIndex_.end()) {
+        curves_[it->second] = std::move(sorted);
+        return;
+    }
+    curveNameToIndex_[curve.name] = curves_.size();
+    curves_.push_back(std::move(sorted));
+}
+
+const AnimationCurve* AnimationClip::GetCurve(const std::string& name) const {
+    auto it = curveNameToIndex_.find(name);
+    if (it != curveNameToIndex_.end()) {
+        return &curves_[it->second];
+    }
+    return nullptr;
+}
+
 void AnimationClip::Sample(float time, const Skeleton& skeleton,
                            std::vector<Matrix4x4>& outLocalTransforms) const {
     uint32 boneCount = skeleton.GetBoneCount();
@@ -105,11 +246,151 @@ void AnimationClip::Sample(float time, const Skeleton& skeleton,
 
         const BoneAnimation* anim = GetBoneAnimation(bone->name);
         if (anim) {
-            outLocalTransforms[i] = anim->GetLocalTransform(time);
+            BoneAnimation::Cursor cursor;
+            Vector3 position;
+            Quaternion rotation;
+            Vector3 scale;
+            SampleChannel(static_cast<uint32>(anim - boneAnimations_.data()), time, cursor, position, rotation, scale);
+            outLocalTransforms[i] = ComposeLocalTransform(position, rotation, scale);
         } else {
             outLocalTransforms[i] = bone->localBindPose;
         }
     }
 }
 
+void AnimationClip::Sample(float time, const AnimationBinding& binding, const Skeleton& skeleton,
+                           AnimationCursor& cursor, std::vector<Matrix4x4>& outLocalTransforms) const {
+    const uint32 boneCount = binding.GetBoneCount();
+    const auto& bones = skeleton.GetBones();
+    outLocalTransforms.resize(boneCount);
+    cursor.resize(boneAnimations_.size());
+
+    for (uint32 i = 0; i < boneCount; ++i) {
+        const uint32 channel = binding.GetChannel(i);
+        if (channel != AnimationBinding::INVALID_CHANNEL) {
+            Vector3 position;
+            Quaternion rotation;
+            Vector3 scale;
+            SampleChannel(channel, time, cursor[channel], position, rotation, scale);
+            outLocalTransforms[i] = ComposeLocalTransform(position, rotation, scale);
+        } else {
+            outLocalTransforms[i] = bones[i].localBindPose;
+        }
+    }
+}
+
+void AnimationClip::Sample(float time, const AnimationBinding& binding, const Skeleton& skeleton,
+                           AnimationCursor& cursor, Pose& outPose, bool skipDetailBones) const {
+    const uint32 boneCount = binding.GetBoneCount();
+    const Pose& bindPose = skeleton.GetBindPose();
+    outPose.Resize(boneCount);
+    cursor.resize(boneAnimations_.size());
+
+    for (uint32 i = 0; i < boneCount; ++i) {
+        const uint32 channel = binding.GetChannel(i);
+        if (channel != AnimationBinding::INVALID_CHANNEL && !(skipDetailBones && skeleton.IsDetailBone(i))) {
+            Vector3 position;
+            Quaternion rotation;
+            Vector3 scale;
+            SampleChannel(channel, time, cursor[channel], position, rotation, scale);
+            outPose.SetBone(i, position, rotation, scale);
+        } else {
+            outPose.SetBone(i, bindPose.GetTranslation(i), bindPose.GetRotation(i), bindPose.GetScale(i));
+        }
+    }
+}
+
+Vector3 AnimationClip::SampleBoneTranslation(float time, const AnimationBinding& binding, const Skeleton& skeleton,
+                                            uint32 boneIndex, AnimationCursor& cursor) const {
+    const uint32 channel = binding.GetChannel(boneIndex);
+    if (channel == AnimationBinding::INVALID_CHANNEL) {
+        return skeleton.GetBindPose().GetTranslation(boneIndex);
+    }
+
+    cursor.resize(boneAnimations_.size());
+    Vector3 position;
+    Quaternion rotation;
+    Vector3 scale;
+    SampleChannel(channel, time, cursor[channel], position, rotation, scale);
+    return position;
+}
+
+void AnimationClip::SampleChannel(uint32 channel, float time, BoneAnimation::Cursor& cursor,
+                                  Vector3& outPosition, Quaternion& outRotation, Vector3& outScale) const {
+    if (compressed_) {
+        compressed_->Sample(channel, time, cursor, outPosition, outRotation, outScale);
+    } else {
+        boneAnimations_[channel].Sample(time, cursor, outPosition, outRotation, outScale);
+    }
+}
+
+void AnimationClip::Compress(const Skeleton& skeleton, const AnimationCompressionSettings& settings,
+                             AnimationCompressionReport* outReport) {
+    if (compressed_) {
+        return;
+    }
+
+    UniquePtr<CompressedAnimation> compressed = CompressedAnimation::Compress(*this, skeleton, settings);
+
+    if (outReport) {
+        AnimationCompressionReport& report = *outReport;
+        report = AnimationCompressionReport();
+        report.trackCount = static_cast<uint32>(boneAnimations_.size()) * 3;
+        report.constantTrackCount = compressed->GetConstantTrackCount();
+        report.compressedKeyCount = compressed->GetKeyCount();
+        report.compressedBytes = compressed->GetMemoryUsage();
+
+        report.rawBytes = boneAnimations_.capacity() * sizeof(BoneAnimation);
+        for (const BoneAnimation& anim : boneAnimations_) {
+            report.rawKeyCount += static_cast<uint32>(anim.positionKeys.size() + anim.rotationKeys.size() + anim.scaleKeys.size());
+            report.rawBytes += anim.positionKeys.capacity() * sizeof(Keyframe<Vector3>)
+                + anim.rotationKeys.capacity() * sizeof(Keyframe<Quaternion>)
+                + anim.scaleKeys.capacity() * sizeof(Keyframe<Vector3>);
+        }
+
+        // 元のキーと圧縮後のキーでポーズを比べ、スケルトン空間でのボーン位置のずれの最大値を測る
+        // フレームの間の補間も含めるため、1フレームを4分割した時刻で比較する
+        constexpr uint32 SUBDIVISIONS = 4;
+        const auto& bones = skeleton.GetBones();
+        const uint32 boneCount = skeleton.GetBoneCount();
+        const uint32 stepCount = (std::max)(static_cast<uint32>(duration_ * settings.sampleRate / ticksPerSecond_), 1u) * SUBDIVISIONS;
+
+        AnimationBinding binding(*this, skeleton);
+        std::vector<Matrix4x4> rawGlobal(boneCount);
+        std::vector<Matrix4x4> compressedGlobal(boneCount);
+        AnimationCursor rawCursor(boneAnimations_.size());
+        AnimationCursor compressedCursor(boneAnimations_.size());
+
+        for (uint32 step = 0; step <= stepCount; ++step) {
+            const float time = duration_ * static_cast<float>(step) / static_cast<float>(stepCount);
+            for (uint32 i = 0; i < boneCount; ++i) {
+                Matrix4x4 rawLocal = bones[i].localBindPose;
+                Matrix4x4 compressedLocal = bones[i].localBindPose;
+                const uint32 channel = binding.GetChannel(i);
+                if (channel != AnimationBinding::INVALID_CHANNEL) {
+                    rawLocal = boneAnimations_[channel].GetLocalTransform(time, rawCursor[channel]);
+                    compressedLocal = compressed->GetLocalTransform(channel, time, compressedCursor[channel]);
+                }
+
+                // : Global = Local * Parent
+                const int32 parent = bones[i].parentIndex;
+                rawGlobal[i] = parent == INVALID_BONE_INDEX ? rawLocal : rawLocal * rawGlobal[parent];
+                compressedGlobal[i] = parent == INVALID_BONE_INDEX ? compressedLocal : compressedLocal * compressedGlobal[parent];
+
+                const Vector3 origin(0.0f, 0.0f, 0.0f);
+                const float error = (rawGlobal[i].TransformPoint(origin) - compressedGlobal[i].TransformPoint(origin)).Length();
+                report.maxPositionError = (std::max)(report.maxPositionError, error);
+            }
+        }
+    }
+
+    // 圧縮後は名前だけを残す（バインディングの構築にはボーン名を使う）
+    for (BoneAnimation& anim : boneAnimations_) {
+        anim.positionKeys = {};
+        anim.rotationKeys = {};
+        anim.scaleKeys = {};
+    }
+    compressed_ = std::move(compressed);
+}
+
 } // namespace UnoEngine
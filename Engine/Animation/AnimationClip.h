@@ -10,6 +10,13 @@
 
 namespace UnoEngine {
 
+class AnimationClip;
+class CompressedAnimation;
+class Skeleton;
+class Pose;
+struct AnimationCompressionSettings;
+struct AnimationCompressionReport;
+
 template<typename T>
 struct Keyframe {
     float time = 0.0f;
@@ -27,12 +34,64 @@ struct BoneAnimation {
     Vector3 InterpolateScale(float time) const;
 
     Matrix4x4 GetLocalTransform(float time) const;
+
+    // キー位置のキャッシュ付き（前回のキーから探索を始めるため、順再生ではほぼO(1)）
+    struct Cursor {
+        uint32 position = 0;
+        uint32 rotation = 0;
+        uint32 scale = 0;
+    };
+    Matrix4x4 GetLocalTransform(float time, Cursor& cursor) const;
+    void Sample(float time, Cursor& cursor, Vector3& outPosition, Quaternion& outRotation, Vector3& outScale) const;
+};
+
+// 再生位置が指定した時刻を通過した時に通知するイベント（足音・効果音・スクリプトの呼び出しなど）
+struct AnimationEvent {
+    float time = 0.0f;      // ticks
+    std::string name;
+    float floatParameter = 0.0f;
+    int32 intParameter = 0;
+    std::string stringParameter;
+};
+
+// 時刻に対するfloat値の曲線（ゲーム側やマテリアルに渡すパラメータ用）
+// キーの間は線形補間し、範囲外は端のキーの値になる
+struct AnimationCurve {
+    std::string name;
+    std::vector<Keyframe<float>> keys;  // 時刻（ticks）の昇順
+
+    float Evaluate(float time) const;
+};
+
+// クリップのチャンネルとスケルトンのボーンの対応表
+// ボーン名による検索を構築時の1回だけにし、サンプリング時はボーン番号からチャンネル番号を直接引く
+class AnimationBinding {
+public:
+    static constexpr uint32 INVALID_CHANNEL = 0xFFFFFFFF;
+
+    AnimationBinding() = default;
+    AnimationBinding(const AnimationClip& clip, const Skeleton& skeleton);
+
+    bool IsBoundTo(const AnimationClip* clip, const Skeleton* skeleton) const {
+        return clip_ == clip && skeleton_ == skeleton && clip != nullptr;
+    }
+
+    uint32 GetBoneCount() const { return static_cast<uint32>(boneToChannel_.size()); }
+    uint32 GetChannel(uint32 boneIndex) const { return boneToChannel_[boneIndex]; }
+
+private:
+    const AnimationClip* clip_ = nullptr;
+    const Skeleton* skeleton_ = nullptr;
+    std::vector<uint32> boneToChannel_;  // ボーン番号 -> BoneAnimationの番号（無ければINVALID_CHANNEL）
 };
 
+// 再生インスタンスごとのキー位置キャッシュ（チャンネル番号で引く）
+using AnimationCursor = std::vector<BoneAnimation::Cursor>;
+
 class AnimationClip {
 public:
-    AnimationClip() = default;
-    ~AnimationClip() = default;
+    AnimationClip();
+    ~AnimationClip();
 
     void SetName(const std::string& name) { name_ = name; }
     const std::string& GetName() const { return name_; }
@@ -48,16 +107,58 @@ public:
 
     const std::vector<BoneAnimation>& GetBoneAnimations() const { return boneAnimations_; }
 
-    void Sample(float time, const class Skeleton& skeleton,
+    // キーを圧縮形式に変換し、元のキーを破棄する（BoneAnimationはボーン名だけが残る）
+    // 以降のSampleは圧縮済みのデータから行う
+    void Compress(const Skeleton& skeleton, const AnimationCompressionSettings& settings,
+                  AnimationCompressionReport* outReport = nullptr);
+    bool IsCompressed() const { return compressed_ != nullptr; }
+
+    void Sample(float time, const Skeleton& skeleton,
                 std::vector<Matrix4x4>& outLocalTransforms) const;
 
+    // 対応表とキー位置キャッシュを使うサンプリング（毎フレーム再生する場合はこちらを使う）
+    // cursorはチャンネル数に合わせて自動で確保される
+    void Sample(float time, const AnimationBinding& binding, const Skeleton& skeleton,
+                AnimationCursor& cursor, std::vector<Matrix4x4>& outLocalTransforms) const;
+
+    // 行列を作らずに平行移動・回転・スケールのままPoseへ書き出す（ブレンドする場合はこちらを使う）
+    // skipDetailBonesがtrueの場合、細部のボーン（Skeleton::IsDetailBone）はサンプリングせずバインドポーズにする
+    void Sample(float time, const AnimationBinding& binding, const Skeleton& skeleton,
+                AnimationCursor& cursor, Pose& outPose, bool skipDetailBones = false) const;
+
+    // 1本のボーンの平行移動（チャンネルが無ければバインドポーズの値）
+    Vector3 SampleBoneTranslation(float time, const AnimationBinding& binding, const Skeleton& skeleton,
+                                  uint32 boneIndex, AnimationCursor& cursor) const;
+
+    // イベントは時刻順に並べて保持する（同じ時刻なら追加順）
+    void AddEvent(const AnimationEvent& event);
+    const std::vector<AnimationEvent>& GetEvents() const { return events_; }
+    bool HasEvents() const { return !events_.empty(); }
+
+    // 時刻がlo〜hiの間にあるイベントの範囲 [outBegin, outEnd) を求める（includeLo/includeHiで端を含めるか指定）
+    // cursorは前回のoutEndで、続きから探す順再生ではほぼO(1)。シークした場合は二分探索に切り替える
+    void FindEvents(float lo, float hi, bool includeLo, bool includeHi, uint32& cursor,
+                    uint32& outBegin, uint32& outEnd) const;
+
+    // キーは時刻順に並べ替えて保持する。同じ名前の曲線は置き換える
+    void AddCurve(const AnimationCurve& curve);
+    const std::vector<AnimationCurve>& GetCurves() const { return curves_; }
+    const AnimationCurve* GetCurve(const std::string& name) const;
+
 private:
     std::string name_;
     float duration_ = 0.0f;
     float ticksPerSecond_ = 25.0f;
 
+    void SampleChannel(uint32 channel, float time, BoneAnimation::Cursor& cursor,
+                       Vector3& outPosition, Quaternion& outRotation, Vector3& outScale) const;
+
     std::vector<BoneAnimation> boneAnimations_;
     std::unordered_map<std::string, size_t> boneNameToAnimIndex_;
+    std::vector<AnimationEvent> events_;
+    std::vector<AnimationCurve> curves_;
+    std::unordered_map<std::string, size_t> curveNameToIndex_;
+    UniquePtr<CompressedAnimation> compressed_;
 };
 
 } // namespace UnoEngine
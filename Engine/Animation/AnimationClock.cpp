@@ -0,0 +1,35 @@
+#include "AnimationClock.h"
+#include <algorithm>
+
+namespace UnoEngine {
+
+void AnimationClock::SetTimeStep(float timeStep) {
+    timeStep_ = (std::max)(timeStep, 0.0f);
+    accumulator_ = 0.0;
+}
+
+void AnimationClock::SetMaxStepsPerFrame(uint32 maxSteps) {
+    maxStepsPerFrame_ = (std::max)(maxSteps, 1u);
+}
+
+AnimationClockFrame AnimationClock::Advance(float deltaTime) {
+    AnimationClockFrame frame;
+    if (timeStep_ <= 0.0f) {
+        frame.stepDelta = deltaTime;
+        return frame;
+    }
+
+    // 経過時間をためておき、ステップの時間幅ごとに進める
+    accumulator_ += deltaTime;
+    frame.stepCount = static_cast<uint32>(accumulator_ / timeStep_);
+    accumulator_ -= static_cast<double>(frame.stepCount) * timeStep_;
+    if (frame.stepCount > maxStepsPerFrame_) {
+        // 追いつけない分の時間は捨てる（アニメーションが遅れるだけで、次のフレームに持ち越さない）
+        frame.stepCount = maxStepsPerFrame_;
+    }
+    frame.stepDelta = timeStep_;
+    frame.interpolation = static_cast<float>(accumulator_ / timeStep_);
+    return frame;
+}
+
+} // namespace UnoEngine
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../Core/Types.h"
+
+namespace UnoEngine {
+
+// 1フレームで進めるステップ
+struct AnimationClockFrame {
+    float stepDelta = 0.0f;         // 1ステップの時間幅（秒）
+    uint32 stepCount = 1;
+    float interpolation = 1.0f;     // 最後のステップの前（0）から後（1）のどこを描画するか
+};
+
+// 可変のフレーム時間を固定の時間幅のステップに分ける、アニメーション用の時計
+// 再生位置・遷移・ルートモーションをステップ単位で進めることで、結果がフレームレートによらず同じになる
+class AnimationClock {
+public:
+    // 処理落ちで更新が追いつかなくなるのを防ぐ、1フレームの最大ステップ数
+    static constexpr uint32 DEFAULT_MAX_STEPS_PER_FRAME = 4;
+
+    AnimationClock() = default;
+
+    // 時間幅（秒）。0ならフレームの経過時間でそのまま1回進める。変更するとためていた時間は捨てる
+    void SetTimeStep(float timeStep);
+    float GetTimeStep() const { return timeStep_; }
+
+    void SetMaxStepsPerFrame(uint32 maxSteps);
+    uint32 GetMaxStepsPerFrame() const { return maxStepsPerFrame_; }
+
+    // deltaTime（秒）だけ時間を進め、このフレームで進めるステップを返す
+    AnimationClockFrame Advance(float deltaTime);
+
+    void Reset() { accumulator_ = 0.0; }
+
+private:
+    float timeStep_ = 1.0f / 60.0f;
+    uint32 maxStepsPerFrame_ = DEFAULT_MAX_STEPS_PER_FRAME;
+    double accumulator_ = 0.0;  // まだステップとして進めていない時間
+};
+
+} // namespace UnoEngine
@@ -0,0 +1,63 @@
+#include "AnimationLod.h"
+#include "../Core/Camera.h"
+#include <cmath>
+
+namespace UnoEngine {
+
+namespace AnimationLod {
+
+float ComputeScreenSize(const Camera& camera, const BoundingSphere& worldSphere) {
+    // ビュー行列を使わずカメラの基底ベクトルで判定する（Cameraのconstなメンバだけで済むため、
+    // 他のシステムと並行して呼んでもカメラの状態を書き換えない）
+    const Vector3 toCenter = worldSphere.center - camera.GetPosition();
+    const float depth = toCenter.Dot(camera.GetForward());
+    const float x = toCenter.Dot(camera.GetRight());
+    const float y = toCenter.Dot(camera.GetUp());
+    const float radius = worldSphere.radius;
+
+    if (depth + radius < camera.GetNearClip() || depth - radius > camera.GetFarClip()) {
+        return -1.0f;
+    }
+
+    if (camera.GetProjectionType() == ProjectionType::Orthographic) {
+        const float halfWidth = camera.GetOrthographicWidth() * 0.5f;
+        const float halfHeight = camera.GetOrthographicHeight() * 0.5f;
+        if (std::abs(x) > halfWidth + radius || std::abs(y) > halfHeight + radius) {
+            return -1.0f;
+        }
+        return radius / halfHeight;
+    }
+
+    // 側面の平面までの距離で判定する（平面の法線方向の成分 = 中心の位置を傾きで補正したもの）
+    const float tanHalfFovY = std::tan(camera.GetFieldOfView() * 0.5f);
+    const float tanHalfFovX = tanHalfFovY * camera.GetAspectRatio();
+    const float cosHalfFovY = 1.0f / std::sqrt(1.0f + tanHalfFovY * tanHalfFovY);
+    const float cosHalfFovX = 1.0f / std::sqrt(1.0f + tanHalfFovX * tanHalfFovX);
+    if ((std::abs(x) - depth * tanHalfFovX) * cosHalfFovX > radius ||
+        (std::abs(y) - depth * tanHalfFovY) * cosHalfFovY > radius) {
+        return -1.0f;
+    }
+
+    // カメラが球の内側にある場合は画面全体を覆う
+    if (depth <= radius) {
+        return 1.0f;
+    }
+    return radius / (depth * tanHalfFovY);
+}
+
+uint32 SelectLevel(const Camera& camera, const BoundingSphere& worldSphere, const AnimationLodSettings& settings) {
+    const float screenSize = ComputeScreenSize(camera, worldSphere);
+    if (screenSize < 0.0f) {
+        return settings.skipInvisible ? CULLED : AnimationLodSettings::LEVEL_COUNT - 1;
+    }
+
+    uint32 level = 0;
+    while (level < AnimationLodSettings::LEVEL_COUNT - 1 && screenSize < settings.screenSizes[level]) {
+        ++level;
+    }
+    return level;
+}
+
+} // namespace AnimationLod
+
+} // namespace UnoEngine
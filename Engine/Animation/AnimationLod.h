@@ -0,0 +1,48 @@
+#pragma once
+
+#include "../Core/Types.h"
+#include "../Math/BoundingVolume.h"
+
+namespace UnoEngine {
+
+class Camera;
+
+// アニメーションLODの1段階分の設定
+struct AnimationLodLevel {
+    uint32 updateInterval = 1;      // 何フレームに1回ポーズを計算するか
+    bool interpolate = true;        // 計算しないフレームで直前2回の結果を補間するか（falseなら前回の結果を保持）
+    bool skipDetailBones = false;   // 指・顔などの細部のボーン（Skeleton::IsDetailBone）をバインドポーズのままにする
+};
+
+// 画面上の大きさによるLODの選択基準
+// 大きさはバウンディング球の直径がビューポートの高さに占める比率
+struct AnimationLodSettings {
+    static constexpr uint32 LEVEL_COUNT = 3;
+
+    float screenSizes[LEVEL_COUNT - 1] = { 0.25f, 0.08f };  // これ未満になると次の段階へ
+    AnimationLodLevel levels[LEVEL_COUNT] = {
+        { 1, false, false },    // 近景: 毎フレーム・全ボーン
+        { 2, true,  false },    // 中景: 2フレームに1回
+        { 4, true,  true  },    // 遠景: 4フレームに1回、細部のボーンは省略
+    };
+
+    bool enabled = true;            // falseなら全員を毎フレーム・全ボーンで更新する
+    bool skipInvisible = true;      // 視錐台の外にあるものはポーズを計算しない（再生時間だけ進める）
+    float defaultRadius = 1.0f;     // SkinnedMeshRendererが無い場合に使うバウンディング球の半径
+};
+
+namespace AnimationLod {
+
+// SelectLevelの戻り値（視錐台の外）
+constexpr uint32 CULLED = 0xFFFFFFFF;
+
+// ワールド空間のバウンディング球の画面上の大きさ（直径 / ビューポートの高さ）
+// 視錐台の外にある場合は負の値を返す
+float ComputeScreenSize(const Camera& camera, const BoundingSphere& worldSphere);
+
+// LODの段階番号（0が最も詳細）。視錐台の外で、settings.skipInvisibleが有効ならCULLED
+uint32 SelectLevel(const Camera& camera, const BoundingSphere& worldSphere, const AnimationLodSettings& settings);
+
+} // namespace AnimationLod
+
+} // namespace UnoEngine
@@ -0,0 +1,106 @@
+#include "AnimationPoseCache.h"
+#include "AnimationClip.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace UnoEngine {
+
+AnimationPoseCache::Key AnimationPoseCache::MakeKey(const Skeleton& skeleton, const AnimationClip& clip,
+                                                    float timeInTicks, bool skipDetailBones,
+                                                    float& outSampleTime) const {
+    const float ticksPerSecond = clip.GetTicksPerSecond() > 0.0f ? clip.GetTicksPerSecond() : 1.0f;
+
+    Key key;
+    key.skeleton = &skeleton;
+    key.clip = &clip;
+    key.skipDetailBones = skipDetailBones;
+    key.timeStep = timeQuantum_ > 0.0f ? std::llround(timeInTicks / ticksPerSecond / timeQuantum_) : 0;
+
+    // 同じキーならどのAnimatorが計算しても同じ結果になるよう、丸めた時刻でサンプリングする
+    const float quantizedTime = timeQuantum_ > 0.0f
+        ? static_cast<float>(key.timeStep) * timeQuantum_ * ticksPerSecond
+        : timeInTicks;
+    outSampleTime = std::clamp(quantizedTime, 0.0f, clip.GetDuration());
+    return key;
+}
+
+void AnimationPoseCache::BeginFrame() {
+    lastFrameRequests_ = frameRequests_;
+    lastFramePoses_ = entryCount_;
+    frameRequests_ = 0;
+
+    // パレットはまだAnimatorが参照しているため、ここでは手放すだけにして再利用はAllocatePaletteで判断する
+    for (uint32 i = 0; i < entryCount_; ++i) {
+        Entry& entry = *entries_[i];
+        retired_.push_back(std::move(entry.palette));
+        entry.ready.store(false, std::memory_order_relaxed);
+    }
+    entryCount_ = 0;
+    lookup_.clear();
+
+    // どのAnimatorからも参照されなくなったパレットは、次のフレームで必要になりそうな数（直前のフレームのポーズ数）だけ残す
+    size_t freeCount = 0;
+    retired_.erase(std::remove_if(retired_.begin(), retired_.end(),
+        [&](const std::shared_ptr<Palette>& palette) {
+            return palette.use_count() == 1 && ++freeCount > lastFramePoses_;
+        }), retired_.end());
+}
+
+AnimationPoseCache::PaletteHandle AnimationPoseCache::Acquire(const Key& key,
+                                                              const std::function<void(Palette&)>& compute) {
+    Entry* entry = nullptr;
+    bool isOwner = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++frameRequests_;
+
+        auto [it, inserted] = lookup_.try_emplace(key, nullptr);
+        if (inserted) {
+            if (entryCount_ == entries_.size()) {
+                entries_.push_back(MakeUnique<Entry>());
+            }
+            entry = entries_[entryCount_++].get();
+            entry->palette = AllocatePalette();
+            it->second = entry;
+            isOwner = true;
+        } else {
+            entry = it->second;
+        }
+    }
+
+    if (isOwner) {
+        compute(*entry->palette);
+        entry->ready.store(true, std::memory_order_release);
+    } else {
+        // 計算中のスレッドは実行中なので、短い待ちで済む
+        while (!entry->ready.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+    return entry->palette;
+}
+
+std::shared_ptr<AnimationPoseCache::Palette> AnimationPoseCache::AllocatePalette() {
+    // 呼び出し元でmutex_をロック済み
+    for (size_t i = 0; i < retired_.size(); ++i) {
+        if (retired_[i].use_count() == 1) {
+            // 最後に参照していたスレッドの読み取りが済んでから書き換える
+            std::atomic_thread_fence(std::memory_order_acquire);
+            std::shared_ptr<Palette> palette = std::move(retired_[i]);
+            retired_[i] = std::move(retired_.back());
+            retired_.pop_back();
+            return palette;
+        }
+    }
+    return std::make_shared<Palette>();
+}
+
+size_t AnimationPoseCache::KeyHash::operator()(const Key& key) const {
+    size_t hash = std::hash<const void*>()(key.skeleton);
+    hash ^= std::hash<const void*>()(key.clip) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<int64>()(key.timeStep * 2 + (key.skipDetailBones ? 1 : 0)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+} // namespace UnoEngine
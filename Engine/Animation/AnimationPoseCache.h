@@ -0,0 +1,90 @@
+#pragma once
+
+#include "../Core/Types.h"
+#include "../Math/Matrix.h"
+#include "Skeleton.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace UnoEngine {
+
+class AnimationClip;
+
+// 同じスケルトン・同じクリップ・同じ時刻のポーズを、フレーム内で1回だけ計算して共有するキャッシュ
+//
+// 群衆のように同じモデルで同じクリップを同期再生しているキャラクターは、ボーン行列がまったく同じになる
+// 時刻はtimeQuantum秒単位に丸めてキーにし（丸めた時刻でサンプリングする）、わずかにずれた再生位置もまとめる
+// 計算したパレットは参照カウントで共有し、使っているAnimatorが無くなったものは次のフレームで再利用する
+//
+// AnimationSystemが毎フレームBeginFrameを呼び、Animatorの並列更新中はAcquireを複数スレッドから呼んでよい
+class AnimationPoseCache {
+public:
+    struct Palette {
+        std::vector<Matrix4x4> localTransforms;
+        std::vector<BoneMatrixPair> boneMatrixPairs;
+        std::vector<Matrix4x4> boneMatrices;
+    };
+    using PaletteHandle = std::shared_ptr<const Palette>;
+
+    struct Key {
+        const Skeleton* skeleton = nullptr;
+        const AnimationClip* clip = nullptr;
+        int64 timeStep = 0;             // 再生位置（秒）/ timeQuantum を丸めた値
+        bool skipDetailBones = false;   // アニメーションLODで細部のボーンを省略しているか
+
+        bool operator==(const Key& other) const {
+            return skeleton == other.skeleton && clip == other.clip &&
+                   timeStep == other.timeStep && skipDetailBones == other.skipDetailBones;
+        }
+    };
+
+    static constexpr float DEFAULT_TIME_QUANTUM = 1.0f / 120.0f;
+
+    void SetTimeQuantum(float seconds) { timeQuantum_ = seconds; }
+    float GetTimeQuantum() const { return timeQuantum_; }
+
+    // 再生位置（ticks）からキーを作る。outSampleTimeには実際にサンプリングする時刻（ticks）を返す
+    Key MakeKey(const Skeleton& skeleton, const AnimationClip& clip, float timeInTicks, bool skipDetailBones,
+                float& outSampleTime) const;
+
+    // 前のフレームのエントリを破棄する（並列更新の外で呼ぶ）
+    void BeginFrame();
+
+    // キーに対応するパレットを返す。キャッシュに無ければこのフレームで最初に要求したスレッドがcomputeで作り、
+    // 同じキーを同時に要求した他のスレッドはその完了を待つ
+    PaletteHandle Acquire(const Key& key, const std::function<void(Palette&)>& compute);
+
+    // 直前のフレームの統計（BeginFrameで更新）
+    uint32 GetLastFrameRequestCount() const { return lastFrameRequests_; }
+    uint32 GetLastFramePoseCount() const { return lastFramePoses_; }
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        std::shared_ptr<Palette> palette;
+        std::atomic<bool> ready{ false };
+    };
+
+    std::shared_ptr<Palette> AllocatePalette();
+
+    float timeQuantum_ = DEFAULT_TIME_QUANTUM;
+
+    std::mutex mutex_;
+    std::unordered_map<Key, Entry*, KeyHash> lookup_;
+    std::vector<UniquePtr<Entry>> entries_;             // 確保済みのエントリ（先頭entryCount_個がこのフレームで使用中）
+    uint32 entryCount_ = 0;
+    std::vector<std::shared_ptr<Palette>> retired_;     // 前のフレーム以前のパレット（誰も参照しなくなったら再利用する）
+
+    uint32 frameRequests_ = 0;
+    uint32 lastFrameRequests_ = 0;
+    uint32 lastFramePoses_ = 0;
+};
+
+} // namespace UnoEngine
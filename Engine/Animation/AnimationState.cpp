@@ -1,5 +1,8 @@
 #include "AnimationState.h"
 #include "AnimationClip.h"
+#include "Skeleton.h"
+#include "Pose.h"
+#include <algorithm>
 #include <cmath>
 
 namespace UnoEngine {
@@ -8,75 +11,241 @@ AnimationState::AnimationState(const std::string& name, std::shared_ptr<Animatio
     : name_(name), clip_(clip) {
 }
 
+AnimationState::AnimationState(const std::string& name, UniquePtr<BlendTree> blendTree)
+    : name_(name), blendTree_(std::move(blendTree)) {
+}
+
 void AnimationState::AddTransition(const AnimationTransition& transition) {
     transitions_.push_back(transition);
 }
 
-void AnimationState::Update(float deltaTime) {
-    if (!clip_ || isFinished_) {
+void AnimationState::Update(float deltaTime, std::vector<FiredAnimationEvent>* outEvents, float eventWeight) {
+    previousNormalizedTime_ = normalizedTime_;
+    loopedLastUpdate_ = false;
+
+    if (!HasMotion() || isFinished_) {
         return;
     }
 
-    float duration = clip_->GetDuration();
-    if (duration <= 0.0f) {
-        return;
+    float normalizedDelta = 0.0f;
+    if (blendTree_) {
+        // ブレンドツリーは重み付きの長さ（秒）で進める
+        const float duration = blendTree_->GetDuration();
+        if (duration <= 0.0f) {
+            return;
+        }
+        normalizedDelta = deltaTime * speed_ / duration;
+    } else {
+        float duration = clip_->GetDuration();
+        if (duration <= 0.0f) {
+            return;
+        }
+
+        // deltaTimeは秒単位、durationはticks単位
+        // ticksPerSecondを使ってdeltaTimeをticks単位に変換
+        float ticksPerSecond = clip_->GetTicksPerSecond();
+        float deltaInTicks = deltaTime * speed_ * ticksPerSecond;
+        normalizedDelta = deltaInTicks / duration;
     }
 
-    // deltaTimeは秒単位、durationはticks単位
-    // ticksPerSecondを使ってdeltaTimeをticks単位に変換
-    float ticksPerSecond = clip_->GetTicksPerSecond();
-    float deltaInTicks = deltaTime * speed_ * ticksPerSecond;
-    float normalizedDelta = deltaInTicks / duration;
-    normalizedTime_ += normalizedDelta;
+    const AnimationClip* eventClip = outEvents ? GetEventClip() : nullptr;
+    const bool includeStart = atStart_;
+    atStart_ = false;
+    auto fire = [&](float from, float to, bool includeFrom) {
+        if (eventClip) {
+            FireEvents(*eventClip, from, to, includeFrom, *outEvents, eventWeight);
+        }
+    };
 
     switch (wrapMode_) {
     case AnimationWrapMode::Once:
+        normalizedTime_ += normalizedDelta;
         if (normalizedTime_ >= 1.0f) {
             normalizedTime_ = 1.0f;
             isFinished_ = true;
         }
+        fire(previousNormalizedTime_, normalizedTime_, includeStart);
         break;
 
-    case AnimationWrapMode::Loop:
-        normalizedTime_ = std::fmod(normalizedTime_, 1.0f);
+    case AnimationWrapMode::Loop: {
+        const float unwrapped = normalizedTime_ + normalizedDelta;
+        loopedLastUpdate_ = unwrapped >= 1.0f || unwrapped < 0.0f;
+        normalizedTime_ = std::fmod(unwrapped, 1.0f);
         if (normalizedTime_ < 0.0f) {
             normalizedTime_ += 1.0f;
         }
+
+        if (!loopedLastUpdate_) {
+            fire(previousNormalizedTime_, normalizedTime_, includeStart);
+        } else if (normalizedDelta >= 0.0f) {
+            fire(previousNormalizedTime_, 1.0f, includeStart);
+            fire(0.0f, normalizedTime_, true);
+        } else {
+            fire(previousNormalizedTime_, 0.0f, includeStart);
+            fire(1.0f, normalizedTime_, true);
+        }
         break;
+    }
 
     case AnimationWrapMode::PingPong: {
-        float pingPongTime = std::fmod(normalizedTime_, 2.0f);
-        if (pingPongTime < 0.0f) {
-            pingPongTime += 2.0f;
-        }
-        if (pingPongTime > 1.0f) {
-            normalizedTime_ = 2.0f - pingPongTime;
-        } else {
-            normalizedTime_ = pingPongTime;
+        // 端で折り返して向きを反転する（1回の更新で折り返すのは2回まで）
+        float time = normalizedTime_ + (playingBackward_ ? -normalizedDelta : normalizedDelta);
+        float from = normalizedTime_;
+        bool includeFrom = includeStart;
+        for (int bounce = 0; bounce < 2 && (time > 1.0f || time < 0.0f); ++bounce) {
+            const float edge = time > 1.0f ? 1.0f : 0.0f;
+            fire(from, edge, includeFrom);
+            time = 2.0f * edge - time;
+            from = edge;
+            includeFrom = false;    // 折り返し位置のイベントは1回だけ通知する
+            playingBackward_ = !playingBackward_;
         }
+        normalizedTime_ = std::clamp(time, 0.0f, 1.0f);
+        fire(from, normalizedTime_, includeFrom);
         break;
     }
 
     case AnimationWrapMode::ClampForever:
-        if (normalizedTime_ >= 1.0f) {
-            normalizedTime_ = 1.0f;
-        } else if (normalizedTime_ < 0.0f) {
-            normalizedTime_ = 0.0f;
-        }
+        normalizedTime_ = std::clamp(normalizedTime_ + normalizedDelta, 0.0f, 1.0f);
+        fire(previousNormalizedTime_, normalizedTime_, includeStart);
         break;
     }
 }
 
 float AnimationState::GetCurrentTime() const {
+    if (blendTree_) {
+        return normalizedTime_ * blendTree_->GetDuration();
+    }
     if (!clip_) {
         return 0.0f;
     }
     return normalizedTime_ * clip_->GetDuration();
 }
 
+float AnimationState::GetInterpolatedNormalizedTime(float alpha) const {
+    if (alpha >= 1.0f) {
+        return normalizedTime_;
+    }
+
+    // ループの終端をまたいだ場合は1周分ずらして、戻る方向に補間しないようにする
+    float delta = normalizedTime_ - previousNormalizedTime_;
+    if (loopedLastUpdate_) {
+        delta += delta < 0.0f ? 1.0f : -1.0f;
+    }
+
+    float t = previousNormalizedTime_ + delta * alpha;
+    if (loopedLastUpdate_) {
+        t -= std::floor(t);
+    }
+    return t;
+}
+
 void AnimationState::Reset() {
     normalizedTime_ = 0.0f;
+    previousNormalizedTime_ = 0.0f;
+    loopedLastUpdate_ = false;
     isFinished_ = false;
+    playingBackward_ = false;
+    atStart_ = true;
+    eventCursor_ = 0;
+}
+
+void AnimationState::Sample(const Skeleton& skeleton, std::vector<Matrix4x4>& outLocalTransforms) {
+    if (!clip_) {
+        return;
+    }
+
+    UpdateBinding(skeleton);
+    clip_->Sample(GetCurrentTime(), binding_, skeleton, cursor_, outLocalTransforms);
+}
+
+void AnimationState::Sample(const Skeleton& skeleton, PosePool& pool, Pose& outPose, bool skipDetailBones) {
+    if (blendTree_) {
+        blendTree_->Sample(normalizedTime_, skeleton, pool, outPose, skipDetailBones);
+        return;
+    }
+    if (!clip_) {
+        return;
+    }
+
+    UpdateBinding(skeleton);
+    clip_->Sample(GetCurrentTime(), binding_, skeleton, cursor_, outPose, skipDetailBones);
+}
+
+void AnimationState::SampleAt(float time, const Skeleton& skeleton, Pose& outPose, bool skipDetailBones) {
+    if (!clip_) {
+        return;
+    }
+
+    UpdateBinding(skeleton);
+    clip_->Sample(time, binding_, skeleton, cursor_, outPose, skipDetailBones);
+}
+
+Vector3 AnimationState::SampleBoneTranslation(const Skeleton& skeleton, uint32 boneIndex, float normalizedTime) {
+    if (blendTree_) {
+        return blendTree_->SampleBoneTranslation(normalizedTime, skeleton, boneIndex);
+    }
+    if (!clip_) {
+        return skeleton.GetBindPose().GetTranslation(boneIndex);
+    }
+
+    UpdateBinding(skeleton);
+    return clip_->SampleBoneTranslation(normalizedTime * clip_->GetDuration(), binding_, skeleton, boneIndex, cursor_);
+}
+
+bool AnimationState::EvaluateCurve(const std::string& name, float& outValue) const {
+    if (blendTree_) {
+        return blendTree_->EvaluateCurve(name, normalizedTime_, outValue);
+    }
+    if (!clip_) {
+        return false;
+    }
+
+    const AnimationCurve* curve = clip_->GetCurve(name);
+    if (!curve) {
+        return false;
+    }
+    outValue = curve->Evaluate(GetCurrentTime());
+    return true;
+}
+
+void AnimationState::ClearBinding() {
+    binding_ = AnimationBinding();
+    if (blendTree_) {
+        blendTree_->ClearBindings();
+    }
+}
+
+void AnimationState::UpdateBinding(const Skeleton& skeleton) {
+    if (!binding_.IsBoundTo(clip_.get(), &skeleton)) {
+        binding_ = AnimationBinding(*clip_, skeleton);
+        cursor_.clear();
+    }
+}
+
+const AnimationClip* AnimationState::GetEventClip() const {
+    const AnimationClip* clip = blendTree_ ? blendTree_->GetDominantClip() : clip_.get();
+    return clip && clip->HasEvents() ? clip : nullptr;
+}
+
+void AnimationState::FireEvents(const AnimationClip& clip, float from, float to, bool includeFrom,
+                                std::vector<FiredAnimationEvent>& outEvents, float weight) {
+    const float duration = clip.GetDuration();
+    const auto& events = clip.GetEvents();
+    uint32 begin = 0;
+    uint32 end = 0;
+
+    if (from <= to) {
+        clip.FindEvents(from * duration, to * duration, includeFrom, true, eventCursor_, begin, end);
+        for (uint32 i = begin; i < end; ++i) {
+            outEvents.push_back({ &events[i], this, weight });
+        }
+    } else {
+        clip.FindEvents(to * duration, from * duration, true, includeFrom, eventCursor_, begin, end);
+        for (uint32 i = end; i > begin; --i) {
+            outEvents.push_back({ &events[i - 1], this, weight });
+        }
+    }
 }
 
 } // namespace UnoEngine
@@ -1,13 +1,17 @@
 #pragma once
 
 #include "../Core/Types.h"
+#include "AnimationClip.h"
+#include "BlendTree.h"
 #include <string>
 #include <memory>
 #include <functional>
 
 namespace UnoEngine {
 
-class AnimationClip;
+class Skeleton;
+class Pose;
+class PosePool;
 
 enum class AnimationWrapMode {
     Once,       // 1回再生して停止
@@ -16,22 +20,36 @@ enum class AnimationWrapMode {
     ClampForever // 最後のフレームで停止
 };
 
+class AnimationState;
+
+// 再生位置が通過したイベント
+struct FiredAnimationEvent {
+    const AnimationEvent* event = nullptr;
+    const AnimationState* state = nullptr;
+    float weight = 1.0f;    // 遷移中のブレンド率やレイヤーの重み（弱いイベントを無視する判定などに使う）
+};
+
 struct AnimationTransition {
     std::string targetStateName;
     float duration = 0.2f;  // ブレンド時間（秒）
-    std::function<bool()> condition;
+    std::function<bool()> condition;  // AnimationSystemのワーカースレッドから呼ばれることがある
 };
 
 class AnimationState {
 public:
     AnimationState() = default;
     AnimationState(const std::string& name, std::shared_ptr<AnimationClip> clip);
+    AnimationState(const std::string& name, UniquePtr<BlendTree> blendTree);
     ~AnimationState() = default;
 
     const std::string& GetName() const { return name_; }
     AnimationClip* GetClip() const { return clip_.get(); }
     std::shared_ptr<AnimationClip> GetClipShared() const { return clip_; }
 
+    // クリップの代わりにブレンドツリーを再生するステート（GetClipはnullptrを返す）
+    BlendTree* GetBlendTree() const { return blendTree_.get(); }
+    bool HasMotion() const { return clip_ || blendTree_; }
+
     void SetWrapMode(AnimationWrapMode mode) { wrapMode_ = mode; }
     AnimationWrapMode GetWrapMode() const { return wrapMode_; }
 
@@ -44,21 +62,62 @@ public:
     float GetNormalizedTime() const { return normalizedTime_; }
     void SetNormalizedTime(float t) { normalizedTime_ = t; }
 
-    void Update(float deltaTime);
+    // outEventsを指定した場合は、今回の更新で通過したイベントを通過した順に追加する
+    // ループ・往復では終端・折り返しをまたいだ分も含める（1回の更新で2周以上進んだ場合の途中の周は通知しない）
+    // ブレンドツリーは重みが最も大きいモーションのイベントだけを通知する
+    void Update(float deltaTime, std::vector<FiredAnimationEvent>* outEvents = nullptr, float eventWeight = 1.0f);
+    // クリップの場合はticks、ブレンドツリーの場合は秒
     float GetCurrentTime() const;
     bool IsFinished() const { return isFinished_; }
 
+    // 直前のUpdateの前の再生位置と、そのUpdateでループの終端をまたいだか
+    float GetPreviousNormalizedTime() const { return previousNormalizedTime_; }
+    bool HasLoopedLastUpdate() const { return loopedLastUpdate_; }
+    // 直前のUpdateの前（alpha=0）から後（alpha=1）までを補間した再生位置（固定ステップ再生の描画用）
+    float GetInterpolatedNormalizedTime(float alpha) const;
+
     void Reset();
 
+    // 現在の再生位置でクリップをサンプリング
+    // スケルトンとの対応表は初回（スケルトン・クリップが変わった時）だけ作り直す
+    // 行列版はクリップのステートのみ対応
+    void Sample(const Skeleton& skeleton, std::vector<Matrix4x4>& outLocalTransforms);
+    void Sample(const Skeleton& skeleton, PosePool& pool, Pose& outPose, bool skipDetailBones = false);
+    // 現在の再生位置の代わりに指定した時刻（ticks）でサンプリングする（クリップのステートのみ）
+    void SampleAt(float time, const Skeleton& skeleton, Pose& outPose, bool skipDetailBones = false);
+    // 1本のボーンの平行移動だけをサンプリングする（ルートモーション用）
+    Vector3 SampleBoneTranslation(const Skeleton& skeleton, uint32 boneIndex, float normalizedTime);
+
+    // 現在の再生位置での曲線の値。曲線が無ければfalseを返す
+    bool EvaluateCurve(const std::string& name, float& outValue) const;
+
+    // スケルトンを差し替えた時に呼ぶ（同じアドレスに別のスケルトンが確保された場合に備える）
+    void ClearBinding();
+
 private:
+    void UpdateBinding(const Skeleton& skeleton);
+    const AnimationClip* GetEventClip() const;
+    // 正規化時間fromからtoまでに通過したイベントを追加する（to < fromなら逆再生として逆順に追加する）
+    void FireEvents(const AnimationClip& clip, float from, float to, bool includeFrom,
+                    std::vector<FiredAnimationEvent>& outEvents, float weight);
+
     std::string name_;
     std::shared_ptr<AnimationClip> clip_;
+    UniquePtr<BlendTree> blendTree_;
     AnimationWrapMode wrapMode_ = AnimationWrapMode::Loop;
     float speed_ = 1.0f;
     float normalizedTime_ = 0.0f;
+    float previousNormalizedTime_ = 0.0f;
+    bool loopedLastUpdate_ = false;
     bool isFinished_ = false;
+    bool playingBackward_ = false;  // PingPongで折り返した後の区間を再生中
+    bool atStart_ = true;           // Reset後の最初の更新では開始位置ちょうどのイベントも通知する
+    uint32 eventCursor_ = 0;
 
     std::vector<AnimationTransition> transitions_;
+
+    AnimationBinding binding_;
+    AnimationCursor cursor_;
 };
 
 } // namespace UnoEngine
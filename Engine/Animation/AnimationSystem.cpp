@@ -2,9 +2,40 @@
 #include "AnimatorComponent.h"
 #include "../Core/Scene.h"
 #include "../Core/GameObject.h"
+#include "../Core/Camera.h"
+#include "../Core/JobSystem.h"
+#include "../Core/Transform.h"
+#include <algorithm>
+#include <cmath>
 
 namespace UnoEngine {
 
+namespace {
+
+// LOD判定用のワールド空間のバウンディング球
+// 描画時の姿勢補正（RenderSystemの起き上がり回転）やアニメーションによる回転に左右されないよう、
+// オブジェクトの原点を中心に、メッシュのバウンディング球を含む大きさにする
+BoundingSphere ComputeLodSphere(const Matrix4x4& world, const BoundingSphere* modelBounds, float defaultRadius) {
+    float maxScaleSq = 0.0f;
+    for (uint32 row = 0; row < 3; ++row) {
+        const Vector3 axis(world.GetElement(row, 0), world.GetElement(row, 1), world.GetElement(row, 2));
+        maxScaleSq = (std::max)(maxScaleSq, axis.LengthSq());
+    }
+
+    const float localRadius = modelBounds ? modelBounds->center.Length() + modelBounds->radius : defaultRadius;
+
+    const Vector3 origin(world.GetElement(3, 0), world.GetElement(3, 1), world.GetElement(3, 2));
+    return BoundingSphere(origin, localRadius * std::sqrt(maxScaleSq));
+}
+
+} // anonymous namespace
+
+void AnimationSystem::DeclareAccess(SystemAccess& access) const {
+    access.Write<AnimatorComponent>();
+    access.Write<Transform>();
+    DeclareRendererAccess(access);
+}
+
 void AnimationSystem::OnUpdate(Scene* scene, float deltaTime) {
     if (!scene) return;
 
@@ -21,15 +52,111 @@ void AnimationSystem::OnUpdate(Scene* scene, float deltaTime) {
 
     if (!isPlaying_) return;
 
-    const auto& gameObjects = scene->GetGameObjects();
+    animators_.clear();
+    scene->Query<AnimatorComponent>().ForEach([this](GameObject& go, AnimatorComponent& animator) {
+        if (go.IsActive() && animator.IsEnabled()) {
+            animators_.push_back(&animator);
+        }
+    });
+
+    poseCache_.BeginFrame();
+    AnimationPoseCache* poseCache = poseCacheEnabled_ ? &poseCache_ : nullptr;
+
+    // LODはカメラを読むだけなので、並列に更新する前にここでまとめて決めておく
+    const Camera* camera = scene->GetActiveCamera();
+    for (AnimatorComponent* animatorComponent : animators_) {
+        Animator* animator = animatorComponent->GetAnimator();
+        animator->SetPoseCache(poseCache);
+        GameObject* go = animatorComponent->GetGameObject();
+        SkinnedModelInfo model;
+        GetSkinnedModelInfo(*go, model);
+        if (animator->IsRootMotionEnabled()) {
+            // スケルトン空間の移動量mのワールドでの高さは m・(モデル→ワールド行列の2列目) なので、
+            // この列の方向を取り除けば水平方向の移動だけが残る
+            const Matrix4x4 modelToWorld = model.modelCorrection * go->GetTransform().GetWorldMatrix();
+            animator->SetRootMotionUpAxis(modelToWorld.Transpose().TransformDirection(Vector3(0.0f, 1.0f, 0.0f)));
+        }
+        if (!lodSettings_.enabled || !camera) {
+            animator->SetLod(AnimationLodLevel{});
+            animator->SetCulled(false);
+            continue;
+        }
+
+        const BoundingSphere sphere = ComputeLodSphere(go->GetTransform().GetWorldMatrix(),
+                                                       model.hasBounds ? &model.bounds : nullptr,
+                                                       lodSettings_.defaultRadius);
+        const uint32 level = AnimationLod::SelectLevel(*camera, sphere, lodSettings_);
+        animator->SetCulled(level == AnimationLod::CULLED);
+        if (level != AnimationLod::CULLED) {
+            animator->SetLod(lodSettings_.levels[level]);
+        }
+    }
+
+    const AnimationClockFrame frame = clock_.Advance(deltaTime);
+    const float stepDelta = frame.stepDelta;
+    const uint32 stepCount = frame.stepCount;
+    const float interpolation = frame.interpolation;
+
+    const uint32 count = static_cast<uint32>(animators_.size());
+    JobSystem* jobSystem = GetJobSystem();
+    if (!jobSystem || jobSystem->GetWorkerCount() == 0 || count < PARALLEL_UPDATE_THRESHOLD) {
+        for (AnimatorComponent* animator : animators_) {
+            animator->UpdateAnimation(stepDelta, stepCount, interpolation);
+        }
+    } else {
+        // サンプリング → ブレンド → ボーン行列の計算はAnimatorごとに閉じており、
+        // 書き込み先もAnimatorが保持する確保済みのパレット（共有する場合はポーズキャッシュ）だけなので、そのまま並列に実行できる
+        // （遷移条件のコールバックもワーカースレッドから呼ばれる）
+        const uint32 grainSize = (std::max)(1u, count / (jobSystem->GetThreadCount() * 4));
+        jobSystem->ParallelFor(count, grainSize, [this, stepDelta, stepCount, interpolation](uint32 begin, uint32 end) {
+            for (uint32 i = begin; i < end; ++i) {
+                animators_[i]->UpdateAnimation(stepDelta, stepCount, interpolation);
+            }
+        });
+    }
+
+    // Transformは親子で行列のキャッシュを共有するため、ルートモーションの反映は並列の更新の後にまとめて行う
+    ApplyRootMotion();
+
+    // ポーズキャッシュはこのシステムの更新中だけ使う（ゲーム側から呼ばれるPlayなどでは個別に計算する）
+    for (AnimatorComponent* animatorComponent : animators_) {
+        animatorComponent->GetAnimator()->SetPoseCache(nullptr);
+    }
+}
+
+void AnimationSystem::OnMainThreadUpdate(Scene* scene) {
+    if (!scene) return;
+
+    // イベントのリスナー（スクリプトや効果音）はシーンを触るため、他のシステムのジョブが終わった後に通知する
+    // OnUpdateの後に破棄されたAnimatorを触らないよう、一覧は取り直す
+    scene->Query<AnimatorComponent>().ForEach([](GameObject& go, AnimatorComponent& animator) {
+        if (go.IsActive() && animator.IsEnabled()) {
+            animator.GetAnimator()->DispatchEvents();
+        }
+    });
+}
 
-    for (const auto& go : gameObjects) {
-        if (!go || !go->IsActive()) continue;
+void AnimationSystem::ApplyRootMotion() {
+    for (AnimatorComponent* animatorComponent : animators_) {
+        Animator* animator = animatorComponent->GetAnimator();
+        if (!animator->IsRootMotionEnabled()) {
+            continue;
+        }
 
-        auto* animator = go->GetComponent<AnimatorComponent>();
-        if (animator && animator->IsEnabled()) {
-            animator->UpdateAnimation(deltaTime);
+        const Vector3 motion = animator->ConsumeRootMotion();
+        if (motion.LengthSq() <= 0.0f) {
+            continue;
         }
+
+        // スケルトン空間の移動量を、描画時と同じ補正・スケール・回転で親の空間へ移す
+        GameObject* go = animatorComponent->GetGameObject();
+        SkinnedModelInfo model;
+        GetSkinnedModelInfo(*go, model);
+        Transform& transform = go->GetTransform();
+        const Matrix4x4 toParent = model.modelCorrection *
+                                   Matrix4x4::Scale(transform.GetLocalScale()) *
+                                   transform.GetLocalRotation().ToMatrix();
+        transform.SetLocalPosition(transform.GetLocalPosition() + toParent.TransformDirection(motion));
     }
 }
 
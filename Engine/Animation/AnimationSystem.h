@@ -1,24 +1,78 @@
 #pragma once
 
 #include "../Systems/ISystem.h"
+#include "../Core/Types.h"
+#include "AnimationClock.h"
+#include "AnimationLod.h"
+#include "AnimationPoseCache.h"
+#include <algorithm>
+#include <vector>
 
 namespace UnoEngine {
 
+class AnimatorComponent;
+class GameObject;
+
 class AnimationSystem : public ISystem {
 public:
     AnimationSystem() = default;
     ~AnimationSystem() override = default;
 
     void OnUpdate(Scene* scene, float deltaTime) override;
+    // Dispatches animation events gathered in OnUpdate to script and audio listeners
+    void OnMainThreadUpdate(Scene* scene) override;
 
     // Animation system should run early to update bone matrices before rendering
     int GetPriority() const override { return 10; }
 
+    // Advances AnimatorComponent state; reads renderer bounds for animation LOD and
+    // moves transforms by root motion. Event listeners are called from OnMainThreadUpdate,
+    // so OnUpdate can run as a job alongside other systems
+    void DeclareAccess(SystemAccess& access) const override;
+
     // Play/Pause control
     void SetPlaying(bool playing) { isPlaying_ = playing; }
     bool IsPlaying() const { return isPlaying_; }
 
+    // アクティブカメラから見た画面上の大きさで更新頻度と計算するボーンを落とす
+    void SetLodSettings(const AnimationLodSettings& settings) { lodSettings_ = settings; }
+    const AnimationLodSettings& GetLodSettings() const { return lodSettings_; }
+
+    // 同じクリップを同じ時刻で再生しているAnimator同士でボーン行列を共有する
+    void SetPoseCacheEnabled(bool enabled) { poseCacheEnabled_ = enabled; }
+    bool IsPoseCacheEnabled() const { return poseCacheEnabled_; }
+    AnimationPoseCache& GetPoseCache() { return poseCache_; }
+
+    // アニメーションの時間を固定の時間幅（秒）で進める。0ならフレームの経過時間でそのまま進める
+    // 固定ステップでは再生位置・遷移・ルートモーションがフレームレートによらず同じになり、
+    // 描画するポーズは直前のステップとの間を補間する
+    void SetFixedTimeStep(float timeStep) { clock_.SetTimeStep(timeStep); }
+    float GetFixedTimeStep() const { return clock_.GetTimeStep(); }
+
 private:
+    // キャラクター同士は独立しているため、この数以上ならAnimator単位のジョブに分けて並列に更新する
+    static constexpr uint32 PARALLEL_UPDATE_THRESHOLD = 4;
+
+    // LOD判定とルートモーションに使うスキンメッシュの情報
+    struct SkinnedModelInfo {
+        Matrix4x4 modelCorrection = Matrix4x4::Identity();  // スケルトン空間からTransformのローカル空間の手前までの補正（描画時と同じ起き上がり回転）
+        bool hasBounds = false;
+        BoundingSphere bounds;                              // モデル空間のバウンディング球
+    };
+    // スキンメッシュのレンダラーの情報を取得する。レンダラーが無ければfalse（補正なし・既定の半径を使う）
+    // レンダラーの型に依存するため AnimationSystemRenderer.cpp に分けてある（AnimationSystem.cpp はグラフィックスAPI無しでビルドできる）
+    static bool GetSkinnedModelInfo(const GameObject& gameObject, SkinnedModelInfo& outInfo);
+    // GetSkinnedModelInfoが読むレンダラーの型を宣言する
+    static void DeclareRendererAccess(SystemAccess& access);
+
+    void ApplyRootMotion();
+
+    std::vector<AnimatorComponent*> animators_;  // 更新対象の一覧（毎フレーム詰め直す）
+    AnimationLodSettings lodSettings_;
+    AnimationPoseCache poseCache_;
+    bool poseCacheEnabled_ = true;
+    AnimationClock clock_;
+
 #ifdef _DEBUG
     bool isPlaying_ = true;  // Debug: 初期再生（0.1秒後にオフ）
     float elapsedTime_ = 0.0f;
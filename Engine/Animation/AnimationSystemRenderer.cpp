@@ -0,0 +1,25 @@
+#include "AnimationSystem.h"
+#include "../Core/GameObject.h"
+#include "../Rendering/SkinnedMeshRenderer.h"
+
+namespace UnoEngine {
+
+bool AnimationSystem::GetSkinnedModelInfo(const GameObject& gameObject, SkinnedModelInfo& outInfo) {
+    const SkinnedMeshRenderer* renderer = gameObject.GetComponent<const SkinnedMeshRenderer>();
+    if (!renderer) {
+        return false;
+    }
+
+    outInfo.modelCorrection = SkinnedMeshRenderer::GetModelCorrection();
+    outInfo.hasBounds = renderer->HasModel();
+    if (outInfo.hasBounds) {
+        outInfo.bounds = renderer->GetBoundingSphere();
+    }
+    return true;
+}
+
+void AnimationSystem::DeclareRendererAccess(SystemAccess& access) {
+    access.Read<SkinnedMeshRenderer>();
+}
+
+} // namespace UnoEngine
@@ -1,12 +1,30 @@
 #include "Animator.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <utility>
 
 namespace UnoEngine {
 
 void Animator::OnUpdate(float deltaTime) {
+    Step(deltaTime);
+    Evaluate(1.0f);
+    DispatchEvents();
+}
+
+void Animator::Step(float deltaTime) {
     if (!isPlaying_ || !skeleton_) {
         return;
     }
 
+    for (AnimationLayer& layer : layers_) {
+        if (layer.state) {
+            UpdateState(layer.state, deltaTime, layer.weight);
+        }
+    }
+
+    previousTransitionTime_ = transitionTime_;
     if (isTransitioning_ && nextState_) {
         transitionTime_ += deltaTime;
         float blendFactor = transitionTime_ / transitionDuration_;
@@ -16,32 +34,91 @@ void Animator::OnUpdate(float deltaTime) {
             nextState_ = nullptr;
             isTransitioning_ = false;
             transitionTime_ = 0.0f;
+            previousTransitionTime_ = 0.0f;
         } else {
             if (currentState_) {
-                currentState_->Update(deltaTime);
+                UpdateState(currentState_, deltaTime, 1.0f - blendFactor);
+            }
+            UpdateState(nextState_, deltaTime, blendFactor);
+
+            if (rootMotionEnabled_) {
+                const Vector3 current = currentState_ ? ComputeRootMotion(currentState_) : Vector3::Zero();
+                AccumulateRootMotion(current + (ComputeRootMotion(nextState_) - current) * blendFactor);
             }
-            nextState_->Update(deltaTime);
-            BlendAnimations(blendFactor);
             return;
         }
     }
 
     if (currentState_) {
-        currentState_->Update(deltaTime);
+        UpdateState(currentState_, deltaTime);
+        if (rootMotionEnabled_) {
+            AccumulateRootMotion(ComputeRootMotion(currentState_));
+        }
         CheckTransitions();
     }
+}
+
+void Animator::Evaluate(float interpolation) {
+    if (!isPlaying_ || !skeleton_) {
+        return;
+    }
+
+    interpolation_ = std::clamp(interpolation, 0.0f, 1.0f);
+    if (!BeginLodFrame()) {
+        return;
+    }
+
+    // 補間する場合は、評価の間だけ各ステートの再生位置を直前のStepとの間の値に置き換える
+    const bool interpolate = interpolation_ < 1.0f;
+    if (interpolate) {
+        BeginInterpolation(interpolation_);
+    }
+
+    if (isTransitioning_ && nextState_) {
+        const float transitionTime = previousTransitionTime_ + (transitionTime_ - previousTransitionTime_) * interpolation_;
+        BlendAnimations(transitionDuration_ > 0.0f ? (std::min)(transitionTime / transitionDuration_, 1.0f) : 1.0f);
+    } else {
+        UpdateBoneMatrices();
+    }
 
-    UpdateBoneMatrices();
+    if (interpolate) {
+        EndInterpolation();
+    }
 }
 
 void Animator::SetSkeleton(std::shared_ptr<Skeleton> skeleton) {
     skeleton_ = skeleton;
+    sharedPalette_.reset();
+    for (auto& [name, state] : states_) {
+        state->ClearBinding();
+    }
+
     if (skeleton_) {
         uint32 boneCount = skeleton_->GetBoneCount();
         finalBoneMatrices_.resize(boneCount);
         finalBoneMatrixPairs_.resize(boneCount);
         currentLocalTransforms_.resize(boneCount);
-        nextLocalTransforms_.resize(boneCount);
+        currentPose_.Resize(boneCount);
+        nextPose_.Resize(boneCount);
+        blendedPose_.Resize(boneCount);
+        lodHistoryValid_ = false;
+
+        // ルートモーションはスケルトンの最初のルートボーンから取り出す
+        rootBoneIndex_ = 0;
+        for (uint32 i = 0; i < boneCount; ++i) {
+            if (skeleton_->GetBones()[i].parentIndex == INVALID_BONE_INDEX) {
+                rootBoneIndex_ = i;
+                break;
+            }
+        }
+
+        // 加算レイヤーの基準とマスクは新しいスケルトンで作り直す
+        for (AnimationLayer& layer : layers_) {
+            layer.referencePose.Resize(0);
+            if (layer.mask.GetBoneCount() != boneCount) {
+                layer.mask = BoneMask();
+            }
+        }
 
         // バインドポーズを初期状態として設定（アニメーション前のレンダリングで倒れないように）
         skeleton_->ComputeBindPoseMatrices(finalBoneMatrices_);
@@ -50,11 +127,10 @@ void Animator::SetSkeleton(std::shared_ptr<Skeleton> skeleton) {
         const auto& bones = skeleton_->GetBones();
         for (uint32 i = 0; i < boneCount; ++i) {
             currentLocalTransforms_[i] = bones[i].localBindPose;
-            nextLocalTransforms_[i] = bones[i].localBindPose;
         }
 
         // BoneMatrixPairsもバインドポーズで初期化（アニメーション再生前の描画で爆発しないように）
-        skeleton_->ComputeBoneMatricesWithInverseTranspose(currentLocalTransforms_, finalBoneMatrixPairs_);
+        skeleton_->ComputeSkinningMatrices(currentLocalTransforms_, globalTransforms_, finalBoneMatrixPairs_);
     }
 }
 
@@ -82,6 +158,17 @@ AnimationState* Animator::AddState(const std::string& stateName, const std::stri
     return ptr;
 }
 
+AnimationState* Animator::AddBlendTreeState(const std::string& stateName, UniquePtr<BlendTree> blendTree) {
+    if (!blendTree) {
+        return nullptr;
+    }
+
+    auto state = std::make_unique<AnimationState>(stateName, std::move(blendTree));
+    AnimationState* ptr = state.get();
+    states_[stateName] = std::move(state);
+    return ptr;
+}
+
 AnimationState* Animator::GetState(const std::string& stateName) {
     auto it = states_.find(stateName);
     if (it != states_.end()) {
@@ -105,6 +192,8 @@ void Animator::Play(const std::string& stateName, float transitionDuration) {
         isTransitioning_ = false;
 
         // 初期フレームを即座に適用（最初のレンダリング前に正しいポーズにする）
+        // 前のステートのポーズから補間しないよう、LODの履歴も捨てる
+        lodHistoryValid_ = false;
         UpdateBoneMatrices();
     }
 }
@@ -119,6 +208,7 @@ void Animator::CrossFade(const std::string& stateName, float duration) {
     nextState_ = state;
     transitionDuration_ = duration;
     transitionTime_ = 0.0f;
+    previousTransitionTime_ = 0.0f;
     isTransitioning_ = true;
     isPlaying_ = true;
 }
@@ -144,6 +234,158 @@ float Animator::GetNormalizedTime() const {
     return 0.0f;
 }
 
+uint32 Animator::AddLayer(const std::string& name, AnimationLayerBlendMode blendMode, float weight) {
+    AnimationLayer layer;
+    layer.name = name;
+    layer.blendMode = blendMode;
+    layer.weight = weight;
+    layers_.push_back(std::move(layer));
+    return static_cast<uint32>(layers_.size() - 1);
+}
+
+void Animator::SetLayerWeight(uint32 layer, float weight) {
+    if (layer < layers_.size()) {
+        layers_[layer].weight = weight;
+    }
+}
+
+void Animator::SetLayerMask(uint32 layer, const BoneMask& mask) {
+    if (layer < layers_.size()) {
+        layers_[layer].mask = mask;
+    }
+}
+
+void Animator::PlayOnLayer(uint32 layer, const std::string& stateName) {
+    AnimationState* state = GetState(stateName);
+    if (layer >= layers_.size() || !state) {
+        return;
+    }
+
+    state->Reset();
+    layers_[layer].state = state;
+    layers_[layer].referencePose.Resize(0);
+}
+
+void Animator::StopLayer(uint32 layer) {
+    if (layer < layers_.size()) {
+        layers_[layer].state = nullptr;
+    }
+}
+
+void Animator::SetLod(const AnimationLodLevel& level) {
+    // 間隔が変わると補間の進み方が合わなくなるため、次のフレームで計算し直す
+    if (level.updateInterval != lod_.updateInterval) {
+        lodHistoryValid_ = false;
+    }
+    lod_ = level;
+}
+
+void Animator::SetCulled(bool culled) {
+    // 見えない間のポーズは古くなっているため、再び見えた時はそこから補間しない
+    if (culled) {
+        lodHistoryValid_ = false;
+    }
+    isCulled_ = culled;
+}
+
+void Animator::SetRootMotionEnabled(bool enabled) {
+    rootMotionEnabled_ = enabled;
+    pendingRootMotion_ = Vector3::Zero();
+    lastStepRootMotion_ = Vector3::Zero();
+}
+
+void Animator::SetRootMotionUpAxis(const Vector3& upAxis) {
+    const float lengthSq = upAxis.LengthSq();
+    if (lengthSq > 0.0f) {
+        rootMotionUpAxis_ = upAxis * (1.0f / std::sqrt(lengthSq));
+    }
+}
+
+Vector3 Animator::ConsumeRootMotion() {
+    // 描画しているポーズは最後のStepの途中（interpolation_）なので、そこまでの移動だけを返し、残りは次回に回す
+    const Vector3 remaining = lastStepRootMotion_ * (1.0f - interpolation_);
+    const Vector3 motion = pendingRootMotion_ - remaining;
+    pendingRootMotion_ = remaining;
+    return motion;
+}
+
+uint32 Animator::AddEventListener(AnimationEventCallback callback) {
+    // Animatorが作り直されても古いIDが新しいリスナーを指さないよう、全Animatorで通し番号にする
+    static std::atomic<uint32> nextId{ 1 };
+    const uint32 id = nextId.fetch_add(1, std::memory_order_relaxed);
+    eventListeners_.push_back({ id, std::move(callback) });
+    return id;
+}
+
+void Animator::RemoveEventListener(uint32 listenerId) {
+    auto it = std::find_if(eventListeners_.begin(), eventListeners_.end(),
+        [listenerId](const EventListener& listener) { return listener.id == listenerId; });
+    if (it == eventListeners_.end()) {
+        return;
+    }
+
+    if (isDispatchingEvents_) {
+        it->callback = nullptr;
+    } else {
+        eventListeners_.erase(it);
+    }
+    if (eventListeners_.empty()) {
+        pendingEvents_.clear();
+    }
+}
+
+bool Animator::HasEventListener(uint32 listenerId) const {
+    return std::any_of(eventListeners_.begin(), eventListeners_.end(),
+        [listenerId](const EventListener& listener) { return listener.id == listenerId && listener.callback; });
+}
+
+void Animator::DispatchEvents() {
+    if (pendingEvents_.empty() || isDispatchingEvents_) {
+        return;
+    }
+
+    // リスナーの中でPlayなどを呼んで新しいイベントが積まれても、今回の通知には混ぜない
+    dispatchingEvents_.swap(pendingEvents_);
+    isDispatchingEvents_ = true;
+    for (const FiredAnimationEvent& event : dispatchingEvents_) {
+        for (size_t i = 0; i < eventListeners_.size(); ++i) {
+            if (eventListeners_[i].callback) {
+                eventListeners_[i].callback(event);
+            }
+        }
+    }
+    isDispatchingEvents_ = false;
+    dispatchingEvents_.clear();
+
+    eventListeners_.erase(std::remove_if(eventListeners_.begin(), eventListeners_.end(),
+        [](const EventListener& listener) { return !listener.callback; }), eventListeners_.end());
+}
+
+float Animator::GetCurveValue(const std::string& name, float defaultValue) const {
+    auto evaluate = [&](const AnimationState* state) {
+        float value = defaultValue;
+        if (state) {
+            state->EvaluateCurve(name, value);
+        }
+        return value;
+    };
+
+    float value = evaluate(currentState_);
+    if (isTransitioning_ && nextState_) {
+        const float blendFactor = transitionDuration_ > 0.0f ? (std::min)(transitionTime_ / transitionDuration_, 1.0f) : 1.0f;
+        value += (evaluate(nextState_) - value) * blendFactor;
+    }
+
+    for (const AnimationLayer& layer : layers_) {
+        float layerValue = 0.0f;
+        if (layer.state && layer.blendMode == AnimationLayerBlendMode::Override &&
+            layer.state->EvaluateCurve(name, layerValue)) {
+            value += (layerValue - value) * layer.weight;
+        }
+    }
+    return value;
+}
+
 void Animator::SetParameter(const std::string& name, float value) {
     floatParams_[name] = value;
 }
@@ -172,19 +414,228 @@ bool Animator::GetBoolParameter(const std::string& name) const {
 }
 
 void Animator::UpdateBoneMatrices() {
-    if (!skeleton_ || !currentState_ || !currentState_->GetClip()) {
+    if (!skeleton_ || !currentState_ || !currentState_->HasMotion()) {
         return;
     }
 
-    float time = currentState_->GetCurrentTime();
-    currentState_->GetClip()->Sample(time, *skeleton_, currentLocalTransforms_);
-    
-    // 新しいメソッドを使用してInverseTranspose行列も計算
-    skeleton_->ComputeBoneMatricesWithInverseTranspose(currentLocalTransforms_, finalBoneMatrixPairs_);
-    
-    // 後方互換性のため、従来のmatrix配列も更新
-    skeleton_->ComputeBoneMatrices(currentLocalTransforms_, finalBoneMatrices_);
+    if (CanUsePoseCache()) {
+        AcquireSharedPalette();
+        return;
+    }
+
+    SampleState(currentState_, currentPose_, lod_.skipDetailBones);
+    RemoveRootMotion(currentPose_);
+    ApplyLayers(currentPose_);
+    PresentPose(currentPose_);
+}
+
+void Animator::UpdateState(AnimationState* state, float deltaTime, float eventWeight) {
+    // ブレンドツリーの長さは重みで変わるため、時間を進める前にパラメータを反映する
+    if (BlendTree* tree = state->GetBlendTree()) {
+        tree->SetParameters(GetFloatParameter(tree->GetParameterX()), GetFloatParameter(tree->GetParameterY()));
+    }
+    state->Update(deltaTime, eventListeners_.empty() ? nullptr : &pendingEvents_, eventWeight);
+}
+
+void Animator::SampleState(AnimationState* state, Pose& outPose, bool skipDetailBones) {
+    if (BlendTree* tree = state->GetBlendTree()) {
+        tree->SetParameters(GetFloatParameter(tree->GetParameterX()), GetFloatParameter(tree->GetParameterY()));
+    }
+    state->Sample(*skeleton_, posePool_, outPose, skipDetailBones);
+}
+
+void Animator::ApplyLayers(Pose& pose) {
+    const uint32 boneCount = skeleton_->GetBoneCount();
+
+    for (AnimationLayer& layer : layers_) {
+        if (!layer.state || !layer.state->HasMotion() || layer.weight <= 0.0f) {
+            continue;
+        }
+
+        const BoneMask* mask = layer.mask.IsEmpty() ? nullptr : &layer.mask;
+        Pose& layerPose = posePool_.Acquire(boneCount);
+
+        if (layer.blendMode == AnimationLayerBlendMode::Additive) {
+            if (layer.referencePose.GetBoneCount() != boneCount) {
+                const float normalizedTime = layer.state->GetNormalizedTime();
+                layer.state->SetNormalizedTime(0.0f);
+                // 基準はLODによらず全ボーンで作る（後で細部のボーンも計算するようになった時に差分がずれないように）
+                SampleState(layer.state, layer.referencePose, false);
+                layer.state->SetNormalizedTime(normalizedTime);
+            }
+
+            SampleState(layer.state, layerPose, lod_.skipDetailBones);
+            Pose::ApplyAdditive(pose, layerPose, layer.referencePose, layer.weight, pose, mask);
+        } else {
+            SampleState(layer.state, layerPose, lod_.skipDetailBones);
+            Pose::Blend(pose, layerPose, layer.weight, pose, mask);
+        }
+
+        posePool_.Release(layerPose);
+    }
+}
+
+void Animator::ApplyPose(const Pose& pose) {
+    sharedPalette_.reset();
+    pose.ToLocalMatrices(currentLocalTransforms_);
 
+    // BoneMatrixPair（法線用の行列つき）と、後方互換性のための従来のmatrix配列を1回の走査で更新
+    skeleton_->ComputeSkinningMatrices(currentLocalTransforms_, globalTransforms_, finalBoneMatrixPairs_, &finalBoneMatrices_);
+}
+
+bool Animator::BeginLodFrame() {
+    if (isCulled_) {
+        return false;
+    }
+
+    const uint32 interval = (std::max)(lod_.updateInterval, 1u);
+    if (interval == 1 || !lodHistoryValid_) {
+        return true;
+    }
+
+    ++lodFramesSinceEvaluation_;
+    if (lodFramesSinceEvaluation_ >= interval) {
+        return true;
+    }
+
+    if (lod_.interpolate) {
+        // 前回と前々回の計算結果の間を進める（計算したフレームで1/interval、その次で2/interval...）
+        const float t = static_cast<float>(lodFramesSinceEvaluation_ + 1) / static_cast<float>(interval);
+        Pose::Blend(lodPreviousPose_, lodTargetPose_, t, lodDisplayPose_);
+        ApplyPose(lodDisplayPose_);
+    }
+    return false;
+}
+
+void Animator::PresentPose(const Pose& pose) {
+    const uint32 interval = (std::max)(lod_.updateInterval, 1u);
+    if (interval == 1) {
+        lodHistoryValid_ = false;
+        ApplyPose(pose);
+        return;
+    }
+
+    if (!lodHistoryValid_) {
+        // 履歴が無い最初の計算はそのまま表示する
+        // 同じフレームに出現した多数のキャラクターの計算が同じフレームに集中しないよう、アドレスから次の計算までの間隔をずらす
+        lodPreviousPose_ = pose;
+        lodTargetPose_ = pose;
+        lodHistoryValid_ = true;
+        lodFramesSinceEvaluation_ = static_cast<uint32>(reinterpret_cast<std::uintptr_t>(this) / alignof(Animator)) % interval;
+        ApplyPose(pose);
+        return;
+    }
+
+    std::swap(lodPreviousPose_, lodTargetPose_);
+    lodTargetPose_ = pose;
+    lodFramesSinceEvaluation_ = 0;
+
+    if (lod_.interpolate) {
+        Pose::Blend(lodPreviousPose_, lodTargetPose_, 1.0f / static_cast<float>(interval), lodDisplayPose_);
+        ApplyPose(lodDisplayPose_);
+    } else {
+        ApplyPose(pose);
+    }
+}
+
+bool Animator::CanUsePoseCache() const {
+    // ルートモーションはポーズからルートの移動を取り除くため、キャッシュのポーズとは別になる
+    if (!poseCache_ || !currentState_->GetClip() || rootMotionEnabled_) {
+        return false;
+    }
+
+    // 補間するLODは前回のポーズとの合成が個別に必要になる
+    if (lod_.updateInterval > 1 && lod_.interpolate) {
+        return false;
+    }
+
+    for (const AnimationLayer& layer : layers_) {
+        if (layer.state && layer.state->HasMotion() && layer.weight > 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Animator::AcquireSharedPalette() {
+    AnimationState* state = currentState_;
+    float sampleTime = 0.0f;
+    const AnimationPoseCache::Key key = poseCache_->MakeKey(*skeleton_, *state->GetClip(), state->GetCurrentTime(),
+                                                            lod_.skipDetailBones, sampleTime);
+
+    // 先に手放しておくと、前のフレームのパレットをこのフレームでそのまま再利用できる
+    sharedPalette_.reset();
+    sharedPalette_ = poseCache_->Acquire(key, [&](AnimationPoseCache::Palette& palette) {
+        state->SampleAt(sampleTime, *skeleton_, currentPose_, lod_.skipDetailBones);
+        currentPose_.ToLocalMatrices(palette.localTransforms);
+        skeleton_->ComputeSkinningMatrices(palette.localTransforms, globalTransforms_,
+                                           palette.boneMatrixPairs, &palette.boneMatrices);
+    });
+
+    // キャッシュを使わなくなった時は補間の履歴が無い状態から始める
+    lodHistoryValid_ = false;
+}
+
+void Animator::BeginInterpolation(float alpha) {
+    interpolatedStates_.clear();
+    auto interpolateState = [&](AnimationState* state) {
+        if (state) {
+            interpolatedStates_.push_back({ state, state->GetNormalizedTime() });
+            state->SetNormalizedTime(state->GetInterpolatedNormalizedTime(alpha));
+        }
+    };
+
+    interpolateState(currentState_);
+    if (isTransitioning_) {
+        interpolateState(nextState_);
+    }
+    for (AnimationLayer& layer : layers_) {
+        interpolateState(layer.state);
+    }
+}
+
+void Animator::EndInterpolation() {
+    for (auto it = interpolatedStates_.rbegin(); it != interpolatedStates_.rend(); ++it) {
+        it->state->SetNormalizedTime(it->normalizedTime);
+    }
+    interpolatedStates_.clear();
+}
+
+Vector3 Animator::ComputeRootMotion(AnimationState* state) {
+    if (!state->HasMotion()) {
+        return Vector3::Zero();
+    }
+
+    const float previousTime = state->GetPreviousNormalizedTime();
+    const float currentTime = state->GetNormalizedTime();
+    Vector3 motion = state->SampleBoneTranslation(*skeleton_, rootBoneIndex_, currentTime) -
+                     state->SampleBoneTranslation(*skeleton_, rootBoneIndex_, previousTime);
+
+    // ループの終端をまたいだ場合は1周分の移動を足す（逆再生なら引く）
+    if (state->HasLoopedLastUpdate()) {
+        const Vector3 cycle = state->SampleBoneTranslation(*skeleton_, rootBoneIndex_, 1.0f) -
+                              state->SampleBoneTranslation(*skeleton_, rootBoneIndex_, 0.0f);
+        motion += currentTime < previousTime ? cycle : cycle * -1.0f;
+    }
+    return motion;
+}
+
+void Animator::AccumulateRootMotion(const Vector3& motion) {
+    // 上下動はポーズに残すため、水平方向の移動だけを取り出す
+    lastStepRootMotion_ = motion - rootMotionUpAxis_ * motion.Dot(rootMotionUpAxis_);
+    pendingRootMotion_ += lastStepRootMotion_;
+}
+
+void Animator::RemoveRootMotion(Pose& pose) const {
+    if (!rootMotionEnabled_) {
+        return;
+    }
+
+    // ルートボーンの水平位置をバインドポーズに固定する（移動はConsumeRootMotionでTransformへ移す）
+    const Vector3 bindTranslation = skeleton_->GetBindPose().GetTranslation(rootBoneIndex_);
+    const Vector3 offset = pose.GetTranslation(rootBoneIndex_) - bindTranslation;
+    pose.SetBone(rootBoneIndex_, bindTranslation + rootMotionUpAxis_ * offset.Dot(rootMotionUpAxis_),
+                 pose.GetRotation(rootBoneIndex_), pose.GetScale(rootBoneIndex_));
 }
 
 void Animator::CheckTransitions() {
@@ -206,24 +657,17 @@ void Animator::BlendAnimations(float blendFactor) {
         return;
     }
 
-    AnimationClip* currentClip = currentState_->GetClip();
-    AnimationClip* nextClip = nextState_->GetClip();
-
-    if (!currentClip || !nextClip) {
+    if (!currentState_->HasMotion() || !nextState_->HasMotion()) {
         return;
     }
 
-    currentClip->Sample(currentState_->GetCurrentTime(), *skeleton_, currentLocalTransforms_);
-    nextClip->Sample(nextState_->GetCurrentTime(), *skeleton_, nextLocalTransforms_);
-
-    uint32 boneCount = skeleton_->GetBoneCount();
-    std::vector<Matrix4x4> blendedTransforms(boneCount);
-
-    for (uint32 i = 0; i < boneCount; ++i) {
-        blendedTransforms[i] = Matrix4x4::Lerp(currentLocalTransforms_[i], nextLocalTransforms_[i], blendFactor);
-    }
-
-    skeleton_->ComputeBoneMatrices(blendedTransforms, finalBoneMatrices_);
+    // 行列同士の線形補間は回転が潰れる（シアーが出る）ため、平行移動・回転・スケールのまま補間して最後に行列にする
+    SampleState(currentState_, currentPose_, lod_.skipDetailBones);
+    SampleState(nextState_, nextPose_, lod_.skipDetailBones);
+    Pose::Blend(currentPose_, nextPose_, blendFactor, blendedPose_);
+    RemoveRootMotion(blendedPose_);
+    ApplyLayers(blendedPose_);
+    PresentPose(blendedPose_);
 }
 
 } // namespace UnoEngine
@@ -6,20 +6,48 @@
 #include "AnimationState.h"
 #include "Skeleton.h"
 #include "AnimationClip.h"
+#include "AnimationLod.h"
+#include "AnimationPoseCache.h"
+#include "Pose.h"
 #include <vector>
 #include <string>
 #include <memory>
+#include <functional>
 #include <unordered_map>
 
 namespace UnoEngine {
 
+enum class AnimationLayerBlendMode {
+    Override,   // 下のレイヤーの結果を重みの分だけ置き換える
+    Additive    // ステートの先頭フレームからの差分を下のレイヤーの結果に加える
+};
+
+// 基本レイヤー（current/nextのステート）の上に重ねるレイヤー
+struct AnimationLayer {
+    std::string name;
+    AnimationLayerBlendMode blendMode = AnimationLayerBlendMode::Override;
+    float weight = 1.0f;
+    BoneMask mask;                      // 空なら全ボーン
+    AnimationState* state = nullptr;
+    Pose referencePose;                 // 加算の基準（ステートの先頭フレーム。最初の合成時に作る）
+};
+
+using AnimationEventCallback = std::function<void(const FiredAnimationEvent&)>;
+
 class Animator : public Component {
 public:
     Animator() = default;
     ~Animator() override = default;
 
+    // Step(deltaTime)とEvaluate(1)をまとめて行う（可変フレーム時間での再生）
     void OnUpdate(float deltaTime) override;
 
+    // 固定ステップ再生
+    // Stepは再生位置・遷移・ルートモーションだけを進め、ポーズは計算しない。同じ時間幅で呼べば結果はフレームレートによらない
+    // Evaluateは直前のStepの前（0）から後（1）までをinterpolationで補間した再生位置のポーズを計算する
+    void Step(float deltaTime);
+    void Evaluate(float interpolation = 1.0f);
+
     void SetSkeleton(std::shared_ptr<Skeleton> skeleton);
     Skeleton* GetSkeleton() const { return skeleton_.get(); }
 
@@ -27,6 +55,8 @@ public:
     AnimationClip* GetClip(const std::string& name) const;
 
     AnimationState* AddState(const std::string& stateName, const std::string& clipName);
+    // ツリーの入力にはSetParameter(float)で設定した値を使う
+    AnimationState* AddBlendTreeState(const std::string& stateName, UniquePtr<BlendTree> blendTree);
     AnimationState* GetState(const std::string& stateName);
     AnimationState* GetCurrentState() const { return currentState_; }
 
@@ -38,11 +68,65 @@ public:
     float GetCurrentTime() const;
     float GetNormalizedTime() const;
 
-    const std::vector<Matrix4x4>& GetBoneMatrices() const { return finalBoneMatrices_; }
-    const std::vector<BoneMatrixPair>& GetBoneMatrixPairs() const { return finalBoneMatrixPairs_; }
-    const std::vector<Matrix4x4>& GetCurrentLocalTransforms() const { return currentLocalTransforms_; }
+    // ポーズキャッシュのパレットを共有している間はその内容を返す
+    const std::vector<Matrix4x4>& GetBoneMatrices() const {
+        return sharedPalette_ ? sharedPalette_->boneMatrices : finalBoneMatrices_;
+    }
+    const std::vector<BoneMatrixPair>& GetBoneMatrixPairs() const {
+        return sharedPalette_ ? sharedPalette_->boneMatrixPairs : finalBoneMatrixPairs_;
+    }
+    const std::vector<Matrix4x4>& GetCurrentLocalTransforms() const {
+        return sharedPalette_ ? sharedPalette_->localTransforms : currentLocalTransforms_;
+    }
     uint32 GetBoneCount() const { return skeleton_ ? skeleton_->GetBoneCount() : 0; }
 
+    // レイヤーは追加した順に基本レイヤーの上へ重ねる。戻り値はレイヤー番号
+    // 同じステートを基本レイヤーと別のレイヤーで同時に再生してはならない（時間が二重に進むため）
+    uint32 AddLayer(const std::string& name, AnimationLayerBlendMode blendMode = AnimationLayerBlendMode::Override,
+                    float weight = 1.0f);
+    uint32 GetLayerCount() const { return static_cast<uint32>(layers_.size()); }
+    const AnimationLayer& GetLayer(uint32 layer) const { return layers_[layer]; }
+    void SetLayerWeight(uint32 layer, float weight);
+    void SetLayerMask(uint32 layer, const BoneMask& mask);
+    void PlayOnLayer(uint32 layer, const std::string& stateName);
+    void StopLayer(uint32 layer);
+
+    // アニメーションLOD（AnimationSystemがカメラからの見え方に応じて毎フレーム設定する）
+    // 更新間隔が2以上の場合、ポーズの計算はその間隔ごとに行い、間のフレームは直前2回の結果を補間する
+    // （補間する場合、表示は最大で間隔-1フレーム遅れる）。再生時間と遷移は毎フレーム進める
+    void SetLod(const AnimationLodLevel& level);
+    const AnimationLodLevel& GetLod() const { return lod_; }
+    // 視錐台の外にある間はポーズを計算せず、ボーン行列は最後の結果のままにする
+    void SetCulled(bool culled);
+    bool IsCulled() const { return isCulled_; }
+
+    // 同じスケルトン・クリップ・時刻のAnimator同士でボーン行列を共有する（AnimationSystemが毎フレーム設定する）
+    // 共有するのはクリップのステートを1つだけ再生している間（遷移・レイヤー・ブレンドツリー・LODの補間が無い時）
+    void SetPoseCache(AnimationPoseCache* cache) { poseCache_ = cache; }
+    bool IsUsingSharedPose() const { return sharedPalette_ != nullptr; }
+
+    // ルートモーション: ルートボーンの水平方向の移動をポーズから取り除き、Stepごとの移動量として取り出す
+    // upAxisはスケルトン空間の上方向（この方向の移動は上下動としてポーズに残す）
+    void SetRootMotionEnabled(bool enabled);
+    bool IsRootMotionEnabled() const { return rootMotionEnabled_; }
+    void SetRootMotionUpAxis(const Vector3& upAxis);
+    const Vector3& GetRootMotionUpAxis() const { return rootMotionUpAxis_; }
+    // 前回の呼び出しから、現在描画しているポーズまでの移動量（スケルトン空間）を返す
+    Vector3 ConsumeRootMotion();
+
+    // イベント: Stepで通過したイベント（クリップのAddEvent）をためておき、DispatchEventsでリスナーへ通知する
+    // AnimationSystemは並列の更新が終わった後にメインスレッドで通知する。リスナーが無い間はイベントを集めない
+    // リスナーのIDはすべてのAnimatorを通して重複しない（別のAnimatorのIDを渡しても何も起きない）
+    uint32 AddEventListener(AnimationEventCallback callback);
+    void RemoveEventListener(uint32 listenerId);
+    bool HasEventListener(uint32 listenerId) const;
+    void DispatchEvents();
+
+    // 曲線（クリップのAddCurve）の現在の値
+    // 遷移中は2つのステートをブレンド率で補間し、上書きレイヤーの曲線は重みの分だけ重ねる
+    // 曲線を持たないステートはdefaultValueとして扱う
+    float GetCurveValue(const std::string& name, float defaultValue = 0.0f) const;
+
     void SetParameter(const std::string& name, float value);
     void SetParameter(const std::string& name, int32 value);
     void SetParameter(const std::string& name, bool value);
@@ -55,6 +139,21 @@ private:
     void UpdateBoneMatrices();
     void CheckTransitions();
     void BlendAnimations(float blendFactor);
+    void UpdateState(AnimationState* state, float deltaTime, float eventWeight = 1.0f);
+    void SampleState(AnimationState* state, Pose& outPose, bool skipDetailBones);
+    void ApplyLayers(Pose& pose);
+    void ApplyPose(const Pose& pose);
+    // LODに従って、このフレームでポーズを計算するかを返す（計算しない場合は補間した結果を適用する）
+    bool BeginLodFrame();
+    // 計算したポーズをLODの補間の履歴に入れてから適用する
+    void PresentPose(const Pose& pose);
+    bool CanUsePoseCache() const;
+    void AcquireSharedPalette();
+    void BeginInterpolation(float alpha);
+    void EndInterpolation();
+    Vector3 ComputeRootMotion(AnimationState* state);
+    void AccumulateRootMotion(const Vector3& motion);
+    void RemoveRootMotion(Pose& pose) const;
 
     std::shared_ptr<Skeleton> skeleton_;
     std::unordered_map<std::string, std::shared_ptr<AnimationClip>> clips_;
@@ -65,13 +164,56 @@ private:
 
     float transitionDuration_ = 0.0f;
     float transitionTime_ = 0.0f;
+    float previousTransitionTime_ = 0.0f;   // 直前のStepの前のtransitionTime_
+    float interpolation_ = 1.0f;            // 直前のEvaluateの補間率
     bool isTransitioning_ = false;
     bool isPlaying_ = false;
 
     std::vector<Matrix4x4> finalBoneMatrices_;
     std::vector<BoneMatrixPair> finalBoneMatrixPairs_;
     std::vector<Matrix4x4> currentLocalTransforms_;
-    std::vector<Matrix4x4> nextLocalTransforms_;
+    std::vector<Matrix4x4> globalTransforms_;   // ボーン行列計算の作業領域
+
+    // サンプリング・ブレンド用の作業領域（毎フレーム確保し直さないよう保持しておく）
+    Pose currentPose_;
+    Pose nextPose_;
+    Pose blendedPose_;
+    PosePool posePool_;
+
+    std::vector<AnimationLayer> layers_;
+
+    AnimationLodLevel lod_;
+    bool isCulled_ = false;
+    uint32 lodFramesSinceEvaluation_ = 0;
+    bool lodHistoryValid_ = false;      // lodPreviousPose_/lodTargetPose_が有効か
+    Pose lodPreviousPose_;              // 1つ前に計算したポーズ
+    Pose lodTargetPose_;                // 最後に計算したポーズ
+    Pose lodDisplayPose_;               // 補間結果
+
+    AnimationPoseCache* poseCache_ = nullptr;
+    AnimationPoseCache::PaletteHandle sharedPalette_;   // 有効な間はfinalBoneMatrixPairs_などの代わりに使う
+
+    // Evaluate中に再生位置を補間値に置き換えたステートと元の値
+    struct InterpolatedState {
+        AnimationState* state;
+        float normalizedTime;
+    };
+    std::vector<InterpolatedState> interpolatedStates_;
+
+    bool rootMotionEnabled_ = false;
+    uint32 rootBoneIndex_ = 0;
+    Vector3 rootMotionUpAxis_ = Vector3(0.0f, 1.0f, 0.0f);
+    Vector3 pendingRootMotion_ = Vector3::Zero();   // まだConsumeRootMotionで取り出していない移動量
+    Vector3 lastStepRootMotion_ = Vector3::Zero();
+
+    struct EventListener {
+        uint32 id;
+        AnimationEventCallback callback;    // 通知中に削除された場合は空にしておき、通知の後で取り除く
+    };
+    std::vector<EventListener> eventListeners_;
+    bool isDispatchingEvents_ = false;
+    std::vector<FiredAnimationEvent> pendingEvents_;
+    std::vector<FiredAnimationEvent> dispatchingEvents_;
 
     std::unordered_map<std::string, float> floatParams_;
     std::unordered_map<std::string, int32> intParams_;
@@ -68,4 +68,15 @@ void AnimatorComponent::UpdateAnimation(float deltaTime) {
     animator_.OnUpdate(deltaTime);
 }
 
+void AnimatorComponent::UpdateAnimation(float stepDelta, uint32 stepCount, float interpolation) {
+    if (!initialized_ || !IsEnabled()) {
+        return;
+    }
+
+    for (uint32 i = 0; i < stepCount; ++i) {
+        animator_.Step(stepDelta);
+    }
+    animator_.Evaluate(interpolation);
+}
+
 } // namespace UnoEngine
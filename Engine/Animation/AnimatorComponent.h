@@ -42,6 +42,9 @@ public:
 
     // Called by AnimationSystem
     void UpdateAnimation(float deltaTime);
+    // Fixed-step update: advances stepCount steps of stepDelta, then evaluates the pose
+    // interpolation (0-1) of the way through the last step
+    void UpdateAnimation(float stepDelta, uint32 stepCount, float interpolation);
 
 private:
     Animator animator_;
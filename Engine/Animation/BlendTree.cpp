@@ -0,0 +1,238 @@
+#include "BlendTree.h"
+#include "Pose.h"
+#include "Skeleton.h"
+#include <algorithm>
+
+namespace UnoEngine {
+
+namespace {
+
+float GetClipDurationInSeconds(const AnimationClip& clip) {
+    const float ticksPerSecond = clip.GetTicksPerSecond();
+    return ticksPerSecond > 0.0f ? clip.GetDuration() / ticksPerSecond : 0.0f;
+}
+
+} // anonymous namespace
+
+BlendTree::BlendTree(BlendTreeType type, const std::string& parameterX, const std::string& parameterY)
+    : type_(type)
+    , parameterX_(parameterX)
+    , parameterY_(parameterY) {
+}
+
+void BlendTree::AddMotion(std::shared_ptr<AnimationClip> clip, float threshold) {
+    Motion motion;
+    motion.clip = std::move(clip);
+    motion.position = Vector2(threshold, 0.0f);
+
+    auto it = std::upper_bound(motions_.begin(), motions_.end(), threshold,
+        [](float value, const Motion& m) { return value < m.position.GetX(); });
+    motions_.insert(it, std::move(motion));
+}
+
+void BlendTree::AddMotion(std::shared_ptr<AnimationClip> clip, const Vector2& position) {
+    Motion motion;
+    motion.clip = std::move(clip);
+    motion.position = position;
+    motions_.push_back(std::move(motion));
+}
+
+void BlendTree::SetParameters(float x, float y) {
+    if (motions_.empty()) {
+        return;
+    }
+
+    for (Motion& motion : motions_) {
+        motion.weight = 0.0f;
+    }
+
+    if (type_ == BlendTreeType::Simple1D) {
+        ComputeWeights1D(x);
+    } else {
+        ComputeWeights2D(x, y);
+    }
+}
+
+void BlendTree::ComputeWeights1D(float x) {
+    // motions_はしきい値の昇順
+    if (x <= motions_.front().position.GetX()) {
+        motions_.front().weight = 1.0f;
+        return;
+    }
+    if (x >= motions_.back().position.GetX()) {
+        motions_.back().weight = 1.0f;
+        return;
+    }
+
+    for (size_t i = 0; i + 1 < motions_.size(); ++i) {
+        const float lower = motions_[i].position.GetX();
+        const float upper = motions_[i + 1].position.GetX();
+        if (x < upper) {
+            const float range = upper - lower;
+            const float t = range > 0.0f ? (x - lower) / range : 1.0f;
+            motions_[i].weight = 1.0f - t;
+            motions_[i + 1].weight = t;
+            return;
+        }
+    }
+}
+
+void BlendTree::ComputeWeights2D(float x, float y) {
+    // 勾配帯補間（gradient band interpolation）
+    // モーションiの重みは、他の各モーションjへ向かう方向でpがどこまで進んでいるかの最小値
+    // モーションの位置ちょうどではそのモーションだけが1になり、間では連続的に変化する
+    const Vector2 point(x, y);
+    float totalWeight = 0.0f;
+
+    for (size_t i = 0; i < motions_.size(); ++i) {
+        const Vector2& pi = motions_[i].position;
+        const Vector2 toPoint = point - pi;
+        float weight = 1.0f;
+
+        for (size_t j = 0; j < motions_.size() && weight > 0.0f; ++j) {
+            if (i == j) continue;
+            const Vector2 toOther = motions_[j].position - pi;
+            const float lengthSq = toOther.LengthSq();
+            if (lengthSq <= 0.0f) continue;
+
+            const float h = 1.0f - toPoint.Dot(toOther) / lengthSq;
+            weight = (std::min)(weight, (std::max)(h, 0.0f));
+        }
+
+        motions_[i].weight = weight;
+        totalWeight += weight;
+    }
+
+    if (totalWeight > 0.0f) {
+        for (Motion& motion : motions_) {
+            motion.weight /= totalWeight;
+        }
+        return;
+    }
+
+    // 位置が重複している場合などで重みが決まらなければ最も近いモーションを使う
+    size_t nearest = 0;
+    float nearestDistanceSq = (motions_[0].position - point).LengthSq();
+    for (size_t i = 1; i < motions_.size(); ++i) {
+        const float distanceSq = (motions_[i].position - point).LengthSq();
+        if (distanceSq < nearestDistanceSq) {
+            nearest = i;
+            nearestDistanceSq = distanceSq;
+        }
+    }
+    motions_[nearest].weight = 1.0f;
+}
+
+float BlendTree::GetDuration() const {
+    float duration = 0.0f;
+    for (const Motion& motion : motions_) {
+        if (motion.weight > 0.0f && motion.clip) {
+            duration += GetClipDurationInSeconds(*motion.clip) * motion.weight;
+        }
+    }
+
+    if (duration <= 0.0f && !motions_.empty() && motions_.front().clip) {
+        return GetClipDurationInSeconds(*motions_.front().clip);
+    }
+    return duration;
+}
+
+void BlendTree::Sample(float normalizedTime, const Skeleton& skeleton, PosePool& pool, Pose& outPose,
+                       bool skipDetailBones) {
+    const uint32 boneCount = skeleton.GetBoneCount();
+
+    uint32 activeCount = 0;
+    Motion* single = nullptr;
+    for (Motion& motion : motions_) {
+        if (motion.weight > 0.0f && motion.clip) {
+            ++activeCount;
+            single = &motion;
+        }
+    }
+
+    auto sampleMotion = [&](Motion& motion, Pose& out) {
+        BindMotion(motion, skeleton);
+        motion.clip->Sample(normalizedTime * motion.clip->GetDuration(), motion.binding, skeleton, motion.cursor, out,
+                             skipDetailBones);
+    };
+
+    if (activeCount == 0) {
+        outPose = skeleton.GetBindPose();
+        return;
+    }
+
+    // パラメータがモーションの位置ちょうどなら合成せずにそのまま書き出す
+    if (activeCount == 1) {
+        sampleMotion(*single, outPose);
+        return;
+    }
+
+    Pose& scratch = pool.Acquire(boneCount);
+    outPose.BeginAccumulate(boneCount);
+    for (Motion& motion : motions_) {
+        if (motion.weight > 0.0f && motion.clip) {
+            sampleMotion(motion, scratch);
+            outPose.Accumulate(scratch, motion.weight);
+        }
+    }
+    outPose.EndAccumulate();
+    pool.Release(scratch);
+}
+
+Vector3 BlendTree::SampleBoneTranslation(float normalizedTime, const Skeleton& skeleton, uint32 boneIndex) {
+    Vector3 translation = Vector3::Zero();
+    float totalWeight = 0.0f;
+    for (Motion& motion : motions_) {
+        if (motion.weight > 0.0f && motion.clip) {
+            BindMotion(motion, skeleton);
+            translation += motion.clip->SampleBoneTranslation(normalizedTime * motion.clip->GetDuration(), motion.binding,
+                                                              skeleton, boneIndex, motion.cursor) * motion.weight;
+            totalWeight += motion.weight;
+        }
+    }
+    return totalWeight > 0.0f ? translation : skeleton.GetBindPose().GetTranslation(boneIndex);
+}
+
+void BlendTree::BindMotion(Motion& motion, const Skeleton& skeleton) {
+    if (!motion.binding.IsBoundTo(motion.clip.get(), &skeleton)) {
+        motion.binding = AnimationBinding(*motion.clip, skeleton);
+        motion.cursor.clear();
+    }
+}
+
+const AnimationClip* BlendTree::GetDominantClip() const {
+    const Motion* dominant = nullptr;
+    for (const Motion& motion : motions_) {
+        if (motion.clip && motion.weight > 0.0f && (!dominant || motion.weight > dominant->weight)) {
+            dominant = &motion;
+        }
+    }
+    return dominant ? dominant->clip.get() : nullptr;
+}
+
+bool BlendTree::EvaluateCurve(const std::string& name, float normalizedTime, float& outValue) const {
+    bool found = false;
+    float value = 0.0f;
+    for (const Motion& motion : motions_) {
+        if (motion.weight <= 0.0f || !motion.clip) {
+            continue;
+        }
+        if (const AnimationCurve* curve = motion.clip->GetCurve(name)) {
+            value += curve->Evaluate(normalizedTime * motion.clip->GetDuration()) * motion.weight;
+            found = true;
+        }
+    }
+
+    if (found) {
+        outValue = value;
+    }
+    return found;
+}
+
+void BlendTree::ClearBindings() {
+    for (Motion& motion : motions_) {
+        motion.binding = AnimationBinding();
+    }
+}
+
+} // namespace UnoEngine
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../Core/Types.h"
+#include "../Math/Vector.h"
+#include "AnimationClip.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace UnoEngine {
+
+class Pose;
+class PosePool;
+class Skeleton;
+
+enum class BlendTreeType {
+    Simple1D,       // 1つのパラメータの値で隣り合う2つのモーションを補間（歩き→走りなど）
+    Freeform2D      // 2つのパラメータの平面上に置いたモーションを補間（移動方向と速さなど）
+};
+
+// パラメータの値に応じて複数のクリップを重み付きで合成するモーション
+//
+// 各モーションは正規化時間を共有して同期再生する（歩きと走りの足の運びをそろえるため）
+// サンプリングは重みが0でないモーションだけを行い、結果をPose::Accumulateで1回に合成する
+// バインディングとキー位置キャッシュをモーションごとに持つため、1つのツリーは1つのAnimationStateでのみ使う
+class BlendTree {
+public:
+    BlendTree(BlendTreeType type, const std::string& parameterX, const std::string& parameterY = "");
+
+    BlendTreeType GetType() const { return type_; }
+    const std::string& GetParameterX() const { return parameterX_; }
+    const std::string& GetParameterY() const { return parameterY_; }
+
+    // Simple1D用。thresholdの昇順に並べ替えて保持する
+    void AddMotion(std::shared_ptr<AnimationClip> clip, float threshold);
+    // Freeform2D用
+    void AddMotion(std::shared_ptr<AnimationClip> clip, const Vector2& position);
+
+    uint32 GetMotionCount() const { return static_cast<uint32>(motions_.size()); }
+    float GetMotionWeight(uint32 index) const { return motions_[index].weight; }
+
+    // パラメータの値から各モーションの重みを計算する（サンプリング・時間の更新の前に呼ぶ）
+    void SetParameters(float x, float y = 0.0f);
+
+    // 重み付きの長さ（秒）
+    float GetDuration() const;
+
+    void Sample(float normalizedTime, const Skeleton& skeleton, PosePool& pool, Pose& outPose,
+                bool skipDetailBones = false);
+
+    // 1本のボーンの平行移動の重み付き平均（ルートモーション用）
+    Vector3 SampleBoneTranslation(float normalizedTime, const Skeleton& skeleton, uint32 boneIndex);
+
+    // 重みが最も大きいモーションのクリップ（イベントはこのクリップのものだけを通知する）
+    const AnimationClip* GetDominantClip() const;
+
+    // 曲線の重み付き平均。曲線を持たないモーションは0として扱い、どのモーションにも無ければfalseを返す
+    bool EvaluateCurve(const std::string& name, float normalizedTime, float& outValue) const;
+
+    void ClearBindings();
+
+private:
+    struct Motion {
+        std::shared_ptr<AnimationClip> clip;
+        Vector2 position;
+        float weight = 0.0f;
+        AnimationBinding binding;
+        AnimationCursor cursor;
+    };
+
+    void BindMotion(Motion& motion, const Skeleton& skeleton);
+    void ComputeWeights1D(float x);
+    void ComputeWeights2D(float x, float y);
+
+    BlendTreeType type_;
+    std::string parameterX_;
+    std::string parameterY_;
+    std::vector<Motion> motions_;
+};
+
+} // namespace UnoEngine
@@ -0,0 +1,417 @@
+#include "CompressedAnimation.h"
+#include "Skeleton.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace UnoEngine {
+
+namespace {
+
+constexpr float MAX_SAMPLE_RATE = 240.0f;
+constexpr float VECTOR_QUANTIZE_MAX = 65535.0f;
+constexpr float ROTATION_QUANTIZE_MAX = 32767.0f;        // 15bit（残りの1bitに最大成分の番号を入れる）
+constexpr float ROTATION_COMPONENT_RANGE = 0.70710678f;  // 最大成分以外の絶対値は1/√2以下
+
+uint16 Quantize(float normalized, float maxValue) {
+    normalized = (std::min)((std::max)(normalized, 0.0f), 1.0f);
+    return static_cast<uint16>(normalized * maxValue + 0.5f);
+}
+
+void ToArray(const Vector3& v, float* out) {
+    out[0] = v.GetX();
+    out[1] = v.GetY();
+    out[2] = v.GetZ();
+}
+
+void ToArray(const Quaternion& q, float* out) {
+    out[0] = q.GetX();
+    out[1] = q.GetY();
+    out[2] = q.GetZ();
+    out[3] = q.GetW();
+}
+
+// smallest-three: 絶対値が最大の成分を除いた3成分を15bitずつ格納し、最大成分の番号を下位bitに分けて持つ
+void EncodeRotation(const Quaternion& rotation, uint16* out) {
+    float q[4];
+    ToArray(rotation.Normalize(), q);
+
+    uint32 largest = 0;
+    for (uint32 i = 1; i < 4; ++i) {
+        if (std::abs(q[i]) > std::abs(q[largest])) largest = i;
+    }
+    // 最大成分が正になる側を選ぶ（q と -q は同じ回転）
+    const float sign = q[largest] < 0.0f ? -1.0f : 1.0f;
+
+    uint32 slot = 0;
+    for (uint32 i = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        const float normalized = (q[i] * sign + ROTATION_COMPONENT_RANGE) / (2.0f * ROTATION_COMPONENT_RANGE);
+        out[slot] = static_cast<uint16>(Quantize(normalized, ROTATION_QUANTIZE_MAX) << 1);
+        ++slot;
+    }
+    out[0] |= largest & 1;
+    out[1] |= (largest >> 1) & 1;
+}
+
+Quaternion DecodeRotation(const uint16* in) {
+    const uint32 largest = (in[0] & 1) | ((in[1] & 1) << 1);
+
+    float q[4];
+    float sumSq = 0.0f;
+    uint32 slot = 0;
+    for (uint32 i = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        const float normalized = static_cast<float>(in[slot] >> 1) / ROTATION_QUANTIZE_MAX;
+        q[i] = normalized * (2.0f * ROTATION_COMPONENT_RANGE) - ROTATION_COMPONENT_RANGE;
+        sumSq += q[i] * q[i];
+        ++slot;
+    }
+    q[largest] = std::sqrt((std::max)(1.0f - sumSq, 0.0f));
+
+    return Quaternion(q[0], q[1], q[2], q[3]);
+}
+
+// 2つの回転の差の角度（ラジアン）
+// 小さな角度ではacos(dot)の精度が足りないため、同じ半球に揃えた差の長さ（弦）から求める
+float RotationError(const Quaternion& a, const Quaternion& b) {
+    float qa[4];
+    float qb[4];
+    ToArray(a.Normalize(), qa);
+    ToArray(b.Normalize(), qb);
+
+    const float sign = a.Dot(b) < 0.0f ? -1.0f : 1.0f;
+    float chordSq = 0.0f;
+    for (int i = 0; i < 4; ++i) {
+        const float d = qa[i] - qb[i] * sign;
+        chordSq += d * d;
+    }
+    return 4.0f * std::asin((std::min)(std::sqrt(chordSq) * 0.5f, 1.0f));
+}
+
+// start～endの間のサンプルを両端の補間で許容誤差内に再現できるか
+template<typename T, typename Interpolate, typename Error>
+bool SpanFits(const std::vector<T>& samples, const std::vector<T>& decoded, uint32 start, uint32 end,
+              float tolerance, Interpolate interpolate, Error error) {
+    const float span = static_cast<float>(end - start);
+    for (uint32 f = start + 1; f < end; ++f) {
+        const T value = interpolate(decoded[start], decoded[end], static_cast<float>(f - start) / span);
+        if (error(value, samples[f]) > tolerance) return false;
+    }
+    return true;
+}
+
+// 残すキーのフレーム番号を選ぶ（先頭と末尾は必ず残す）
+template<typename T, typename Interpolate, typename Error>
+std::vector<uint32> ReduceKeys(const std::vector<T>& samples, const std::vector<T>& decoded,
+                               float tolerance, Interpolate interpolate, Error error) {
+    const uint32 lastFrame = static_cast<uint32>(samples.size()) - 1;
+
+    std::vector<uint32> keys;
+    keys.push_back(0);
+    uint32 start = 0;
+    while (start < lastFrame) {
+        uint32 end = start + 1;
+        while (end < lastFrame && SpanFits(samples, decoded, start, end + 1, tolerance, interpolate, error)) {
+            ++end;
+        }
+        keys.push_back(end);
+        start = end;
+    }
+    return keys;
+}
+
+// キーの間隔の最小値（重複したキーは除く）
+template<typename T>
+float MinKeyInterval(const std::vector<Keyframe<T>>& keys) {
+    constexpr float MIN_INTERVAL = 0.0001f;
+
+    float interval = FLT_MAX;
+    for (size_t i = 1; i < keys.size(); ++i) {
+        const float delta = keys[i].time - keys[i - 1].time;
+        if (delta > MIN_INTERVAL) {
+            interval = (std::min)(interval, delta);
+        }
+    }
+    return interval;
+}
+
+// ボーンごとの許容誤差を決めるための骨格の情報
+struct BoneChainInfo {
+    std::vector<float> reach;         // 子孫ボーンまでの最大距離（回転誤差が子孫の位置誤差になる倍率）
+    std::vector<uint32> chainLength;  // そのボーンを通るルートから末端までの最長のボーン数（誤差が積み重なる数）
+};
+
+BoneChainInfo ComputeBoneChainInfo(const Skeleton& skeleton) {
+    const auto& bones = skeleton.GetBones();
+    BoneChainInfo info;
+    info.reach.assign(bones.size(), 0.0f);
+    info.chainLength.assign(bones.size(), 1);
+
+    // 親は子より前に並んでいるので、末尾から親へ子孫側の値を伝える
+    std::vector<uint32> below(bones.size(), 0);
+    for (size_t i = bones.size(); i-- > 0;) {
+        const int32 parent = bones[i].parentIndex;
+        if (parent == INVALID_BONE_INDEX) continue;
+
+        const float length = bones[i].localBindPose.TransformPoint(Vector3(0.0f, 0.0f, 0.0f)).Length();
+        info.reach[parent] = (std::max)(info.reach[parent], info.reach[i] + length);
+        below[parent] = (std::max)(below[parent], below[i] + 1);
+    }
+
+    // 先頭から祖先側の数を足す
+    std::vector<uint32> depth(bones.size(), 1);
+    for (size_t i = 0; i < bones.size(); ++i) {
+        const int32 parent = bones[i].parentIndex;
+        if (parent != INVALID_BONE_INDEX) {
+            depth[i] = depth[parent] + 1;
+        }
+        info.chainLength[i] = depth[i] + below[i];
+    }
+    return info;
+}
+
+} // anonymous namespace
+
+UniquePtr<CompressedAnimation> CompressedAnimation::Compress(const AnimationClip& clip, const Skeleton& skeleton,
+                                                             const AnimationCompressionSettings& settings) {
+    auto result = MakeUnique<CompressedAnimation>();
+
+    // フレーム間隔を決め、クリップの長さをちょうど等分するように合わせる
+    // 元のキーがsampleRateより密な（ベイク済みの）クリップは、キーの間隔に合わせて取りこぼさないようにする
+    // ただし不規則に近接したキーでフレーム数が膨らまないよう、MAX_SAMPLE_RATEより細かくはしない
+    const auto& boneAnimations = clip.GetBoneAnimations();
+    const float duration = (std::max)(clip.GetDuration(), 0.0f);
+    float frameInterval = clip.GetTicksPerSecond() / (std::max)(settings.sampleRate, 1.0f);
+    for (const BoneAnimation& anim : boneAnimations) {
+        frameInterval = (std::min)({ frameInterval, MinKeyInterval(anim.positionKeys),
+                                     MinKeyInterval(anim.rotationKeys), MinKeyInterval(anim.scaleKeys) });
+    }
+    frameInterval = (std::max)(frameInterval, clip.GetTicksPerSecond() / MAX_SAMPLE_RATE);
+
+    // キーの時刻の丸め誤差でフレームがずれないよう、最も近い整数に丸める
+    const float framesInClip = std::round(duration / frameInterval);
+    result->lastFrame_ = static_cast<uint32>((std::min)((std::max)(framesInClip, 1.0f), 65535.0f));
+    result->ticksPerFrame_ = duration > 0.0f ? duration / static_cast<float>(result->lastFrame_) : 1.0f;
+
+    // 位置の許容誤差はスケルトンの大きさ（ルートから最も遠いボーンまでの距離）を基準にする
+    const BoneChainInfo chainInfo = ComputeBoneChainInfo(skeleton);
+    float skeletonSize = 0.0f;
+    for (const Bone& bone : skeleton.GetBones()) {
+        if (bone.parentIndex == INVALID_BONE_INDEX) {
+            skeletonSize = (std::max)(skeletonSize, chainInfo.reach[&bone - skeleton.GetBones().data()]);
+        }
+    }
+    const float positionTolerance = settings.positionTolerance * (skeletonSize > 0.0f ? skeletonSize : 1.0f);
+
+    const uint32 frameCount = result->lastFrame_ + 1;
+    std::vector<Vector3> positions(frameCount);
+    std::vector<Quaternion> rotations(frameCount);
+    std::vector<Vector3> scales(frameCount);
+
+    result->channels_.resize(boneAnimations.size());
+    for (size_t c = 0; c < boneAnimations.size(); ++c) {
+        const BoneAnimation& anim = boneAnimations[c];
+        for (uint32 f = 0; f < frameCount; ++f) {
+            const float time = static_cast<float>(f) * result->ticksPerFrame_;
+            positions[f] = anim.InterpolatePosition(time);
+            rotations[f] = anim.InterpolateRotation(time);
+            scales[f] = anim.InterpolateScale(time);
+        }
+
+        // 各ボーンの誤差は子孫へ積み重なるため、許容誤差をチェーン上のボーン数で分け合う
+        // 回転の誤差は子孫ボーンの位置を reach 倍ずらすため、その分さらに絞る
+        float bonePositionTolerance = positionTolerance;
+        float boneRotationTolerance = settings.rotationTolerance;
+        const int32 boneIndex = skeleton.GetBoneIndex(anim.boneName);
+        if (boneIndex != INVALID_BONE_INDEX) {
+            bonePositionTolerance /= static_cast<float>(chainInfo.chainLength[boneIndex]);
+            if (chainInfo.reach[boneIndex] > 0.0f) {
+                boneRotationTolerance = (std::min)(boneRotationTolerance, bonePositionTolerance / chainInfo.reach[boneIndex]);
+            }
+        }
+
+        Channel& channel = result->channels_[c];
+        result->CompressVectorTrack(positions, bonePositionTolerance, channel.position);
+        result->CompressRotationTrack(rotations, boneRotationTolerance, channel.rotation);
+        result->CompressVectorTrack(scales, settings.scaleTolerance, channel.scale);
+    }
+
+    result->keyFrames_.shrink_to_fit();
+    result->keyValues_.shrink_to_fit();
+    return result;
+}
+
+void CompressedAnimation::CompressVectorTrack(const std::vector<Vector3>& samples, float tolerance, Track& track) {
+    auto error = [](const Vector3& a, const Vector3& b) { return (a - b).Length(); };
+
+    const bool isConstant = std::all_of(samples.begin(), samples.end(),
+        [&](const Vector3& sample) { return error(sample, samples[0]) <= tolerance; });
+    if (isConstant) {
+        ToArray(samples[0], track.base);
+        return;
+    }
+
+    // トラックの値の範囲で量子化する
+    float minValue[3] = { samples[0].GetX(), samples[0].GetY(), samples[0].GetZ() };
+    float maxValue[3] = { minValue[0], minValue[1], minValue[2] };
+    for (const Vector3& sample : samples) {
+        float v[3];
+        ToArray(sample, v);
+        for (int i = 0; i < 3; ++i) {
+            minValue[i] = (std::min)(minValue[i], v[i]);
+            maxValue[i] = (std::max)(maxValue[i], v[i]);
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        track.base[i] = minValue[i];
+        track.extent[i] = (maxValue[i] - minValue[i]) / VECTOR_QUANTIZE_MAX;
+    }
+
+    std::vector<uint16> quantized(samples.size() * 3);
+    std::vector<Vector3> decoded(samples.size());
+    for (size_t f = 0; f < samples.size(); ++f) {
+        float v[3];
+        ToArray(samples[f], v);
+        float d[3];
+        for (int i = 0; i < 3; ++i) {
+            const float range = maxValue[i] - minValue[i];
+            const uint16 q = range > 0.0f ? Quantize((v[i] - minValue[i]) / range, VECTOR_QUANTIZE_MAX) : 0;
+            quantized[f * 3 + i] = q;
+            d[i] = track.base[i] + static_cast<float>(q) * track.extent[i];
+        }
+        decoded[f] = Vector3(d[0], d[1], d[2]);
+    }
+
+    const std::vector<uint32> keys = ReduceKeys(samples, decoded, tolerance, &Vector3::Lerp, error);
+
+    track.firstKey = static_cast<uint32>(keyFrames_.size());
+    track.keyCount = static_cast<uint32>(keys.size());
+    for (uint32 frame : keys) {
+        keyFrames_.push_back(static_cast<uint16>(frame));
+        keyValues_.insert(keyValues_.end(), quantized.begin() + frame * 3, quantized.begin() + frame * 3 + 3);
+    }
+}
+
+void CompressedAnimation::CompressRotationTrack(const std::vector<Quaternion>& samples, float tolerance, Track& track) {
+    const bool isConstant = std::all_of(samples.begin(), samples.end(),
+        [&](const Quaternion& sample) { return RotationError(sample, samples[0]) <= tolerance; });
+    if (isConstant) {
+        ToArray(samples[0], track.base);
+        return;
+    }
+
+    std::vector<uint16> quantized(samples.size() * 3);
+    std::vector<Quaternion> decoded(samples.size());
+    for (size_t f = 0; f < samples.size(); ++f) {
+        EncodeRotation(samples[f], &quantized[f * 3]);
+        decoded[f] = DecodeRotation(&quantized[f * 3]);
+    }
+
+    const std::vector<uint32> keys = ReduceKeys(samples, decoded, tolerance, &Quaternion::Slerp, &RotationError);
+
+    track.firstKey = static_cast<uint32>(keyFrames_.size());
+    track.keyCount = static_cast<uint32>(keys.size());
+    for (uint32 frame : keys) {
+        keyFrames_.push_back(static_cast<uint16>(frame));
+        keyValues_.insert(keyValues_.end(), quantized.begin() + frame * 3, quantized.begin() + frame * 3 + 3);
+    }
+}
+
+Matrix4x4 CompressedAnimation::GetLocalTransform(uint32 channel, float time, BoneAnimation::Cursor& cursor) const {
+    Vector3 position;
+    Quaternion rotation;
+    Vector3 scale;
+    Sample(channel, time, cursor, position, rotation, scale);
+
+    // BoneAnimation::GetLocalTransformと同じ S * R * T
+    return Matrix4x4::CreateScale(scale) * Matrix4x4::CreateFromQuaternion(rotation) * Matrix4x4::CreateTranslation(position);
+}
+
+void CompressedAnimation::Sample(uint32 channel, float time, BoneAnimation::Cursor& cursor,
+                                 Vector3& outPosition, Quaternion& outRotation, Vector3& outScale) const {
+    const Channel& c = channels_[channel];
+    const float frame = (std::min)((std::max)(time / ticksPerFrame_, 0.0f), static_cast<float>(lastFrame_));
+
+    outPosition = SampleVector(c.position, frame, cursor.position);
+    outRotation = SampleRotation(c.rotation, frame, cursor.rotation);
+    outScale = SampleVector(c.scale, frame, cursor.scale);
+}
+
+size_t CompressedAnimation::GetMemoryUsage() const {
+    return sizeof(*this)
+        + channels_.capacity() * sizeof(Channel)
+        + keyFrames_.capacity() * sizeof(uint16)
+        + keyValues_.capacity() * sizeof(uint16);
+}
+
+uint32 CompressedAnimation::GetConstantTrackCount() const {
+    uint32 count = 0;
+    for (const Channel& channel : channels_) {
+        count += (channel.position.keyCount == 0) + (channel.rotation.keyCount == 0) + (channel.scale.keyCount == 0);
+    }
+    return count;
+}
+
+Vector3 CompressedAnimation::SampleVector(const Track& track, float frame, uint32& cursor) const {
+    if (track.keyCount == 0) {
+        return Vector3(track.base[0], track.base[1], track.base[2]);
+    }
+
+    const uint32 key = FindKey(track, frame, cursor);
+    const float frame0 = keyFrames_[key];
+    const float frame1 = keyFrames_[key + 1];
+    const float factor = (std::min)((frame - frame0) / (frame1 - frame0), 1.0f);
+
+    const uint16* q0 = &keyValues_[key * 3];
+    const uint16* q1 = &keyValues_[(key + 1) * 3];
+    const Vector3 v0(track.base[0] + q0[0] * track.extent[0], track.base[1] + q0[1] * track.extent[1], track.base[2] + q0[2] * track.extent[2]);
+    const Vector3 v1(track.base[0] + q1[0] * track.extent[0], track.base[1] + q1[1] * track.extent[1], track.base[2] + q1[2] * track.extent[2]);
+    return Vector3::Lerp(v0, v1, factor);
+}
+
+Quaternion CompressedAnimation::SampleRotation(const Track& track, float frame, uint32& cursor) const {
+    if (track.keyCount == 0) {
+        return Quaternion(track.base[0], track.base[1], track.base[2], track.base[3]);
+    }
+
+    const uint32 key = FindKey(track, frame, cursor);
+    const float frame0 = keyFrames_[key];
+    const float frame1 = keyFrames_[key + 1];
+    const float factor = (std::min)((frame - frame0) / (frame1 - frame0), 1.0f);
+
+    return Quaternion::Slerp(DecodeRotation(&keyValues_[key * 3]), DecodeRotation(&keyValues_[(key + 1) * 3]), factor);
+}
+
+uint32 CompressedAnimation::FindKey(const Track& track, float frame, uint32& cursor) const {
+    // AnimationClipのキー探索と同じく、前回の位置から数キー進めて見つからなければ二分探索する
+    constexpr uint32 MAX_FORWARD_STEPS = 4;
+
+    const uint16* frames = &keyFrames_[track.firstKey];
+    const uint32 lastIndex = track.keyCount - 2;
+
+    auto search = [&]() {
+        const uint16* it = std::upper_bound(frames + 1, frames + lastIndex + 1, frame,
+            [](float f, uint16 keyFrame) { return f < static_cast<float>(keyFrame); });
+        return static_cast<uint32>(it - frames) - 1;
+    };
+
+    uint32 index = (std::min)(cursor, lastIndex);
+    if (index > 0 && frame < frames[index]) {
+        index = search();
+    } else {
+        uint32 steps = 0;
+        while (index < lastIndex && !(frame < frames[index + 1])) {
+            if (++steps > MAX_FORWARD_STEPS) {
+                index = search();
+                break;
+            }
+            ++index;
+        }
+    }
+
+    cursor = index;
+    return track.firstKey + index;
+}
+
+} // namespace UnoEngine
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../Core/Types.h"
+#include "../Math/Vector.h"
+#include "../Math/Quaternion.h"
+#include "../Math/Matrix.h"
+#include "AnimationClip.h"
+#include <vector>
+
+namespace UnoEngine {
+
+class Skeleton;
+
+struct AnimationCompressionSettings {
+    float sampleRate = 30.0f;           // 一様サンプリングの頻度（1秒あたりのフレーム数）
+    float positionTolerance = 0.0005f;  // 位置の許容誤差（スケルトンの大きさに対する比率。モデルの単位系に依存しないようにする）
+    float rotationTolerance = 0.001f;   // 回転の許容誤差（ラジアン）。ボーンごとに子孫ボーンまでの距離で絞り込む
+    float scaleTolerance = 0.0001f;
+};
+
+// 圧縮の結果（インポート時のログ用）
+struct AnimationCompressionReport {
+    size_t rawBytes = 0;
+    size_t compressedBytes = 0;
+    uint32 trackCount = 0;
+    uint32 constantTrackCount = 0;
+    uint32 rawKeyCount = 0;
+    uint32 compressedKeyCount = 0;
+    float maxPositionError = 0.0f;      // 全ボーンのスケルトン空間での位置誤差の最大値
+};
+
+// 圧縮済みのアニメーションクリップ
+//
+// 各トラック（チャンネルごとの位置・回転・スケール）を一様なフレームで再サンプリングし、
+// - 許容誤差内で値が変化しないトラックは定数1つにする
+// - 位置・スケールはトラックごとの範囲で16bitに、回転はsmallest-three（3成分×15bit）に量子化する
+// - 前後のキーの補間で許容誤差内に収まるキーを取り除き、残ったキーはフレーム番号（16bit）で持つ
+// チャンネルの並びは元のAnimationClip::GetBoneAnimations()と同じ
+class CompressedAnimation {
+public:
+    static UniquePtr<CompressedAnimation> Compress(const AnimationClip& clip, const Skeleton& skeleton,
+                                                   const AnimationCompressionSettings& settings);
+
+    uint32 GetChannelCount() const { return static_cast<uint32>(channels_.size()); }
+    Matrix4x4 GetLocalTransform(uint32 channel, float time, BoneAnimation::Cursor& cursor) const;
+    void Sample(uint32 channel, float time, BoneAnimation::Cursor& cursor,
+                Vector3& outPosition, Quaternion& outRotation, Vector3& outScale) const;
+
+    size_t GetMemoryUsage() const;
+    uint32 GetKeyCount() const { return static_cast<uint32>(keyFrames_.size()); }
+    uint32 GetConstantTrackCount() const;
+
+private:
+    // keyCountが0なら定数トラック（値はbase）
+    // 位置・スケールは base + 量子化値 * extent、回転はsmallest-three（baseは使わない）
+    struct Track {
+        uint32 firstKey = 0;
+        uint32 keyCount = 0;
+        float base[4] = {};
+        float extent[3] = {};
+    };
+
+    struct Channel {
+        Track position;
+        Track rotation;
+        Track scale;
+    };
+
+    void CompressVectorTrack(const std::vector<Vector3>& samples, float tolerance, Track& track);
+    void CompressRotationTrack(const std::vector<Quaternion>& samples, float tolerance, Track& track);
+
+    Vector3 SampleVector(const Track& track, float frame, uint32& cursor) const;
+    Quaternion SampleRotation(const Track& track, float frame, uint32& cursor) const;
+    uint32 FindKey(const Track& track, float frame, uint32& cursor) const;
+
+    float ticksPerFrame_ = 1.0f;
+    uint32 lastFrame_ = 0;
+    std::vector<Channel> channels_;
+    std::vector<uint16> keyFrames_;  // 全トラックのキーのフレーム番号（トラックごとに昇順）
+    std::vector<uint16> keyValues_;  // キーごとに3個
+};
+
+} // namespace UnoEngine
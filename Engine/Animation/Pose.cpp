@@ -0,0 +1,334 @@
+#include "Pose.h"
+#include "Skeleton.h"
+#include "../Math/SimdConfig.h"
+#include "../Math/MatrixKernels.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace UnoEngine {
+
+namespace {
+
+// 配列の確保単位（SIMD幅に関係なく4の倍数にそろえる）
+constexpr uint32 PADDING = 4;
+
+// ブレンド用のレーン演算
+// SSE2では4ボーンずつ、それ以外（NEONを含む）ではスカラーで1ボーンずつ処理する
+#if UNO_SIMD_SSE
+using Lane = __m128;
+constexpr uint32 LANE_WIDTH = 4;
+
+inline Lane Load(const float* p) { return _mm_loadu_ps(p); }
+inline void Store(float* p, Lane v) { _mm_storeu_ps(p, v); }
+inline Lane Splat(float v) { return _mm_set1_ps(v); }
+inline Lane Add(Lane a, Lane b) { return _mm_add_ps(a, b); }
+inline Lane Sub(Lane a, Lane b) { return _mm_sub_ps(a, b); }
+inline Lane Mul(Lane a, Lane b) { return _mm_mul_ps(a, b); }
+inline Lane Div(Lane a, Lane b) { return _mm_div_ps(a, b); }
+inline Lane Sqrt(Lane v) { return _mm_sqrt_ps(v); }
+
+// signが負のレーンだけvの符号を反転する
+inline Lane FlipSign(Lane v, Lane sign) {
+    const Lane mask = _mm_cmplt_ps(sign, _mm_setzero_ps());
+    return _mm_xor_ps(v, _mm_and_ps(mask, _mm_set1_ps(-0.0f)));
+}
+#else
+using Lane = float;
+constexpr uint32 LANE_WIDTH = 1;
+
+inline Lane Load(const float* p) { return *p; }
+inline void Store(float* p, Lane v) { *p = v; }
+inline Lane Splat(float v) { return v; }
+inline Lane Add(Lane a, Lane b) { return a + b; }
+inline Lane Sub(Lane a, Lane b) { return a - b; }
+inline Lane Mul(Lane a, Lane b) { return a * b; }
+inline Lane Div(Lane a, Lane b) { return a / b; }
+inline Lane Sqrt(Lane v) { return std::sqrt(v); }
+inline Lane FlipSign(Lane v, Lane sign) { return sign < 0.0f ? -v : v; }
+#endif
+
+static_assert(PADDING % LANE_WIDTH == 0, "Pose padding must be a multiple of the SIMD width");
+
+inline Lane Lerp(Lane a, Lane b, Lane t) {
+    return Add(a, Mul(Sub(b, a), t));
+}
+
+uint32 GetPaddedCount(uint32 boneCount) {
+    return (boneCount + PADDING - 1) / PADDING * PADDING;
+}
+
+} // anonymous namespace
+
+BoneMask::BoneMask(uint32 boneCount, float weight)
+    : weights_(GetPaddedCount(boneCount), weight)
+    , boneCount_(boneCount) {
+}
+
+void BoneMask::SetBranchWeight(const Skeleton& skeleton, const std::string& rootBoneName, float weight) {
+    const int32 root = skeleton.GetBoneIndex(rootBoneName);
+    if (root == INVALID_BONE_INDEX) {
+        return;
+    }
+
+    // 親は必ず子より前に格納されているため、rootから後ろへ1回走査すれば子孫がすべて見つかる
+    const auto& bones = skeleton.GetBones();
+    std::vector<bool> inBranch(bones.size(), false);
+    for (uint32 i = static_cast<uint32>(root); i < boneCount_ && i < bones.size(); ++i) {
+        const int32 parent = bones[i].parentIndex;
+        if (static_cast<int32>(i) == root || (parent != INVALID_BONE_INDEX && inBranch[parent])) {
+            inBranch[i] = true;
+            weights_[i] = weight;
+        }
+    }
+}
+
+void Pose::Resize(uint32 boneCount) {
+    const uint32 capacity = GetPaddedCount(boneCount);
+    for (uint32 s = 0; s < STREAM_COUNT; ++s) {
+        const float identity = (s == RW || s >= SX) ? 1.0f : 0.0f;
+        auto& stream = streams_[s];
+        stream.resize(capacity, identity);
+
+        // 端数の要素は単位姿勢にしておく（ブレンドの正規化で0除算にならないように）
+        for (uint32 i = boneCount; i < capacity; ++i) {
+            stream[i] = identity;
+        }
+    }
+    boneCount_ = boneCount;
+}
+
+void Pose::SetBone(uint32 index, const Vector3& translation, const Quaternion& rotation, const Vector3& scale) {
+    assert(index < boneCount_);
+    streams_[TX][index] = translation.GetX();
+    streams_[TY][index] = translation.GetY();
+    streams_[TZ][index] = translation.GetZ();
+    streams_[RX][index] = rotation.GetX();
+    streams_[RY][index] = rotation.GetY();
+    streams_[RZ][index] = rotation.GetZ();
+    streams_[RW][index] = rotation.GetW();
+    streams_[SX][index] = scale.GetX();
+    streams_[SY][index] = scale.GetY();
+    streams_[SZ][index] = scale.GetZ();
+}
+
+Vector3 Pose::GetTranslation(uint32 index) const {
+    return Vector3(streams_[TX][index], streams_[TY][index], streams_[TZ][index]);
+}
+
+Quaternion Pose::GetRotation(uint32 index) const {
+    return Quaternion(streams_[RX][index], streams_[RY][index], streams_[RZ][index], streams_[RW][index]);
+}
+
+Vector3 Pose::GetScale(uint32 index) const {
+    return Vector3(streams_[SX][index], streams_[SY][index], streams_[SZ][index]);
+}
+
+void Pose::Blend(const Pose& a, const Pose& b, float t, Pose& out, const BoneMask* mask) {
+    assert(a.boneCount_ == b.boneCount_);
+    assert(!mask || mask->IsEmpty() || mask->GetBoneCount() == a.boneCount_);
+    out.Resize(a.boneCount_);
+
+    const uint32 count = static_cast<uint32>(a.streams_[TX].size());
+    const Lane weight = Splat(t);
+    const float* boneWeights = (mask && !mask->IsEmpty()) ? mask->GetData() : nullptr;
+
+    // 平行移動・スケール: 線形補間
+    constexpr Stream LINEAR_STREAMS[] = { TX, TY, TZ, SX, SY, SZ };
+    for (Stream s : LINEAR_STREAMS) {
+        const float* pa = a.streams_[s].data();
+        const float* pb = b.streams_[s].data();
+        float* po = out.streams_[s].data();
+        for (uint32 i = 0; i < count; i += LANE_WIDTH) {
+            const Lane factor = boneWeights ? Mul(weight, Load(boneWeights + i)) : weight;
+            Store(po + i, Lerp(Load(pa + i), Load(pb + i), factor));
+        }
+    }
+
+    // 回転: 内積が負なら b を反転して最短経路にし、線形補間して正規化する（nlerp）
+    // クロスフェードの補間係数は単調に変化するため、slerpとの角速度の差は見た目に影響しない
+    const float* ax = a.streams_[RX].data();
+    const float* ay = a.streams_[RY].data();
+    const float* az = a.streams_[RZ].data();
+    const float* aw = a.streams_[RW].data();
+    const float* bx = b.streams_[RX].data();
+    const float* by = b.streams_[RY].data();
+    const float* bz = b.streams_[RZ].data();
+    const float* bw = b.streams_[RW].data();
+    float* ox = out.streams_[RX].data();
+    float* oy = out.streams_[RY].data();
+    float* oz = out.streams_[RZ].data();
+    float* ow = out.streams_[RW].data();
+
+    const Lane one = Splat(1.0f);
+    for (uint32 i = 0; i < count; i += LANE_WIDTH) {
+        const Lane factor = boneWeights ? Mul(weight, Load(boneWeights + i)) : weight;
+        const Lane qax = Load(ax + i), qay = Load(ay + i), qaz = Load(az + i), qaw = Load(aw + i);
+        Lane qbx = Load(bx + i), qby = Load(by + i), qbz = Load(bz + i), qbw = Load(bw + i);
+
+        const Lane dot = Add(Add(Mul(qax, qbx), Mul(qay, qby)), Add(Mul(qaz, qbz), Mul(qaw, qbw)));
+        qbx = FlipSign(qbx, dot);
+        qby = FlipSign(qby, dot);
+        qbz = FlipSign(qbz, dot);
+        qbw = FlipSign(qbw, dot);
+
+        const Lane x = Lerp(qax, qbx, factor);
+        const Lane y = Lerp(qay, qby, factor);
+        const Lane z = Lerp(qaz, qbz, factor);
+        const Lane w = Lerp(qaw, qbw, factor);
+
+        const Lane lengthSq = Add(Add(Mul(x, x), Mul(y, y)), Add(Mul(z, z), Mul(w, w)));
+        const Lane invLength = Div(one, Sqrt(lengthSq));
+        Store(ox + i, Mul(x, invLength));
+        Store(oy + i, Mul(y, invLength));
+        Store(oz + i, Mul(z, invLength));
+        Store(ow + i, Mul(w, invLength));
+    }
+}
+
+void Pose::ApplyAdditive(const Pose& base, const Pose& additive, const Pose& reference, float weight,
+                         Pose& out, const BoneMask* mask) {
+    assert(base.boneCount_ == additive.boneCount_ && base.boneCount_ == reference.boneCount_);
+    assert(!mask || mask->IsEmpty() || mask->GetBoneCount() == base.boneCount_);
+    out.Resize(base.boneCount_);
+
+    const bool useMask = mask && !mask->IsEmpty();
+    for (uint32 i = 0; i < base.boneCount_; ++i) {
+        const float t = useMask ? weight * mask->GetWeight(i) : weight;
+        if (t <= 0.0f) {
+            if (&out != &base) {
+                out.SetBone(i, base.GetTranslation(i), base.GetRotation(i), base.GetScale(i));
+            }
+            continue;
+        }
+
+        // 平行移動: 基準からの差分を加える
+        const Vector3 translation = base.GetTranslation(i) + (additive.GetTranslation(i) - reference.GetTranslation(i)) * t;
+
+        // 回転: additive = reference * delta となる delta を求め、base * delta で適用する
+        // （M(a * b) = M(b) * M(a) のため、行列では delta がボーンのローカル空間で先に掛かる）
+        Quaternion delta = reference.GetRotation(i).Conjugate() * additive.GetRotation(i);
+        if (delta.GetW() < 0.0f) {
+            delta = Quaternion(-delta.GetX(), -delta.GetY(), -delta.GetZ(), -delta.GetW());
+        }
+        delta = Quaternion(delta.GetX() * t, delta.GetY() * t, delta.GetZ() * t, 1.0f + (delta.GetW() - 1.0f) * t).Normalize();
+        const Quaternion rotation = (base.GetRotation(i) * delta).Normalize();
+
+        // スケール: 基準に対する比率を掛ける
+        const Vector3 baseScale = base.GetScale(i);
+        const Vector3 additiveScale = additive.GetScale(i);
+        const Vector3 referenceScale = reference.GetScale(i);
+        auto scaleRatio = [t](float value, float referenceValue) {
+            const float ratio = std::abs(referenceValue) > 1e-6f ? value / referenceValue : 1.0f;
+            return 1.0f + (ratio - 1.0f) * t;
+        };
+        const Vector3 scale(baseScale.GetX() * scaleRatio(additiveScale.GetX(), referenceScale.GetX()),
+                            baseScale.GetY() * scaleRatio(additiveScale.GetY(), referenceScale.GetY()),
+                            baseScale.GetZ() * scaleRatio(additiveScale.GetZ(), referenceScale.GetZ()));
+
+        out.SetBone(i, translation, rotation, scale);
+    }
+}
+
+void Pose::BeginAccumulate(uint32 boneCount) {
+    Resize(boneCount);
+    for (auto& stream : streams_) {
+        std::fill(stream.begin(), stream.end(), 0.0f);
+    }
+}
+
+void Pose::Accumulate(const Pose& pose, float weight) {
+    assert(pose.boneCount_ == boneCount_);
+
+    const uint32 count = static_cast<uint32>(streams_[TX].size());
+    const Lane w = Splat(weight);
+
+    constexpr Stream LINEAR_STREAMS[] = { TX, TY, TZ, SX, SY, SZ };
+    for (Stream s : LINEAR_STREAMS) {
+        const float* src = pose.streams_[s].data();
+        float* dst = streams_[s].data();
+        for (uint32 i = 0; i < count; i += LANE_WIDTH) {
+            Store(dst + i, Add(Load(dst + i), Mul(Load(src + i), w)));
+        }
+    }
+
+    // 回転は累積値と同じ半球にそろえてから加える（最初の1つは累積値が0なのでそのまま）
+    float* rx = streams_[RX].data();
+    float* ry = streams_[RY].data();
+    float* rz = streams_[RZ].data();
+    float* rw = streams_[RW].data();
+    const float* px = pose.streams_[RX].data();
+    const float* py = pose.streams_[RY].data();
+    const float* pz = pose.streams_[RZ].data();
+    const float* pw = pose.streams_[RW].data();
+    for (uint32 i = 0; i < count; i += LANE_WIDTH) {
+        const Lane ax = Load(rx + i), ay = Load(ry + i), az = Load(rz + i), aw = Load(rw + i);
+        const Lane bx = Load(px + i), by = Load(py + i), bz = Load(pz + i), bw = Load(pw + i);
+
+        const Lane dot = Add(Add(Mul(ax, bx), Mul(ay, by)), Add(Mul(az, bz), Mul(aw, bw)));
+        const Lane signedWeight = FlipSign(w, dot);
+        Store(rx + i, Add(ax, Mul(bx, signedWeight)));
+        Store(ry + i, Add(ay, Mul(by, signedWeight)));
+        Store(rz + i, Add(az, Mul(bz, signedWeight)));
+        Store(rw + i, Add(aw, Mul(bw, signedWeight)));
+    }
+}
+
+void Pose::EndAccumulate() {
+    const uint32 count = static_cast<uint32>(streams_[TX].size());
+    float* rx = streams_[RX].data();
+    float* ry = streams_[RY].data();
+    float* rz = streams_[RZ].data();
+    float* rw = streams_[RW].data();
+
+    const Lane one = Splat(1.0f);
+    for (uint32 i = 0; i < count; i += LANE_WIDTH) {
+        const Lane x = Load(rx + i), y = Load(ry + i), z = Load(rz + i), w = Load(rw + i);
+        const Lane lengthSq = Add(Add(Mul(x, x), Mul(y, y)), Add(Mul(z, z), Mul(w, w)));
+        const Lane invLength = Div(one, Sqrt(lengthSq));
+        Store(rx + i, Mul(x, invLength));
+        Store(ry + i, Mul(y, invLength));
+        Store(rz + i, Mul(z, invLength));
+        Store(rw + i, Mul(w, invLength));
+    }
+}
+
+void Pose::ToLocalMatrices(std::vector<Matrix4x4>& outLocalTransforms) const {
+    outLocalTransforms.resize(boneCount_);
+
+    for (uint32 i = 0; i < boneCount_; ++i) {
+        float* m = outLocalTransforms[i].GetData();
+
+        // 回転行列の各行にスケールを掛け、4行目に平行移動を置く（S * R * T を展開した形）
+        const float q[4] = { streams_[RX][i], streams_[RY][i], streams_[RZ][i], streams_[RW][i] };
+        Math::QuaternionToMatrix(q, m);
+
+        const float scale[3] = { streams_[SX][i], streams_[SY][i], streams_[SZ][i] };
+        for (uint32 row = 0; row < 3; ++row) {
+            m[row * 4 + 0] *= scale[row];
+            m[row * 4 + 1] *= scale[row];
+            m[row * 4 + 2] *= scale[row];
+        }
+
+        m[12] = streams_[TX][i];
+        m[13] = streams_[TY][i];
+        m[14] = streams_[TZ][i];
+    }
+}
+
+Pose& PosePool::Acquire(uint32 boneCount) {
+    if (inUse_ == poses_.size()) {
+        poses_.push_back(MakeUnique<Pose>());
+    }
+    Pose& pose = *poses_[inUse_++];
+    pose.Resize(boneCount);
+    return pose;
+}
+
+void PosePool::Release(Pose& pose) {
+    assert(inUse_ > 0 && poses_[inUse_ - 1].get() == &pose);
+    (void)pose;
+    --inUse_;
+}
+
+} // namespace UnoEngine
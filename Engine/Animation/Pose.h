@@ -0,0 +1,98 @@
+#pragma once
+
+#include "../Core/Types.h"
+#include "../Math/Vector.h"
+#include "../Math/Quaternion.h"
+#include "../Math/Matrix.h"
+#include <array>
+#include <string>
+#include <vector>
+
+namespace UnoEngine {
+
+class Skeleton;
+
+// ボーンごとのブレンドの重み（上半身だけ別のアニメーションを重ねる場合など）
+// Poseと同じくSIMD幅の倍数まで確保する
+class BoneMask {
+public:
+    BoneMask() = default;
+    explicit BoneMask(uint32 boneCount, float weight = 0.0f);
+
+    bool IsEmpty() const { return boneCount_ == 0; }
+    uint32 GetBoneCount() const { return boneCount_; }
+
+    void SetWeight(uint32 boneIndex, float weight) { weights_[boneIndex] = weight; }
+    float GetWeight(uint32 boneIndex) const { return weights_[boneIndex]; }
+
+    // rootBoneNameのボーンとその子孫すべての重みを設定する（見つからなければ何もしない）
+    void SetBranchWeight(const Skeleton& skeleton, const std::string& rootBoneName, float weight);
+
+    const float* GetData() const { return weights_.data(); }
+
+private:
+    std::vector<float> weights_;
+    uint32 boneCount_ = 0;
+};
+
+// スケルトン全体のローカル姿勢（ボーンごとの平行移動・回転・スケール）
+//
+// 成分ごとの配列（SoA）で持つため、ブレンドは複数ボーンをまとめてSIMDで処理できる
+// 行列への変換は最後にToLocalMatricesで1回だけ行う
+// 配列はSIMD幅の倍数まで確保し、端数の要素は単位姿勢で埋めておく
+class Pose {
+public:
+    void Resize(uint32 boneCount);
+    uint32 GetBoneCount() const { return boneCount_; }
+
+    void SetBone(uint32 index, const Vector3& translation, const Quaternion& rotation, const Vector3& scale);
+    Vector3 GetTranslation(uint32 index) const;
+    Quaternion GetRotation(uint32 index) const;
+    Vector3 GetScale(uint32 index) const;
+
+    // out = a と b の補間（平行移動・スケールは線形補間、回転は最短経路のnlerp）
+    // a, b, out のボーン数は同じであること。outはaまたはbと同じでもよい
+    // maskを指定した場合はボーンごとに t * 重み で補間する
+    static void Blend(const Pose& a, const Pose& b, float t, Pose& out, const BoneMask* mask = nullptr);
+
+    // base に additive と reference の差分を weight 倍して加える（加算レイヤー）
+    // 回転の差分はボーンのローカル空間で適用する。outはbaseと同じでもよい
+    static void ApplyAdditive(const Pose& base, const Pose& additive, const Pose& reference, float weight,
+                              Pose& out, const BoneMask* mask = nullptr);
+
+    // 複数ポーズの重み付き平均（ブレンドツリー用）
+    // BeginAccumulateで0クリアし、Accumulateで加算、EndAccumulateで回転を正規化する
+    // 重みの合計は1にしておくこと
+    void BeginAccumulate(uint32 boneCount);
+    void Accumulate(const Pose& pose, float weight);
+    void EndAccumulate();
+
+    // ボーンごとに S * R * T の行列を作る（BoneAnimation::GetLocalTransformと同じ構成）
+    void ToLocalMatrices(std::vector<Matrix4x4>& outLocalTransforms) const;
+
+private:
+    enum Stream : uint32 {
+        TX, TY, TZ,
+        RX, RY, RZ, RW,
+        SX, SY, SZ,
+        STREAM_COUNT
+    };
+
+    std::array<std::vector<float>, STREAM_COUNT> streams_;
+    uint32 boneCount_ = 0;
+};
+
+// 作業用Poseの使い回し
+// ブレンドツリーやレイヤーの合成で一時的に必要なPoseを貸し出す。確保済みのPoseは保持し続けるため、
+// 2回目以降のフレームではヒープ確保が起きない。返却は借りた順の逆（スタック順）で行う
+class PosePool {
+public:
+    Pose& Acquire(uint32 boneCount);
+    void Release(Pose& pose);
+
+private:
+    std::vector<UniquePtr<Pose>> poses_;
+    uint32 inUse_ = 0;
+};
+
+} // namespace UnoEngine
@@ -1,7 +1,34 @@
 #include "Skeleton.h"
+#include "../Math/MatrixBatch.h"
+#include <algorithm>
+#include <cctype>
 
 namespace UnoEngine {
 
+namespace {
+
+// 細部のボーンとみなす名前の部分文字列（小文字）
+constexpr const char* DETAIL_BONE_KEYWORDS[] = {
+    "finger", "thumb", "index", "middle", "ring", "pinky", "little",
+    "toe",
+    "eye", "jaw", "tongue", "teeth", "brow", "lip", "cheek", "face",
+};
+
+bool IsDetailBoneName(const std::string& name) {
+    std::string lower(name);
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    for (const char* keyword : DETAIL_BONE_KEYWORDS) {
+        if (lower.find(keyword) != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // anonymous namespace
+
 void Skeleton::AddBone(const std::string& name, int32 parentIndex,
                        const Matrix4x4& offsetMatrix, const Matrix4x4& localBindPose) {
     int32 index = static_cast<int32>(bones_.size());
@@ -13,7 +40,16 @@ void Skeleton::AddBone(const std::string& name, int32 parentIndex,
     bone.localBindPose = localBindPose;
 
     bones_.push_back(bone);
+    offsetMatrices_.push_back(offsetMatrix);
+    detailBones_.push_back(0);
     boneNameToIndex_[name] = index;
+
+    Vector3 scale;
+    Quaternion rotation;
+    Vector3 translation;
+    localBindPose.Decompose(scale, rotation, translation);
+    bindPose_.Resize(static_cast<uint32>(bones_.size()));
+    bindPose_.SetBone(static_cast<uint32>(index), translation, rotation, scale);
 }
 
 int32 Skeleton::GetBoneIndex(const std::string& name) const {
@@ -36,51 +72,86 @@ const Bone* Skeleton::GetBone(const std::string& name) const {
     return GetBone(index);
 }
 
+void Skeleton::MarkDetailBonesByName() {
+    // 親が子より後に追加されている場合もあるため、ボーンごとに親をたどって判定する
+    const uint32 boneCount = GetBoneCount();
+    for (uint32 i = 0; i < boneCount; ++i) {
+        bool isDetail = false;
+        for (int32 index = static_cast<int32>(i); index != INVALID_BONE_INDEX && !isDetail;
+             index = bones_[index].parentIndex) {
+            isDetail = IsDetailBoneName(bones_[index].name);
+        }
+        detailBones_[i] = isDetail ? 1 : 0;
+    }
+}
+
 void Skeleton::ComputeBoneMatrices(const std::vector<Matrix4x4>& localTransforms,
                                    std::vector<Matrix4x4>& outFinalMatrices) const {
     const uint32 boneCount = GetBoneCount();
     outFinalMatrices.resize(boneCount);
 
     std::vector<Matrix4x4> globalTransforms(boneCount);
+    ComputeGlobalTransforms(localTransforms, globalTransforms);
+
+    // : Final = InverseBindPose * Global
+    Math::MultiplyPairwise(offsetMatrices_, globalTransforms, outFinalMatrices);
+}
+
+void Skeleton::ComputeBoneMatricesWithInverseTranspose(const std::vector<Matrix4x4>& localTransforms,
+                                                       std::vector<BoneMatrixPair>& outBoneMatrices) const {
+    std::vector<Matrix4x4> globalTransforms;
+    ComputeSkinningMatrices(localTransforms, globalTransforms, outBoneMatrices);
+}
+
+void Skeleton::ComputeSkinningMatrices(const std::vector<Matrix4x4>& localTransforms,
+                                       std::vector<Matrix4x4>& globalTransforms,
+                                       std::vector<BoneMatrixPair>& outBoneMatrices,
+                                       std::vector<Matrix4x4>* outFinalMatrices) const {
+    const uint32 boneCount = GetBoneCount();
+    globalTransforms.resize(boneCount);
+    outBoneMatrices.resize(boneCount);
+    if (outFinalMatrices) {
+        outFinalMatrices->resize(boneCount);
+    }
 
+    // 親は必ず子より前に格納されているため、先頭から順に1回たどれば済む
     for (uint32 i = 0; i < boneCount; ++i) {
-        const Bone& bone = bones_[i];
+        const int32 parentIndex = bones_[i].parentIndex;
+        float* global = globalTransforms[i].GetData();
 
         // : Global = Local * Parent
-        if (bone.parentIndex == INVALID_BONE_INDEX) {
+        if (parentIndex == INVALID_BONE_INDEX) {
             globalTransforms[i] = localTransforms[i];
         } else {
-            globalTransforms[i] = localTransforms[i] * globalTransforms[bone.parentIndex];
+            Math::MatrixMultiply(localTransforms[i].GetData(), globalTransforms[parentIndex].GetData(), global);
         }
 
         // : Final = InverseBindPose * Global
-        outFinalMatrices[i] = bone.offsetMatrix * globalTransforms[i];
+        BoneMatrixPair& pair = outBoneMatrices[i];
+        Math::MatrixMultiply(offsetMatrices_[i].GetData(), global, pair.skeletonSpaceMatrix.GetData());
+
+        // 法線変換用（シェーダーは左上3x3だけを使う）
+        Math::MatrixNormal(pair.skeletonSpaceMatrix.GetData(), pair.skeletonSpaceInverseTransposeMatrix.GetData());
+
+        if (outFinalMatrices) {
+            (*outFinalMatrices)[i] = pair.skeletonSpaceMatrix;
+        }
     }
 }
 
-void Skeleton::ComputeBoneMatricesWithInverseTranspose(const std::vector<Matrix4x4>& localTransforms,
-                                                       std::vector<BoneMatrixPair>& outBoneMatrices) const {
+void Skeleton::ComputeGlobalTransforms(const std::vector<Matrix4x4>& localTransforms,
+                                       std::vector<Matrix4x4>& outGlobalTransforms) const {
+    // 親は必ず子より前に格納されているため、先頭から順に処理できる
     const uint32 boneCount = GetBoneCount();
-    outBoneMatrices.resize(boneCount);
-
-    std::vector<Matrix4x4> globalTransforms(boneCount);
-
     for (uint32 i = 0; i < boneCount; ++i) {
-        const Bone& bone = bones_[i];
+        const int32 parentIndex = bones_[i].parentIndex;
 
         // : Global = Local * Parent
-        if (bone.parentIndex == INVALID_BONE_INDEX) {
-            globalTransforms[i] = localTransforms[i];
+        if (parentIndex == INVALID_BONE_INDEX) {
+            outGlobalTransforms[i] = localTransforms[i];
         } else {
-            globalTransforms[i] = localTransforms[i] * globalTransforms[bone.parentIndex];
+            outGlobalTransforms[i] = localTransforms[i] * outGlobalTransforms[parentIndex];
         }
-
-        // : Final = InverseBindPose * Global
-        outBoneMatrices[i].skeletonSpaceMatrix = bone.offsetMatrix * globalTransforms[i];
-
-        // InverseTranspose行列を計算（法線変換用）
-        outBoneMatrices[i].skeletonSpaceInverseTransposeMatrix =
-            outBoneMatrices[i].skeletonSpaceMatrix.Inverse().Transpose();
     }
 }
 
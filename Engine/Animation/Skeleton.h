@@ -4,6 +4,7 @@
 #include "../Math/Matrix.h"
 #include "../Math/Vector.h"
 #include "../Math/Quaternion.h"
+#include "Pose.h"
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -26,6 +27,9 @@ struct BoneMatrixPair {
     Matrix4x4 skeletonSpaceInverseTransposeMatrix;
 };
 
+// 一括演算・GPU転送で行列2つ分の連続領域として扱うため、パディングが入らないことを保証する
+static_assert(sizeof(BoneMatrixPair) == sizeof(Matrix4x4) * 2, "BoneMatrixPair must be two tightly packed matrices");
+
 class Skeleton {
 public:
     Skeleton() = default;
@@ -44,6 +48,15 @@ public:
     uint32 GetBoneCount() const { return static_cast<uint32>(bones_.size()); }
     const std::vector<Bone>& GetBones() const { return bones_; }
 
+    // 各ボーンのlocalBindPoseを平行移動・回転・スケールに分解したもの（クリップに無いボーンの姿勢に使う）
+    const Pose& GetBindPose() const { return bindPose_; }
+
+    // 細部のボーン（指・つま先・顔など）。遠景のアニメーションLODで計算を省略する対象
+    bool IsDetailBone(uint32 index) const { return detailBones_[index] != 0; }
+    void SetDetailBone(uint32 index, bool isDetail) { detailBones_[index] = isDetail ? 1 : 0; }
+    // ボーン名から細部のボーンを判定して設定する（該当するボーンの子孫もすべて細部とみなす）
+    void MarkDetailBonesByName();
+
     void ComputeBoneMatrices(const std::vector<Matrix4x4>& localTransforms,
                              std::vector<Matrix4x4>& outFinalMatrices) const;
     
@@ -52,8 +65,22 @@ public:
 
     void ComputeBindPoseMatrices(std::vector<Matrix4x4>& outFinalMatrices) const;
 
+    // スキニング用の行列（BoneMatrixPairと、指定されていればMatrix4x4の配列）を1回の階層走査でまとめて計算する
+    // globalTransformsは作業領域。呼び出し側で保持して使い回すことで毎フレームの確保をなくす
+    // 法線用の行列は左上3x3の逆転置から作る（平行移動成分は0）
+    void ComputeSkinningMatrices(const std::vector<Matrix4x4>& localTransforms,
+                                 std::vector<Matrix4x4>& globalTransforms,
+                                 std::vector<BoneMatrixPair>& outBoneMatrices,
+                                 std::vector<Matrix4x4>* outFinalMatrices = nullptr) const;
+
 private:
+    void ComputeGlobalTransforms(const std::vector<Matrix4x4>& localTransforms,
+                                 std::vector<Matrix4x4>& outGlobalTransforms) const;
+
     std::vector<Bone> bones_;
+    std::vector<Matrix4x4> offsetMatrices_;  // bones_[i].offsetMatrixの連続配列（一括演算用）
+    Pose bindPose_;
+    std::vector<uint8> detailBones_;
     std::unordered_map<std::string, int32> boneNameToIndex_;
     Matrix4x4 globalInverseTransform_;  // シーンルートノードの逆変換
 };
@@ -32,6 +32,9 @@ public:
     void OnUpdate(Scene* scene, float deltaTime) override;
     void OnSceneEnd(Scene* scene) override;
     int GetPriority() const override { return 10; }
+    // OnUpdateではコンポーネントに触れない（3D更新はAudioSource::OnUpdateで行う）
+    // ボイスの管理はメインスレッドから再生するAudioSourceと共有するため、メインスレッドで実行する
+    void DeclareAccess(SystemAccess& access) const override { access.MainThread(); }
 
     // ボイス管理
     IXAudio2SourceVoice* AcquireVoice(const WAVEFORMATEX* format);
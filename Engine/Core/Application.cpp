@@ -42,6 +42,11 @@ void Application::Initialize() {
         }
     });
     
+    // ジョブシステム初期化
+    jobSystem_ = MakeUnique<JobSystem>();
+    jobSystem_->Initialize();
+    systemManager_.SetJobSystem(jobSystem_.get());
+
     // 描画システム初期化
     sceneManager_ = MakeUnique<SceneManager>();
     sceneManager_->SetApplication(this);
@@ -84,6 +89,12 @@ void Application::MainLoop() {
         
         OnUpdate(deltaTime);
 
+        // ワールド行列を一括更新（更新処理で変更されたTransformを描画前に確定させる）
+        activeScene = sceneManager_->GetActiveScene();
+        if (activeScene) {
+            activeScene->UpdateTransforms(jobSystem_.get());
+        }
+
         // 描画
         OnRender();
     }
@@ -108,6 +119,8 @@ void Application::OnRender() {
 
 void Application::Shutdown() {
     OnShutdown();
+    systemManager_.SetJobSystem(nullptr);
+    jobSystem_.reset();
     input_.reset();
     graphics_.reset();
     window_.reset();
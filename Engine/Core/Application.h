@@ -4,6 +4,7 @@
 #include "NonCopyable.h"
 #include "../Rendering/RenderSystem.h"
 #include "SceneManager.h"
+#include "JobSystem.h"
 #include "../Window/Window.h"
 #include "../Graphics/GraphicsDevice.h"
 #include "../Rendering/LightManager.h"
@@ -34,6 +35,7 @@ public:
     InputManager* GetInput() const { return input_.get(); }
     SceneManager* GetSceneManager() const { return sceneManager_.get(); }
     SystemManager* GetSystemManager() { return &systemManager_; }
+    JobSystem* GetJobSystem() const { return jobSystem_.get(); }
 
 protected:
     // オーバーライド可能なライフサイクル
@@ -59,6 +61,7 @@ private:
     UniquePtr<Window> window_;
     UniquePtr<InputManager> input_;
     UniquePtr<SceneManager> sceneManager_;
+    UniquePtr<JobSystem> jobSystem_;
     
     bool running_ = false;
 };
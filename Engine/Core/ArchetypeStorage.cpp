@@ -0,0 +1,177 @@
+#include "ArchetypeStorage.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+namespace UnoEngine {
+
+Archetype::Archetype(std::vector<ComponentTypeId> types)
+    : types_(std::move(types))
+    , columns_(types_.size()) {
+}
+
+uint32 Archetype::GetColumnIndex(ComponentTypeId type) const {
+    auto it = std::lower_bound(types_.begin(), types_.end(), type);
+    if (it == types_.end() || *it != type) return INVALID_COLUMN;
+    return static_cast<uint32>(it - types_.begin());
+}
+
+bool QueryCache::TryAdd(const Archetype& archetype) {
+    const size_t base = columns.size();
+    for (ComponentTypeId type : types) {
+        uint32 column = Archetype::INVALID_COLUMN;
+        if (type != ComponentType::INVALID_ID) {
+            column = archetype.GetColumnIndex(type);
+            if (column == Archetype::INVALID_COLUMN) {
+                columns.resize(base);
+                return false;
+            }
+        }
+        columns.push_back(column);
+    }
+    archetypes.push_back(&archetype);
+    return true;
+}
+
+ArchetypeStorage::ArchetypeStorage() {
+    // コンポーネントなしのアーキタイプは常に先頭に置く
+    GetOrCreateArchetype({});
+}
+
+ArchetypeStorage::~ArchetypeStorage() {
+    Clear();
+}
+
+void ArchetypeStorage::Add(GameObject* gameObject) {
+    assert(gameObject && !gameObject->storage_ && "GameObject is already registered to a storage");
+
+    typeScratch_.clear();
+    for (const auto& entry : gameObject->componentTable_) {
+        typeScratch_.push_back(entry.type);
+    }
+
+    gameObject->storage_ = this;
+    AppendRow(GetOrCreateArchetype(typeScratch_), gameObject);
+    ++entityCount_;
+}
+
+void ArchetypeStorage::Remove(GameObject* gameObject) {
+    assert(gameObject && gameObject->storage_ == this && "GameObject is not registered to this storage");
+
+    RemoveRow(gameObject->archetype_, gameObject->archetypeRow_);
+    gameObject->storage_ = nullptr;
+    gameObject->archetype_ = nullptr;
+    gameObject->archetypeRow_ = 0;
+    --entityCount_;
+}
+
+void ArchetypeStorage::Clear() {
+    for (auto& archetype : archetypes_) {
+        for (GameObject* gameObject : archetype->entities_) {
+            gameObject->storage_ = nullptr;
+            gameObject->archetype_ = nullptr;
+            gameObject->archetypeRow_ = 0;
+        }
+        archetype->entities_.clear();
+        for (auto& column : archetype->columns_) {
+            column.clear();
+        }
+    }
+    entityCount_ = 0;
+}
+
+void ArchetypeStorage::OnComponentsChanged(GameObject* gameObject) {
+    assert(gameObject->storage_ == this);
+
+    typeScratch_.clear();
+    for (const auto& entry : gameObject->componentTable_) {
+        typeScratch_.push_back(entry.type);
+    }
+
+    Archetype* current = gameObject->archetype_;
+    if (current->types_ == typeScratch_) {
+        // 構成は同じ（同じ型の差し替え）なので列の参照だけ更新
+        for (size_t column = 0; column < current->columns_.size(); ++column) {
+            current->columns_[column][gameObject->archetypeRow_] = gameObject->componentTable_[column].component;
+        }
+        return;
+    }
+
+    Archetype* target = GetOrCreateArchetype(typeScratch_);
+    RemoveRow(current, gameObject->archetypeRow_);
+    AppendRow(target, gameObject);
+}
+
+Archetype* ArchetypeStorage::GetOrCreateArchetype(const std::vector<ComponentTypeId>& types) {
+    auto it = archetypeLookup_.find(types);
+    if (it != archetypeLookup_.end()) {
+        return it->second;
+    }
+
+    archetypes_.push_back(MakeUnique<Archetype>(types));
+    Archetype* archetype = archetypes_.back().get();
+    archetypeLookup_.emplace(types, archetype);
+
+    // 既存のクエリに新しいアーキタイプを反映
+    std::lock_guard<std::mutex> lock(queryCacheMutex_);
+    for (auto& cache : queryCaches_) {
+        if (cache) {
+            cache->TryAdd(*archetype);
+        }
+    }
+    return archetype;
+}
+
+uint32 ArchetypeStorage::AllocateQueryId() {
+    static std::atomic<uint32> nextId{ 0 };
+    return nextId.fetch_add(1, std::memory_order_relaxed);
+}
+
+const QueryCache& ArchetypeStorage::GetQueryCache(uint32 queryId, std::vector<ComponentTypeId> (*getTypes)()) const {
+    std::lock_guard<std::mutex> lock(queryCacheMutex_);
+
+    if (queryId >= queryCaches_.size()) {
+        queryCaches_.resize(queryId + 1);
+    }
+
+    auto& cache = queryCaches_[queryId];
+    if (!cache) {
+        cache = MakeUnique<QueryCache>();
+        cache->types = getTypes();
+        for (const auto& archetype : archetypes_) {
+            cache->TryAdd(*archetype);
+        }
+    }
+    return *cache;
+}
+
+void ArchetypeStorage::AppendRow(Archetype* archetype, GameObject* gameObject) {
+    // 検索表もアーキタイプの型も昇順なので、列は検索表と同じ順に並ぶ
+    assert(archetype->types_.size() == gameObject->componentTable_.size());
+
+    gameObject->archetype_ = archetype;
+    gameObject->archetypeRow_ = archetype->GetCount();
+    archetype->entities_.push_back(gameObject);
+    for (size_t column = 0; column < archetype->columns_.size(); ++column) {
+        archetype->columns_[column].push_back(gameObject->componentTable_[column].component);
+    }
+}
+
+void ArchetypeStorage::RemoveRow(Archetype* archetype, uint32 row) {
+    const uint32 last = archetype->GetCount() - 1;
+    if (row != last) {
+        GameObject* moved = archetype->entities_[last];
+        archetype->entities_[row] = moved;
+        for (auto& column : archetype->columns_) {
+            column[row] = column[last];
+        }
+        moved->archetypeRow_ = row;
+    }
+
+    archetype->entities_.pop_back();
+    for (auto& column : archetype->columns_) {
+        column.pop_back();
+    }
+}
+
+} // namespace UnoEngine
@@ -0,0 +1,228 @@
+#pragma once
+
+#include "Types.h"
+#include "NonCopyable.h"
+#include "ComponentType.h"
+#include "GameObject.h"
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace UnoEngine {
+
+// 同じコンポーネント型の組み合わせを持つGameObjectの表
+// 型ごとの列にコンポーネントを連続して並べるため、クエリは行を順に読むだけで済む
+//
+// コンポーネント本体はヒープ上に置いたまま（ポインタを保持しているコードがあるため移動しない）、
+// 列にはそのポインタを詰めて持つ。行の削除は末尾との入れ替えで行う
+class Archetype : public NonCopyable {
+public:
+    static constexpr uint32 INVALID_COLUMN = 0xFFFFFFFF;
+
+    explicit Archetype(std::vector<ComponentTypeId> types);
+
+    const std::vector<ComponentTypeId>& GetTypes() const { return types_; }
+    uint32 GetColumnIndex(ComponentTypeId type) const;
+
+    uint32 GetCount() const { return static_cast<uint32>(entities_.size()); }
+    GameObject* const* GetEntities() const { return entities_.data(); }
+    Component* const* GetColumn(uint32 column) const { return columns_[column].data(); }
+
+private:
+    friend class ArchetypeStorage;
+
+    std::vector<ComponentTypeId> types_;            // 昇順
+    std::vector<GameObject*> entities_;
+    std::vector<std::vector<Component*>> columns_;  // types_と同じ順
+};
+
+// クエリに該当するアーキタイプの一覧（ArchetypeStorageが型の組み合わせごとにキャッシュする）
+// アーキタイプが増えた時だけ追記されるため、クエリの実行時にアーキタイプを走査し直す必要はない
+struct QueryCache {
+    std::vector<ComponentTypeId> types;      // クエリの型（TransformはComponentType::INVALID_ID）
+    std::vector<const Archetype*> archetypes;
+    std::vector<uint32> columns;             // archetypes[i] の列番号を types.size() 個ずつ（TransformはINVALID_COLUMN）
+
+    // 該当すれば列番号を追記する
+    bool TryAdd(const Archetype& archetype);
+};
+
+// クエリ結果の走査
+// Ts... はすべてのコンポーネント型を持つGameObjectを列挙する（Transformを指定した場合はGameObjectのTransformを返す）
+// 読み取るだけの型はconst付きで指定する（デバッグビルドではシステムのRead/Writeの宣言と照らし合わせる）
+// 走査中にコンポーネントの追加・削除やGameObjectの生成・破棄を行ってはならない
+//
+//   for (auto [go, transform, renderer] : scene.Query<Transform, SkinnedMeshRenderer>()) { ... }
+//   scene.Query<AnimatorComponent>().ForEach([](GameObject& go, AnimatorComponent& animator) { ... });
+template<typename... Ts>
+class ArchetypeQuery {
+    static_assert(sizeof...(Ts) > 0, "Query needs at least one type");
+    static constexpr size_t TYPE_COUNT = sizeof...(Ts);
+
+public:
+    using Row = std::tuple<GameObject&, Ts&...>;
+
+    explicit ArchetypeQuery(const QueryCache& cache)
+        : cache_(&cache) {
+    }
+
+    // クエリの型をQueryCache::typesの形式で取得
+    static std::vector<ComponentTypeId> GetTypes() {
+        return { TypeIdOf<Ts>()... };
+    }
+
+    template<typename Func>
+    void ForEach(Func&& func) const {
+        const size_t archetypeCount = cache_->archetypes.size();
+        for (size_t match = 0; match < archetypeCount; ++match) {
+            const uint32 count = cache_->archetypes[match]->GetCount();
+            for (uint32 row = 0; row < count; ++row) {
+                std::apply(func, MakeRow(match, row, std::index_sequence_for<Ts...>{}));
+            }
+        }
+    }
+
+    uint32 Count() const {
+        uint32 count = 0;
+        for (const Archetype* archetype : cache_->archetypes) {
+            count += archetype->GetCount();
+        }
+        return count;
+    }
+
+    class Iterator {
+    public:
+        Iterator(const ArchetypeQuery* query, size_t match)
+            : query_(query), match_(match) {
+            SkipEmpty();
+        }
+
+        Row operator*() const {
+            return query_->MakeRow(match_, row_, std::index_sequence_for<Ts...>{});
+        }
+
+        Iterator& operator++() {
+            if (++row_ >= query_->cache_->archetypes[match_]->GetCount()) {
+                ++match_;
+                row_ = 0;
+                SkipEmpty();
+            }
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return match_ == other.match_ && row_ == other.row_; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        void SkipEmpty() {
+            const auto& archetypes = query_->cache_->archetypes;
+            while (match_ < archetypes.size() && archetypes[match_]->GetCount() == 0) {
+                ++match_;
+            }
+        }
+
+        const ArchetypeQuery* query_;
+        size_t match_;
+        uint32 row_ = 0;
+    };
+
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, cache_->archetypes.size()); }
+
+private:
+    template<typename T>
+    static ComponentTypeId TypeIdOf() {
+        if constexpr (std::is_same_v<std::remove_const_t<T>, Transform>) {
+            return ComponentType::INVALID_ID;
+        } else {
+            static_assert(std::is_base_of_v<Component, T>, "T must derive from Component or be Transform");
+            return ComponentType::GetId<std::remove_const_t<T>>();
+        }
+    }
+
+    template<typename T>
+    T& Fetch(GameObject& gameObject, const Archetype* archetype, size_t match, size_t index, uint32 row) const {
+        if constexpr (std::is_same_v<std::remove_const_t<T>, Transform>) {
+            return gameObject.GetTransform();
+        } else {
+            return *static_cast<T*>(archetype->GetColumn(cache_->columns[match * TYPE_COUNT + index])[row]);
+        }
+    }
+
+    template<size_t... Is>
+    Row MakeRow(size_t match, uint32 row, std::index_sequence<Is...>) const {
+        const Archetype* archetype = cache_->archetypes[match];
+        GameObject& gameObject = *archetype->GetEntities()[row];
+        return Row(gameObject, Fetch<Ts>(gameObject, archetype, match, Is, row)...);
+    }
+
+    const QueryCache* cache_;
+};
+
+// シーン内のGameObjectをコンポーネント構成ごとのアーキタイプに振り分けて保持する
+// GameObjectのコンポーネント追加・削除時にアーキタイプ間を移動する
+//
+// クエリの該当アーキタイプは型の組み合わせごとにキャッシュし、アーキタイプの生成時に更新する
+// 1型のクエリはその型を持つGameObjectの登録簿として働くため、
+// 特定のコンポーネントを持つオブジェクトだけを全オブジェクト数に関係なく列挙できる
+class ArchetypeStorage : public NonCopyable {
+public:
+    ArchetypeStorage();
+    ~ArchetypeStorage();
+
+    void Add(GameObject* gameObject);
+    void Remove(GameObject* gameObject);
+
+    // 全GameObjectの登録を解除（シーン破棄時用）
+    void Clear();
+
+    // GameObjectのコンポーネント構成が変わった時に呼ばれる
+    void OnComponentsChanged(GameObject* gameObject);
+
+    uint32 GetEntityCount() const { return entityCount_; }
+    const std::vector<UniquePtr<Archetype>>& GetArchetypes() const { return archetypes_; }
+
+    // 複数のシステムから同時に呼んでよい（構成の変更とは同時に呼ばないこと）
+    template<typename... Ts>
+    ArchetypeQuery<Ts...> Query() const;
+
+private:
+    template<typename... Ts>
+    static uint32 GetQueryId() {
+        static const uint32 id = AllocateQueryId();
+        return id;
+    }
+    static uint32 AllocateQueryId();
+
+    const QueryCache& GetQueryCache(uint32 queryId, std::vector<ComponentTypeId> (*getTypes)()) const;
+
+    Archetype* GetOrCreateArchetype(const std::vector<ComponentTypeId>& types);
+
+    // 行の追加（列はGameObjectの検索表から埋める）と、末尾との入れ替えによる削除
+    void AppendRow(Archetype* archetype, GameObject* gameObject);
+    void RemoveRow(Archetype* archetype, uint32 row);
+
+    std::vector<UniquePtr<Archetype>> archetypes_;
+    std::map<std::vector<ComponentTypeId>, Archetype*> archetypeLookup_;
+    std::vector<ComponentTypeId> typeScratch_;
+    uint32 entityCount_ = 0;
+
+    // クエリIDで引くキャッシュ（初回のクエリ時に作成するため、作成だけはロックする）
+    mutable std::vector<UniquePtr<QueryCache>> queryCaches_;
+    mutable std::mutex queryCacheMutex_;
+};
+
+template<typename... Ts>
+ArchetypeQuery<Ts...> ArchetypeStorage::Query() const {
+#ifdef _DEBUG
+    (SystemAccess::ValidateComponentAccess<Ts>(), ...);
+#endif
+
+    // const付きの型（読み取りのみ）も同じキャッシュを使う
+    return ArchetypeQuery<Ts...>(GetQueryCache(GetQueryId<std::remove_const_t<Ts>...>(), &ArchetypeQuery<Ts...>::GetTypes));
+}
+
+} // namespace UnoEngine
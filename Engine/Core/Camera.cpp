@@ -53,7 +53,6 @@ void Camera::SetOrthographic(float width, float height, float nearZ, float farZ)
 
 void Camera::SetTarget(const Vector3& target) {
     Vector3 direction = (target - position_).Normalize();
-    Vector3 up = Vector3::UnitY();
 
     // 前方向からクォータニオンを計算
     // 簡易実装: LookAt風の回転を設定
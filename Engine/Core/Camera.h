@@ -48,6 +48,9 @@ public:
     float GetFarClip() const { return farZ_; }
     float GetAspectRatio() const { return aspect_; }
     float GetFieldOfView() const { return fovY_; }
+    ProjectionType GetProjectionType() const { return projectionType_; }
+    float GetOrthographicWidth() const { return width_; }
+    float GetOrthographicHeight() const { return height_; }
 
 private:
     // トランスフォーム
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Types.h"
+#include "PoolAllocator.h"
+#include <new>
 
 namespace UnoEngine {
 
@@ -11,6 +13,12 @@ public:
     Component() = default;
     virtual ~Component() = default;
 
+    // 派生クラスのサイズごとのプールから確保する（仮想デストラクタ経由で実際のサイズがdeleteに渡る）
+    static void* operator new(size_t size) { return PoolAllocator::Allocate(size); }
+    static void operator delete(void* ptr, size_t size) { PoolAllocator::Deallocate(ptr, size); }
+    static void* operator new(size_t size, std::align_val_t alignment) { return ::operator new(size, alignment); }
+    static void operator delete(void* ptr, size_t size, std::align_val_t alignment) { ::operator delete(ptr, size, alignment); }
+
     // Lifecycle methods (Unity-style)
     virtual void Awake() {}                      // Called immediately after AddComponent
     virtual void Start() {}                      // Called once before first Update (after all Awake)
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Types.h"
+#include <atomic>
+
+namespace UnoEngine {
+
+using ComponentTypeId = uint32;
+
+// コンポーネント型ごとの連番ID
+// 型の初回使用時に採番する。std::type_indexのハッシュ検索を避け、整数比較で型を判定するために使う
+namespace ComponentType {
+
+constexpr ComponentTypeId INVALID_ID = 0xFFFFFFFF;
+
+inline ComponentTypeId AllocateId() {
+    static std::atomic<ComponentTypeId> nextId{ 0 };
+    return nextId.fetch_add(1, std::memory_order_relaxed);
+}
+
+template<typename T>
+ComponentTypeId GetId() {
+    static const ComponentTypeId id = AllocateId();
+    return id;
+}
+
+} // namespace ComponentType
+
+} // namespace UnoEngine
@@ -1,12 +1,20 @@
 #include "GameObject.h"
+#include "ArchetypeStorage.h"
+#include <algorithm>
 
 namespace UnoEngine {
 
+static_assert(alignof(GameObject) <= PoolAllocator::ALIGNMENT, "GameObject must fit the pool block alignment");
+
 GameObject::GameObject(const std::string& name)
     : name_(name) {
 }
 
 GameObject::~GameObject() {
+    if (storage_) {
+        storage_->Remove(this);
+    }
+
     // Call OnDestroy for all components before destruction
     for (auto& component : components_) {
         component->OnDestroy();
@@ -23,4 +31,39 @@ void GameObject::OnUpdate(float deltaTime) {
     }
 }
 
+Component* GameObject::FindComponent(ComponentTypeId type) const {
+    for (const auto& entry : componentTable_) {
+        if (entry.type == type) return entry.component;
+    }
+    return nullptr;
+}
+
+void GameObject::SetComponentEntry(ComponentTypeId type, Component* component) {
+    auto it = std::lower_bound(componentTable_.begin(), componentTable_.end(), type,
+        [](const ComponentEntry& entry, ComponentTypeId value) { return entry.type < value; });
+
+    if (it != componentTable_.end() && it->type == type) {
+        // 同じ型を再追加した場合は検索先を新しい方に差し替える（従来と同じ挙動）
+        it->component = component;
+    } else {
+        componentTable_.insert(it, { type, component });
+    }
+
+    if (storage_) {
+        storage_->OnComponentsChanged(this);
+    }
+}
+
+void GameObject::RemoveComponentEntry(ComponentTypeId type) {
+    auto it = std::find_if(componentTable_.begin(), componentTable_.end(),
+        [type](const ComponentEntry& entry) { return entry.type == type; });
+    if (it == componentTable_.end()) return;
+
+    componentTable_.erase(it);
+
+    if (storage_) {
+        storage_->OnComponentsChanged(this);
+    }
+}
+
 } // namespace UnoEngine
@@ -1,16 +1,22 @@
 #pragma once
 
 #include "Component.h"
+#include "ComponentType.h"
+#include "GameObjectHandle.h"
+#include "PoolAllocator.h"
 #include "Transform.h"
 #include "Types.h"
+#include "../Systems/SystemAccess.h"
 #include <vector>
 #include <memory>
 #include <string>
 #include <typeindex>
-#include <unordered_map>
 
 namespace UnoEngine {
 
+class Archetype;
+class ArchetypeStorage;
+
 /// レイヤー定義
 /// GameObjectをグループ化し、レンダリングやコリジョン判定の対象を制御
 namespace Layers {
@@ -36,11 +42,16 @@ public:
     GameObject(const std::string& name = "GameObject");
     ~GameObject();
 
+    // 大量の生成・破棄でヒープが断片化しないよう、専用のプールから確保する
+    static void* operator new(size_t size) { return PoolAllocator::Allocate(size); }
+    static void operator delete(void* ptr, size_t size) { PoolAllocator::Deallocate(ptr, size); }
+
     void OnUpdate(float deltaTime);
 
     template<typename T, typename... Args>
     T* AddComponent(Args&&... args);
 
+    // 読み取るだけならGetComponent<const T>()で取得する（システムのRead宣言で足りる）
     template<typename T>
     T* GetComponent() const;
 
@@ -67,11 +78,43 @@ public:
     const std::vector<std::unique_ptr<Component>>& GetComponents() const { return components_; }
     std::vector<std::unique_ptr<Component>>& GetComponents() { return components_; }
 
+    // 所属しているアーキタイプ（シーンに登録されていない場合はnullptr）
+    Archetype* GetArchetype() const { return archetype_; }
+
+    // シーン内でのハンドル（シーンに登録されていない場合はIsNull()）
+    GameObjectHandle GetHandle() const { return handle_; }
+
+    // Scene::DestroyGameObject済みで、フレーム末の破棄を待っている
+    bool IsPendingDestroy() const { return pendingDestroy_; }
+
 private:
+    friend class ArchetypeStorage;
+    friend class Scene;
+
+    // 型IDからの検索表（型IDの昇順、コンポーネント数は少ないため線形探索）
+    struct ComponentEntry {
+        ComponentTypeId type;
+        Component* component;
+    };
+
+    Component* FindComponent(ComponentTypeId type) const;
+    void SetComponentEntry(ComponentTypeId type, Component* component);
+    void RemoveComponentEntry(ComponentTypeId type);
+
     std::string name_;
     Transform transform_;
     std::vector<std::unique_ptr<Component>> components_;
-    std::unordered_map<std::type_index, Component*> componentMap_;
+    std::vector<ComponentEntry> componentTable_;
+
+    // シーンのアーキタイプストレージ上の位置（ArchetypeStorageが管理）
+    ArchetypeStorage* storage_ = nullptr;
+    Archetype* archetype_ = nullptr;
+    uint32 archetypeRow_ = 0;
+
+    // シーンのスロット表上の位置（Sceneが管理）
+    GameObjectHandle handle_;
+    bool pendingDestroy_ = false;
+
     bool isActive_ = true;
     Layer layer_ = Layers::DEFAULT;
     bool isDeletable_ = true;  // デフォルトは削除可能
@@ -85,8 +128,8 @@ T* GameObject::AddComponent(Args&&... args) {
     T* ptr = component.get();
     ptr->gameObject_ = this;
 
-    componentMap_[std::type_index(typeid(T))] = ptr;
     components_.push_back(std::move(component));
+    SetComponentEntry(ComponentType::GetId<T>(), ptr);
 
     // Call Awake immediately after adding
     ptr->Awake();
@@ -99,27 +142,25 @@ template<typename T>
 T* GameObject::GetComponent() const {
     static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
 
-    auto it = componentMap_.find(std::type_index(typeid(T)));
-    if (it != componentMap_.end()) {
-        return static_cast<T*>(it->second);
-    }
-    return nullptr;
+#ifdef _DEBUG
+    SystemAccess::ValidateComponentAccess<T>();
+#endif
+
+    return static_cast<T*>(FindComponent(ComponentType::GetId<std::remove_const_t<T>>()));
 }
 
 template<typename T>
 void GameObject::RemoveComponent() {
     static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
 
-    auto typeIndex = std::type_index(typeid(T));
-    auto mapIt = componentMap_.find(typeIndex);
-    if (mapIt == componentMap_.end()) return;
+    const ComponentTypeId type = ComponentType::GetId<T>();
+    Component* compPtr = FindComponent(type);
+    if (!compPtr) return;
 
-    Component* compPtr = mapIt->second;
-    
     // Call OnDestroy before removing
     compPtr->OnDestroy();
     
-    componentMap_.erase(mapIt);
+    RemoveComponentEntry(type);
 
     components_.erase(
         std::remove_if(components_.begin(), components_.end(),
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Types.h"
+
+namespace UnoEngine {
+
+// GameObjectを指す世代付きハンドル
+// スロット番号と世代の組で、GameObjectの破棄後にスロットが再利用されても古いハンドルは無効と判定できる
+// Scene::Resolveで実体を取得する（破棄済みならnullptr）
+struct GameObjectHandle {
+    static constexpr uint32 INVALID_INDEX = 0xFFFFFFFF;
+
+    uint32 index = INVALID_INDEX;
+    uint32 generation = 0;
+
+    bool IsNull() const { return index == INVALID_INDEX; }
+
+    bool operator==(const GameObjectHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const GameObjectHandle& other) const { return !(*this == other); }
+};
+
+} // namespace UnoEngine
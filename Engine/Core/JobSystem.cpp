@@ -0,0 +1,192 @@
+#include "JobSystem.h"
+#include "Logger.h"
+#include <algorithm>
+
+namespace UnoEngine {
+
+namespace {
+
+// ワーカースレッドが属するジョブシステムとキュー番号
+thread_local const JobSystem* t_ownerSystem = nullptr;
+thread_local uint32 t_queueIndex = 0;
+
+} // namespace
+
+JobSystem::~JobSystem() {
+    Shutdown();
+}
+
+void JobSystem::Initialize(uint32 workerCount) {
+    Shutdown();
+
+    if (workerCount == 0) {
+        const uint32 hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    queues_.clear();
+    for (uint32 i = 0; i < workerCount + 1; ++i) {
+        queues_.push_back(MakeUnique<WorkQueue>());
+    }
+
+    stopping_ = false;
+    workers_.reserve(workerCount);
+    for (uint32 i = 0; i < workerCount; ++i) {
+        workers_.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+    }
+
+    Logger::Info("[JobSystem] ワーカースレッド {}個で初期化", workerCount);
+}
+
+void JobSystem::Shutdown() {
+    if (workers_.empty()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    wakeCondition_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+}
+
+void JobSystem::Run(JobFunction job, JobCounter* counter) {
+    if (counter) {
+        counter->pending_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Job entry;
+    entry.function = std::move(job);
+    entry.counter = counter;
+#ifdef _DEBUG
+    entry.validation = SystemAccess::GetCurrentValidation();
+#endif
+    if (workers_.empty()) {
+        Execute(entry);
+        return;
+    }
+
+    const uint32 queueIndex = GetQueueIndex();
+    {
+        std::lock_guard<std::mutex> lock(queues_[queueIndex]->mutex);
+        queues_[queueIndex]->jobs.push_back(std::move(entry));
+    }
+    queuedJobs_.fetch_add(1, std::memory_order_release);
+
+    // 待機判定とnotifyの間に割り込まれないよう、一度ロックを通してから起こす
+    { std::lock_guard<std::mutex> lock(sleepMutex_); }
+    wakeCondition_.notify_one();
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+    const uint32 queueIndex = GetQueueIndex();
+    while (!counter.IsDone()) {
+        if (!TryRunJob(queueIndex)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::ParallelFor(uint32 count, uint32 grainSize, const RangeFunction& func) {
+    if (count == 0) return;
+    grainSize = (std::max)(grainSize, 1u);
+    const uint32 chunkCount = (count + grainSize - 1) / grainSize;
+
+    if (workers_.empty() || chunkCount == 1) {
+        func(0, count);
+        return;
+    }
+
+    // チャンクは各ジョブが共有カウンタから取り合う（処理の速いスレッドが多く取る）
+    std::atomic<uint32> nextChunk{ 0 };
+    auto runChunks = [&nextChunk, &func, count, grainSize, chunkCount]() {
+        for (;;) {
+            const uint32 chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunkCount) break;
+            const uint32 begin = chunk * grainSize;
+            const uint32 end = (std::min)(count, begin + grainSize);
+            func(begin, end);
+        }
+    };
+
+    JobCounter counter;
+    const uint32 helperCount = (std::min)(chunkCount, GetThreadCount()) - 1;
+    for (uint32 i = 0; i < helperCount; ++i) {
+        Run(runChunks, &counter);
+    }
+
+    runChunks();
+    Wait(counter);
+}
+
+uint32 JobSystem::GetQueueIndex() const {
+    return t_ownerSystem == this ? t_queueIndex : 0;
+}
+
+bool JobSystem::TryRunJob(uint32 queueIndex) {
+    Job job;
+    if (!PopJob(queueIndex, job) && !StealJob(queueIndex, job)) {
+        return false;
+    }
+    Execute(job);
+    return true;
+}
+
+bool JobSystem::PopJob(uint32 queueIndex, Job& job) {
+    WorkQueue& queue = *queues_[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) return false;
+
+    job = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    queuedJobs_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobSystem::StealJob(uint32 thiefIndex, Job& job) {
+    const uint32 queueCount = static_cast<uint32>(queues_.size());
+    for (uint32 offset = 1; offset < queueCount; ++offset) {
+        WorkQueue& queue = *queues_[(thiefIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) continue;
+
+        job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        queuedJobs_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Execute(Job& job) {
+#ifdef _DEBUG
+    // Waitの中で他のシステムのジョブを盗んで実行しても、そのジョブを投入したシステムの宣言で検査する
+    SystemAccess::ValidationScope scope(job.validation);
+#endif
+    job.function();
+    if (job.counter) {
+        job.counter->pending_.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void JobSystem::WorkerLoop(uint32 queueIndex) {
+    t_ownerSystem = this;
+    t_queueIndex = queueIndex;
+
+    for (;;) {
+        if (TryRunJob(queueIndex)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wakeCondition_.wait(lock, [this] {
+            return stopping_ || queuedJobs_.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping_ && queuedJobs_.load(std::memory_order_acquire) == 0) break;
+    }
+
+    t_ownerSystem = nullptr;
+}
+
+} // namespace UnoEngine
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Types.h"
+#include "NonCopyable.h"
+#include "../Systems/SystemAccess.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace UnoEngine {
+
+// ジョブの完了待ちに使うカウンタ（フェンス）
+// Runに渡すたびに1増え、ジョブの完了ごとに1減る。JobSystem::Waitで0になるまで待つ
+class JobCounter : public NonCopyable {
+public:
+    bool IsDone() const { return pending_.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<uint32> pending_{ 0 };
+};
+
+// ワークスティーリング方式のジョブシステム
+//
+// スレッドごとにジョブキューを持ち、自スレッドのキューは末尾から（LIFO）、
+// 空になったら他スレッドのキューの先頭から盗んで実行する
+// Waitで待つスレッドも待っている間は他のジョブを処理するため、ジョブ内からのRun/Wait/ParallelForも可能
+class JobSystem : public NonCopyable {
+public:
+    using JobFunction = std::function<void()>;
+    using RangeFunction = std::function<void(uint32 begin, uint32 end)>;
+
+    JobSystem() = default;
+    ~JobSystem();
+
+    // workerCount = 0 の場合はハードウェアスレッド数 - 1（メインスレッド分）
+    void Initialize(uint32 workerCount = 0);
+    // キューに残っているジョブを処理してからワーカーを停止する
+    void Shutdown();
+
+    uint32 GetWorkerCount() const { return static_cast<uint32>(workers_.size()); }
+    // ジョブを実行し得るスレッド数（ワーカー + 呼び出しスレッド）
+    uint32 GetThreadCount() const { return GetWorkerCount() + 1; }
+
+    // ジョブを投入（counterを指定した場合はWaitで完了を待てる）
+    // ワーカーがいない場合はその場で実行する
+    void Run(JobFunction job, JobCounter* counter = nullptr);
+
+    // counterが0になるまで、他のジョブを処理しながら待つ
+    void Wait(JobCounter& counter);
+
+    // [0, count) を grainSize 個ずつのチャンクに分けて並列実行（fork/join）
+    // 呼び出しスレッドも処理に参加し、全チャンクの完了まで戻らない
+    void ParallelFor(uint32 count, uint32 grainSize, const RangeFunction& func);
+
+private:
+    struct Job {
+        JobFunction function;
+        JobCounter* counter = nullptr;
+#ifdef _DEBUG
+        SystemAccess::ValidationState validation;  // 投入したシステムの宣言（実行中だけ設定し直す）
+#endif
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    // 呼び出しスレッドのキュー番号（ワーカー以外のスレッドは0番を共有する）
+    uint32 GetQueueIndex() const;
+
+    // 自キューの末尾、なければ他キューの先頭から1つ取り出して実行
+    bool TryRunJob(uint32 queueIndex);
+    bool PopJob(uint32 queueIndex, Job& job);
+    bool StealJob(uint32 thiefIndex, Job& job);
+    void Execute(Job& job);
+
+    void WorkerLoop(uint32 queueIndex);
+
+    std::vector<UniquePtr<WorkQueue>> queues_;  // [0]はメインスレッド用、[1..]は各ワーカー用
+    std::vector<std::thread> workers_;
+    std::atomic<uint32> queuedJobs_{ 0 };       // キューに積まれている未取得のジョブ数
+
+    std::mutex sleepMutex_;
+    std::condition_variable wakeCondition_;
+    bool stopping_ = false;  // sleepMutex_で保護
+};
+
+} // namespace UnoEngine
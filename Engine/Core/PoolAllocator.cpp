@@ -0,0 +1,165 @@
+#include "PoolAllocator.h"
+#include "Logger.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <new>
+
+namespace UnoEngine {
+
+namespace {
+
+// 1チャンクの目安サイズ（小さいブロックでもチャンク確保の回数が増えすぎないようにする）
+constexpr size_t CHUNK_BYTES = 64 * 1024;
+constexpr uint32 MIN_BLOCKS_PER_CHUNK = 16;
+
+constexpr size_t SIZE_CLASS_COUNT = PoolAllocator::MAX_POOLED_SIZE / PoolAllocator::ALIGNMENT;
+
+std::atomic<uint64> g_allocations{ 0 };
+std::atomic<uint64> g_chunkAllocations{ 0 };
+
+size_t GetSizeClass(size_t size) {
+    return (std::max<size_t>(size, 1) - 1) / PoolAllocator::ALIGNMENT;
+}
+
+// サイズクラスごとのプール
+// チャンクは初回のAllocateまで確保しないため、全サイズクラス分を先に作っておく（取得時にロック不要）
+struct PoolTable {
+    std::array<UniquePtr<FixedBlockPool>, SIZE_CLASS_COUNT> pools;
+
+    PoolTable() {
+        for (size_t i = 0; i < SIZE_CLASS_COUNT; ++i) {
+            pools[i] = MakeUnique<FixedBlockPool>((i + 1) * PoolAllocator::ALIGNMENT);
+        }
+    }
+
+    FixedBlockPool& Get(size_t sizeClass) { return *pools[sizeClass]; }
+};
+
+PoolTable& GetPoolTable() {
+    static PoolTable table;
+    return table;
+}
+
+} // namespace
+
+FixedBlockPool::FixedBlockPool(size_t blockSize)
+    : blockSize_((std::max)(blockSize, sizeof(FreeBlock)))
+    , blocksPerChunk_((std::max)(static_cast<uint32>(CHUNK_BYTES / blockSize_), MIN_BLOCKS_PER_CHUNK)) {
+    assert(blockSize_ % PoolAllocator::ALIGNMENT == 0);
+}
+
+FixedBlockPool::~FixedBlockPool() {
+    for (void* chunk : chunks_) {
+        ::operator delete(chunk, std::align_val_t{ PoolAllocator::ALIGNMENT });
+    }
+}
+
+void* FixedBlockPool::Allocate() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!freeList_) {
+        AllocateChunk();
+    }
+
+    FreeBlock* block = freeList_;
+    freeList_ = block->next;
+    ++liveBlocks_;
+    return block;
+}
+
+void FixedBlockPool::Deallocate(void* block) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    assert(liveBlocks_ > 0);
+
+    FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = freeList_;
+    freeList_ = freeBlock;
+    --liveBlocks_;
+}
+
+bool FixedBlockPool::ReleaseIfUnused() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (liveBlocks_ > 0 || chunks_.empty()) return false;
+
+    for (void* chunk : chunks_) {
+        ::operator delete(chunk, std::align_val_t{ PoolAllocator::ALIGNMENT });
+    }
+    chunks_.clear();
+    freeList_ = nullptr;
+    return true;
+}
+
+uint32 FixedBlockPool::GetLiveBlockCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return liveBlocks_;
+}
+
+size_t FixedBlockPool::GetReservedBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return chunks_.size() * blocksPerChunk_ * blockSize_;
+}
+
+void FixedBlockPool::AllocateChunk() {
+    char* chunk = static_cast<char*>(::operator new(blocksPerChunk_ * blockSize_, std::align_val_t{ PoolAllocator::ALIGNMENT }));
+    chunks_.push_back(chunk);
+    g_chunkAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    // アドレス順に取り出されるよう、末尾のブロックから積む
+    for (uint32 i = blocksPerChunk_; i-- > 0;) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * blockSize_);
+        block->next = freeList_;
+        freeList_ = block;
+    }
+}
+
+namespace PoolAllocator {
+
+void* Allocate(size_t size) {
+    if (size > MAX_POOLED_SIZE) {
+        return ::operator new(size, std::align_val_t{ ALIGNMENT });
+    }
+
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return GetPoolTable().Get(GetSizeClass(size)).Allocate();
+}
+
+void Deallocate(void* ptr, size_t size) {
+    if (!ptr) return;
+
+    if (size > MAX_POOLED_SIZE) {
+        ::operator delete(ptr, std::align_val_t{ ALIGNMENT });
+        return;
+    }
+
+    GetPoolTable().Get(GetSizeClass(size)).Deallocate(ptr);
+}
+
+void ReleaseUnusedMemory() {
+    size_t releasedBytes = 0;
+    for (auto& pool : GetPoolTable().pools) {
+        const size_t reserved = pool->GetReservedBytes();
+        if (pool->ReleaseIfUnused()) {
+            releasedBytes += reserved;
+        }
+    }
+
+    if (releasedBytes > 0) {
+        Logger::Info("[PoolAllocator] 未使用のチャンクを解放: {} KB", releasedBytes / 1024);
+    }
+}
+
+Stats GetStats() {
+    Stats stats;
+    stats.allocations = g_allocations.load(std::memory_order_relaxed);
+    stats.chunkAllocations = g_chunkAllocations.load(std::memory_order_relaxed);
+    for (const auto& pool : GetPoolTable().pools) {
+        stats.liveBlocks += pool->GetLiveBlockCount();
+        stats.reservedBytes += pool->GetReservedBytes();
+    }
+    return stats;
+}
+
+} // namespace PoolAllocator
+
+} // namespace UnoEngine
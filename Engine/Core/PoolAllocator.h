@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Types.h"
+#include "NonCopyable.h"
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace UnoEngine {
+
+// 固定サイズブロックのプール
+// チャンク単位でまとめて確保し、解放されたブロックはフリーリストで再利用する
+class FixedBlockPool : public NonCopyable {
+public:
+    explicit FixedBlockPool(size_t blockSize);
+    ~FixedBlockPool();
+
+    void* Allocate();
+    void Deallocate(void* block);
+
+    // 使用中のブロックが無ければチャンクをすべて解放する
+    bool ReleaseIfUnused();
+
+    size_t GetBlockSize() const { return blockSize_; }
+    uint32 GetLiveBlockCount() const;
+    size_t GetReservedBytes() const;
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    void AllocateChunk();
+
+    size_t blockSize_;
+    uint32 blocksPerChunk_;
+    std::vector<void*> chunks_;
+    FreeBlock* freeList_ = nullptr;
+    uint32 liveBlocks_ = 0;
+    mutable std::mutex mutex_;
+};
+
+// GameObjectとComponentのメモリ確保
+// サイズクラス（ALIGNMENT刻み）ごとのFixedBlockPoolから切り出すため、
+// 同じ型のオブジェクトを大量に生成・破棄してもヒープの断片化やロック競合が起きにくい
+// MAX_POOLED_SIZEを超えるサイズは通常のoperator newを使う
+namespace PoolAllocator {
+
+constexpr size_t ALIGNMENT = 16;
+constexpr size_t MAX_POOLED_SIZE = 1024;
+
+void* Allocate(size_t size);
+void Deallocate(void* ptr, size_t size);
+
+// 使用中のブロックが無いサイズクラスのチャンクを解放する（シーンのアンロード時に呼ぶ）
+void ReleaseUnusedMemory();
+
+struct Stats {
+    uint64 allocations = 0;       // Allocateの累計
+    uint64 chunkAllocations = 0;  // ヒープからのチャンク確保の累計
+    uint32 liveBlocks = 0;        // 使用中のブロック数
+    size_t reservedBytes = 0;     // 確保済みチャンクの合計サイズ
+};
+Stats GetStats();
+
+} // namespace PoolAllocator
+
+} // namespace UnoEngine
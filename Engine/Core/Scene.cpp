@@ -1,6 +1,7 @@
 #include "Scene.h"
 #include "Component.h"
 #include <algorithm>
+#include <cassert>
 
 namespace UnoEngine {
 
@@ -8,6 +9,14 @@ Scene::Scene(const std::string& name)
     : name_(name) {
 }
 
+Scene::~Scene() {
+    // GameObjectの破棄順序に依存しないよう、先に親子リンクとストアへの登録を解除する
+    transformHierarchy_.Clear();
+    componentStorage_.Clear();
+    spatialIndex_.Clear();
+    ClearGameObjects();
+}
+
 void Scene::OnUpdate(float deltaTime) {
     // Process pending Start() calls before Update
     ProcessPendingStarts();
@@ -18,31 +27,110 @@ void Scene::OnUpdate(float deltaTime) {
     }
 
     // Destroy pending objects
-    if (!pendingDestroy_.empty()) {
-        for (GameObject* obj : pendingDestroy_) {
-            gameObjects_.erase(
-                std::remove_if(gameObjects_.begin(), gameObjects_.end(),
-                    [obj](const std::unique_ptr<GameObject>& go) {
-                        return go.get() == obj;
-                    }),
-                gameObjects_.end()
-            );
-        }
-        pendingDestroy_.clear();
-    }
+    FlushDestroyedGameObjects();
 }
 
 GameObject* Scene::CreateGameObject(const std::string& name) {
-    auto obj = std::make_unique<GameObject>(name);
+    return AddGameObject(std::make_unique<GameObject>(name));
+}
+
+GameObject* Scene::AddGameObject(std::unique_ptr<GameObject> obj) {
+    assert(obj && obj->GetHandle().IsNull() && "GameObject already belongs to a scene");
+
     GameObject* ptr = obj.get();
+
+    uint32 slotIndex;
+    if (!freeSlots_.empty()) {
+        slotIndex = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        slotIndex = static_cast<uint32>(slots_.size());
+        slots_.emplace_back();
+    }
+    slots_[slotIndex].denseIndex = static_cast<uint32>(gameObjects_.size());
+    ptr->handle_ = { slotIndex, slots_[slotIndex].generation };
+
+    transformHierarchy_.Register(&ptr->GetTransform());
+    componentStorage_.Add(ptr);
+    spatialIndex_.Add(ptr);
     gameObjects_.push_back(std::move(obj));
     return ptr;
 }
 
 void Scene::DestroyGameObject(GameObject* obj) {
+    // 破棄済み・他シーンのオブジェクトは無視する
+    if (!obj || obj->pendingDestroy_ || Resolve(obj->GetHandle()) != obj) return;
+
+    obj->pendingDestroy_ = true;
     pendingDestroy_.push_back(obj);
 }
 
+void Scene::DestroyGameObject(GameObjectHandle handle) {
+    DestroyGameObject(Resolve(handle));
+}
+
+void Scene::ClearGameObjects() {
+    // 先にスロットを無効化してから破棄する（OnDestroy内からのDestroyGameObjectは無視される）
+    std::vector<std::unique_ptr<GameObject>> destroying = std::move(gameObjects_);
+    gameObjects_.clear();
+    spatialIndex_.Clear();
+
+    // 世代は残し、既存のハンドルがすべて無効になるようにする
+    freeSlots_.clear();
+    for (uint32 i = static_cast<uint32>(slots_.size()); i-- > 0;) {
+        if (slots_[i].denseIndex != GameObjectHandle::INVALID_INDEX) {
+            slots_[i].denseIndex = GameObjectHandle::INVALID_INDEX;
+            ++slots_[i].generation;
+        }
+        freeSlots_.push_back(i);
+    }
+
+    destroying.clear();
+    pendingDestroy_.clear();
+}
+
+GameObject* Scene::Resolve(GameObjectHandle handle) const {
+    if (handle.index >= slots_.size()) return nullptr;
+
+    const GameObjectSlot& slot = slots_[handle.index];
+    if (slot.generation != handle.generation || slot.denseIndex == GameObjectHandle::INVALID_INDEX) {
+        return nullptr;
+    }
+    return gameObjects_[slot.denseIndex].get();
+}
+
+void Scene::FlushDestroyedGameObjects() {
+    // 1オブジェクトあたりO(1)（末尾の要素を空いた位置へ移してから取り除く）
+    // 破棄中のOnDestroyから追加で予約されても処理できるよう、空になるまで末尾から取り出す
+    while (!pendingDestroy_.empty()) {
+        GameObject* obj = pendingDestroy_.back();
+        pendingDestroy_.pop_back();
+        spatialIndex_.Remove(obj);
+
+        GameObjectSlot& slot = slots_[obj->handle_.index];
+        const uint32 denseIndex = slot.denseIndex;
+        const uint32 lastIndex = static_cast<uint32>(gameObjects_.size()) - 1;
+
+        if (denseIndex != lastIndex) {
+            std::swap(gameObjects_[denseIndex], gameObjects_[lastIndex]);
+            slots_[gameObjects_[denseIndex]->handle_.index].denseIndex = denseIndex;
+        }
+
+        slot.denseIndex = GameObjectHandle::INVALID_INDEX;
+        ++slot.generation;
+        freeSlots_.push_back(obj->handle_.index);
+
+        // 配列から外してから破棄する（OnDestroy内でGameObjectが追加されても配列を壊さない）
+        std::unique_ptr<GameObject> destroying = std::move(gameObjects_.back());
+        gameObjects_.pop_back();
+    }
+}
+
+void Scene::UpdateTransforms(JobSystem* jobSystem) {
+    transformHierarchy_.UpdateWorldMatrices(jobSystem);
+    spatialIndex_.Update(transformHierarchy_);
+}
+
 void Scene::ProcessPendingStarts() {
     // Call Start() on components that have been Awake'd but not Started
     for (auto& obj : gameObjects_) {
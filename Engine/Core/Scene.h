@@ -2,6 +2,9 @@
 
 #include "GameObject.h"
 #include "Camera.h"
+#include "TransformHierarchy.h"
+#include "ArchetypeStorage.h"
+#include "SpatialIndex.h"
 #include "../Rendering/RenderView.h"
 #include <vector>
 #include <memory>
@@ -11,11 +14,12 @@ namespace UnoEngine {
 
 class Application;
 class InputManager;
+class JobSystem;
 
 class Scene {
 public:
     Scene(const std::string& name = "Scene");
-    virtual ~Scene() = default;
+    virtual ~Scene();
 
     virtual void OnLoad() {}
     virtual void OnUnload() {}
@@ -24,11 +28,24 @@ public:
     virtual void OnImGui() {}
 
     GameObject* CreateGameObject(const std::string& name = "GameObject");
+
+    // シーン外で生成したGameObjectを追加（エディタ・シリアライザ用）
+    GameObject* AddGameObject(std::unique_ptr<GameObject> obj);
+
+    // 破棄の予約（フレーム末のOnUpdate内でまとめて破棄する。同じオブジェクトを複数回指定してもよい）
     void DestroyGameObject(GameObject* obj);
+    void DestroyGameObject(GameObjectHandle handle);
+
+    // 全GameObjectを即座に破棄（シーンの再ロード用）
+    void ClearGameObjects();
+
+    // ハンドルから実体を取得（破棄済み・無効なハンドルはnullptr）
+    GameObject* Resolve(GameObjectHandle handle) const;
+    bool IsValid(GameObjectHandle handle) const { return Resolve(handle) != nullptr; }
 
     const std::string& GetName() const { return name_; }
+    // 並び順は破棄のたびに変わる（末尾の要素が破棄された位置へ移動する）
     const std::vector<std::unique_ptr<GameObject>>& GetGameObjects() const { return gameObjects_; }
-    std::vector<std::unique_ptr<GameObject>>& GetGameObjects() { return gameObjects_; }
 
     Camera* GetActiveCamera() const { return activeCamera_; }
     void SetActiveCamera(Camera* camera) { activeCamera_ = camera; }
@@ -38,6 +55,20 @@ public:
     
     void SetInputManager(InputManager* input) { input_ = input; }
 
+    TransformHierarchy& GetTransformHierarchy() { return transformHierarchy_; }
+    // ワールド空間の境界による検索（視錐台・レイ・範囲・最近傍）。UpdateTransformsの後の位置を反映している
+    SpatialIndex& GetSpatialIndex() { return spatialIndex_; }
+    const SpatialIndex& GetSpatialIndex() const { return spatialIndex_; }
+    const ArchetypeStorage& GetComponentStorage() const { return componentStorage_; }
+
+    // 指定したコンポーネントをすべて持つGameObjectを列挙
+    // 全GameObjectを走査してGetComponentする代わりに、該当するアーキタイプの配列だけを読む
+    template<typename... Ts>
+    ArchetypeQuery<Ts...> Query() const { return componentStorage_.Query<Ts...>(); }
+
+    // ワールド行列を一括更新し、動いた物体の空間インデックスを更新（Applicationが描画前に毎フレーム呼ぶ）
+    void UpdateTransforms(JobSystem* jobSystem = nullptr);
+
     // Call Start() on a specific GameObject's components (useful for runtime-created objects)
     void StartGameObject(GameObject* obj);
 
@@ -48,8 +79,22 @@ protected:
     void ProcessPendingStarts();
 
 private:
+    // 破棄予約されたGameObjectを末尾との入れ替えでまとめて取り除く
+    void FlushDestroyedGameObjects();
+
+    // スロット表（handle.index で引き、denseIndex が gameObjects_ 上の位置）
+    struct GameObjectSlot {
+        uint32 generation = 0;
+        uint32 denseIndex = GameObjectHandle::INVALID_INDEX;  // 空きスロットはINVALID_INDEX
+    };
+
     std::string name_;
+    TransformHierarchy transformHierarchy_;  // gameObjects_より先に宣言（GameObjectより後に破棄される）
+    ArchetypeStorage componentStorage_;      // 同上
+    SpatialIndex spatialIndex_;              // 同上
     std::vector<std::unique_ptr<GameObject>> gameObjects_;
+    std::vector<GameObjectSlot> slots_;
+    std::vector<uint32> freeSlots_;
     std::vector<GameObject*> pendingDestroy_;
     Camera* activeCamera_ = nullptr;
     Application* app_ = nullptr;
@@ -1,5 +1,6 @@
 #include "SceneManager.h"
 #include "Application.h"
+#include "PoolAllocator.h"
 
 namespace UnoEngine {
 
@@ -12,6 +13,10 @@ void SceneManager::Update(float deltaTime) {
 void SceneManager::LoadScene(std::unique_ptr<Scene> scene) {
     if (activeScene_) {
         activeScene_->OnUnload();
+        activeScene_.reset();
+
+        // 旧シーンのGameObject・Componentはすべて破棄済みなので、空になったプールのチャンクを返す
+        PoolAllocator::ReleaseUnusedMemory();
     }
 
     activeScene_ = std::move(scene);
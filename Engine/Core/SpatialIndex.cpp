@@ -0,0 +1,202 @@
+#include "SpatialIndex.h"
+#include "GameObject.h"
+#include "TransformHierarchy.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace UnoEngine {
+
+void SpatialIndex::Add(GameObject* gameObject) {
+    assert(gameObject && slotByTransform_.find(&gameObject->GetTransform()) == slotByTransform_.end());
+
+    uint32 slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        slot = static_cast<uint32>(entries_.size());
+        entries_.emplace_back();
+    }
+
+    entries_[slot] = Entry();
+    entries_[slot].gameObject = gameObject;
+    slotByTransform_[&gameObject->GetTransform()] = slot;
+    QueueRefresh(slot);
+}
+
+void SpatialIndex::Remove(GameObject* gameObject) {
+    auto it = slotByTransform_.find(&gameObject->GetTransform());
+    if (it == slotByTransform_.end()) return;
+
+    const uint32 slot = it->second;
+    slotByTransform_.erase(it);
+
+    Entry& entry = entries_[slot];
+    if (entry.proxy != BoundingVolumeTree::NULL_NODE) {
+        tree_.DestroyProxy(entry.proxy);
+    }
+    // Update待ちのスロットはUpdateで空きに戻す（ここで戻すとpendingSlots_に残ったまま再利用されてしまう）
+    entry.gameObject = nullptr;
+    entry.proxy = BoundingVolumeTree::NULL_NODE;
+    if (!entry.pending) {
+        freeSlots_.push_back(slot);
+    }
+}
+
+void SpatialIndex::Clear() {
+    tree_.Clear();
+    entries_.clear();
+    freeSlots_.clear();
+    pendingSlots_.clear();
+    slotByTransform_.clear();
+}
+
+void SpatialIndex::MarkBoundsDirty(GameObject* gameObject) {
+    auto it = slotByTransform_.find(&gameObject->GetTransform());
+    if (it != slotByTransform_.end()) {
+        QueueRefresh(it->second);
+    }
+}
+
+void SpatialIndex::QueueRefresh(uint32 slot) {
+    if (!entries_[slot].pending) {
+        entries_[slot].pending = true;
+        pendingSlots_.push_back(slot);
+    }
+}
+
+void SpatialIndex::Update(const TransformHierarchy& hierarchy) {
+    hierarchy.ForEachUpdated([this](const Transform& transform) {
+        auto it = slotByTransform_.find(&transform);
+        if (it != slotByTransform_.end()) {
+            QueueRefresh(it->second);
+        }
+    });
+
+    uint32 insertedCount = 0;
+    for (uint32 slot : pendingSlots_) {
+        Entry& entry = entries_[slot];
+        entry.pending = false;
+        if (!entry.gameObject) {
+            // 待っている間に取り除かれた
+            freeSlots_.push_back(slot);
+            continue;
+        }
+        if (Refresh(slot)) {
+            ++insertedCount;
+        }
+    }
+    pendingSlots_.clear();
+
+    // 1つずつの挿入で作ったツリーは、まとめて作り直すより問い合わせが遅い
+    if (insertedCount >= REBUILD_MIN_INSERTS &&
+        insertedCount >= static_cast<uint32>(tree_.GetProxyCount() * REBUILD_INSERT_RATIO)) {
+        tree_.Rebuild();
+    }
+}
+
+bool SpatialIndex::Refresh(uint32 slot) {
+    Entry& entry = entries_[slot];
+    const Matrix4x4 worldMatrix = entry.gameObject->GetTransform().GetWorldMatrix();
+
+    BoundingBox localBounds = GetDefaultBounds();
+    float boundsScale = 1.0f;
+    entry.boundsToWorld = worldMatrix;
+
+    RendererBounds rendererBounds;
+    if (GetRendererBounds(*entry.gameObject, rendererBounds)) {
+        localBounds = rendererBounds.localBounds;
+        boundsScale = rendererBounds.scale;
+        entry.boundsToWorld = rendererBounds.modelCorrection * worldMatrix;
+    }
+
+    entry.localBounds = localBounds;
+    const Vector3 center = localBounds.GetCenter();
+    const Vector3 extents = localBounds.GetExtents() * boundsScale;
+    entry.worldBounds = BoundingBox(center - extents, center + extents).Transform(entry.boundsToWorld);
+
+    if (entry.proxy == BoundingVolumeTree::NULL_NODE) {
+        entry.proxy = tree_.CreateProxy(entry.worldBounds, slot);
+        return true;
+    }
+    tree_.MoveProxy(entry.proxy, entry.worldBounds);
+    return false;
+}
+
+void SpatialIndex::QueryFrustum(const Frustum& frustum, std::vector<GameObject*>& outObjects) const {
+    tree_.QueryFrustum(frustum, [&](int32 proxy) {
+        const Entry& entry = entries_[tree_.GetUserData(proxy)];
+        if (entry.gameObject->IsActive() && frustum.Intersects(entry.worldBounds)) {
+            outObjects.push_back(entry.gameObject);
+        }
+        return true;
+    });
+}
+
+void SpatialIndex::QueryOverlap(const BoundingBox& box, std::vector<GameObject*>& outObjects) const {
+    tree_.QueryOverlap(box, [&](int32 proxy) {
+        const Entry& entry = entries_[tree_.GetUserData(proxy)];
+        if (entry.gameObject->IsActive() && entry.worldBounds.Intersects(box)) {
+            outObjects.push_back(entry.gameObject);
+        }
+        return true;
+    });
+}
+
+GameObject* SpatialIndex::RayCast(const Vector3& origin, const Vector3& direction, float maxDistance,
+                                  float* outDistance) const {
+    GameObject* closest = nullptr;
+    float closestDistance = maxDistance;
+
+    tree_.RayCast(origin, direction, maxDistance, [&](int32 proxy, float currentMax) {
+        const Entry& entry = entries_[tree_.GetUserData(proxy)];
+        if (!entry.gameObject->IsActive()) return currentMax;
+
+        // レイを物体のローカル空間に移して回転に沿った箱と判定する
+        const Matrix4x4 worldToLocal = entry.boundsToWorld.Inverse();
+        const Vector3 localOrigin = worldToLocal.TransformPoint(origin);
+        const Vector3 localDirection = worldToLocal.TransformDirection(direction).Normalize();
+
+        float tMin, tMax;
+        if (!entry.localBounds.IntersectsRay(localOrigin, localDirection, tMin, tMax)) return currentMax;
+
+        const Vector3 hitPoint = entry.boundsToWorld.TransformPoint(localOrigin + localDirection * tMin);
+        const float distance = (hitPoint - origin).Length();
+        if (distance >= currentMax) return currentMax;
+
+        closest = entry.gameObject;
+        closestDistance = distance;
+        return distance;
+    });
+
+    if (closest && outDistance) {
+        *outDistance = closestDistance;
+    }
+    return closest;
+}
+
+GameObject* SpatialIndex::FindNearest(const Vector3& point, float maxDistance, float* outDistance) const {
+    float nearestDistanceSq = std::numeric_limits<float>::infinity();
+    const int32 proxy = tree_.FindNearest(point, maxDistance, [&](int32 candidate) {
+        const Entry& entry = entries_[tree_.GetUserData(candidate)];
+        if (!entry.gameObject->IsActive()) return std::numeric_limits<float>::infinity();
+
+        const Vector3 closest(
+            std::clamp(point.GetX(), entry.worldBounds.min.GetX(), entry.worldBounds.max.GetX()),
+            std::clamp(point.GetY(), entry.worldBounds.min.GetY(), entry.worldBounds.max.GetY()),
+            std::clamp(point.GetZ(), entry.worldBounds.min.GetZ(), entry.worldBounds.max.GetZ()));
+        const float distanceSq = (closest - point).LengthSq();
+        nearestDistanceSq = (std::min)(nearestDistanceSq, distanceSq);
+        return distanceSq;
+    });
+
+    if (proxy == BoundingVolumeTree::NULL_NODE) return nullptr;
+
+    if (outDistance) {
+        *outDistance = std::sqrt(nearestDistanceSq);
+    }
+    return entries_[tree_.GetUserData(proxy)].gameObject;
+}
+
+} // namespace UnoEngine
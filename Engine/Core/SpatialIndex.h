@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Types.h"
+#include "../Math/BoundingVolumeTree.h"
+#include "../Math/Matrix.h"
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace UnoEngine {
+
+class GameObject;
+class Transform;
+class TransformHierarchy;
+
+// シーン内のGameObjectのワールド空間AABBをBVHに保持し、視錐台・レイ・箱・最近傍の問い合わせに答える
+//
+// 境界は MeshRenderer のメッシュ、SkinnedMeshRenderer のモデル（描画と同じ補正行列をかけ、アニメーション分だけ広げる）、
+// どちらも無ければエディタで選択するための既定の箱から求める
+// Scene::UpdateTransforms でワールド行列を再計算したTransformの物体だけを見直すため、止まっている物体には毎フレームの処理がかからない
+// 移動を伴わずに境界が変わった場合（レンダラーの追加やモデルの差し替えなど）は MarkBoundsDirty を呼ぶ
+// 非アクティブなGameObjectはどの問い合わせにも返さない
+class SpatialIndex {
+public:
+    SpatialIndex() = default;
+
+    SpatialIndex(const SpatialIndex&) = delete;
+    SpatialIndex& operator=(const SpatialIndex&) = delete;
+
+    // 登録（境界は次のUpdateで求める。同じフレームで追加したコンポーネントも反映される）
+    void Add(GameObject* gameObject);
+    void Remove(GameObject* gameObject);
+    void Clear();
+
+    // 次のUpdateで境界を求め直す
+    void MarkBoundsDirty(GameObject* gameObject);
+
+    // 追加・境界の変更・直前のワールド行列の更新があった物体の箱を更新する
+    // 一度に多くの物体を追加した場合（シーンのロード直後など）はツリー全体をSAHで作り直す
+    void Update(const TransformHierarchy& hierarchy);
+
+    // ツリー全体をSAHで作り直す
+    void Rebuild() { tree_.Rebuild(); }
+
+    // 視錐台・箱と交わる物体をoutObjectsに追加する（ワールド空間のAABBで判定）
+    void QueryFrustum(const Frustum& frustum, std::vector<GameObject*>& outObjects) const;
+    void QueryOverlap(const BoundingBox& box, std::vector<GameObject*>& outObjects) const;
+
+    // レイ（directionは正規化済み）が最初に当たる物体。当たらなければnullptr
+    // 物体のローカル空間の箱（回転に沿った箱）で判定し、outDistanceにはワールド空間での始点からの距離を書く
+    GameObject* RayCast(const Vector3& origin, const Vector3& direction,
+                        float maxDistance = std::numeric_limits<float>::max(), float* outDistance = nullptr) const;
+
+    // pointに最も近い物体（ワールド空間のAABBまでの距離、内側なら0）。maxDistance未満に無ければnullptr
+    GameObject* FindNearest(const Vector3& point, float maxDistance = std::numeric_limits<float>::max(),
+                            float* outDistance = nullptr) const;
+
+    uint32 GetCount() const { return tree_.GetProxyCount(); }
+    const BoundingVolumeTree& GetTree() const { return tree_; }
+
+    // レンダラーを持たない物体の境界（ローカル空間）
+    static BoundingBox GetDefaultBounds() { return BoundingBox(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 2.0f, 1.0f)); }
+
+    // レンダラーから求めた境界
+    struct RendererBounds {
+        BoundingBox localBounds;                           // モデル（メッシュ）空間の箱
+        Matrix4x4 modelCorrection = Matrix4x4::Identity(); // モデル空間からTransformのローカル空間への補正
+        float scale = 1.0f;                                // 箱を中心から広げる倍率
+    };
+    // 描画に使うレンダラーの境界を取得する。レンダラーが無ければfalse（既定の箱を使う）
+    // レンダラーの型に依存するため SpatialIndexBounds.cpp に分けてある（SpatialIndex.cpp はグラフィックスAPI無しでビルドできる）
+    static bool GetRendererBounds(const GameObject& gameObject, RendererBounds& outBounds);
+
+    // Update内でツリーを作り直す、1回のUpdateで新しく登録した物体の数の下限と全体に対する割合
+    static constexpr uint32 REBUILD_MIN_INSERTS = 256;
+    static constexpr float REBUILD_INSERT_RATIO = 0.25f;
+
+private:
+    struct Entry {
+        GameObject* gameObject = nullptr;      // 空きスロットではnullptr
+        int32 proxy = BoundingVolumeTree::NULL_NODE;
+        BoundingBox localBounds;               // boundsToWorld を掛ける前の箱（レイの判定用）
+        Matrix4x4 boundsToWorld;               // ワールド行列（スキンメッシュはモデルの補正込み）
+        BoundingBox worldBounds;               // ツリーに登録した箱（余白なし）
+        bool pending = false;                  // pendingSlots_ に積まれている
+    };
+
+    void QueueRefresh(uint32 slot);
+    // 境界とワールド行列を求め直してツリーに反映し、新しく登録した場合はtrueを返す
+    bool Refresh(uint32 slot);
+
+    BoundingVolumeTree tree_;
+    std::vector<Entry> entries_;
+    std::vector<uint32> freeSlots_;
+    std::vector<uint32> pendingSlots_;
+    std::unordered_map<const Transform*, uint32> slotByTransform_;
+};
+
+} // namespace UnoEngine
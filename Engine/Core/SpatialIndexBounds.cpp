@@ -0,0 +1,30 @@
+#include "SpatialIndex.h"
+#include "GameObject.h"
+#include "../Graphics/MeshRenderer.h"
+#include "../Graphics/Mesh.h"
+#include "../Rendering/SkinnedMeshRenderer.h"
+
+namespace UnoEngine {
+
+bool SpatialIndex::GetRendererBounds(const GameObject& gameObject, RendererBounds& outBounds) {
+    // スキンメッシュは描画と同じ補正行列をかけ、アニメーションで動く分だけ広げる
+    if (auto* skinnedRenderer = gameObject.GetComponent<const SkinnedMeshRenderer>();
+        skinnedRenderer && skinnedRenderer->HasModel() && skinnedRenderer->GetBounds().IsValid()) {
+        outBounds.localBounds = skinnedRenderer->GetBounds();
+        outBounds.modelCorrection = SkinnedMeshRenderer::GetModelCorrection();
+        outBounds.scale = SkinnedMeshRenderer::CULLING_BOUNDS_SCALE;
+        return true;
+    }
+
+    if (auto* meshRenderer = gameObject.GetComponent<const MeshRenderer>();
+        meshRenderer && meshRenderer->GetMesh()) {
+        const Mesh* mesh = meshRenderer->GetMesh();
+        outBounds.localBounds = BoundingBox(mesh->GetBoundsMin(), mesh->GetBoundsMax());
+        outBounds.modelCorrection = Matrix4x4::Identity();
+        outBounds.scale = 1.0f;
+        return true;
+    }
+    return false;
+}
+
+} // namespace UnoEngine
@@ -1,20 +1,50 @@
 #include "Transform.h"
+#include "TransformHierarchy.h"
 #include <algorithm>
 
 namespace UnoEngine {
 
+Transform::~Transform() {
+    // 子はルートとして切り離す
+    while (!children_.empty()) {
+        children_.back()->SetParent(nullptr);
+    }
+
+    if (parent_) {
+        auto& siblings = parent_->children_;
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), this), siblings.end());
+        parent_ = nullptr;
+    }
+
+    if (hierarchy_) {
+        hierarchy_->Unregister(this);
+    }
+}
+
 void Transform::SetLocalPosition(const Vector3& pos) {
     localPosition_ = pos;
+    if (hierarchy_) {
+        hierarchy_->SetLocalPosition(hierarchyIndex_, pos);
+        return;
+    }
     MarkDirty();
 }
 
 void Transform::SetLocalRotation(const Quaternion& rot) {
     localRotation_ = rot;
+    if (hierarchy_) {
+        hierarchy_->SetLocalRotation(hierarchyIndex_, rot);
+        return;
+    }
     MarkDirty();
 }
 
 void Transform::SetLocalScale(const Vector3& scale) {
     localScale_ = scale;
+    if (hierarchy_) {
+        hierarchy_->SetLocalScale(hierarchyIndex_, scale);
+        return;
+    }
     MarkDirty();
 }
 
@@ -24,12 +54,12 @@ Vector3 Transform::GetPosition() const {
         return localPosition_;
     }
     // 親がある場合はワールド行列から取得
-    if (isDirty_) UpdateWorldMatrix();
+    const Matrix4x4 world = GetWorldMatrix();
     // DirectXの行優先行列：Translation は m[3][0], m[3][1], m[3][2]
     return Vector3(
-        cachedWorldMatrix_.GetElement(3, 0),
-        cachedWorldMatrix_.GetElement(3, 1),
-        cachedWorldMatrix_.GetElement(3, 2)
+        world.GetElement(3, 0),
+        world.GetElement(3, 1),
+        world.GetElement(3, 2)
     );
 }
 
@@ -53,6 +83,9 @@ Vector3 Transform::GetScale() const {
 }
 
 Matrix4x4 Transform::GetWorldMatrix() const {
+    if (hierarchy_) {
+        return hierarchy_->GetWorldMatrix(hierarchyIndex_);
+    }
     if (isDirty_) UpdateWorldMatrix();
     return cachedWorldMatrix_;
 }
@@ -93,6 +126,24 @@ void Transform::SetParent(Transform* parent) {
         parent_->children_.push_back(this);
     }
 
+    // 片方だけがストアに登録されている場合は、未登録側を含む木全体を同じストアに登録する
+    // （親子関係の反映もRegister内で行われる）
+    if (parent_ && parent_->hierarchy_ != hierarchy_) {
+        if (!hierarchy_) {
+            parent_->hierarchy_->Register(this);
+            return;
+        }
+        if (!parent_->hierarchy_) {
+            hierarchy_->Register(parent_);
+            return;
+        }
+    }
+
+    if (hierarchy_) {
+        hierarchy_->SetParent(this, parent_);
+        return;
+    }
+
     MarkDirty();
 }
 
@@ -1,15 +1,24 @@
 #pragma once
 
 #include "../Math/Math.h"
+#include "Types.h"
 #include <vector>
 #include <memory>
 
 namespace UnoEngine {
 
+class TransformHierarchy;
+
+// TransformHierarchyに登録されている場合、ワールド行列の計算と保持はストア側で一括して行う
+// 未登録の場合は従来どおり親をたどって遅延計算する
 class Transform {
 public:
     Transform() = default;
-    ~Transform() = default;
+    ~Transform();
+
+    // ストアが自身のアドレスを保持するためコピー不可
+    Transform(const Transform&) = delete;
+    Transform& operator=(const Transform&) = delete;
 
     // Local transform
     void SetLocalPosition(const Vector3& pos);
@@ -39,7 +48,12 @@ public:
     Vector3 GetRight() const;
     Vector3 GetUp() const;
 
+    TransformHierarchy* GetHierarchy() const { return hierarchy_; }
+    uint32 GetHierarchyIndex() const { return hierarchyIndex_; }
+
 private:
+    friend class TransformHierarchy;
+
     void MarkDirty();
     void UpdateWorldMatrix() const;
 
@@ -52,6 +66,9 @@ private:
 
     mutable Matrix4x4 cachedWorldMatrix_ = Matrix4x4::Identity();
     mutable bool isDirty_ = true;
+
+    TransformHierarchy* hierarchy_ = nullptr;
+    uint32 hierarchyIndex_ = 0xFFFFFFFF;
 };
 
 } // namespace UnoEngine
@@ -0,0 +1,388 @@
+#include "TransformHierarchy.h"
+#include "Transform.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cassert>
+
+namespace UnoEngine {
+
+namespace {
+
+// ローカル行列 S * R * T を行列積なしで構築
+// 行ベクトル規約では S * R は回転行列の各行をスケール倍したもの、T は4行目に平行移動を置くだけになる
+Matrix4x4 ComposeLocalMatrix(const Vector3& position, const Quaternion& rotation, const Vector3& scale) {
+    Matrix4x4 result = rotation.ToMatrix();
+    float* m = result.GetData();
+    const float s[3] = { scale.GetX(), scale.GetY(), scale.GetZ() };
+    for (int row = 0; row < 3; ++row) {
+        m[row * 4 + 0] *= s[row];
+        m[row * 4 + 1] *= s[row];
+        m[row * 4 + 2] *= s[row];
+    }
+    m[12] = position.GetX();
+    m[13] = position.GetY();
+    m[14] = position.GetZ();
+    return result;
+}
+
+} // namespace
+
+TransformHierarchy::~TransformHierarchy() {
+    Clear();
+}
+
+void TransformHierarchy::Register(Transform* transform) {
+    assert(transform && "Transform is null");
+
+    // 未登録の祖先があればそこから登録しないと、ストア外の親を無視した行列になる
+    Transform* top = transform;
+    while (top->parent_ && !top->parent_->hierarchy_) {
+        top = top->parent_;
+    }
+    RegisterTree(top);
+}
+
+void TransformHierarchy::RegisterTree(Transform* node) {
+    if (node->hierarchy_) {
+        assert(node->hierarchy_ == this && "Transform is registered to another hierarchy");
+
+        // 登録済みノードは親の登録が後になった場合だけ親子関係を反映する
+        const uint32 expectedParent = node->parent_ ? node->parent_->hierarchyIndex_ : INVALID_INDEX;
+        if (parents_[node->hierarchyIndex_] != expectedParent) {
+            SetParent(node, node->parent_);
+        }
+        return;
+    }
+
+    const uint32 index = static_cast<uint32>(owners_.size());
+    const uint32 parentIndex = node->parent_ ? node->parent_->hierarchyIndex_ : INVALID_INDEX;
+
+    localPositions_.push_back(node->localPosition_);
+    localRotations_.push_back(node->localRotation_);
+    localScales_.push_back(node->localScale_);
+    parents_.push_back(parentIndex);
+    subtreeSizes_.push_back(1);
+    worldMatrices_.push_back(Matrix4x4::Identity());
+    dirty_.push_back(1);
+    moved_.push_back(1);
+    owners_.push_back(node);
+    anyDirty_ = true;
+    anyMoved_ = true;
+
+    node->hierarchy_ = this;
+    node->hierarchyIndex_ = index;
+
+    if (parentIndex != INVALID_INDEX) {
+        // 親の部分木が配列末尾で終わっていれば、末尾への追加で先行順が保たれる（先行順で登録する場合は常にこちら）
+        if (!orderDirty_ && parentIndex + subtreeSizes_[parentIndex] == index) {
+            for (uint32 a = parentIndex; a != INVALID_INDEX; a = parents_[a]) {
+                ++subtreeSizes_[a];
+            }
+        } else {
+            orderDirty_ = true;
+        }
+    }
+
+    for (Transform* child : node->children_) {
+        RegisterTree(child);
+    }
+}
+
+void TransformHierarchy::Unregister(Transform* transform) {
+    assert(transform && transform->hierarchy_ == this && "Transform is not registered to this hierarchy");
+
+    // 子が残っている場合はルートとして切り離す
+    for (Transform* child : transform->children_) {
+        if (child->hierarchy_ == this) {
+            SetParent(child, nullptr);
+        }
+    }
+
+    // 配列からの除去は次の並べ替え時にまとめて行う
+    owners_[transform->hierarchyIndex_] = nullptr;
+    ++deadCount_;
+
+    transform->hierarchy_ = nullptr;
+    transform->hierarchyIndex_ = INVALID_INDEX;
+}
+
+void TransformHierarchy::Clear() {
+    for (Transform* owner : owners_) {
+        if (!owner) continue;
+        owner->hierarchy_ = nullptr;
+        owner->hierarchyIndex_ = INVALID_INDEX;
+        owner->parent_ = nullptr;
+        owner->children_.clear();
+    }
+
+    localPositions_.clear();
+    localRotations_.clear();
+    localScales_.clear();
+    parents_.clear();
+    subtreeSizes_.clear();
+    worldMatrices_.clear();
+    dirty_.clear();
+    moved_.clear();
+    owners_.clear();
+    dirtyRanges_.clear();
+    movedRanges_.clear();
+    deadCount_ = 0;
+    orderDirty_ = false;
+    anyDirty_ = false;
+    anyMoved_ = false;
+}
+
+void TransformHierarchy::SetParent(Transform* transform, Transform* parent) {
+    assert(transform && transform->hierarchy_ == this);
+    assert((!parent || parent->hierarchy_ == this) && "Parent must belong to the same hierarchy");
+
+    const uint32 index = transform->hierarchyIndex_;
+    const uint32 parentIndex = parent ? parent->hierarchyIndex_ : INVALID_INDEX;
+
+    // 自身の子孫を親にすると循環するため拒否
+    for (uint32 a = parentIndex; a != INVALID_INDEX; a = parents_[a]) {
+        if (a == index) {
+            assert(false && "Cannot parent a transform to its own descendant");
+            return;
+        }
+    }
+
+    // 並べ替えは次のUpdateWorldMatricesでまとめて行う（大量の親子付けでも1回のO(n)で済む）
+    parents_[index] = parentIndex;
+    orderDirty_ = true;
+    MarkDirty(index);
+}
+
+void TransformHierarchy::SetLocalPosition(uint32 index, const Vector3& position) {
+    localPositions_[index] = position;
+    MarkDirty(index);
+}
+
+void TransformHierarchy::SetLocalRotation(uint32 index, const Quaternion& rotation) {
+    localRotations_[index] = rotation;
+    MarkDirty(index);
+}
+
+void TransformHierarchy::SetLocalScale(uint32 index, const Vector3& scale) {
+    localScales_[index] = scale;
+    MarkDirty(index);
+}
+
+const Matrix4x4& TransformHierarchy::GetWorldMatrix(uint32 index) {
+    if (anyDirty_) {
+        // 最も根に近いダーティな祖先から計算すれば自身も確定する
+        uint32 topDirty = INVALID_INDEX;
+        for (uint32 i = index; i != INVALID_INDEX; i = parents_[i]) {
+            if (dirty_[i]) topDirty = i;
+        }
+        if (topDirty != INVALID_INDEX) {
+            if (orderDirty_) {
+                // 並べ替え前は部分木が連続していないため、祖先チェーンだけ計算する（フラグは次の一括更新まで残す）
+                UpdateChain(topDirty, index);
+            } else {
+                UpdateRange(topDirty, topDirty + subtreeSizes_[topDirty]);
+            }
+        }
+    }
+    return worldMatrices_[index];
+}
+
+void TransformHierarchy::UpdateWorldMatrices(JobSystem* jobSystem) {
+    if (orderDirty_ || deadCount_ > 0) RebuildOrder();
+
+    // 動いた部分木はGetWorldMatrixで先に計算済みになっていても報告する
+    // 何も動かなかったフレームにForEachUpdatedが前回の範囲を返さないよう、先に空にする
+    movedRanges_.clear();
+    if (anyMoved_) {
+        CollectFlaggedRanges(moved_, movedRanges_);
+        for (const DirtyRange& range : movedRanges_) {
+            std::fill(moved_.begin() + range.begin, moved_.begin() + range.end, uint8(0));
+        }
+        anyMoved_ = false;
+    }
+
+    dirtyRanges_.clear();
+    if (!anyDirty_) return;
+
+    // 最上位のダーティな部分木を列挙（範囲の根の祖先はすべて計算済みで、範囲同士は重ならない）
+    CollectFlaggedRanges(dirty_, dirtyRanges_);
+    uint32 dirtyNodeCount = 0;
+    for (const DirtyRange& range : dirtyRanges_) {
+        dirtyNodeCount += range.end - range.begin;
+    }
+    anyDirty_ = false;
+
+    if (!jobSystem || jobSystem->GetWorkerCount() == 0 || dirtyNodeCount < PARALLEL_UPDATE_THRESHOLD) {
+        for (const DirtyRange& range : dirtyRanges_) {
+            UpdateRange(range.begin, range.end);
+        }
+        return;
+    }
+
+    // 小さな部分木はノード数がおおよそ揃うようにまとめて1ジョブにする
+    const uint32 jobCountTarget = (jobSystem->GetWorkerCount() + 1) * 4;
+    const uint32 nodesPerJob = (std::max)(MIN_NODES_PER_JOB, dirtyNodeCount / jobCountTarget);
+
+    jobRangeStarts_.clear();
+    uint32 nodesInJob = nodesPerJob;
+    for (uint32 r = 0; r < static_cast<uint32>(dirtyRanges_.size()); ++r) {
+        if (nodesInJob >= nodesPerJob) {
+            jobRangeStarts_.push_back(r);
+            nodesInJob = 0;
+        }
+        nodesInJob += dirtyRanges_[r].end - dirtyRanges_[r].begin;
+    }
+    const uint32 jobCount = static_cast<uint32>(jobRangeStarts_.size());
+    jobRangeStarts_.push_back(static_cast<uint32>(dirtyRanges_.size()));
+
+    jobSystem->ParallelFor(jobCount, 1, [this](uint32 begin, uint32 end) {
+        for (uint32 job = begin; job < end; ++job) {
+            for (uint32 r = jobRangeStarts_[job]; r < jobRangeStarts_[job + 1]; ++r) {
+                UpdateRange(dirtyRanges_[r].begin, dirtyRanges_[r].end);
+            }
+        }
+    });
+}
+
+void TransformHierarchy::CollectFlaggedRanges(const std::vector<uint8>& flags, std::vector<DirtyRange>& outRanges) const {
+    const uint32 count = static_cast<uint32>(owners_.size());
+    uint32 i = 0;
+    while (i < count) {
+        if (flags[i]) {
+            const uint32 end = i + subtreeSizes_[i];
+            outRanges.push_back({ i, end });
+            i = end;
+        } else {
+            ++i;
+        }
+    }
+}
+
+void TransformHierarchy::UpdateRange(uint32 begin, uint32 end) {
+    for (uint32 i = begin; i < end; ++i) {
+        UpdateNode(i);
+        dirty_[i] = 0;
+    }
+}
+
+void TransformHierarchy::UpdateChain(uint32 top, uint32 index) {
+    // index から top までの祖先チェーンを根側から計算
+    chainScratch_.clear();
+    for (uint32 i = index; i != top; i = parents_[i]) {
+        chainScratch_.push_back(i);
+    }
+    chainScratch_.push_back(top);
+    for (auto it = chainScratch_.rbegin(); it != chainScratch_.rend(); ++it) {
+        UpdateNode(*it);
+    }
+}
+
+void TransformHierarchy::UpdateNode(uint32 index) {
+    Matrix4x4 local = ComposeLocalMatrix(localPositions_[index], localRotations_[index], localScales_[index]);
+    const uint32 parent = parents_[index];
+    if (parent != INVALID_INDEX) {
+        Math::MatrixMultiply(local.GetData(), worldMatrices_[parent].GetData(), worldMatrices_[index].GetData());
+    } else {
+        worldMatrices_[index] = local;
+    }
+}
+
+void TransformHierarchy::Rebuild(const std::vector<uint32>& newOrder) {
+    const uint32 oldCount = static_cast<uint32>(owners_.size());
+    const uint32 newCount = static_cast<uint32>(newOrder.size());
+
+    std::vector<uint32> oldToNew(oldCount, INVALID_INDEX);
+    for (uint32 i = 0; i < newCount; ++i) {
+        oldToNew[newOrder[i]] = i;
+    }
+
+    std::vector<Vector3> positions(newCount);
+    std::vector<Quaternion> rotations(newCount);
+    std::vector<Vector3> scales(newCount);
+    std::vector<uint32> parents(newCount);
+    std::vector<Matrix4x4> worldMatrices(newCount);
+    std::vector<uint8> dirty(newCount);
+    std::vector<uint8> moved(newCount);
+    std::vector<Transform*> owners(newCount);
+
+    for (uint32 i = 0; i < newCount; ++i) {
+        const uint32 src = newOrder[i];
+        positions[i] = localPositions_[src];
+        rotations[i] = localRotations_[src];
+        scales[i] = localScales_[src];
+        parents[i] = (parents_[src] != INVALID_INDEX) ? oldToNew[parents_[src]] : INVALID_INDEX;
+        worldMatrices[i] = worldMatrices_[src];
+        dirty[i] = dirty_[src];
+        moved[i] = moved_[src];
+        owners[i] = owners_[src];
+        if (owners[i]) {
+            owners[i]->hierarchyIndex_ = i;
+        }
+        assert((parents[i] == INVALID_INDEX || parents[i] < i) && "Parent must precede its children");
+    }
+
+    // 親は子より前にあるため、末尾から親へ加算すれば部分木サイズが求まる
+    std::vector<uint32> subtreeSizes(newCount, 1);
+    for (uint32 i = newCount; i-- > 0;) {
+        if (parents[i] != INVALID_INDEX) {
+            subtreeSizes[parents[i]] += subtreeSizes[i];
+        }
+    }
+
+    localPositions_ = std::move(positions);
+    localRotations_ = std::move(rotations);
+    localScales_ = std::move(scales);
+    parents_ = std::move(parents);
+    subtreeSizes_ = std::move(subtreeSizes);
+    worldMatrices_ = std::move(worldMatrices);
+    dirty_ = std::move(dirty);
+    moved_ = std::move(moved);
+    owners_ = std::move(owners);
+}
+
+void TransformHierarchy::RebuildOrder() {
+    const uint32 count = static_cast<uint32>(owners_.size());
+
+    // 親ごとの子リストを現在の並び順のまま作る（兄弟の順序を保つ）
+    std::vector<uint32> childOffsets(count + 1, 0);
+    for (uint32 i = 0; i < count; ++i) {
+        if (owners_[i] && parents_[i] != INVALID_INDEX) {
+            ++childOffsets[parents_[i] + 1];
+        }
+    }
+    for (uint32 i = 0; i < count; ++i) {
+        childOffsets[i + 1] += childOffsets[i];
+    }
+    std::vector<uint32> children(childOffsets[count]);
+    std::vector<uint32> fill(childOffsets.begin(), childOffsets.end() - 1);
+    for (uint32 i = 0; i < count; ++i) {
+        if (owners_[i] && parents_[i] != INVALID_INDEX) {
+            children[fill[parents_[i]]++] = i;
+        }
+    }
+
+    // ルートから深さ優先で先行順を作る（登録解除済みのノードは除外）
+    std::vector<uint32> newOrder;
+    newOrder.reserve(count - deadCount_);
+    std::vector<uint32> stack;
+    for (uint32 root = 0; root < count; ++root) {
+        if (!owners_[root] || parents_[root] != INVALID_INDEX) continue;
+
+        stack.push_back(root);
+        while (!stack.empty()) {
+            const uint32 node = stack.back();
+            stack.pop_back();
+            newOrder.push_back(node);
+            for (uint32 c = childOffsets[node + 1]; c-- > childOffsets[node];) {
+                stack.push_back(children[c]);
+            }
+        }
+    }
+    assert(newOrder.size() == count - deadCount_ && "Transform hierarchy contains a cycle or orphaned node");
+
+    deadCount_ = 0;
+    orderDirty_ = false;
+    Rebuild(newOrder);
+}
+
+} // namespace UnoEngine
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Types.h"
+#include "../Math/Math.h"
+#include <vector>
+
+namespace UnoEngine {
+
+class Transform;
+class JobSystem;
+
+// シーン内のTransform階層をSoA配列で保持し、ワールド行列を線形パスで更新するストア
+//
+// ノードは深さ優先の先行順（親が必ず子より前、各部分木は連続した範囲）で並ぶため、
+// ダーティなノードから部分木サイズ分の範囲を先頭から順に計算するだけで親の行列は常に計算済みになる
+// MarkDirtyは自ノードにフラグを立てるだけ（子孫への再帰なし）
+// 最上位のダーティな部分木同士は互いに独立しているため、JobSystemを渡すと部分木単位で並列に更新する
+// （各ノードの計算内容は直列時と同一なので結果も完全に一致する）
+class TransformHierarchy {
+public:
+    static constexpr uint32 INVALID_INDEX = 0xFFFFFFFF;
+
+    TransformHierarchy() = default;
+    ~TransformHierarchy();
+
+    TransformHierarchy(const TransformHierarchy&) = delete;
+    TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+    // Transformを登録（親子リンクでつながっている未登録のTransformもまとめて登録し、親子関係を反映する）
+    void Register(Transform* transform);
+
+    // 登録解除（子が残っている場合はルートに切り離してから解除する）
+    void Unregister(Transform* transform);
+
+    // 全Transformの登録を解除（シーン破棄時用、親子リンクも解除する）
+    void Clear();
+
+    // 親子関係の変更（parentにnullptrを指定するとルートになる）
+    // 配列の並べ替えは次のUpdateWorldMatricesでまとめて行う
+    void SetParent(Transform* transform, Transform* parent);
+
+    void SetLocalPosition(uint32 index, const Vector3& position);
+    void SetLocalRotation(uint32 index, const Quaternion& rotation);
+    void SetLocalScale(uint32 index, const Vector3& scale);
+
+    void MarkDirty(uint32 index) {
+        dirty_[index] = 1;
+        moved_[index] = 1;
+        anyDirty_ = true;
+        anyMoved_ = true;
+    }
+
+    // ワールド行列の取得（自身または祖先がダーティな場合はその部分木だけ先に更新する）
+    const Matrix4x4& GetWorldMatrix(uint32 index);
+
+    // ダーティな範囲のワールド行列を一括更新（1フレームに1回）
+    // jobSystemがnullptrまたは更新ノード数が少ない場合は直列で処理する
+    void UpdateWorldMatrices(JobSystem* jobSystem = nullptr);
+
+    // 直前のUpdateWorldMatricesで（その前の呼び出し以降に）ワールド行列が変わったTransformごとに callback(Transform&) を呼ぶ
+    // （空間インデックスなど、動いた物だけを見直したい処理用。次のUpdateWorldMatricesまで有効）
+    // GetWorldMatrixの遅延更新で先に計算済みになったTransformも含む
+    template<typename Callback>
+    void ForEachUpdated(Callback&& callback) const {
+        for (const DirtyRange& range : movedRanges_) {
+            for (uint32 i = range.begin; i < range.end; ++i) {
+                if (owners_[i]) {
+                    callback(*owners_[i]);
+                }
+            }
+        }
+    }
+
+    // 並列更新に切り替える最小ノード数と、1ジョブあたりの最小ノード数
+    static constexpr uint32 PARALLEL_UPDATE_THRESHOLD = 2048;
+    static constexpr uint32 MIN_NODES_PER_JOB = 256;
+
+    uint32 GetCount() const { return static_cast<uint32>(owners_.size()) - deadCount_; }
+    uint32 GetParentIndex(uint32 index) const { return parents_[index]; }
+    // UpdateWorldMatrices後（並べ替え済み）のみ有効
+    uint32 GetSubtreeSize(uint32 index) const { return subtreeSizes_[index]; }
+
+private:
+    // nodeとその子孫を先行順で登録
+    void RegisterTree(Transform* node);
+
+    // [begin, end) の範囲を先頭から順に再計算してダーティフラグを下ろす（範囲は部分木単位であること）
+    void UpdateRange(uint32 begin, uint32 end);
+    // top から index までの祖先チェーンのみ再計算（並べ替え前の遅延取得用）
+    void UpdateChain(uint32 top, uint32 index);
+    void UpdateNode(uint32 index);
+
+    // newOrder[新インデックス] = 旧インデックス で配列を並べ替え、親インデックス・部分木サイズ・所有者の参照を再構築
+    void Rebuild(const std::vector<uint32>& newOrder);
+
+    // 親インデックスから先行順を作り直し、登録解除済みノードを取り除く
+    void RebuildOrder();
+
+    // SoA配列（すべて同じインデックスで対応）
+    std::vector<Vector3> localPositions_;
+    std::vector<Quaternion> localRotations_;
+    std::vector<Vector3> localScales_;
+    std::vector<uint32> parents_;
+    std::vector<uint32> subtreeSizes_;   // 自身を含む部分木のノード数
+    std::vector<Matrix4x4> worldMatrices_;
+    std::vector<uint8> dirty_;
+    std::vector<Transform*> owners_;     // 登録解除済みのノードはnullptr
+
+    // 前回のUpdateWorldMatrices以降に変更されたノード（dirty_と違いGetWorldMatrixの遅延更新では下ろさない）
+    std::vector<uint8> moved_;
+
+    // [begin, end) の範囲を先頭から順に見て、最上位のフラグが立った部分木をoutRangesに追加する
+    struct DirtyRange {
+        uint32 begin;
+        uint32 end;
+    };
+    void CollectFlaggedRanges(const std::vector<uint8>& flags, std::vector<DirtyRange>& outRanges) const;
+
+    // UpdateWorldMatrices用の作業バッファ
+    std::vector<DirtyRange> dirtyRanges_;
+    std::vector<DirtyRange> movedRanges_;  // ForEachUpdatedで返す範囲
+    std::vector<uint32> jobRangeStarts_;  // 各ジョブが担当するdirtyRanges_の先頭（末尾に番兵）
+
+    std::vector<uint32> chainScratch_;
+
+    uint32 deadCount_ = 0;
+    bool orderDirty_ = false;  // 親子関係の変更後、先行順の並べ替えが必要
+    bool anyDirty_ = false;
+    bool anyMoved_ = false;
+};
+
+} // namespace UnoEngine
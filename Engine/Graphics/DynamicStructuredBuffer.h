@@ -0,0 +1,87 @@
+#pragma once
+
+#include "D3D12Common.h"
+#include "../Core/Types.h"
+#include <cstring>
+
+namespace UnoEngine {
+
+// フレーム内で追記していくダイナミックなStructuredBuffer
+// Allocateで要素の配列を書き込み、その先頭のGPUアドレスを返す（ルートSRVにそのまま渡せる）
+template<typename T>
+class DynamicStructuredBuffer {
+public:
+    DynamicStructuredBuffer() = default;
+    ~DynamicStructuredBuffer() = default;
+
+    // 作成（maxElementsPerFrame: 1フレーム内に書き込める要素数の合計）
+    void Create(ID3D12Device* device, uint32 maxElementsPerFrame) {
+        maxElements_ = maxElementsPerFrame;
+
+        D3D12_HEAP_PROPERTIES heapProps = {};
+        heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+        D3D12_RESOURCE_DESC resDesc = {};
+        resDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        resDesc.Width = static_cast<uint64>(sizeof(T)) * maxElements_;
+        resDesc.Height = 1;
+        resDesc.DepthOrArraySize = 1;
+        resDesc.MipLevels = 1;
+        resDesc.Format = DXGI_FORMAT_UNKNOWN;
+        resDesc.SampleDesc.Count = 1;
+        resDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+        ThrowIfFailed(
+            device->CreateCommittedResource(
+                &heapProps,
+                D3D12_HEAP_FLAG_NONE,
+                &resDesc,
+                D3D12_RESOURCE_STATE_GENERIC_READ,
+                nullptr,
+                IID_PPV_ARGS(&buffer_)
+            ),
+            "Failed to create dynamic structured buffer"
+        );
+
+        // 常時マップ状態を維持
+        ThrowIfFailed(
+            buffer_->Map(0, nullptr, reinterpret_cast<void**>(&mappedData_)),
+            "Failed to map dynamic structured buffer"
+        );
+
+        baseGpuAddress_ = buffer_->GetGPUVirtualAddress();
+    }
+
+    // フレーム開始時にリセット
+    void Reset() {
+        currentOffset_ = 0;
+    }
+
+    // count個の要素を書き込み、先頭のGPUアドレスを返す
+    // 残りの容量が足りない場合は何も書かずに0を返す（描画中のデータを上書きしないため巻き戻さない）
+    D3D12_GPU_VIRTUAL_ADDRESS Allocate(const T* data, uint32 count) {
+        if (count > maxElements_ - currentOffset_) {
+            return 0;
+        }
+
+        std::memcpy(mappedData_ + static_cast<size_t>(currentOffset_) * sizeof(T), data, sizeof(T) * count);
+
+        D3D12_GPU_VIRTUAL_ADDRESS gpuAddr = baseGpuAddress_ + static_cast<uint64>(currentOffset_) * sizeof(T);
+        currentOffset_ += count;
+
+        return gpuAddr;
+    }
+
+    uint32 GetRemaining() const { return maxElements_ - currentOffset_; }
+    ID3D12Resource* GetResource() const { return buffer_.Get(); }
+
+private:
+    ComPtr<ID3D12Resource> buffer_;
+    uint8* mappedData_ = nullptr;
+    D3D12_GPU_VIRTUAL_ADDRESS baseGpuAddress_ = 0;
+
+    uint32 maxElements_ = 0;
+    uint32 currentOffset_ = 0;
+};
+
+} // namespace UnoEngine
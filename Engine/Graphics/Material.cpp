@@ -1,9 +1,15 @@
 #include "Material.h"
 #include "GraphicsDevice.h"
+#include <atomic>
 #include <filesystem>
 
 namespace UnoEngine {
 
+uint32 Material::AllocateSortId() {
+    static std::atomic<uint32> nextSortId{ 0 };
+    return nextSortId.fetch_add(1, std::memory_order_relaxed);
+}
+
 void Material::LoadFromData(const MaterialData& data, GraphicsDevice* graphics,
                            ID3D12GraphicsCommandList* commandList,
                            const std::string& baseDirectory, uint32 srvIndex) {
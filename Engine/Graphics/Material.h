@@ -44,10 +44,16 @@ public:
     uint32 GetSRVIndex() const { return diffuseTexture_ ? diffuseTexture_->GetSRVIndex() : 0; }
     D3D12_GPU_DESCRIPTOR_HANDLE GetAlbedoSRV(ID3D12DescriptorHeap* heap) const;
 
+    // 描画順のソートキーで使う番号（生成順に振る。同じマテリアルの描画を隣り合わせてステートの切り替えを減らす）
+    uint32 GetSortId() const { return sortId_; }
+
 private:
+    static uint32 AllocateSortId();
+
     MaterialData data_;
     std::unique_ptr<Texture2D> diffuseTexture_;
     ID3D12Device* device_ = nullptr;
+    uint32 sortId_ = AllocateSortId();
 };
 
 } // namespace UnoEngine
@@ -1,10 +1,16 @@
 #include "Mesh.h"
 #include "../Math/MathUtils.h"
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 
 namespace UnoEngine {
 
+uint32 Mesh::AllocateSortId() {
+    static std::atomic<uint32> nextSortId{ 0 };
+    return nextSortId.fetch_add(1, std::memory_order_relaxed);
+}
+
 void Mesh::Create(ID3D12Device* device, ID3D12GraphicsCommandList* commandList,
                   const std::vector<Vertex>& vertices, const std::vector<uint32>& indices,
                   const std::string& name) {
@@ -22,9 +22,9 @@ void Pipeline::CreateRootSignature(ID3D12Device* device) {
     descRange.OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
 
     // ルートパラメータ
-    D3D12_ROOT_PARAMETER rootParams[4] = {};
+    D3D12_ROOT_PARAMETER rootParams[5] = {};
 
-    // 定数バッファ (b0) - Transform
+    // 定数バッファ (b0) - View
     rootParams[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
     rootParams[0].Descriptor.ShaderRegister = 0;
     rootParams[0].Descriptor.RegisterSpace = 0;
@@ -48,6 +48,12 @@ void Pipeline::CreateRootSignature(ID3D12Device* device) {
     rootParams[3].Descriptor.RegisterSpace = 0;
     rootParams[3].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 
+    // ルートSRV (t1) - インスタンスデータのStructuredBuffer（バッチごとに先頭アドレスをずらして設定する）
+    rootParams[4].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+    rootParams[4].Descriptor.ShaderRegister = 1;
+    rootParams[4].Descriptor.RegisterSpace = 0;
+    rootParams[4].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+
     // スタティックサンプラー (s0)
     D3D12_STATIC_SAMPLER_DESC sampler = {};
     sampler.Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
@@ -65,7 +71,7 @@ void Pipeline::CreateRootSignature(ID3D12Device* device) {
     sampler.ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 
     D3D12_ROOT_SIGNATURE_DESC rootSigDesc = {};
-    rootSigDesc.NumParameters = 4;
+    rootSigDesc.NumParameters = _countof(rootParams);
     rootSigDesc.pParameters = rootParams;
     rootSigDesc.NumStaticSamplers = 1;
     rootSigDesc.pStaticSamplers = &sampler;
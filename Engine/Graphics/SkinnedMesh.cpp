@@ -1,10 +1,16 @@
 #include "SkinnedMesh.h"
 #include "GraphicsDevice.h"
 #include <algorithm>
+#include <atomic>
 #include <limits>
 
 namespace UnoEngine {
 
+uint32 SkinnedMesh::AllocateSortId() {
+    static std::atomic<uint32> nextSortId{ 0 };
+    return nextSortId.fetch_add(1, std::memory_order_relaxed);
+}
+
 void SkinnedMesh::Create(ID3D12Device* device, ID3D12GraphicsCommandList* commandList,
                          const std::vector<SkinnedVertex>& vertices, const std::vector<uint32>& indices,
                          const std::string& name) {
@@ -40,7 +40,12 @@ public:
     Vector3 GetBoundsMin() const { return boundsMin_; }
     Vector3 GetBoundsMax() const { return boundsMax_; }
 
+    // 描画順のソートキーで使う番号（生成順に振る。同じメッシュの描画を隣り合わせてステートの切り替えを減らす）
+    uint32 GetSortId() const { return sortId_; }
+
 private:
+    static uint32 AllocateSortId();
+
     void CalculateBounds(const std::vector<SkinnedVertex>& vertices);
 
     VertexBuffer vertexBuffer_;
@@ -49,6 +54,7 @@ private:
     Vector3 boundsMin_;
     Vector3 boundsMax_;
     std::unique_ptr<Material> material_;
+    uint32 sortId_ = AllocateSortId();
 };
 
 } // namespace UnoEngine
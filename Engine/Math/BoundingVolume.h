@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Vector.h"
+#include "Matrix.h"
 #include <cmath>
 #include <limits>
 #include <algorithm>
@@ -42,6 +43,19 @@ struct BoundingBox {
                point.GetZ() >= min.GetZ() && point.GetZ() <= max.GetZ();
     }
 
+    // otherが完全に内側にあるか
+    bool Contains(const BoundingBox& other) const {
+        return other.min.GetX() >= min.GetX() && other.max.GetX() <= max.GetX() &&
+               other.min.GetY() >= min.GetY() && other.max.GetY() <= max.GetY() &&
+               other.min.GetZ() >= min.GetZ() && other.max.GetZ() <= max.GetZ();
+    }
+
+    // 表面積（BVHのSAHコスト用）
+    float GetSurfaceArea() const {
+        const Vector3 size = GetSize();
+        return 2.0f * (size.GetX() * size.GetY() + size.GetY() * size.GetZ() + size.GetZ() * size.GetX());
+    }
+
     bool Intersects(const BoundingBox& other) const {
         return min.GetX() <= other.max.GetX() && max.GetX() >= other.min.GetX() &&
                min.GetY() <= other.max.GetY() && max.GetY() >= other.min.GetY() &&
@@ -101,6 +115,27 @@ struct BoundingBox {
         Expand(other.max);
     }
 
+    // 行列で変換した箱を囲むAABB（中心を変換し、半分の大きさは行列の各要素の絶対値で広げる）
+    BoundingBox Transform(const Matrix4x4& m) const {
+        const Vector3 center = m.TransformPoint(GetCenter());
+        const Vector3 extents = GetExtents();
+        float worldExtents[3];
+        for (uint32 col = 0; col < 3; ++col) {
+            worldExtents[col] = std::abs(m.GetElement(0, col)) * extents.GetX() +
+                                std::abs(m.GetElement(1, col)) * extents.GetY() +
+                                std::abs(m.GetElement(2, col)) * extents.GetZ();
+        }
+        const Vector3 worldExtent(worldExtents[0], worldExtents[1], worldExtents[2]);
+        return BoundingBox(center - worldExtent, center + worldExtent);
+    }
+
+    // 2つの箱を囲む箱
+    static BoundingBox Merge(const BoundingBox& a, const BoundingBox& b) {
+        return BoundingBox(
+            Vector3(std::min(a.min.GetX(), b.min.GetX()), std::min(a.min.GetY(), b.min.GetY()), std::min(a.min.GetZ(), b.min.GetZ())),
+            Vector3(std::max(a.max.GetX(), b.max.GetX()), std::max(a.max.GetY(), b.max.GetY()), std::max(a.max.GetZ(), b.max.GetZ())));
+    }
+
     static BoundingBox CreateFromPoints(const Vector3* points, size_t count) {
         BoundingBox box;
         for (size_t i = 0; i < count; ++i) {
@@ -139,6 +174,16 @@ struct BoundingSphere {
         return (closest - center).LengthSq() <= radius * radius;
     }
 
+    // 行列で変換した球を囲む球（半径は最も大きい軸のスケールで広げる）
+    BoundingSphere Transform(const Matrix4x4& m) const {
+        float maxScaleSq = 0.0f;
+        for (uint32 row = 0; row < 3; ++row) {
+            const Vector3 axis(m.GetElement(row, 0), m.GetElement(row, 1), m.GetElement(row, 2));
+            maxScaleSq = std::max(maxScaleSq, axis.LengthSq());
+        }
+        return BoundingSphere(m.TransformPoint(center), radius * std::sqrt(maxScaleSq));
+    }
+
     static BoundingSphere CreateFromBox(const BoundingBox& box) {
         BoundingSphere sphere;
         sphere.center = box.GetCenter();
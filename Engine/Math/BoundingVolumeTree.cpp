@@ -0,0 +1,455 @@
+#include "BoundingVolumeTree.h"
+#include <algorithm>
+#include <cassert>
+
+namespace UnoEngine {
+
+namespace {
+
+// Rebuildで1回の分割に使うビンの数
+constexpr uint32 SAH_BIN_COUNT = 16;
+
+// 太った箱がこの倍率分の余白を超えて大きい場合は、縮んだとみなして挿入し直す
+constexpr float SHRINK_MARGIN_SCALE = 4.0f;
+
+float GetAxis(const Vector3& v, uint32 axis) {
+    return axis == 0 ? v.GetX() : (axis == 1 ? v.GetY() : v.GetZ());
+}
+
+} // anonymous namespace
+
+int32 BoundingVolumeTree::AllocateNode() {
+    if (freeList_ == NULL_NODE) {
+        nodes_.emplace_back();
+        return static_cast<int32>(nodes_.size()) - 1;
+    }
+
+    const int32 node = freeList_;
+    freeList_ = nodes_[node].parent;
+    nodes_[node] = Node();
+    return node;
+}
+
+void BoundingVolumeTree::FreeNode(int32 node) {
+    nodes_[node].parent = freeList_;
+    nodes_[node].child1 = NULL_NODE;
+    nodes_[node].child2 = NULL_NODE;
+    nodes_[node].userData = 0;
+    nodes_[node].height = -1;
+    freeList_ = node;
+}
+
+int32 BoundingVolumeTree::CreateProxy(const BoundingBox& box, uint32 userData) {
+    const int32 proxy = AllocateNode();
+    Node& node = nodes_[proxy];
+    node.box = Fatten(box);
+    node.userData = userData;
+    node.height = 0;
+
+    InsertLeaf(proxy);
+    ++proxyCount_;
+    return proxy;
+}
+
+void BoundingVolumeTree::DestroyProxy(int32 proxy) {
+    assert(proxy >= 0 && proxy < static_cast<int32>(nodes_.size()) && nodes_[proxy].IsLeaf() && nodes_[proxy].height == 0);
+
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    --proxyCount_;
+}
+
+bool BoundingVolumeTree::MoveProxy(int32 proxy, const BoundingBox& box) {
+    assert(proxy >= 0 && proxy < static_cast<int32>(nodes_.size()) && nodes_[proxy].IsLeaf() && nodes_[proxy].height == 0);
+
+    const BoundingBox& fatBox = nodes_[proxy].box;
+    if (fatBox.Contains(box)) {
+        const float shrink = margin_ * SHRINK_MARGIN_SCALE;
+        const BoundingBox hugeBox(box.min - Vector3(shrink, shrink, shrink), box.max + Vector3(shrink, shrink, shrink));
+        if (hugeBox.Contains(fatBox)) {
+            return false;
+        }
+    }
+
+    RemoveLeaf(proxy);
+    nodes_[proxy].box = Fatten(box);
+    InsertLeaf(proxy);
+    return true;
+}
+
+void BoundingVolumeTree::Clear() {
+    nodes_.clear();
+    root_ = NULL_NODE;
+    freeList_ = NULL_NODE;
+    proxyCount_ = 0;
+}
+
+float BoundingVolumeTree::ComputeCost() const {
+    if (root_ == NULL_NODE) return 0.0f;
+
+    const float rootArea = nodes_[root_].box.GetSurfaceArea();
+    if (rootArea <= 0.0f) return 0.0f;
+
+    float totalArea = 0.0f;
+    for (const Node& node : nodes_) {
+        if (node.height > 0) {
+            totalArea += node.box.GetSurfaceArea();
+        }
+    }
+    return totalArea / rootArea;
+}
+
+void BoundingVolumeTree::InsertLeaf(int32 leaf) {
+    if (root_ == NULL_NODE) {
+        root_ = leaf;
+        nodes_[root_].parent = NULL_NODE;
+        return;
+    }
+
+    // 兄弟の選択: その節点の兄弟にした場合の表面積の増分と、祖先が広がる分の合計が最小になる位置まで下りる
+    const BoundingBox leafBox = nodes_[leaf].box;
+    int32 index = root_;
+    while (!nodes_[index].IsLeaf()) {
+        const Node& node = nodes_[index];
+        const float area = node.box.GetSurfaceArea();
+        const float combinedArea = BoundingBox::Merge(node.box, leafBox).GetSurfaceArea();
+
+        // ここで新しい親を作る場合のコストと、子へ下りる場合に祖先として広がる分のコスト
+        const float cost = 2.0f * combinedArea;
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int32 child) {
+            const Node& childNode = nodes_[child];
+            const float mergedArea = BoundingBox::Merge(childNode.box, leafBox).GetSurfaceArea();
+            return childNode.IsLeaf() ? mergedArea + inheritanceCost
+                                      : (mergedArea - childNode.box.GetSurfaceArea()) + inheritanceCost;
+        };
+        const float cost1 = descendCost(node.child1);
+        const float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2) break;
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+    const int32 sibling = index;
+
+    // AllocateNodeで配列が伸びるため、参照は確保の後で取る
+    const int32 newParent = AllocateNode();
+    const int32 oldParent = nodes_[sibling].parent;
+    nodes_[newParent].parent = oldParent;
+    nodes_[newParent].box = BoundingBox::Merge(leafBox, nodes_[sibling].box);
+    nodes_[newParent].height = nodes_[sibling].height + 1;
+    nodes_[newParent].child1 = sibling;
+    nodes_[newParent].child2 = leaf;
+    nodes_[sibling].parent = newParent;
+    nodes_[leaf].parent = newParent;
+
+    if (oldParent != NULL_NODE) {
+        if (nodes_[oldParent].child1 == sibling) {
+            nodes_[oldParent].child1 = newParent;
+        } else {
+            nodes_[oldParent].child2 = newParent;
+        }
+    } else {
+        root_ = newParent;
+    }
+
+    Refit(nodes_[leaf].parent);
+}
+
+void BoundingVolumeTree::RemoveLeaf(int32 leaf) {
+    if (leaf == root_) {
+        root_ = NULL_NODE;
+        return;
+    }
+
+    // 親を取り除き、兄弟を祖父の子にする
+    const int32 parent = nodes_[leaf].parent;
+    const int32 grandParent = nodes_[parent].parent;
+    const int32 sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+    if (grandParent != NULL_NODE) {
+        if (nodes_[grandParent].child1 == parent) {
+            nodes_[grandParent].child1 = sibling;
+        } else {
+            nodes_[grandParent].child2 = sibling;
+        }
+        nodes_[sibling].parent = grandParent;
+        FreeNode(parent);
+        Refit(grandParent);
+    } else {
+        root_ = sibling;
+        nodes_[sibling].parent = NULL_NODE;
+        FreeNode(parent);
+    }
+    nodes_[leaf].parent = NULL_NODE;
+}
+
+void BoundingVolumeTree::Refit(int32 index) {
+    while (index != NULL_NODE) {
+        index = Balance(index);
+
+        Node& node = nodes_[index];
+        const Node& child1 = nodes_[node.child1];
+        const Node& child2 = nodes_[node.child2];
+        node.height = 1 + (std::max)(child1.height, child2.height);
+        node.box = BoundingBox::Merge(child1.box, child2.box);
+
+        index = node.parent;
+    }
+}
+
+int32 BoundingVolumeTree::Balance(int32 iA) {
+    Node& A = nodes_[iA];
+    if (A.IsLeaf() || A.height < 2) {
+        return iA;
+    }
+
+    const int32 iB = A.child1;
+    const int32 iC = A.child2;
+    Node& B = nodes_[iB];
+    Node& C = nodes_[iC];
+
+    const int32 balance = C.height - B.height;
+
+    // Cを持ち上げる
+    if (balance > 1) {
+        const int32 iF = C.child1;
+        const int32 iG = C.child2;
+        Node& F = nodes_[iF];
+        Node& G = nodes_[iG];
+
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+
+        if (C.parent != NULL_NODE) {
+            if (nodes_[C.parent].child1 == iA) {
+                nodes_[C.parent].child1 = iC;
+            } else {
+                nodes_[C.parent].child2 = iC;
+            }
+        } else {
+            root_ = iC;
+        }
+
+        // 高い方の孫をCの下に残し、低い方をAへ移す
+        if (F.height > G.height) {
+            C.child2 = iF;
+            A.child2 = iG;
+            G.parent = iA;
+            A.box = BoundingBox::Merge(B.box, G.box);
+            C.box = BoundingBox::Merge(A.box, F.box);
+            A.height = 1 + (std::max)(B.height, G.height);
+            C.height = 1 + (std::max)(A.height, F.height);
+        } else {
+            C.child2 = iG;
+            A.child2 = iF;
+            F.parent = iA;
+            A.box = BoundingBox::Merge(B.box, F.box);
+            C.box = BoundingBox::Merge(A.box, G.box);
+            A.height = 1 + (std::max)(B.height, F.height);
+            C.height = 1 + (std::max)(A.height, G.height);
+        }
+        return iC;
+    }
+
+    // Bを持ち上げる
+    if (balance < -1) {
+        const int32 iD = B.child1;
+        const int32 iE = B.child2;
+        Node& D = nodes_[iD];
+        Node& E = nodes_[iE];
+
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+
+        if (B.parent != NULL_NODE) {
+            if (nodes_[B.parent].child1 == iA) {
+                nodes_[B.parent].child1 = iB;
+            } else {
+                nodes_[B.parent].child2 = iB;
+            }
+        } else {
+            root_ = iB;
+        }
+
+        if (D.height > E.height) {
+            B.child2 = iD;
+            A.child1 = iE;
+            E.parent = iA;
+            A.box = BoundingBox::Merge(C.box, E.box);
+            B.box = BoundingBox::Merge(A.box, D.box);
+            A.height = 1 + (std::max)(C.height, E.height);
+            B.height = 1 + (std::max)(A.height, D.height);
+        } else {
+            B.child2 = iE;
+            A.child1 = iD;
+            D.parent = iA;
+            A.box = BoundingBox::Merge(C.box, D.box);
+            B.box = BoundingBox::Merge(A.box, E.box);
+            A.height = 1 + (std::max)(C.height, D.height);
+            B.height = 1 + (std::max)(A.height, E.height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+void BoundingVolumeTree::Rebuild() {
+    if (proxyCount_ == 0) return;
+
+    // 葉を集めて内部節点はすべて空きに戻す
+    std::vector<BuildEntry> entries;
+    entries.reserve(proxyCount_);
+    for (int32 i = 0; i < static_cast<int32>(nodes_.size()); ++i) {
+        Node& node = nodes_[i];
+        if (node.height == 0) {
+            const Vector3 center = node.box.GetCenter();
+            entries.push_back({ i, { center.GetX(), center.GetY(), center.GetZ() } });
+        } else if (node.height > 0) {
+            FreeNode(i);
+        }
+    }
+
+    root_ = BuildRange(entries, 0, static_cast<uint32>(entries.size()));
+    nodes_[root_].parent = NULL_NODE;
+}
+
+int32 BoundingVolumeTree::BuildRange(std::vector<BuildEntry>& entries, uint32 begin, uint32 end) {
+    const uint32 count = end - begin;
+    if (count == 1) {
+        return entries[begin].node;
+    }
+
+    // 中心の範囲が最も広い軸で分割する
+    float centroidMin[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+    float centroidMax[3] = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+    for (uint32 i = begin; i < end; ++i) {
+        for (uint32 a = 0; a < 3; ++a) {
+            centroidMin[a] = (std::min)(centroidMin[a], entries[i].centroid[a]);
+            centroidMax[a] = (std::max)(centroidMax[a], entries[i].centroid[a]);
+        }
+    }
+    uint32 axis = 0;
+    for (uint32 a = 1; a < 3; ++a) {
+        if (centroidMax[a] - centroidMin[a] > centroidMax[axis] - centroidMin[axis]) {
+            axis = a;
+        }
+    }
+    const float extent = centroidMax[axis] - centroidMin[axis];
+
+    uint32 mid = begin + count / 2;
+    if (extent > 0.0f && count > 2) {
+        // 中心をビンに振り分け、各分割位置の左右の (表面積 × 個数) の和が最小になる位置で分ける
+        struct Bin {
+            BoundingBox box;
+            uint32 count = 0;
+        };
+        Bin bins[SAH_BIN_COUNT];
+        const float binScale = SAH_BIN_COUNT / extent;
+        auto binIndex = [&](const BuildEntry& entry) {
+            const uint32 b = static_cast<uint32>((entry.centroid[axis] - centroidMin[axis]) * binScale);
+            return (std::min)(b, SAH_BIN_COUNT - 1);
+        };
+        for (uint32 i = begin; i < end; ++i) {
+            Bin& bin = bins[binIndex(entries[i])];
+            bin.box = bin.count == 0 ? nodes_[entries[i].node].box : BoundingBox::Merge(bin.box, nodes_[entries[i].node].box);
+            ++bin.count;
+        }
+
+        // rightCost[s] はビン s+1 以降をまとめた側のコスト
+        float rightCost[SAH_BIN_COUNT - 1];
+        BoundingBox rightBox;
+        uint32 rightCount = 0;
+        for (uint32 s = SAH_BIN_COUNT - 1; s > 0; --s) {
+            if (bins[s].count > 0) {
+                rightBox = rightCount == 0 ? bins[s].box : BoundingBox::Merge(rightBox, bins[s].box);
+                rightCount += bins[s].count;
+            }
+            rightCost[s - 1] = rightCount > 0 ? rightBox.GetSurfaceArea() * rightCount : 0.0f;
+        }
+
+        float bestCost = std::numeric_limits<float>::max();
+        uint32 bestSplit = SAH_BIN_COUNT;
+        BoundingBox leftBox;
+        uint32 leftCount = 0;
+        for (uint32 s = 0; s + 1 < SAH_BIN_COUNT; ++s) {
+            if (bins[s].count > 0) {
+                leftBox = leftCount == 0 ? bins[s].box : BoundingBox::Merge(leftBox, bins[s].box);
+                leftCount += bins[s].count;
+            }
+            if (leftCount == 0 || leftCount == count) continue;
+
+            const float cost = leftBox.GetSurfaceArea() * leftCount + rightCost[s];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = s;
+            }
+        }
+
+        if (bestSplit < SAH_BIN_COUNT) {
+            auto it = std::partition(entries.begin() + begin, entries.begin() + end,
+                [&](const BuildEntry& entry) { return binIndex(entry) <= bestSplit; });
+            mid = static_cast<uint32>(it - entries.begin());
+        }
+    } else if (extent > 0.0f) {
+        std::nth_element(entries.begin() + begin, entries.begin() + mid, entries.begin() + end,
+            [axis](const BuildEntry& a, const BuildEntry& b) { return a.centroid[axis] < b.centroid[axis]; });
+    }
+    // 中心がすべて重なっている場合は個数で半分に分ける
+
+    const int32 child1 = BuildRange(entries, begin, mid);
+    const int32 child2 = BuildRange(entries, mid, end);
+
+    const int32 index = AllocateNode();
+    Node& node = nodes_[index];
+    node.child1 = child1;
+    node.child2 = child2;
+    node.box = BoundingBox::Merge(nodes_[child1].box, nodes_[child2].box);
+    node.height = 1 + (std::max)(nodes_[child1].height, nodes_[child2].height);
+    nodes_[child1].parent = index;
+    nodes_[child2].parent = index;
+    return index;
+}
+
+bool BoundingVolumeTree::IntersectsRay(const BoundingBox& box, const float origin[3], const float invDirection[3],
+                                       float maxDistance, float& outEntry) {
+    float tMin = 0.0f;
+    float tMax = maxDistance;
+    for (uint32 axis = 0; axis < 3; ++axis) {
+        const float boxMin = GetAxis(box.min, axis);
+        const float boxMax = GetAxis(box.max, axis);
+        if (invDirection[axis] == 0.0f) {
+            // 軸に平行なレイはこの軸の範囲内にあるかだけを見る
+            if (origin[axis] < boxMin || origin[axis] > boxMax) {
+                return false;
+            }
+            continue;
+        }
+
+        float t1 = (boxMin - origin[axis]) * invDirection[axis];
+        float t2 = (boxMax - origin[axis]) * invDirection[axis];
+        if (t1 > t2) std::swap(t1, t2);
+        tMin = (std::max)(tMin, t1);
+        tMax = (std::min)(tMax, t2);
+        if (tMin > tMax) {
+            return false;
+        }
+    }
+    outEntry = tMin;
+    return true;
+}
+
+float BoundingVolumeTree::DistanceSq(const BoundingBox& box, const Vector3& point) {
+    float distanceSq = 0.0f;
+    for (uint32 axis = 0; axis < 3; ++axis) {
+        const float p = GetAxis(point, axis);
+        const float d = (std::max)((std::max)(GetAxis(box.min, axis) - p, 0.0f), p - GetAxis(box.max, axis));
+        distanceSq += d * d;
+    }
+    return distanceSq;
+}
+
+} // namespace UnoEngine
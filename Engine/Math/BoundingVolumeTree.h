@@ -0,0 +1,291 @@
+#pragma once
+
+#include "BoundingVolume.h"
+#include "Frustum.h"
+#include "../Core/Types.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace UnoEngine {
+
+// 動的AABBツリー（BVH）
+//
+// 葉は登録した箱を余白分だけ広げた「太った箱」を持ち、移動後の箱が太った箱に収まっている間はツリーを触らない
+// はみ出した葉だけを取り外して挿入し直し、祖先の箱と高さを付け直す（挿入先はSAHコストの増分が最小になる兄弟）
+// 付け直しの途中で左右の高さの差が2以上になった節点は回転して偏りを抑える
+// まとめて登録した直後などは Rebuild でビン分割SAHのトップダウン構築をやり直すと、以降の問い合わせが速くなる
+//
+// 問い合わせは太った箱に対して行うため、実際の箱とは交わらない葉も通知される（厳密な判定は呼び出し側で行う）
+class BoundingVolumeTree {
+public:
+    static constexpr int32 NULL_NODE = -1;
+
+    BoundingVolumeTree() = default;
+
+    // 箱を登録して番号（プロキシ）を返す。番号は DestroyProxy まで変わらない
+    // userDataは呼び出し側の管理番号（問い合わせの結果から元の物体を引くために使う）
+    int32 CreateProxy(const BoundingBox& box, uint32 userData);
+    void DestroyProxy(int32 proxy);
+
+    // 箱の移動。太った箱からはみ出した（または大きく縮んだ）場合だけ挿入し直してtrueを返す
+    bool MoveProxy(int32 proxy, const BoundingBox& box);
+
+    uint32 GetUserData(int32 proxy) const { return nodes_[proxy].userData; }
+    const BoundingBox& GetFatBox(int32 proxy) const { return nodes_[proxy].box; }
+
+    // 太った箱の余白（小さな移動のたびに挿入し直さないための遊び）
+    void SetMargin(float margin) { margin_ = margin; }
+    float GetMargin() const { return margin_; }
+
+    // 全ての葉からビン分割SAHでツリーを作り直す（プロキシ番号と太った箱は変わらない）
+    void Rebuild();
+
+    void Clear();
+
+    uint32 GetProxyCount() const { return proxyCount_; }
+    // 根の高さ（葉は0、空のツリーは-1）
+    int32 GetHeight() const { return root_ != NULL_NODE ? nodes_[root_].height : -1; }
+    // 内部節点の表面積の合計を根の表面積で割った値（ツリーの質の目安で、小さいほど問い合わせが速い）
+    float ComputeCost() const;
+
+    // 箱と交わる葉ごとに callback(proxy) を呼ぶ。falseを返すと打ち切る
+    template<typename Callback>
+    void QueryOverlap(const BoundingBox& box, Callback&& callback) const;
+
+    // 視錐台と交わる葉ごとに callback(proxy) を呼ぶ。falseを返すと打ち切る
+    // 完全に内側にある部分木は平面との判定を省いて葉をまとめて通知する
+    template<typename Callback>
+    void QueryFrustum(const Frustum& frustum, Callback&& callback) const;
+
+    // 始点からmaxDistance以内でレイ（directionは正規化済み）が通る葉ごとに callback(proxy, maxDistance) を呼ぶ
+    // callbackは物体に当たった距離を返す（当たらなければ受け取ったmaxDistanceをそのまま返し、負の値で打ち切る）
+    // 返された距離より遠い部分木は以降調べず、近い子から先に調べるため最も近い物を探す場合は早く打ち切れる
+    template<typename Callback>
+    void RayCast(const Vector3& origin, const Vector3& direction, float maxDistance, Callback&& callback) const;
+
+    // pointに最も近い葉を探す。callback(proxy) はその葉の物体までの距離の2乗を返す（対象外なら無限大）
+    // 箱までの距離が近い順に調べ、見つかった最小値より遠い箱は調べない。maxDistance未満に無ければNULL_NODE
+    template<typename Callback>
+    int32 FindNearest(const Vector3& point, float maxDistance, Callback&& callback) const;
+
+private:
+    struct Node {
+        BoundingBox box;
+        uint32 userData = 0;
+        int32 parent = NULL_NODE;   // 空き節点では次の空き節点
+        int32 child1 = NULL_NODE;
+        int32 child2 = NULL_NODE;
+        int32 height = -1;          // 葉は0、空き節点は-1
+
+        bool IsLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    // 走査用のスタック（浅いツリーではヒープを確保しない）
+    template<typename T>
+    class TraversalStack {
+    public:
+        void Push(const T& value) {
+            if (count_ < INLINE_CAPACITY) {
+                inline_[count_] = value;
+            } else {
+                overflow_.push_back(value);
+            }
+            ++count_;
+        }
+
+        T Pop() {
+            --count_;
+            if (count_ < INLINE_CAPACITY) {
+                return inline_[count_];
+            }
+            T value = overflow_.back();
+            overflow_.pop_back();
+            return value;
+        }
+
+        bool IsEmpty() const { return count_ == 0; }
+
+    private:
+        static constexpr uint32 INLINE_CAPACITY = 64;
+        T inline_[INLINE_CAPACITY];
+        std::vector<T> overflow_;
+        uint32 count_ = 0;
+    };
+
+    // Rebuild用の葉の情報
+    struct BuildEntry {
+        int32 node;
+        float centroid[3];
+    };
+
+    int32 AllocateNode();
+    void FreeNode(int32 node);
+
+    void InsertLeaf(int32 leaf);
+    void RemoveLeaf(int32 leaf);
+    // nodeから根までの箱と高さを付け直す（途中で回転する）
+    void Refit(int32 node);
+    // 左右の高さの差が2以上なら回転し、その位置の新しい節点を返す
+    int32 Balance(int32 node);
+
+    // entries[begin, end) の葉から部分木を作って根を返す
+    int32 BuildRange(std::vector<BuildEntry>& entries, uint32 begin, uint32 end);
+
+    BoundingBox Fatten(const BoundingBox& box) const {
+        const Vector3 margin(margin_, margin_, margin_);
+        return BoundingBox(box.min - margin, box.max + margin);
+    }
+
+    // レイ（逆方向ベクトル）と箱が [0, maxDistance] で交わるなら入る距離をoutEntryに書いてtrueを返す
+    static bool IntersectsRay(const BoundingBox& box, const float origin[3], const float invDirection[3],
+                              float maxDistance, float& outEntry);
+
+    static float DistanceSq(const BoundingBox& box, const Vector3& point);
+
+    std::vector<Node> nodes_;
+    int32 root_ = NULL_NODE;
+    int32 freeList_ = NULL_NODE;
+    uint32 proxyCount_ = 0;
+    float margin_ = 0.1f;
+};
+
+template<typename Callback>
+void BoundingVolumeTree::QueryOverlap(const BoundingBox& box, Callback&& callback) const {
+    if (root_ == NULL_NODE) return;
+
+    TraversalStack<int32> stack;
+    stack.Push(root_);
+    while (!stack.IsEmpty()) {
+        const int32 index = stack.Pop();
+        const Node& node = nodes_[index];
+        if (!node.box.Intersects(box)) continue;
+
+        if (node.IsLeaf()) {
+            if (!callback(index)) return;
+        } else {
+            stack.Push(node.child2);
+            stack.Push(node.child1);
+        }
+    }
+}
+
+template<typename Callback>
+void BoundingVolumeTree::QueryFrustum(const Frustum& frustum, Callback&& callback) const {
+    if (root_ == NULL_NODE) return;
+
+    // 第2要素は「祖先が視錐台の完全に内側にあった」（以降の判定は不要）
+    TraversalStack<std::pair<int32, bool>> stack;
+    stack.Push({ root_, false });
+    while (!stack.IsEmpty()) {
+        const auto [index, inside] = stack.Pop();
+        const Node& node = nodes_[index];
+
+        bool nodeInside = inside;
+        if (!nodeInside) {
+            if (!frustum.Intersects(node.box)) continue;
+            // 葉では完全に内側かどうかを調べても得にならない
+            nodeInside = !node.IsLeaf() && frustum.Contains(node.box);
+        }
+
+        if (node.IsLeaf()) {
+            if (!callback(index)) return;
+        } else {
+            stack.Push({ node.child2, nodeInside });
+            stack.Push({ node.child1, nodeInside });
+        }
+    }
+}
+
+template<typename Callback>
+void BoundingVolumeTree::RayCast(const Vector3& origin, const Vector3& direction, float maxDistance,
+                                 Callback&& callback) const {
+    if (root_ == NULL_NODE) return;
+
+    const float o[3] = { origin.GetX(), origin.GetY(), origin.GetZ() };
+    const float d[3] = { direction.GetX(), direction.GetY(), direction.GetZ() };
+    float invDirection[3];
+    for (uint32 axis = 0; axis < 3; ++axis) {
+        invDirection[axis] = std::abs(d[axis]) > 1e-8f ? 1.0f / d[axis] : 0.0f;
+    }
+
+    float rootEntry;
+    if (!IntersectsRay(nodes_[root_].box, o, invDirection, maxDistance, rootEntry)) return;
+
+    // 第2要素は箱に入る距離（積んだ後で見つかった当たりより遠ければ捨てる）
+    TraversalStack<std::pair<int32, float>> stack;
+    stack.Push({ root_, rootEntry });
+    while (!stack.IsEmpty()) {
+        const auto [index, entry] = stack.Pop();
+        if (entry > maxDistance) continue;
+
+        const Node& node = nodes_[index];
+        if (node.IsLeaf()) {
+            const float hit = callback(index, maxDistance);
+            if (hit < 0.0f) return;
+            maxDistance = (std::min)(maxDistance, hit);
+            continue;
+        }
+
+        float entry1, entry2;
+        const bool hit1 = IntersectsRay(nodes_[node.child1].box, o, invDirection, maxDistance, entry1);
+        const bool hit2 = IntersectsRay(nodes_[node.child2].box, o, invDirection, maxDistance, entry2);
+        if (hit1 && hit2) {
+            // 近い方を後に積んで先に取り出す
+            if (entry1 <= entry2) {
+                stack.Push({ node.child2, entry2 });
+                stack.Push({ node.child1, entry1 });
+            } else {
+                stack.Push({ node.child1, entry1 });
+                stack.Push({ node.child2, entry2 });
+            }
+        } else if (hit1) {
+            stack.Push({ node.child1, entry1 });
+        } else if (hit2) {
+            stack.Push({ node.child2, entry2 });
+        }
+    }
+}
+
+template<typename Callback>
+int32 BoundingVolumeTree::FindNearest(const Vector3& point, float maxDistance, Callback&& callback) const {
+    if (root_ == NULL_NODE) return NULL_NODE;
+
+    float bestDistanceSq = maxDistance * maxDistance;
+    int32 best = NULL_NODE;
+
+    // 箱までの距離の2乗が小さい順に取り出す
+    using QueueEntry = std::pair<float, int32>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    queue.push({ DistanceSq(nodes_[root_].box, point), root_ });
+    while (!queue.empty()) {
+        const auto [boxDistanceSq, index] = queue.top();
+        queue.pop();
+        // 残りの箱はすべてこれ以上遠い
+        if (boxDistanceSq >= bestDistanceSq) break;
+
+        const Node& node = nodes_[index];
+        if (node.IsLeaf()) {
+            const float distanceSq = callback(index);
+            if (distanceSq < bestDistanceSq) {
+                bestDistanceSq = distanceSq;
+                best = index;
+            }
+            continue;
+        }
+
+        for (const int32 child : { node.child1, node.child2 }) {
+            const float childDistanceSq = DistanceSq(nodes_[child].box, point);
+            if (childDistanceSq < bestDistanceSq) {
+                queue.push({ childDistanceSq, child });
+            }
+        }
+    }
+    return best;
+}
+
+} // namespace UnoEngine
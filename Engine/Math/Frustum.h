@@ -0,0 +1,241 @@
+#pragma once
+
+#include "BoundingVolume.h"
+#include "Matrix.h"
+#include "SimdConfig.h"
+#include "../Core/Types.h"
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace UnoEngine {
+
+// 視錐台カリング用のワールド空間AABBの配列
+// 中心と半分の大きさを成分ごとの配列（SoA）で持ち、Frustum::Cullで複数の箱をまとめてSIMDで判定する
+class CullingBoundsArray {
+public:
+    void Clear() {
+        for (std::vector<float>& stream : streams_) {
+            stream.clear();
+        }
+    }
+
+    void Reserve(uint32 count) {
+        for (std::vector<float>& stream : streams_) {
+            stream.reserve(count);
+        }
+    }
+
+    // ワールド空間の箱を追加して番号を返す
+    uint32 Add(const BoundingBox& box) {
+        const Vector3 center = box.GetCenter();
+        const Vector3 extents = box.GetExtents();
+        streams_[CX].push_back(center.GetX());
+        streams_[CY].push_back(center.GetY());
+        streams_[CZ].push_back(center.GetZ());
+        streams_[EX].push_back(extents.GetX());
+        streams_[EY].push_back(extents.GetY());
+        streams_[EZ].push_back(extents.GetZ());
+        return GetCount() - 1;
+    }
+
+    uint32 GetCount() const { return static_cast<uint32>(streams_[CX].size()); }
+
+private:
+    friend class Frustum;
+
+    enum Stream : uint32 {
+        CX, CY, CZ,     // 中心
+        EX, EY, EZ,     // 半分の大きさ
+        STREAM_COUNT
+    };
+
+    std::array<std::vector<float>, STREAM_COUNT> streams_;
+};
+
+// 視錐台（6枚の平面）
+// 平面(a, b, c, d)は a*x + b*y + c*z + d >= 0 の側が内側で、法線(a, b, c)は正規化してある
+// 判定は保守的で、どれか1枚の平面の完全に外側にある場合だけ見えないとする（角の付近では見えない物を残すことがある）
+class Frustum {
+public:
+    enum PlaneIndex : uint32 {
+        Left, Right, Bottom, Top, Near, Far,
+        PLANE_COUNT
+    };
+
+    Frustum() = default;
+
+    // 行ベクトル規約（v * M）のビュー射影行列から平面を取り出す（クリップ空間のzは0〜w、D3Dの規約）
+    // ワールド行列を掛けた行列を渡せば、そのオブジェクトのローカル空間の視錐台になる
+    explicit Frustum(const Matrix4x4& viewProjection) {
+        // クリップ座標の各成分は v と行列の各列の内積
+        auto column = [&](uint32 col, float (&out)[4]) {
+            for (uint32 row = 0; row < 4; ++row) {
+                out[row] = viewProjection.GetElement(row, col);
+            }
+        };
+        float c0[4], c1[4], c2[4], c3[4];
+        column(0, c0);
+        column(1, c1);
+        column(2, c2);
+        column(3, c3);
+
+        // -w <= x <= w, -w <= y <= w, 0 <= z <= w
+        float planes[PLANE_COUNT][4];
+        for (uint32 i = 0; i < 4; ++i) {
+            planes[Left][i] = c3[i] + c0[i];
+            planes[Right][i] = c3[i] - c0[i];
+            planes[Bottom][i] = c3[i] + c1[i];
+            planes[Top][i] = c3[i] - c1[i];
+            planes[Near][i] = c2[i];
+            planes[Far][i] = c3[i] - c2[i];
+        }
+
+        for (uint32 p = 0; p < PLANE_COUNT; ++p) {
+            const float length = std::sqrt(planes[p][0] * planes[p][0] + planes[p][1] * planes[p][1] +
+                                           planes[p][2] * planes[p][2]);
+            const float invLength = length > 0.0f ? 1.0f / length : 0.0f;
+            a_[p] = planes[p][0] * invLength;
+            b_[p] = planes[p][1] * invLength;
+            c_[p] = planes[p][2] * invLength;
+            d_[p] = planes[p][3] * invLength;
+        }
+    }
+
+    Vector4 GetPlane(uint32 index) const { return Vector4(a_[index], b_[index], c_[index], d_[index]); }
+
+    bool Intersects(const BoundingBox& box) const {
+        const Vector3 center = box.GetCenter();
+        const Vector3 extents = box.GetExtents();
+        return IntersectsBox(center.GetX(), center.GetY(), center.GetZ(),
+                             extents.GetX(), extents.GetY(), extents.GetZ());
+    }
+
+    // 箱が視錐台の完全に内側にあるか（BVHの走査で部分木の判定を省くために使う）
+    bool Contains(const BoundingBox& box) const {
+        const Vector3 center = box.GetCenter();
+        const Vector3 extents = box.GetExtents();
+        for (uint32 p = 0; p < PLANE_COUNT; ++p) {
+            const float distance = a_[p] * center.GetX() + b_[p] * center.GetY() + c_[p] * center.GetZ() + d_[p];
+            const float radius = std::abs(a_[p]) * extents.GetX() + std::abs(b_[p]) * extents.GetY() +
+                                 std::abs(c_[p]) * extents.GetZ();
+            if (distance - radius < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Intersects(const BoundingSphere& sphere) const {
+        for (uint32 p = 0; p < PLANE_COUNT; ++p) {
+            const float distance = a_[p] * sphere.center.GetX() + b_[p] * sphere.center.GetY() +
+                                   c_[p] * sphere.center.GetZ() + d_[p];
+            if (distance < -sphere.radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // boundsの各箱が視錐台と交わるか（1=交わる）をoutVisibleに書き出す
+    // AVXでは8個、SSE/NEONでは4個ずつ判定し、端数はスカラーで判定する
+    void Cull(const CullingBoundsArray& bounds, std::vector<uint8>& outVisible) const {
+        const uint32 count = bounds.GetCount();
+        outVisible.resize(count);
+        if (count == 0) {
+            return;
+        }
+
+        const float* cx = bounds.streams_[CullingBoundsArray::CX].data();
+        const float* cy = bounds.streams_[CullingBoundsArray::CY].data();
+        const float* cz = bounds.streams_[CullingBoundsArray::CZ].data();
+        const float* ex = bounds.streams_[CullingBoundsArray::EX].data();
+        const float* ey = bounds.streams_[CullingBoundsArray::EY].data();
+        const float* ez = bounds.streams_[CullingBoundsArray::EZ].data();
+        uint8* visible = outVisible.data();
+        uint32 i = 0;
+
+#if UNO_SIMD_AVX
+        for (; i + 8 <= count; i += 8) {
+            const __m256 x = _mm256_loadu_ps(cx + i), y = _mm256_loadu_ps(cy + i), z = _mm256_loadu_ps(cz + i);
+            const __m256 sx = _mm256_loadu_ps(ex + i), sy = _mm256_loadu_ps(ey + i), sz = _mm256_loadu_ps(ez + i);
+            __m256 outside = _mm256_setzero_ps();
+            for (uint32 p = 0; p < PLANE_COUNT; ++p) {
+                const __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+                    _mm256_mul_ps(_mm256_set1_ps(a_[p]), x), _mm256_mul_ps(_mm256_set1_ps(b_[p]), y)),
+                    _mm256_mul_ps(_mm256_set1_ps(c_[p]), z)), _mm256_set1_ps(d_[p]));
+                const __m256 radius = _mm256_add_ps(_mm256_add_ps(
+                    _mm256_mul_ps(_mm256_set1_ps(std::abs(a_[p])), sx), _mm256_mul_ps(_mm256_set1_ps(std::abs(b_[p])), sy)),
+                    _mm256_mul_ps(_mm256_set1_ps(std::abs(c_[p])), sz));
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_LT_OQ));
+            }
+            const int mask = _mm256_movemask_ps(outside);
+            for (uint32 k = 0; k < 8; ++k) {
+                visible[i + k] = static_cast<uint8>(((mask >> k) & 1) ^ 1);
+            }
+        }
+#endif
+#if UNO_SIMD_SSE
+        for (; i + 4 <= count; i += 4) {
+            const __m128 x = _mm_loadu_ps(cx + i), y = _mm_loadu_ps(cy + i), z = _mm_loadu_ps(cz + i);
+            const __m128 sx = _mm_loadu_ps(ex + i), sy = _mm_loadu_ps(ey + i), sz = _mm_loadu_ps(ez + i);
+            __m128 outside = _mm_setzero_ps();
+            for (uint32 p = 0; p < PLANE_COUNT; ++p) {
+                const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(_mm_set1_ps(a_[p]), x), _mm_mul_ps(_mm_set1_ps(b_[p]), y)),
+                    _mm_mul_ps(_mm_set1_ps(c_[p]), z)), _mm_set1_ps(d_[p]));
+                const __m128 radius = _mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(_mm_set1_ps(std::abs(a_[p])), sx), _mm_mul_ps(_mm_set1_ps(std::abs(b_[p])), sy)),
+                    _mm_mul_ps(_mm_set1_ps(std::abs(c_[p])), sz));
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+            }
+            const int mask = _mm_movemask_ps(outside);
+            for (uint32 k = 0; k < 4; ++k) {
+                visible[i + k] = static_cast<uint8>(((mask >> k) & 1) ^ 1);
+            }
+        }
+#elif UNO_SIMD_NEON
+        for (; i + 4 <= count; i += 4) {
+            const float32x4_t x = vld1q_f32(cx + i), y = vld1q_f32(cy + i), z = vld1q_f32(cz + i);
+            const float32x4_t sx = vld1q_f32(ex + i), sy = vld1q_f32(ey + i), sz = vld1q_f32(ez + i);
+            uint32x4_t outside = vdupq_n_u32(0);
+            for (uint32 p = 0; p < PLANE_COUNT; ++p) {
+                const float32x4_t distance = vaddq_f32(vaddq_f32(vaddq_f32(
+                    vmulq_n_f32(x, a_[p]), vmulq_n_f32(y, b_[p])), vmulq_n_f32(z, c_[p])), vdupq_n_f32(d_[p]));
+                const float32x4_t radius = vaddq_f32(vaddq_f32(
+                    vmulq_n_f32(sx, std::abs(a_[p])), vmulq_n_f32(sy, std::abs(b_[p]))), vmulq_n_f32(sz, std::abs(c_[p])));
+                outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(distance, radius), vdupq_n_f32(0.0f)));
+            }
+            uint32 lanes[4];
+            vst1q_u32(lanes, outside);
+            for (uint32 k = 0; k < 4; ++k) {
+                visible[i + k] = lanes[k] ? 0 : 1;
+            }
+        }
+#endif
+
+        for (; i < count; ++i) {
+            visible[i] = IntersectsBox(cx[i], cy[i], cz[i], ex[i], ey[i], ez[i]) ? 1 : 0;
+        }
+    }
+
+private:
+    // SIMD版と同じ演算順序で計算する
+    bool IntersectsBox(float x, float y, float z, float sx, float sy, float sz) const {
+        for (uint32 p = 0; p < PLANE_COUNT; ++p) {
+            const float distance = a_[p] * x + b_[p] * y + c_[p] * z + d_[p];
+            const float radius = std::abs(a_[p]) * sx + std::abs(b_[p]) * sy + std::abs(c_[p]) * sz;
+            if (distance + radius < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    float a_[PLANE_COUNT] = {};
+    float b_[PLANE_COUNT] = {};
+    float c_[PLANE_COUNT] = {};
+    float d_[PLANE_COUNT] = {};
+};
+
+} // namespace UnoEngine
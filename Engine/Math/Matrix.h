@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Vector.h"
+#include "MatrixKernels.h"
 #include "../Core/Types.h"
 #include <cmath>
 #include <cstring>
@@ -10,7 +11,8 @@ namespace UnoEngine {
 class Quaternion;
 
 // 4x4行列 (行優先 row-major)
-class Matrix4x4 {
+// 演算はMatrixKernels.hのSIMDカーネルで行うため16バイト境界に配置する
+class alignas(16) Matrix4x4 {
 public:
     // デフォルトコンストラクタ（単位行列）
     Matrix4x4() {
@@ -31,63 +33,45 @@ public:
 
     // 行列乗算
     Matrix4x4 operator*(const Matrix4x4& rhs) const {
-        Matrix4x4 result;
-        for (int i = 0; i < 4; ++i) {
-            for (int j = 0; j < 4; ++j) {
-                result.m_[i][j] = m_[i][0] * rhs.m_[0][j] +
-                                  m_[i][1] * rhs.m_[1][j] +
-                                  m_[i][2] * rhs.m_[2][j] +
-                                  m_[i][3] * rhs.m_[3][j];
-            }
-        }
+        Matrix4x4 result(Uninitialized{});
+        Math::MatrixMultiply(GetData(), rhs.GetData(), result.GetData());
         return result;
     }
 
     Matrix4x4& operator*=(const Matrix4x4& rhs) {
-        *this = *this * rhs;
+        Math::MatrixMultiply(GetData(), rhs.GetData(), GetData());
         return *this;
     }
 
     // ベクトル変換（点: w=1として変換、パースペクティブ除算あり）
     Vector3 TransformPoint(const Vector3& point) const {
-        float x = point.GetX() * m_[0][0] + point.GetY() * m_[1][0] + point.GetZ() * m_[2][0] + m_[3][0];
-        float y = point.GetX() * m_[0][1] + point.GetY() * m_[1][1] + point.GetZ() * m_[2][1] + m_[3][1];
-        float z = point.GetX() * m_[0][2] + point.GetY() * m_[1][2] + point.GetZ() * m_[2][2] + m_[3][2];
-        float w = point.GetX() * m_[0][3] + point.GetY() * m_[1][3] + point.GetZ() * m_[2][3] + m_[3][3];
-        if (std::abs(w) > 1e-6f) {
-            float invW = 1.0f / w;
-            return Vector3(x * invW, y * invW, z * invW);
-        }
-        return Vector3(x, y, z);
+        float in[3] = { point.GetX(), point.GetY(), point.GetZ() };
+        float out[3];
+        Math::TransformPoint(GetData(), in, out);
+        return Vector3(out[0], out[1], out[2]);
     }
 
     // 方向変換（w=0として変換、平行移動なし）
     Vector3 TransformDirection(const Vector3& dir) const {
-        return Vector3(
-            dir.GetX() * m_[0][0] + dir.GetY() * m_[1][0] + dir.GetZ() * m_[2][0],
-            dir.GetX() * m_[0][1] + dir.GetY() * m_[1][1] + dir.GetZ() * m_[2][1],
-            dir.GetX() * m_[0][2] + dir.GetY() * m_[1][2] + dir.GetZ() * m_[2][2]
-        );
+        float in[3] = { dir.GetX(), dir.GetY(), dir.GetZ() };
+        float out[3];
+        Math::TransformDirection(GetData(), in, out);
+        return Vector3(out[0], out[1], out[2]);
     }
 
     // Vector4変換
     Vector4 TransformVector4(const Vector4& vec) const {
-        return Vector4(
-            vec.GetX() * m_[0][0] + vec.GetY() * m_[1][0] + vec.GetZ() * m_[2][0] + vec.GetW() * m_[3][0],
-            vec.GetX() * m_[0][1] + vec.GetY() * m_[1][1] + vec.GetZ() * m_[2][1] + vec.GetW() * m_[3][1],
-            vec.GetX() * m_[0][2] + vec.GetY() * m_[1][2] + vec.GetZ() * m_[2][2] + vec.GetW() * m_[3][2],
-            vec.GetX() * m_[0][3] + vec.GetY() * m_[1][3] + vec.GetZ() * m_[2][3] + vec.GetW() * m_[3][3]
-        );
+        float in[4] = { vec.GetX(), vec.GetY(), vec.GetZ(), vec.GetW() };
+        float out[4];
+        Math::TransformVector4(GetData(), in, out);
+        return Vector4(out[0], out[1], out[2], out[3]);
     }
 
     // 転置
     Matrix4x4 Transpose() const {
-        return Matrix4x4(
-            m_[0][0], m_[1][0], m_[2][0], m_[3][0],
-            m_[0][1], m_[1][1], m_[2][1], m_[3][1],
-            m_[0][2], m_[1][2], m_[2][2], m_[3][2],
-            m_[0][3], m_[1][3], m_[2][3], m_[3][3]
-        );
+        Matrix4x4 result(Uninitialized{});
+        Math::MatrixTranspose(GetData(), result.GetData());
+        return result;
     }
 
     // 行列式
@@ -109,42 +93,10 @@ public:
 
     // 逆行列
     Matrix4x4 Inverse() const {
-        float a0 = m_[0][0] * m_[1][1] - m_[0][1] * m_[1][0];
-        float a1 = m_[0][0] * m_[1][2] - m_[0][2] * m_[1][0];
-        float a2 = m_[0][0] * m_[1][3] - m_[0][3] * m_[1][0];
-        float a3 = m_[0][1] * m_[1][2] - m_[0][2] * m_[1][1];
-        float a4 = m_[0][1] * m_[1][3] - m_[0][3] * m_[1][1];
-        float a5 = m_[0][2] * m_[1][3] - m_[0][3] * m_[1][2];
-        float b0 = m_[2][0] * m_[3][1] - m_[2][1] * m_[3][0];
-        float b1 = m_[2][0] * m_[3][2] - m_[2][2] * m_[3][0];
-        float b2 = m_[2][0] * m_[3][3] - m_[2][3] * m_[3][0];
-        float b3 = m_[2][1] * m_[3][2] - m_[2][2] * m_[3][1];
-        float b4 = m_[2][1] * m_[3][3] - m_[2][3] * m_[3][1];
-        float b5 = m_[2][2] * m_[3][3] - m_[2][3] * m_[3][2];
-
-        float det = a0 * b5 - a1 * b4 + a2 * b3 + a3 * b2 - a4 * b1 + a5 * b0;
-        if (std::abs(det) < 1e-10f) {
+        Matrix4x4 result(Uninitialized{});
+        if (!Math::MatrixInverse(GetData(), result.GetData())) {
             return Identity(); // 特異行列の場合は単位行列を返す
         }
-        float invDet = 1.0f / det;
-
-        Matrix4x4 result;
-        result.m_[0][0] = (+m_[1][1] * b5 - m_[1][2] * b4 + m_[1][3] * b3) * invDet;
-        result.m_[0][1] = (-m_[0][1] * b5 + m_[0][2] * b4 - m_[0][3] * b3) * invDet;
-        result.m_[0][2] = (+m_[3][1] * a5 - m_[3][2] * a4 + m_[3][3] * a3) * invDet;
-        result.m_[0][3] = (-m_[2][1] * a5 + m_[2][2] * a4 - m_[2][3] * a3) * invDet;
-        result.m_[1][0] = (-m_[1][0] * b5 + m_[1][2] * b2 - m_[1][3] * b1) * invDet;
-        result.m_[1][1] = (+m_[0][0] * b5 - m_[0][2] * b2 + m_[0][3] * b1) * invDet;
-        result.m_[1][2] = (-m_[3][0] * a5 + m_[3][2] * a2 - m_[3][3] * a1) * invDet;
-        result.m_[1][3] = (+m_[2][0] * a5 - m_[2][2] * a2 + m_[2][3] * a1) * invDet;
-        result.m_[2][0] = (+m_[1][0] * b4 - m_[1][1] * b2 + m_[1][3] * b0) * invDet;
-        result.m_[2][1] = (-m_[0][0] * b4 + m_[0][1] * b2 - m_[0][3] * b0) * invDet;
-        result.m_[2][2] = (+m_[3][0] * a4 - m_[3][1] * a2 + m_[3][3] * a0) * invDet;
-        result.m_[2][3] = (-m_[2][0] * a4 + m_[2][1] * a2 - m_[2][3] * a0) * invDet;
-        result.m_[3][0] = (-m_[1][0] * b3 + m_[1][1] * b1 - m_[1][2] * b0) * invDet;
-        result.m_[3][1] = (+m_[0][0] * b3 - m_[0][1] * b1 + m_[0][2] * b0) * invDet;
-        result.m_[3][2] = (-m_[3][0] * a3 + m_[3][1] * a1 - m_[3][2] * a0) * invDet;
-        result.m_[3][3] = (+m_[2][0] * a3 - m_[2][1] * a1 + m_[2][2] * a0) * invDet;
         return result;
     }
 
@@ -152,23 +104,19 @@ public:
     float GetElement(uint32 row, uint32 col) const { return m_[row][col]; }
     void SetElement(uint32 row, uint32 col, float value) { m_[row][col] = value; }
 
+    // 行優先16要素への直接アクセス（カーネル・GPU転送用）
+    const float* GetData() const { return &m_[0][0]; }
+    float* GetData() { return &m_[0][0]; }
+
     // float配列への変換（ImGuizmo用）
     void ToFloatArray(float* out) const {
-        for (int i = 0; i < 4; ++i) {
-            for (int j = 0; j < 4; ++j) {
-                out[i * 4 + j] = m_[i][j];
-            }
-        }
+        std::memcpy(out, m_, sizeof(m_));
     }
 
     // float配列からの変換
     static Matrix4x4 FromFloatArray(const float* data) {
-        Matrix4x4 result;
-        for (int i = 0; i < 4; ++i) {
-            for (int j = 0; j < 4; ++j) {
-                result.m_[i][j] = data[i * 4 + j];
-            }
-        }
+        Matrix4x4 result(Uninitialized{});
+        std::memcpy(result.m_, data, sizeof(result.m_));
         return result;
     }
 
@@ -217,6 +165,9 @@ public:
 
     static Matrix4x4 CreateFromQuaternion(const Quaternion& q);
 
+    // S * R * T で構成された行列をスケール・回転・平行移動に分解する（シアーは無視される）
+    void Decompose(Vector3& outScale, Quaternion& outRotation, Vector3& outTranslation) const;
+
     // X軸回転
     static Matrix4x4 RotationX(float radians) {
         float c = std::cos(radians);
@@ -338,6 +289,10 @@ public:
     }
 
 private:
+    // 全要素をカーネルで上書きする場合の初期化省略用
+    struct Uninitialized {};
+    explicit Matrix4x4(Uninitialized) {}
+
     float m_[4][4];
 };
 
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Matrix.h"
+#include "MathCommon.h"
+#include "MatrixKernels.h"
+#include <cassert>
+#include <span>
+
+// Matrix4x4 / Vector3 配列に対する一括演算
+// 要素ごとに演算子を呼ぶ代わりに、共通オペランドをレジスタに保持したまま配列全体を1パスで処理する
+// 出力は入力と同じ配列でもよい（部分的に重なる範囲は不可）
+
+namespace UnoEngine {
+namespace Math {
+
+constexpr size_t MATRIX_FLOAT_STRIDE = 16;
+constexpr size_t VECTOR3_FLOAT_STRIDE = 3;
+
+static_assert(sizeof(Matrix4x4) == sizeof(float) * MATRIX_FLOAT_STRIDE, "Matrix4x4 must be 16 tightly packed floats");
+static_assert(sizeof(Float4x4) == sizeof(float) * MATRIX_FLOAT_STRIDE, "Float4x4 must be 16 tightly packed floats");
+static_assert(sizeof(Vector3) == sizeof(float) * VECTOR3_FLOAT_STRIDE, "Vector3 must be 3 tightly packed floats");
+
+// out[i] = lhs[i] * rhs
+inline void MultiplyArray(std::span<const Matrix4x4> lhs, const Matrix4x4& rhs, std::span<Matrix4x4> out) {
+    assert(out.size() >= lhs.size());
+    if (lhs.empty()) return;
+    MatrixMultiplyArray(lhs.data()->GetData(), MATRIX_FLOAT_STRIDE, rhs.GetData(),
+                        out.data()->GetData(), MATRIX_FLOAT_STRIDE, lhs.size());
+}
+
+// out[i] = lhs * rhs[i]
+inline void MultiplyArray(const Matrix4x4& lhs, std::span<const Matrix4x4> rhs, std::span<Matrix4x4> out) {
+    assert(out.size() >= rhs.size());
+    if (rhs.empty()) return;
+    MatrixMultiplyArrayLeft(lhs.GetData(), rhs.data()->GetData(), MATRIX_FLOAT_STRIDE,
+                            out.data()->GetData(), MATRIX_FLOAT_STRIDE, rhs.size());
+}
+
+// out[i] = lhs[i] * rhs[i]
+inline void MultiplyPairwise(std::span<const Matrix4x4> lhs, std::span<const Matrix4x4> rhs, std::span<Matrix4x4> out) {
+    assert(rhs.size() >= lhs.size() && out.size() >= lhs.size());
+    if (lhs.empty()) return;
+    MatrixMultiplyPairwise(lhs.data()->GetData(), MATRIX_FLOAT_STRIDE, rhs.data()->GetData(), MATRIX_FLOAT_STRIDE,
+                           out.data()->GetData(), MATRIX_FLOAT_STRIDE, lhs.size());
+}
+
+inline void TransposeArray(std::span<const Matrix4x4> in, std::span<Matrix4x4> out) {
+    assert(out.size() >= in.size());
+    if (in.empty()) return;
+    MatrixTransposeArray(in.data()->GetData(), MATRIX_FLOAT_STRIDE,
+                         out.data()->GetData(), MATRIX_FLOAT_STRIDE, in.size());
+}
+
+// 法線変換用の逆転置行列（特異行列は単位行列）
+inline void InverseTransposeArray(std::span<const Matrix4x4> in, std::span<Matrix4x4> out) {
+    assert(out.size() >= in.size());
+    if (in.empty()) return;
+    MatrixInverseTransposeArray(in.data()->GetData(), MATRIX_FLOAT_STRIDE,
+                                out.data()->GetData(), MATRIX_FLOAT_STRIDE, in.size());
+}
+
+// out[i] = m.TransformPoint(points[i])
+inline void TransformPoints(const Matrix4x4& m, std::span<const Vector3> points, std::span<Vector3> out) {
+    assert(out.size() >= points.size());
+    if (points.empty()) return;
+    TransformPointArray(m.GetData(), reinterpret_cast<const float*>(points.data()), VECTOR3_FLOAT_STRIDE,
+                        reinterpret_cast<float*>(out.data()), VECTOR3_FLOAT_STRIDE, points.size());
+}
+
+// シェーダー用に転置してFloat4x4配列へ格納（アップロードバッファへの直接書き込み用）
+inline void StoreTransposedArray(std::span<const Matrix4x4> in, std::span<Float4x4> out) {
+    assert(out.size() >= in.size());
+    if (in.empty()) return;
+    MatrixTransposeArray(in.data()->GetData(), MATRIX_FLOAT_STRIDE,
+                         &out.data()->m[0][0], MATRIX_FLOAT_STRIDE, in.size());
+}
+
+} // namespace Math
+} // namespace UnoEngine
@@ -0,0 +1,687 @@
+#pragma once
+
+#include "SimdConfig.h"
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+// 4x4行列・クォータニオン演算のカーネル群
+// すべて行優先（row-major）のfloat[16]を入出力とし、点は行ベクトルとして左から掛ける（v * M）
+// 出力バッファは入力と同じアドレスでもよい
+//
+// Scalar:: は常に利用可能な参照実装、Simd:: はビルド設定で選択された命令セットの実装
+// Math:: 直下の関数がコンパイル時にどちらかへディスパッチする
+//
+// 〜Array関数は行列・点の配列をまとめて処理する一括版（strideはfloat単位、連続したMatrix4x4配列なら16）
+//
+// 乗算と変換はスカラー版と同じ加算順序で計算するため結果はビット単位で一致する
+// 逆行列・クォータニオン変換は演算順序が異なるため丸め誤差の範囲で一致する
+
+namespace UnoEngine {
+namespace Math {
+
+// 逆行列計算で特異行列とみなす行列式の閾値
+constexpr float SINGULAR_DETERMINANT_EPSILON = 1e-10f;
+
+namespace Scalar {
+
+inline void MatrixMultiply(const float* a, const float* b, float* out) {
+    float result[16];
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            result[i * 4 + j] = a[i * 4 + 0] * b[0 * 4 + j] +
+                                a[i * 4 + 1] * b[1 * 4 + j] +
+                                a[i * 4 + 2] * b[2 * 4 + j] +
+                                a[i * 4 + 3] * b[3 * 4 + j];
+        }
+    }
+    std::memcpy(out, result, sizeof(result));
+}
+
+inline void MatrixTranspose(const float* m, float* out) {
+    float result[16];
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            result[j * 4 + i] = m[i * 4 + j];
+        }
+    }
+    std::memcpy(out, result, sizeof(result));
+}
+
+// 特異行列の場合はfalseを返し、outは変更しない
+inline bool MatrixInverse(const float* m, float* out) {
+    float a0 = m[0] * m[5] - m[1] * m[4];
+    float a1 = m[0] * m[6] - m[2] * m[4];
+    float a2 = m[0] * m[7] - m[3] * m[4];
+    float a3 = m[1] * m[6] - m[2] * m[5];
+    float a4 = m[1] * m[7] - m[3] * m[5];
+    float a5 = m[2] * m[7] - m[3] * m[6];
+    float b0 = m[8] * m[13] - m[9] * m[12];
+    float b1 = m[8] * m[14] - m[10] * m[12];
+    float b2 = m[8] * m[15] - m[11] * m[12];
+    float b3 = m[9] * m[14] - m[10] * m[13];
+    float b4 = m[9] * m[15] - m[11] * m[13];
+    float b5 = m[10] * m[15] - m[11] * m[14];
+
+    float det = a0 * b5 - a1 * b4 + a2 * b3 + a3 * b2 - a4 * b1 + a5 * b0;
+    if (std::abs(det) < SINGULAR_DETERMINANT_EPSILON) {
+        return false;
+    }
+    float invDet = 1.0f / det;
+
+    float result[16];
+    result[0]  = (+m[5] * b5 - m[6] * b4 + m[7] * b3) * invDet;
+    result[1]  = (-m[1] * b5 + m[2] * b4 - m[3] * b3) * invDet;
+    result[2]  = (+m[13] * a5 - m[14] * a4 + m[15] * a3) * invDet;
+    result[3]  = (-m[9] * a5 + m[10] * a4 - m[11] * a3) * invDet;
+    result[4]  = (-m[4] * b5 + m[6] * b2 - m[7] * b1) * invDet;
+    result[5]  = (+m[0] * b5 - m[2] * b2 + m[3] * b1) * invDet;
+    result[6]  = (-m[12] * a5 + m[14] * a2 - m[15] * a1) * invDet;
+    result[7]  = (+m[8] * a5 - m[10] * a2 + m[11] * a1) * invDet;
+    result[8]  = (+m[4] * b4 - m[5] * b2 + m[7] * b0) * invDet;
+    result[9]  = (-m[0] * b4 + m[1] * b2 - m[3] * b0) * invDet;
+    result[10] = (+m[12] * a4 - m[13] * a2 + m[15] * a0) * invDet;
+    result[11] = (-m[8] * a4 + m[9] * a2 - m[11] * a0) * invDet;
+    result[12] = (-m[4] * b3 + m[5] * b1 - m[6] * b0) * invDet;
+    result[13] = (+m[0] * b3 - m[1] * b1 + m[2] * b0) * invDet;
+    result[14] = (-m[12] * a3 + m[13] * a1 - m[14] * a0) * invDet;
+    result[15] = (+m[8] * a3 - m[9] * a1 + m[10] * a0) * invDet;
+    std::memcpy(out, result, sizeof(result));
+    return true;
+}
+
+// 点変換（w=1、パースペクティブ除算あり）
+inline void TransformPoint(const float* m, const float* point, float* out) {
+    float x = point[0] * m[0] + point[1] * m[4] + point[2] * m[8] + m[12];
+    float y = point[0] * m[1] + point[1] * m[5] + point[2] * m[9] + m[13];
+    float z = point[0] * m[2] + point[1] * m[6] + point[2] * m[10] + m[14];
+    float w = point[0] * m[3] + point[1] * m[7] + point[2] * m[11] + m[15];
+    if (std::abs(w) > 1e-6f) {
+        float invW = 1.0f / w;
+        x *= invW;
+        y *= invW;
+        z *= invW;
+    }
+    out[0] = x;
+    out[1] = y;
+    out[2] = z;
+}
+
+// 方向変換（w=0、平行移動なし）
+inline void TransformDirection(const float* m, const float* dir, float* out) {
+    float x = dir[0] * m[0] + dir[1] * m[4] + dir[2] * m[8];
+    float y = dir[0] * m[1] + dir[1] * m[5] + dir[2] * m[9];
+    float z = dir[0] * m[2] + dir[1] * m[6] + dir[2] * m[10];
+    out[0] = x;
+    out[1] = y;
+    out[2] = z;
+}
+
+inline void TransformVector4(const float* m, const float* vec, float* out) {
+    float x = vec[0] * m[0] + vec[1] * m[4] + vec[2] * m[8] + vec[3] * m[12];
+    float y = vec[0] * m[1] + vec[1] * m[5] + vec[2] * m[9] + vec[3] * m[13];
+    float z = vec[0] * m[2] + vec[1] * m[6] + vec[2] * m[10] + vec[3] * m[14];
+    float w = vec[0] * m[3] + vec[1] * m[7] + vec[2] * m[11] + vec[3] * m[15];
+    out[0] = x;
+    out[1] = y;
+    out[2] = z;
+    out[3] = w;
+}
+
+// クォータニオン(x, y, z, w)から回転行列を生成
+inline void QuaternionToMatrix(const float* q, float* out) {
+    float xx = q[0] * q[0];
+    float yy = q[1] * q[1];
+    float zz = q[2] * q[2];
+    float xy = q[0] * q[1];
+    float xz = q[0] * q[2];
+    float yz = q[1] * q[2];
+    float wx = q[3] * q[0];
+    float wy = q[3] * q[1];
+    float wz = q[3] * q[2];
+
+    out[0]  = 1.0f - 2.0f * (yy + zz); out[1]  = 2.0f * (xy + wz);        out[2]  = 2.0f * (xz - wy);        out[3]  = 0.0f;
+    out[4]  = 2.0f * (xy - wz);        out[5]  = 1.0f - 2.0f * (xx + zz); out[6]  = 2.0f * (yz + wx);        out[7]  = 0.0f;
+    out[8]  = 2.0f * (xz + wy);        out[9]  = 2.0f * (yz - wx);        out[10] = 1.0f - 2.0f * (xx + yy); out[11] = 0.0f;
+    out[12] = 0.0f;                    out[13] = 0.0f;                    out[14] = 0.0f;                    out[15] = 1.0f;
+}
+
+// 法線変換用行列（アフィン行列の左上3x3の逆転置）
+// 3x3の逆転置は各行の外積（余因子）を行列式で割ったもので、4x4の逆行列より大幅に少ない演算で求まる
+// 第4行・第4列は平行移動なしの単位行列の値にする。特異行列は単位行列になる
+inline void MatrixNormal(const float* m, float* out) {
+    // 行 r0, r1, r2 に対して (r1 x r2, r2 x r0, r0 x r1) / det
+    float c0x = m[5] * m[10] - m[6] * m[9];
+    float c0y = m[6] * m[8] - m[4] * m[10];
+    float c0z = m[4] * m[9] - m[5] * m[8];
+    float c1x = m[9] * m[2] - m[10] * m[1];
+    float c1y = m[10] * m[0] - m[8] * m[2];
+    float c1z = m[8] * m[1] - m[9] * m[0];
+    float c2x = m[1] * m[6] - m[2] * m[5];
+    float c2y = m[2] * m[4] - m[0] * m[6];
+    float c2z = m[0] * m[5] - m[1] * m[4];
+
+    float det = m[0] * c0x + m[1] * c0y + m[2] * c0z;
+    if (std::abs(det) < SINGULAR_DETERMINANT_EPSILON) {
+        std::memset(out, 0, sizeof(float) * 16);
+        out[0] = out[5] = out[10] = out[15] = 1.0f;
+        return;
+    }
+    float invDet = 1.0f / det;
+
+    out[0]  = c0x * invDet; out[1]  = c0y * invDet; out[2]  = c0z * invDet; out[3]  = 0.0f;
+    out[4]  = c1x * invDet; out[5]  = c1y * invDet; out[6]  = c1z * invDet; out[7]  = 0.0f;
+    out[8]  = c2x * invDet; out[9]  = c2y * invDet; out[10] = c2z * invDet; out[11] = 0.0f;
+    out[12] = 0.0f;         out[13] = 0.0f;         out[14] = 0.0f;         out[15] = 1.0f;
+}
+
+} // namespace Scalar
+
+#if UNO_SIMD_SSE
+
+namespace Simd {
+
+// _mm_shuffle_psの引数順（x, y, z, w = 出力レーン0..3が参照する入力レーン）
+#define UNO_SHUFFLE_MASK(x, y, z, w) ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+
+namespace Detail {
+
+template<int Mask>
+inline __m128 Swizzle(__m128 v) {
+    return _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(v), Mask));
+}
+
+// 行ベクトル v * M（M の各行を rows[0..3] に保持）
+inline __m128 RowTransform(__m128 x, __m128 y, __m128 z, __m128 w,
+                           __m128 r0, __m128 r1, __m128 r2, __m128 r3) {
+    __m128 result = _mm_mul_ps(x, r0);
+    result = _mm_add_ps(result, _mm_mul_ps(y, r1));
+    result = _mm_add_ps(result, _mm_mul_ps(z, r2));
+    result = _mm_add_ps(result, _mm_mul_ps(w, r3));
+    return result;
+}
+
+// 2x2行列（行優先で1レジスタに格納）の積 A * B
+inline __m128 Mat2Mul(__m128 a, __m128 b) {
+    return _mm_add_ps(_mm_mul_ps(a, Swizzle<UNO_SHUFFLE_MASK(0, 3, 0, 3)>(b)),
+                      _mm_mul_ps(Swizzle<UNO_SHUFFLE_MASK(1, 0, 3, 2)>(a), Swizzle<UNO_SHUFFLE_MASK(2, 1, 2, 1)>(b)));
+}
+
+// 余因子行列との積 adj(A) * B
+inline __m128 Mat2AdjMul(__m128 a, __m128 b) {
+    return _mm_sub_ps(_mm_mul_ps(Swizzle<UNO_SHUFFLE_MASK(3, 3, 0, 0)>(a), b),
+                      _mm_mul_ps(Swizzle<UNO_SHUFFLE_MASK(1, 1, 2, 2)>(a), Swizzle<UNO_SHUFFLE_MASK(2, 3, 0, 1)>(b)));
+}
+
+// 余因子行列との積 A * adj(B)
+inline __m128 Mat2MulAdj(__m128 a, __m128 b) {
+    return _mm_sub_ps(_mm_mul_ps(a, Swizzle<UNO_SHUFFLE_MASK(3, 0, 3, 0)>(b)),
+                      _mm_mul_ps(Swizzle<UNO_SHUFFLE_MASK(1, 0, 3, 2)>(a), Swizzle<UNO_SHUFFLE_MASK(2, 1, 2, 1)>(b)));
+}
+
+} // namespace Detail
+
+inline void MatrixMultiply(const float* a, const float* b, float* out) {
+    __m128 b0 = _mm_loadu_ps(b + 0);
+    __m128 b1 = _mm_loadu_ps(b + 4);
+    __m128 b2 = _mm_loadu_ps(b + 8);
+    __m128 b3 = _mm_loadu_ps(b + 12);
+
+#if UNO_SIMD_AVX
+    // 2行ずつ処理（各128bitレーンに1行）
+    __m256 bb0 = _mm256_set_m128(b0, b0);
+    __m256 bb1 = _mm256_set_m128(b1, b1);
+    __m256 bb2 = _mm256_set_m128(b2, b2);
+    __m256 bb3 = _mm256_set_m128(b3, b3);
+    __m256 a01 = _mm256_loadu_ps(a + 0);
+    __m256 a23 = _mm256_loadu_ps(a + 8);
+
+    __m256 r01 = _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x00), bb0);
+    r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x55), bb1));
+    r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xAA), bb2));
+    r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xFF), bb3));
+
+    __m256 r23 = _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x00), bb0);
+    r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x55), bb1));
+    r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xAA), bb2));
+    r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xFF), bb3));
+
+    _mm256_storeu_ps(out + 0, r01);
+    _mm256_storeu_ps(out + 8, r23);
+#else
+    __m128 rows[4];
+    for (int i = 0; i < 4; ++i) {
+        __m128 row = _mm_loadu_ps(a + i * 4);
+        rows[i] = Detail::RowTransform(
+            _mm_shuffle_ps(row, row, 0x00), _mm_shuffle_ps(row, row, 0x55),
+            _mm_shuffle_ps(row, row, 0xAA), _mm_shuffle_ps(row, row, 0xFF),
+            b0, b1, b2, b3);
+    }
+    for (int i = 0; i < 4; ++i) {
+        _mm_storeu_ps(out + i * 4, rows[i]);
+    }
+#endif
+}
+
+inline void MatrixTranspose(const float* m, float* out) {
+    __m128 r0 = _mm_loadu_ps(m + 0);
+    __m128 r1 = _mm_loadu_ps(m + 4);
+    __m128 r2 = _mm_loadu_ps(m + 8);
+    __m128 r3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(out + 0, r0);
+    _mm_storeu_ps(out + 4, r1);
+    _mm_storeu_ps(out + 8, r2);
+    _mm_storeu_ps(out + 12, r3);
+}
+
+namespace Detail {
+
+// 2x2ブロック分割による逆行列（結果の各行をrowsに返す）
+// 特異行列の場合はfalseを返し、rowsは変更しない
+inline bool InverseRows(const float* m, __m128* rows) {
+    __m128 r0 = _mm_loadu_ps(m + 0);
+    __m128 r1 = _mm_loadu_ps(m + 4);
+    __m128 r2 = _mm_loadu_ps(m + 8);
+    __m128 r3 = _mm_loadu_ps(m + 12);
+
+    // | A B |
+    // | C D |
+    __m128 A = _mm_movelh_ps(r0, r1);
+    __m128 B = _mm_movehl_ps(r1, r0);
+    __m128 C = _mm_movelh_ps(r2, r3);
+    __m128 D = _mm_movehl_ps(r3, r2);
+
+    // 各ブロックの行列式 (|A|, |B|, |C|, |D|)
+    __m128 detSub = _mm_sub_ps(
+        _mm_mul_ps(_mm_shuffle_ps(r0, r2, UNO_SHUFFLE_MASK(0, 2, 0, 2)), _mm_shuffle_ps(r1, r3, UNO_SHUFFLE_MASK(1, 3, 1, 3))),
+        _mm_mul_ps(_mm_shuffle_ps(r0, r2, UNO_SHUFFLE_MASK(1, 3, 1, 3)), _mm_shuffle_ps(r1, r3, UNO_SHUFFLE_MASK(0, 2, 0, 2))));
+    __m128 detA = Swizzle<UNO_SHUFFLE_MASK(0, 0, 0, 0)>(detSub);
+    __m128 detB = Swizzle<UNO_SHUFFLE_MASK(1, 1, 1, 1)>(detSub);
+    __m128 detC = Swizzle<UNO_SHUFFLE_MASK(2, 2, 2, 2)>(detSub);
+    __m128 detD = Swizzle<UNO_SHUFFLE_MASK(3, 3, 3, 3)>(detSub);
+
+    __m128 DC = Mat2AdjMul(D, C);
+    __m128 AB = Mat2AdjMul(A, B);
+    __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), Mat2Mul(B, DC));
+    __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), Mat2Mul(C, AB));
+    __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), Mat2MulAdj(D, AB));
+    __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), Mat2MulAdj(A, DC));
+
+    // |M| = |A||D| + |B||C| - tr(adj(A)B * adj(D)C)
+    __m128 tr = _mm_mul_ps(AB, Swizzle<UNO_SHUFFLE_MASK(0, 2, 1, 3)>(DC));
+    tr = _mm_add_ps(tr, Swizzle<UNO_SHUFFLE_MASK(1, 0, 3, 2)>(tr));
+    tr = _mm_add_ps(tr, Swizzle<UNO_SHUFFLE_MASK(2, 3, 0, 1)>(tr));
+    __m128 detM = _mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC));
+    detM = _mm_sub_ps(detM, tr);
+
+    float det = _mm_cvtss_f32(detM);
+    if (std::abs(det) < SINGULAR_DETERMINANT_EPSILON) {
+        return false;
+    }
+
+    const __m128 adjSignMask = _mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f);
+    __m128 rcpDet = _mm_div_ps(adjSignMask, detM);
+    X = _mm_mul_ps(X, rcpDet);
+    Y = _mm_mul_ps(Y, rcpDet);
+    Z = _mm_mul_ps(Z, rcpDet);
+    W = _mm_mul_ps(W, rcpDet);
+
+    rows[0] = _mm_shuffle_ps(X, Y, UNO_SHUFFLE_MASK(3, 1, 3, 1));
+    rows[1] = _mm_shuffle_ps(X, Y, UNO_SHUFFLE_MASK(2, 0, 2, 0));
+    rows[2] = _mm_shuffle_ps(Z, W, UNO_SHUFFLE_MASK(3, 1, 3, 1));
+    rows[3] = _mm_shuffle_ps(Z, W, UNO_SHUFFLE_MASK(2, 0, 2, 0));
+    return true;
+}
+
+} // namespace Detail
+
+// 特異行列の場合はfalseを返し、outは変更しない
+inline bool MatrixInverse(const float* m, float* out) {
+    __m128 rows[4];
+    if (!Detail::InverseRows(m, rows)) {
+        return false;
+    }
+    for (int i = 0; i < 4; ++i) {
+        _mm_storeu_ps(out + i * 4, rows[i]);
+    }
+    return true;
+}
+
+inline void TransformPoint(const float* m, const float* point, float* out) {
+    __m128 v = Detail::RowTransform(
+        _mm_set1_ps(point[0]), _mm_set1_ps(point[1]), _mm_set1_ps(point[2]), _mm_set1_ps(1.0f),
+        _mm_loadu_ps(m + 0), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8), _mm_loadu_ps(m + 12));
+    // w=1の項は乗算しても値が変わらないためスカラー版と結果は一致する
+    float result[4];
+    _mm_storeu_ps(result, v);
+    float w = result[3];
+    if (std::abs(w) > 1e-6f) {
+        float invW = 1.0f / w;
+        result[0] *= invW;
+        result[1] *= invW;
+        result[2] *= invW;
+    }
+    out[0] = result[0];
+    out[1] = result[1];
+    out[2] = result[2];
+}
+
+inline void TransformDirection(const float* m, const float* dir, float* out) {
+    __m128 v = _mm_mul_ps(_mm_set1_ps(dir[0]), _mm_loadu_ps(m + 0));
+    v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(dir[1]), _mm_loadu_ps(m + 4)));
+    v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(dir[2]), _mm_loadu_ps(m + 8)));
+    float result[4];
+    _mm_storeu_ps(result, v);
+    out[0] = result[0];
+    out[1] = result[1];
+    out[2] = result[2];
+}
+
+inline void TransformVector4(const float* m, const float* vec, float* out) {
+    __m128 v = _mm_loadu_ps(vec);
+    _mm_storeu_ps(out, Detail::RowTransform(
+        _mm_shuffle_ps(v, v, 0x00), _mm_shuffle_ps(v, v, 0x55),
+        _mm_shuffle_ps(v, v, 0xAA), _mm_shuffle_ps(v, v, 0xFF),
+        _mm_loadu_ps(m + 0), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8), _mm_loadu_ps(m + 12)));
+}
+
+inline void QuaternionToMatrix(const float* quat, float* out) {
+    __m128 q = _mm_loadu_ps(quat);
+    __m128 q2 = _mm_add_ps(q, q);
+
+    // 対角成分: 1 - (2yy + 2zz), 1 - (2xx + 2zz), 1 - (2xx + 2yy)
+    __m128 sq = _mm_mul_ps(q, q2);
+    __m128 diag = _mm_sub_ps(_mm_set1_ps(1.0f),
+        _mm_add_ps(_mm_shuffle_ps(sq, sq, UNO_SHUFFLE_MASK(1, 0, 0, 3)),
+                   _mm_shuffle_ps(sq, sq, UNO_SHUFFLE_MASK(2, 2, 1, 3))));
+
+    // 非対角成分: (2xy, 2xz, 2yz) ± (2wz, 2wy, 2wx)
+    __m128 cross = _mm_mul_ps(_mm_shuffle_ps(q, q, UNO_SHUFFLE_MASK(0, 0, 1, 3)),
+                              _mm_shuffle_ps(q2, q2, UNO_SHUFFLE_MASK(1, 2, 2, 3)));
+    __m128 wTerms = _mm_mul_ps(_mm_shuffle_ps(q, q, 0xFF), _mm_shuffle_ps(q2, q2, UNO_SHUFFLE_MASK(2, 1, 0, 3)));
+    wTerms = _mm_mul_ps(wTerms, _mm_setr_ps(1.0f, -1.0f, 1.0f, 0.0f));
+    __m128 upper = _mm_add_ps(cross, wTerms);  // m01, m02, m12
+    __m128 lower = _mm_sub_ps(cross, wTerms);  // m10, m20, m21
+
+    float d[4], u[4], l[4];
+    _mm_storeu_ps(d, diag);
+    _mm_storeu_ps(u, upper);
+    _mm_storeu_ps(l, lower);
+
+    out[0]  = d[0]; out[1]  = u[0]; out[2]  = u[1]; out[3]  = 0.0f;
+    out[4]  = l[0]; out[5]  = d[1]; out[6]  = u[2]; out[7]  = 0.0f;
+    out[8]  = l[1]; out[9]  = l[2]; out[10] = d[2]; out[11] = 0.0f;
+    out[12] = 0.0f; out[13] = 0.0f; out[14] = 0.0f; out[15] = 1.0f;
+}
+
+// ---- 配列版（ループ外で共通オペランドをレジスタに保持する） ----
+
+// out[i] = a[i] * b
+inline void MatrixMultiplyArray(const float* a, size_t aStride, const float* b,
+                                float* out, size_t outStride, size_t count) {
+    __m128 b0 = _mm_loadu_ps(b + 0);
+    __m128 b1 = _mm_loadu_ps(b + 4);
+    __m128 b2 = _mm_loadu_ps(b + 8);
+    __m128 b3 = _mm_loadu_ps(b + 12);
+    for (size_t i = 0; i < count; ++i) {
+        const float* src = a + i * aStride;
+        float* dst = out + i * outStride;
+        __m128 rows[4];
+        for (int r = 0; r < 4; ++r) {
+            __m128 row = _mm_loadu_ps(src + r * 4);
+            rows[r] = Detail::RowTransform(
+                _mm_shuffle_ps(row, row, 0x00), _mm_shuffle_ps(row, row, 0x55),
+                _mm_shuffle_ps(row, row, 0xAA), _mm_shuffle_ps(row, row, 0xFF),
+                b0, b1, b2, b3);
+        }
+        for (int r = 0; r < 4; ++r) {
+            _mm_storeu_ps(dst + r * 4, rows[r]);
+        }
+    }
+}
+
+// out[i] = transpose(inverse(in[i]))、特異行列は単位行列になる
+inline void MatrixInverseTransposeArray(const float* in, size_t inStride,
+                                        float* out, size_t outStride, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        __m128 rows[4];
+        if (!Detail::InverseRows(in + i * inStride, rows)) {
+            rows[0] = _mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f);
+            rows[1] = _mm_setr_ps(0.0f, 1.0f, 0.0f, 0.0f);
+            rows[2] = _mm_setr_ps(0.0f, 0.0f, 1.0f, 0.0f);
+            rows[3] = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+        }
+        _MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+        float* dst = out + i * outStride;
+        for (int r = 0; r < 4; ++r) {
+            _mm_storeu_ps(dst + r * 4, rows[r]);
+        }
+    }
+}
+
+// 法線変換用行列（アフィン行列の左上3x3の逆転置）。Scalar::MatrixNormalと同じ演算順序
+inline void MatrixNormal(const float* m, float* out) {
+    // 第4列を0にした行（アフィン行列でなくても外積・内積のwレーンが0になるように）
+    const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    __m128 r0 = _mm_and_ps(_mm_loadu_ps(m + 0), xyzMask);
+    __m128 r1 = _mm_and_ps(_mm_loadu_ps(m + 4), xyzMask);
+    __m128 r2 = _mm_and_ps(_mm_loadu_ps(m + 8), xyzMask);
+
+    // a x b = a.yzx * b.zxy - a.zxy * b.yzx
+    auto cross = [](__m128 a, __m128 b) {
+        return _mm_sub_ps(
+            _mm_mul_ps(Detail::Swizzle<UNO_SHUFFLE_MASK(1, 2, 0, 3)>(a), Detail::Swizzle<UNO_SHUFFLE_MASK(2, 0, 1, 3)>(b)),
+            _mm_mul_ps(Detail::Swizzle<UNO_SHUFFLE_MASK(2, 0, 1, 3)>(a), Detail::Swizzle<UNO_SHUFFLE_MASK(1, 2, 0, 3)>(b)));
+    };
+    __m128 c0 = cross(r1, r2);
+    __m128 c1 = cross(r2, r0);
+    __m128 c2 = cross(r0, r1);
+
+    float d[4];
+    _mm_storeu_ps(d, _mm_mul_ps(r0, c0));
+    float det = d[0] + d[1] + d[2];
+    if (std::abs(det) < SINGULAR_DETERMINANT_EPSILON) {
+        std::memset(out, 0, sizeof(float) * 16);
+        out[0] = out[5] = out[10] = out[15] = 1.0f;
+        return;
+    }
+    __m128 invDet = _mm_set1_ps(1.0f / det);
+
+    _mm_storeu_ps(out + 0, _mm_mul_ps(c0, invDet));
+    _mm_storeu_ps(out + 4, _mm_mul_ps(c1, invDet));
+    _mm_storeu_ps(out + 8, _mm_mul_ps(c2, invDet));
+    _mm_storeu_ps(out + 12, _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+}
+
+// out[i] = TransformPoint(m, points[i])
+inline void TransformPointArray(const float* m, const float* points, size_t pointStride,
+                                float* out, size_t outStride, size_t count) {
+    __m128 r0 = _mm_loadu_ps(m + 0);
+    __m128 r1 = _mm_loadu_ps(m + 4);
+    __m128 r2 = _mm_loadu_ps(m + 8);
+    __m128 r3 = _mm_loadu_ps(m + 12);
+    for (size_t i = 0; i < count; ++i) {
+        const float* p = points + i * pointStride;
+        __m128 v = Detail::RowTransform(
+            _mm_set1_ps(p[0]), _mm_set1_ps(p[1]), _mm_set1_ps(p[2]), _mm_set1_ps(1.0f),
+            r0, r1, r2, r3);
+        float result[4];
+        _mm_storeu_ps(result, v);
+        float w = result[3];
+        if (std::abs(w) > 1e-6f) {
+            float invW = 1.0f / w;
+            result[0] *= invW;
+            result[1] *= invW;
+            result[2] *= invW;
+        }
+        float* dst = out + i * outStride;
+        dst[0] = result[0];
+        dst[1] = result[1];
+        dst[2] = result[2];
+    }
+}
+
+#undef UNO_SHUFFLE_MASK
+
+} // namespace Simd
+
+#elif UNO_SIMD_NEON
+
+namespace Simd {
+
+namespace Detail {
+
+// 行ベクトル v * M（融合積和は使わずスカラー版と同じ丸めにする）
+inline float32x4_t RowTransform(float32x4_t v, float32x4_t r0, float32x4_t r1, float32x4_t r2, float32x4_t r3) {
+    float32x4_t result = vmulq_laneq_f32(r0, v, 0);
+    result = vaddq_f32(result, vmulq_laneq_f32(r1, v, 1));
+    result = vaddq_f32(result, vmulq_laneq_f32(r2, v, 2));
+    result = vaddq_f32(result, vmulq_laneq_f32(r3, v, 3));
+    return result;
+}
+
+} // namespace Detail
+
+inline void MatrixMultiply(const float* a, const float* b, float* out) {
+    float32x4_t b0 = vld1q_f32(b + 0);
+    float32x4_t b1 = vld1q_f32(b + 4);
+    float32x4_t b2 = vld1q_f32(b + 8);
+    float32x4_t b3 = vld1q_f32(b + 12);
+    float32x4_t rows[4];
+    for (int i = 0; i < 4; ++i) {
+        rows[i] = Detail::RowTransform(vld1q_f32(a + i * 4), b0, b1, b2, b3);
+    }
+    for (int i = 0; i < 4; ++i) {
+        vst1q_f32(out + i * 4, rows[i]);
+    }
+}
+
+inline void MatrixTranspose(const float* m, float* out) {
+    float32x4x4_t rows = vld4q_f32(m);
+    vst1q_f32(out + 0, rows.val[0]);
+    vst1q_f32(out + 4, rows.val[1]);
+    vst1q_f32(out + 8, rows.val[2]);
+    vst1q_f32(out + 12, rows.val[3]);
+}
+
+inline bool MatrixInverse(const float* m, float* out) {
+    return Scalar::MatrixInverse(m, out);
+}
+
+inline void TransformPoint(const float* m, const float* point, float* out) {
+    Scalar::TransformPoint(m, point, out);
+}
+
+inline void TransformDirection(const float* m, const float* dir, float* out) {
+    Scalar::TransformDirection(m, dir, out);
+}
+
+inline void TransformVector4(const float* m, const float* vec, float* out) {
+    vst1q_f32(out, Detail::RowTransform(vld1q_f32(vec),
+        vld1q_f32(m + 0), vld1q_f32(m + 4), vld1q_f32(m + 8), vld1q_f32(m + 12)));
+}
+
+inline void QuaternionToMatrix(const float* q, float* out) {
+    Scalar::QuaternionToMatrix(q, out);
+}
+
+inline void MatrixNormal(const float* m, float* out) {
+    Scalar::MatrixNormal(m, out);
+}
+
+} // namespace Simd
+
+#endif
+
+// コンパイル時ディスパッチ
+#if UNO_SIMD_SSE || UNO_SIMD_NEON
+namespace Kernels = Simd;
+#else
+namespace Kernels = Scalar;
+#endif
+
+inline void MatrixMultiply(const float* a, const float* b, float* out) { Kernels::MatrixMultiply(a, b, out); }
+inline void MatrixTranspose(const float* m, float* out) { Kernels::MatrixTranspose(m, out); }
+inline bool MatrixInverse(const float* m, float* out) { return Kernels::MatrixInverse(m, out); }
+inline void TransformPoint(const float* m, const float* point, float* out) { Kernels::TransformPoint(m, point, out); }
+inline void TransformDirection(const float* m, const float* dir, float* out) { Kernels::TransformDirection(m, dir, out); }
+inline void TransformVector4(const float* m, const float* vec, float* out) { Kernels::TransformVector4(m, vec, out); }
+inline void QuaternionToMatrix(const float* q, float* out) { Kernels::QuaternionToMatrix(q, out); }
+inline void MatrixNormal(const float* m, float* out) { Kernels::MatrixNormal(m, out); }
+
+// ---- 配列版 ----
+// 入力と出力は同一配列（同じstride）でもよいが、部分的に重なる範囲は不可
+
+// out[i] = a[i] * b
+inline void MatrixMultiplyArray(const float* a, size_t aStride, const float* b,
+                                float* out, size_t outStride, size_t count) {
+    float rhs[16];
+    std::memcpy(rhs, b, sizeof(rhs)); // bが出力配列内にあっても結果が変わらないようにする
+#if UNO_SIMD_SSE
+    Simd::MatrixMultiplyArray(a, aStride, rhs, out, outStride, count);
+#else
+    for (size_t i = 0; i < count; ++i) {
+        MatrixMultiply(a + i * aStride, rhs, out + i * outStride);
+    }
+#endif
+}
+
+// out[i] = a * b[i]
+inline void MatrixMultiplyArrayLeft(const float* a, const float* b, size_t bStride,
+                                    float* out, size_t outStride, size_t count) {
+    float lhs[16];
+    std::memcpy(lhs, a, sizeof(lhs));
+    for (size_t i = 0; i < count; ++i) {
+        MatrixMultiply(lhs, b + i * bStride, out + i * outStride);
+    }
+}
+
+// out[i] = a[i] * b[i]
+inline void MatrixMultiplyPairwise(const float* a, size_t aStride, const float* b, size_t bStride,
+                                   float* out, size_t outStride, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        MatrixMultiply(a + i * aStride, b + i * bStride, out + i * outStride);
+    }
+}
+
+inline void MatrixTransposeArray(const float* in, size_t inStride,
+                                 float* out, size_t outStride, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        MatrixTranspose(in + i * inStride, out + i * outStride);
+    }
+}
+
+// out[i] = transpose(inverse(in[i]))、特異行列は単位行列になる
+inline void MatrixInverseTransposeArray(const float* in, size_t inStride,
+                                        float* out, size_t outStride, size_t count) {
+#if UNO_SIMD_SSE
+    Simd::MatrixInverseTransposeArray(in, inStride, out, outStride, count);
+#else
+    for (size_t i = 0; i < count; ++i) {
+        float inv[16];
+        if (!MatrixInverse(in + i * inStride, inv)) {
+            std::memset(inv, 0, sizeof(inv));
+            inv[0] = inv[5] = inv[10] = inv[15] = 1.0f;
+        }
+        MatrixTranspose(inv, out + i * outStride);
+    }
+#endif
+}
+
+// out[i] = TransformPoint(m, points[i])（strideはfloat単位、Vector3配列なら3）
+inline void TransformPointArray(const float* m, const float* points, size_t pointStride,
+                                float* out, size_t outStride, size_t count) {
+    float mat[16];
+    std::memcpy(mat, m, sizeof(mat));
+#if UNO_SIMD_SSE
+    Simd::TransformPointArray(mat, points, pointStride, out, outStride, count);
+#else
+    for (size_t i = 0; i < count; ++i) {
+        TransformPoint(mat, points + i * pointStride, out + i * outStride);
+    }
+#endif
+}
+
+} // namespace Math
+} // namespace UnoEngine
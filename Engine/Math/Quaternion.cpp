@@ -48,22 +48,10 @@ Quaternion Quaternion::FromRotationMatrix(const Matrix4x4& mat) {
 }
 
 Matrix4x4 Quaternion::ToMatrix() const {
-    float xx = x_ * x_;
-    float yy = y_ * y_;
-    float zz = z_ * z_;
-    float xy = x_ * y_;
-    float xz = x_ * z_;
-    float yz = y_ * z_;
-    float wx = w_ * x_;
-    float wy = w_ * y_;
-    float wz = w_ * z_;
-
-    return Matrix4x4(
-        1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz),        2.0f * (xz - wy),        0.0f,
-        2.0f * (xy - wz),        1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx),        0.0f,
-        2.0f * (xz + wy),        2.0f * (yz - wx),        1.0f - 2.0f * (xx + yy), 0.0f,
-        0.0f,                    0.0f,                    0.0f,                    1.0f
-    );
+    float q[4] = { x_, y_, z_, w_ };
+    float m[16];
+    Math::QuaternionToMatrix(q, m);
+    return Matrix4x4::FromFloatArray(m);
 }
 
 Quaternion Quaternion::LookRotation(const Vector3& forward, const Vector3& up) {
@@ -87,4 +75,33 @@ Matrix4x4 Matrix4x4::CreateFromQuaternion(const Quaternion& q) {
     return q.ToMatrix();
 }
 
+void Matrix4x4::Decompose(Vector3& outScale, Quaternion& outRotation, Vector3& outTranslation) const {
+    outTranslation = Vector3(m_[3][0], m_[3][1], m_[3][2]);
+
+    // 行ベクトルの長さがスケール（S * R なので各行が回転行列の行をスケールしたもの）
+    float scale[3];
+    for (int i = 0; i < 3; ++i) {
+        scale[i] = std::sqrt(m_[i][0] * m_[i][0] + m_[i][1] * m_[i][1] + m_[i][2] * m_[i][2]);
+    }
+
+    // 鏡映を含む場合はX軸のスケールを負にして回転部分を右手系に戻す
+    if (Determinant() < 0.0f) {
+        scale[0] = -scale[0];
+    }
+    outScale = Vector3(scale[0], scale[1], scale[2]);
+
+    Matrix4x4 rotation;
+    for (int i = 0; i < 3; ++i) {
+        if (std::abs(scale[i]) < 1e-8f) {
+            // 潰れた軸は回転を決められないため、単位行列の行のままにする
+            continue;
+        }
+        const float inv = 1.0f / scale[i];
+        for (int j = 0; j < 3; ++j) {
+            rotation.m_[i][j] = m_[i][j] * inv;
+        }
+    }
+    outRotation = Quaternion::FromRotationMatrix(rotation);
+}
+
 } // namespace UnoEngine
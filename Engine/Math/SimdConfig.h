@@ -0,0 +1,58 @@
+#pragma once
+
+// SIMD命令セットのコンパイル時選択
+// UNO_FORCE_SCALAR_MATH を定義するとSIMDを無効化してスカラー実装に固定する（比較・デバッグ用）
+//
+//   UNO_SIMD_AVX  : AVX（/arch:AVX, /arch:AVX2, -mavx）
+//   UNO_SIMD_SSE  : SSE2（x64では常に有効）
+//   UNO_SIMD_NEON : ARM NEON（ARM64）
+//   いずれも0の場合はスカラー実装
+
+#if defined(UNO_FORCE_SCALAR_MATH)
+    #define UNO_SIMD_AVX  0
+    #define UNO_SIMD_SSE  0
+    #define UNO_SIMD_NEON 0
+#elif defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #if defined(__AVX__)
+        #define UNO_SIMD_AVX 1
+    #else
+        #define UNO_SIMD_AVX 0
+    #endif
+    #define UNO_SIMD_SSE  1
+    #define UNO_SIMD_NEON 0
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #define UNO_SIMD_AVX  0
+    #define UNO_SIMD_SSE  0
+    #define UNO_SIMD_NEON 1
+#else
+    #define UNO_SIMD_AVX  0
+    #define UNO_SIMD_SSE  0
+    #define UNO_SIMD_NEON 0
+#endif
+
+#if UNO_SIMD_AVX
+    #include <immintrin.h>
+#elif UNO_SIMD_SSE
+    #include <emmintrin.h>
+#elif UNO_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace UnoEngine {
+namespace Math {
+
+// 現在のビルドで選択されているSIMDバックエンド名（ログ・プロファイラ表示用）
+constexpr const char* GetSimdBackendName() {
+#if UNO_SIMD_AVX
+    return "AVX";
+#elif UNO_SIMD_SSE
+    return "SSE2";
+#elif UNO_SIMD_NEON
+    return "NEON";
+#else
+    return "Scalar";
+#endif
+}
+
+} // namespace Math
+} // namespace UnoEngine
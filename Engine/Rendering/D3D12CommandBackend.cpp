@@ -0,0 +1,74 @@
+#include "D3D12CommandBackend.h"
+#include "../Graphics/GraphicsDevice.h"
+#include <cassert>
+
+namespace UnoEngine {
+
+void D3D12CommandBackend::Initialize(GraphicsDevice* graphics) {
+    graphics_ = graphics;
+}
+
+void D3D12CommandBackend::RegisterPipeline(uint32 pipelineId, ID3D12PipelineState* pipelineState,
+                                           ID3D12RootSignature* rootSignature) {
+    if (pipelineId >= pipelines_.size()) {
+        pipelines_.resize(pipelineId + 1);
+    }
+    pipelines_[pipelineId] = { pipelineState, rootSignature };
+}
+
+void D3D12CommandBackend::Execute(const RenderCommandStream& stream) {
+    const auto& commands = stream.GetCommands();
+    if (commands.empty()) return;
+
+    auto* cmdList = graphics_->GetCommandList();
+
+    ID3D12DescriptorHeap* heaps[] = {graphics_->GetSRVHeap()};
+    cmdList->SetDescriptorHeaps(1, heaps);
+    cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+    for (const RenderCommand& command : commands) {
+        switch (command.type) {
+        case RenderCommandType::SetPipeline: {
+            assert(command.pipeline.id < pipelines_.size() && "Pipeline is not registered");
+            const PipelineEntry& entry = pipelines_[command.pipeline.id];
+            cmdList->SetPipelineState(entry.pipelineState);
+            cmdList->SetGraphicsRootSignature(entry.rootSignature);
+            break;
+        }
+        case RenderCommandType::SetConstantBuffer:
+            cmdList->SetGraphicsRootConstantBufferView(command.binding.slot, command.binding.address);
+            break;
+        case RenderCommandType::SetShaderResource:
+            cmdList->SetGraphicsRootShaderResourceView(command.binding.slot, command.binding.address);
+            break;
+        case RenderCommandType::SetDescriptorTable: {
+            D3D12_GPU_DESCRIPTOR_HANDLE handle = {};
+            handle.ptr = command.binding.address;
+            cmdList->SetGraphicsRootDescriptorTable(command.binding.slot, handle);
+            break;
+        }
+        case RenderCommandType::SetVertexBuffer: {
+            D3D12_VERTEX_BUFFER_VIEW view = {};
+            view.BufferLocation = command.vertexBuffer.address;
+            view.SizeInBytes = command.vertexBuffer.sizeInBytes;
+            view.StrideInBytes = command.vertexBuffer.strideInBytes;
+            cmdList->IASetVertexBuffers(0, 1, &view);
+            break;
+        }
+        case RenderCommandType::SetIndexBuffer: {
+            D3D12_INDEX_BUFFER_VIEW view = {};
+            view.BufferLocation = command.indexBuffer.address;
+            view.SizeInBytes = command.indexBuffer.sizeInBytes;
+            view.Format = command.indexBuffer.format == IndexFormat::UInt16 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+            cmdList->IASetIndexBuffer(&view);
+            break;
+        }
+        case RenderCommandType::DrawIndexed:
+            cmdList->DrawIndexedInstanced(command.draw.indexCount, command.draw.instanceCount, command.draw.startIndex,
+                                          command.draw.baseVertex, command.draw.startInstance);
+            break;
+        }
+    }
+}
+
+} // namespace UnoEngine
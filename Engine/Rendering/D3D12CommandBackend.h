@@ -0,0 +1,34 @@
+#pragma once
+
+#include "RenderCommand.h"
+#include "../Graphics/D3D12Common.h"
+#include <vector>
+
+namespace UnoEngine {
+
+class GraphicsDevice;
+
+// 描画コマンドの列をGraphicsDeviceのコマンドリストに積み直すバックエンド
+class D3D12CommandBackend : public RenderCommandBackend {
+public:
+    D3D12CommandBackend() = default;
+
+    void Initialize(GraphicsDevice* graphics);
+
+    // SetPipelineのidに対応するパイプラインステートとルートシグネチャ
+    void RegisterPipeline(uint32 pipelineId, ID3D12PipelineState* pipelineState, ID3D12RootSignature* rootSignature);
+
+    // 先頭でSRVヒープと三角形リストのトポロジを設定してからコマンドを積む
+    void Execute(const RenderCommandStream& stream) override;
+
+private:
+    struct PipelineEntry {
+        ID3D12PipelineState* pipelineState = nullptr;
+        ID3D12RootSignature* rootSignature = nullptr;
+    };
+
+    GraphicsDevice* graphics_ = nullptr;
+    std::vector<PipelineEntry> pipelines_;
+};
+
+} // namespace UnoEngine
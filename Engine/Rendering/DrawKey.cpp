@@ -0,0 +1,67 @@
+#include "DrawKey.h"
+#include <algorithm>
+
+namespace UnoEngine {
+
+namespace {
+
+constexpr uint32 RADIX_BITS = 8;
+constexpr uint32 RADIX_SIZE = 1u << RADIX_BITS;
+constexpr uint32 PASS_COUNT = 64 / RADIX_BITS;
+
+// これ以下の要素数では比較ソートの方が速い（ヒストグラムと8回の分配の固定コストが勝つ）
+constexpr size_t COMPARISON_SORT_THRESHOLD = 1024;
+
+} // anonymous namespace
+
+void RadixSortDrawKeys(std::vector<DrawKeyEntry>& entries, std::vector<DrawKeyEntry>& scratch) {
+    const size_t count = entries.size();
+    if (count < 2) return;
+
+    if (count <= COMPARISON_SORT_THRESHOLD) {
+        // 同じキーは入力の並びを保つ（基数ソートと同じ結果にする。indexは連番とは限らない）
+        std::stable_sort(entries.begin(), entries.end(), [](const DrawKeyEntry& a, const DrawKeyEntry& b) {
+            return a.key < b.key;
+        });
+        return;
+    }
+
+    // 全桁のヒストグラムを1回の走査でまとめて数える
+    uint32 histograms[PASS_COUNT][RADIX_SIZE] = {};
+    for (const DrawKeyEntry& entry : entries) {
+        for (uint32 pass = 0; pass < PASS_COUNT; ++pass) {
+            ++histograms[pass][(entry.key >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1)];
+        }
+    }
+
+    scratch.resize(count);
+    DrawKeyEntry* source = entries.data();
+    DrawKeyEntry* destination = scratch.data();
+
+    for (uint32 pass = 0; pass < PASS_COUNT; ++pass) {
+        uint32* histogram = histograms[pass];
+        const uint32 shift = pass * RADIX_BITS;
+
+        // 全要素がこの桁で同じ値なら並びは変わらない
+        if (histogram[(source[0].key >> shift) & (RADIX_SIZE - 1)] == count) continue;
+
+        uint32 offset = 0;
+        for (uint32 digit = 0; digit < RADIX_SIZE; ++digit) {
+            const uint32 digitCount = histogram[digit];
+            histogram[digit] = offset;
+            offset += digitCount;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            const DrawKeyEntry& entry = source[i];
+            destination[histogram[(entry.key >> shift) & (RADIX_SIZE - 1)]++] = entry;
+        }
+        std::swap(source, destination);
+    }
+
+    if (source != entries.data()) {
+        std::copy(source, source + count, entries.data());
+    }
+}
+
+} // namespace UnoEngine
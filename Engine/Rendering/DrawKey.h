@@ -0,0 +1,88 @@
+#pragma once
+
+#include "../Core/Types.h"
+#include <cstring>
+#include <vector>
+
+namespace UnoEngine {
+
+// 描画パス（値の小さい順に描画する）
+enum class DrawPass : uint32 {
+    Opaque = 0,
+    Transparent = 1,
+};
+
+// 描画順を決める64bitのキー。値の小さい順に描画する
+//
+// 不透明:  | ビュー 4 | パス 2 | パイプライン 6 | マテリアル 16 | メッシュ 16 | 深度 20       |
+// 半透明:  | ビュー 4 | パス 2 | 深度(反転) 20 | パイプライン 6 | マテリアル 16 | メッシュ 16 |
+// 不透明はステートの切り替えが少なくなるように並べ、同じメッシュの中では手前から描く（奥の描画を深度テストで省くため）
+// 半透明は正しく合成するため、奥から手前への順をステートよりも優先する
+// 各番号はビット幅に収まらない場合は下位ビットだけを使う（まとまりが崩れるだけで描画は正しい）
+class DrawKey {
+public:
+    static constexpr uint32 VIEW_BITS = 4;
+    static constexpr uint32 PASS_BITS = 2;
+    static constexpr uint32 PIPELINE_BITS = 6;
+    static constexpr uint32 MATERIAL_BITS = 16;
+    static constexpr uint32 MESH_BITS = 16;
+    static constexpr uint32 DEPTH_BITS = 20;
+    static_assert(VIEW_BITS + PASS_BITS + PIPELINE_BITS + MATERIAL_BITS + MESH_BITS + DEPTH_BITS == 64);
+
+    // viewDepthはカメラの前方向に沿った距離
+    static uint64 MakeOpaque(uint32 view, uint32 pipeline, uint32 material, uint32 mesh, float viewDepth) {
+        uint64 key = Field(view, VIEW_BITS);
+        key = (key << PASS_BITS) | static_cast<uint64>(DrawPass::Opaque);
+        key = (key << PIPELINE_BITS) | Field(pipeline, PIPELINE_BITS);
+        key = (key << MATERIAL_BITS) | Field(material, MATERIAL_BITS);
+        key = (key << MESH_BITS) | Field(mesh, MESH_BITS);
+        key = (key << DEPTH_BITS) | QuantizeDepth(viewDepth);
+        return key;
+    }
+
+    static uint64 MakeTransparent(uint32 view, uint32 pipeline, uint32 material, uint32 mesh, float viewDepth) {
+        uint64 key = Field(view, VIEW_BITS);
+        key = (key << PASS_BITS) | static_cast<uint64>(DrawPass::Transparent);
+        key = (key << DEPTH_BITS) | (MAX_DEPTH - QuantizeDepth(viewDepth));
+        key = (key << PIPELINE_BITS) | Field(pipeline, PIPELINE_BITS);
+        key = (key << MATERIAL_BITS) | Field(material, MATERIAL_BITS);
+        key = (key << MESH_BITS) | Field(mesh, MESH_BITS);
+        return key;
+    }
+
+    static uint64 Make(DrawPass pass, uint32 view, uint32 pipeline, uint32 material, uint32 mesh, float viewDepth) {
+        return pass == DrawPass::Transparent ? MakeTransparent(view, pipeline, material, mesh, viewDepth)
+                                             : MakeOpaque(view, pipeline, material, mesh, viewDepth);
+    }
+
+    static DrawPass GetPass(uint64 key) {
+        return static_cast<DrawPass>((key >> (64 - VIEW_BITS - PASS_BITS)) & ((1u << PASS_BITS) - 1));
+    }
+
+    // 正の浮動小数点数はビット列を整数として見ても大小関係が保たれるため、上位ビットをそのまま使う
+    // （近いほど細かく、遠いほど粗く量子化される。カメラより後ろは0）
+    static uint64 QuantizeDepth(float viewDepth) {
+        if (!(viewDepth > 0.0f)) return 0;
+        uint32 bits;
+        std::memcpy(&bits, &viewDepth, sizeof(bits));
+        return (bits >> (31 - DEPTH_BITS)) & MAX_DEPTH;
+    }
+
+private:
+    static constexpr uint64 MAX_DEPTH = (1ull << DEPTH_BITS) - 1;
+
+    static uint64 Field(uint32 value, uint32 bits) { return static_cast<uint64>(value) & ((1ull << bits) - 1); }
+};
+
+// キーと並べ替える前の位置
+struct DrawKeyEntry {
+    uint64 key;
+    uint32 index;
+};
+
+// キーの昇順に並べ替える（8bitずつのLSD基数ソート、O(n)。少ない要素数では比較ソートを使う。どちらも同じキーは入力の並びを保つ）
+// 全要素で同じ値になっている桁は読み飛ばすため、使っていない上位のフィールドにはコストがかからない
+// scratchは作業用（フレーム間で使い回すと確保が起きない）
+void RadixSortDrawKeys(std::vector<DrawKeyEntry>& entries, std::vector<DrawKeyEntry>& scratch);
+
+} // namespace UnoEngine
@@ -0,0 +1,50 @@
+#include "InstanceBatcher.h"
+#include "../Math/MatrixBatch.h"
+
+namespace UnoEngine {
+
+namespace {
+
+// RenderItemの並びをそのまま行列の配列として転置するためのストライド
+constexpr size_t RENDER_ITEM_FLOAT_STRIDE = sizeof(RenderItem) / sizeof(float);
+static_assert(sizeof(RenderItem) % sizeof(float) == 0, "RenderItem must be a whole number of floats");
+
+} // anonymous namespace
+
+void InstanceBatcher::Build(const std::vector<RenderItem>& items) {
+    batches_.clear();
+    instances_.resize(items.size());
+
+    uint32 instanceCount = 0;
+    size_t i = 0;
+    while (i < items.size()) {
+        const RenderItem& first = items[i];
+        if (!first.mesh || !first.material) {
+            ++i;
+            continue;
+        }
+
+        size_t end = i + 1;
+        while (end < items.size() && items[end].mesh == first.mesh && items[end].material == first.material) {
+            ++end;
+        }
+
+        const uint32 count = static_cast<uint32>(end - i);
+        Math::MatrixTransposeArray(first.worldMatrix.GetData(), RENDER_ITEM_FLOAT_STRIDE,
+                                   &instances_[instanceCount].world.m[0][0], Math::MATRIX_FLOAT_STRIDE, count);
+        batches_.push_back({ first.mesh, first.material, instanceCount, count });
+        instanceCount += count;
+        i = end;
+    }
+
+    instances_.resize(instanceCount);
+}
+
+void InstanceBatcher::Clear() {
+    batches_.clear();
+    batches_.shrink_to_fit();
+    instances_.clear();
+    instances_.shrink_to_fit();
+}
+
+} // namespace UnoEngine
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "RenderItem.h"
+#include "../Core/Types.h"
+#include "../Math/MathCommon.h"
+#include <vector>
+
+namespace UnoEngine {
+
+// 1インスタンス分のデータ（PBRVS.hlslのStructuredBuffer<InstanceData>と同じレイアウト）
+struct InstanceData {
+    Float4x4 world;  // シェーダー用に転置済み
+};
+
+// 同じメッシュ・マテリアルで1回のDrawIndexedInstancedにまとめる範囲
+struct InstanceBatch {
+    Mesh* mesh = nullptr;
+    Material* material = nullptr;
+    uint32 firstInstance = 0;  // InstanceBatcher::GetInstances() 内の先頭
+    uint32 instanceCount = 0;
+};
+
+// RenderItemの並びから、連続して同じメッシュ・マテリアルを使うアイテムをインスタンス描画のバッチにまとめる
+// 並びは変えない（描画キーでソート済みのitemsを渡すと、同じメッシュ・マテリアルが隣り合ってまとまる）
+// GPUのリソースには触れないため、デバイス無しで結果を確かめられる
+class InstanceBatcher {
+public:
+    InstanceBatcher() = default;
+
+    // meshかmaterialがnullptrのアイテムは飛ばす
+    void Build(const std::vector<RenderItem>& items);
+    void Clear();
+
+    const std::vector<InstanceBatch>& GetBatches() const { return batches_; }
+    const std::vector<InstanceData>& GetInstances() const { return instances_; }
+
+private:
+    std::vector<InstanceBatch> batches_;
+    std::vector<InstanceData> instances_;
+};
+
+} // namespace UnoEngine
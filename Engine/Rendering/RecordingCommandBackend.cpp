@@ -0,0 +1,42 @@
+#include "RecordingCommandBackend.h"
+
+namespace UnoEngine {
+
+void RecordingCommandBackend::Execute(const RenderCommandStream& stream) {
+    for (const RenderCommand& command : stream.GetCommands()) {
+        switch (command.type) {
+        case RenderCommandType::SetPipeline:
+            ++stats_.pipelineChanges;
+            break;
+        case RenderCommandType::SetConstantBuffer:
+        case RenderCommandType::SetShaderResource:
+        case RenderCommandType::SetDescriptorTable:
+            ++stats_.bindingChanges;
+            break;
+        case RenderCommandType::SetVertexBuffer:
+            ++stats_.vertexBufferChanges;
+            break;
+        case RenderCommandType::SetIndexBuffer:
+            ++stats_.indexBufferChanges;
+            break;
+        case RenderCommandType::DrawIndexed:
+            ++stats_.drawCalls;
+            stats_.instances += command.draw.instanceCount;
+            stats_.indices += static_cast<uint64>(command.draw.indexCount) * command.draw.instanceCount;
+            break;
+        }
+    }
+    stats_.uploadedBytes += stream.GetUploadedBytes();
+    stats_.redundantStateChanges += stream.GetRedundantCount();
+
+    if (keepCommands_) {
+        commands_.insert(commands_.end(), stream.GetCommands().begin(), stream.GetCommands().end());
+    }
+}
+
+void RecordingCommandBackend::Reset() {
+    stats_ = RenderCommandStats();
+    commands_.clear();
+}
+
+} // namespace UnoEngine
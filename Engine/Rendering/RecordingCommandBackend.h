@@ -0,0 +1,46 @@
+#pragma once
+
+#include "RenderCommand.h"
+
+namespace UnoEngine {
+
+// 実行した描画コマンドの集計
+struct RenderCommandStats {
+    uint32 pipelineChanges = 0;
+    uint32 bindingChanges = 0;       // ルートCBV・SRV・ディスクリプタテーブル
+    uint32 vertexBufferChanges = 0;
+    uint32 indexBufferChanges = 0;
+    uint32 drawCalls = 0;
+    uint64 instances = 0;
+    uint64 indices = 0;
+    uint64 uploadedBytes = 0;
+    uint32 redundantStateChanges = 0;  // ストリームが省いた設定
+
+    uint32 GetStateChanges() const {
+        return pipelineChanges + bindingChanges + vertexBufferChanges + indexBufferChanges;
+    }
+};
+
+// GPUに何も送らず、描画コマンドを数えるだけのバックエンド
+// デバイスが無い環境で描画回数やステートの切り替え回数を確かめるために使う
+class RecordingCommandBackend : public RenderCommandBackend {
+public:
+    RecordingCommandBackend() = default;
+
+    void Execute(const RenderCommandStream& stream) override;
+
+    // keepCommandsがtrueなら実行したコマンドをGetCommandsで取り出せるように残す
+    void SetKeepCommands(bool keepCommands) { keepCommands_ = keepCommands; }
+
+    void Reset();
+
+    const RenderCommandStats& GetStats() const { return stats_; }
+    const std::vector<RenderCommand>& GetCommands() const { return commands_; }
+
+private:
+    RenderCommandStats stats_;
+    std::vector<RenderCommand> commands_;
+    bool keepCommands_ = false;
+};
+
+} // namespace UnoEngine
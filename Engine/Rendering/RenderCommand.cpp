@@ -0,0 +1,105 @@
+#include "RenderCommand.h"
+#include <cassert>
+
+namespace UnoEngine {
+
+void RenderCommandStream::Reset() {
+    commands_.clear();
+    uploadedBytes_ = 0;
+    redundantCount_ = 0;
+
+    pipelineValid_ = false;
+    for (BoundSlot& slot : slots_) {
+        slot.valid = false;
+    }
+    vertexBufferValid_ = false;
+    indexBufferValid_ = false;
+}
+
+void RenderCommandStream::SetPipeline(uint32 pipelineId) {
+    if (pipelineValid_ && pipelineId_ == pipelineId) {
+        ++redundantCount_;
+        return;
+    }
+    pipelineId_ = pipelineId;
+    pipelineValid_ = true;
+
+    // ルートシグネチャが変わるとルートパラメータは設定し直しになる
+    for (BoundSlot& slot : slots_) {
+        slot.valid = false;
+    }
+
+    RenderCommand& command = commands_.emplace_back();
+    command.type = RenderCommandType::SetPipeline;
+    command.pipeline = { pipelineId };
+}
+
+void RenderCommandStream::SetConstantBuffer(uint32 slot, uint64 gpuAddress) {
+    SetBinding(RenderCommandType::SetConstantBuffer, slot, gpuAddress);
+}
+
+void RenderCommandStream::SetShaderResource(uint32 slot, uint64 gpuAddress) {
+    SetBinding(RenderCommandType::SetShaderResource, slot, gpuAddress);
+}
+
+void RenderCommandStream::SetDescriptorTable(uint32 slot, uint64 gpuDescriptor) {
+    SetBinding(RenderCommandType::SetDescriptorTable, slot, gpuDescriptor);
+}
+
+void RenderCommandStream::SetBinding(RenderCommandType type, uint32 slot, uint64 address) {
+    assert(pipelineValid_ && "SetPipeline must come before root parameter bindings");
+    assert(slot < MAX_ROOT_SLOTS);
+
+    BoundSlot& bound = slots_[slot];
+    if (bound.valid && bound.type == type && bound.address == address) {
+        ++redundantCount_;
+        return;
+    }
+    bound.type = type;
+    bound.address = address;
+    bound.valid = true;
+
+    RenderCommand& command = commands_.emplace_back();
+    command.type = type;
+    command.binding = { slot, address };
+}
+
+void RenderCommandStream::SetVertexBuffer(uint64 gpuAddress, uint32 sizeInBytes, uint32 strideInBytes) {
+    if (vertexBufferValid_ && vertexBuffer_.address == gpuAddress && vertexBuffer_.sizeInBytes == sizeInBytes &&
+        vertexBuffer_.strideInBytes == strideInBytes) {
+        ++redundantCount_;
+        return;
+    }
+    vertexBuffer_ = { gpuAddress, sizeInBytes, strideInBytes };
+    vertexBufferValid_ = true;
+
+    RenderCommand& command = commands_.emplace_back();
+    command.type = RenderCommandType::SetVertexBuffer;
+    command.vertexBuffer = vertexBuffer_;
+}
+
+void RenderCommandStream::SetIndexBuffer(uint64 gpuAddress, uint32 sizeInBytes, IndexFormat format) {
+    if (indexBufferValid_ && indexBuffer_.address == gpuAddress && indexBuffer_.sizeInBytes == sizeInBytes &&
+        indexBuffer_.format == format) {
+        ++redundantCount_;
+        return;
+    }
+    indexBuffer_ = { gpuAddress, sizeInBytes, format };
+    indexBufferValid_ = true;
+
+    RenderCommand& command = commands_.emplace_back();
+    command.type = RenderCommandType::SetIndexBuffer;
+    command.indexBuffer = indexBuffer_;
+}
+
+void RenderCommandStream::DrawIndexed(uint32 indexCount, uint32 instanceCount, uint32 startIndex, int32 baseVertex,
+                                      uint32 startInstance) {
+    assert(pipelineValid_ && vertexBufferValid_ && indexBufferValid_);
+    if (indexCount == 0 || instanceCount == 0) return;
+
+    RenderCommand& command = commands_.emplace_back();
+    command.type = RenderCommandType::DrawIndexed;
+    command.draw = { indexCount, instanceCount, startIndex, baseVertex, startInstance };
+}
+
+} // namespace UnoEngine
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "../Core/Types.h"
+#include <vector>
+
+namespace UnoEngine {
+
+// 描画コマンドで使うパイプラインの番号（描画キーのパイプライン番号も兼ねる）
+namespace RenderPipeline {
+    constexpr uint32 StaticMesh = 0;
+    constexpr uint32 SkinnedMesh = 1;
+}
+
+enum class RenderCommandType : uint8 {
+    SetPipeline,
+    SetConstantBuffer,   // ルートCBV
+    SetShaderResource,   // ルートSRV
+    SetDescriptorTable,
+    SetVertexBuffer,
+    SetIndexBuffer,
+    DrawIndexed,
+};
+
+enum class IndexFormat : uint8 {
+    UInt16,
+    UInt32,
+};
+
+// グラフィックスAPIに依存しない描画コマンド
+// アドレスやハンドルはバックエンドが解釈する値をそのまま持つ（D3D12ではGPU仮想アドレスとディスクリプタハンドル）
+struct RenderCommand {
+    struct Pipeline {
+        uint32 id;
+    };
+    struct Binding {
+        uint32 slot;      // ルートパラメータの番号
+        uint64 address;
+    };
+    struct VertexBuffer {
+        uint64 address;
+        uint32 sizeInBytes;
+        uint32 strideInBytes;
+    };
+    struct IndexBuffer {
+        uint64 address;
+        uint32 sizeInBytes;
+        IndexFormat format;
+    };
+    struct Draw {
+        uint32 indexCount;
+        uint32 instanceCount;
+        uint32 startIndex;
+        int32 baseVertex;
+        uint32 startInstance;
+    };
+
+    RenderCommandType type;
+    union {
+        Pipeline pipeline;
+        Binding binding;
+        VertexBuffer vertexBuffer;
+        IndexBuffer indexBuffer;
+        Draw draw;
+    };
+};
+
+// Rendererが積む描画コマンドの列
+// 直前と同じ値を設定するコマンドは積まずに数だけ数える（パイプラインを切り替えるとルートパラメータの設定は無効になる）
+// アップロードしたバイト数はコマンドを伴わないため別に数える
+class RenderCommandStream {
+public:
+    // ルートパラメータの番号の上限
+    static constexpr uint32 MAX_ROOT_SLOTS = 16;
+
+    RenderCommandStream() = default;
+
+    // コマンド・設定済みの状態・統計を空にする
+    void Reset();
+
+    void SetPipeline(uint32 pipelineId);
+    void SetConstantBuffer(uint32 slot, uint64 gpuAddress);
+    void SetShaderResource(uint32 slot, uint64 gpuAddress);
+    void SetDescriptorTable(uint32 slot, uint64 gpuDescriptor);
+    void SetVertexBuffer(uint64 gpuAddress, uint32 sizeInBytes, uint32 strideInBytes);
+    void SetIndexBuffer(uint64 gpuAddress, uint32 sizeInBytes, IndexFormat format);
+    void DrawIndexed(uint32 indexCount, uint32 instanceCount = 1, uint32 startIndex = 0, int32 baseVertex = 0,
+                     uint32 startInstance = 0);
+
+    // GPUが読むバッファに書き込んだバイト数を記録する
+    void AddUploadedBytes(uint64 bytes) { uploadedBytes_ += bytes; }
+
+    const std::vector<RenderCommand>& GetCommands() const { return commands_; }
+    uint64 GetUploadedBytes() const { return uploadedBytes_; }
+    // 直前と同じ値だったため積まなかった設定の数
+    uint32 GetRedundantCount() const { return redundantCount_; }
+
+private:
+    void SetBinding(RenderCommandType type, uint32 slot, uint64 address);
+
+    std::vector<RenderCommand> commands_;
+    uint64 uploadedBytes_ = 0;
+    uint32 redundantCount_ = 0;
+
+    // 現在の状態（未設定のものはvalidがfalse）
+    struct BoundSlot {
+        RenderCommandType type = RenderCommandType::SetConstantBuffer;
+        uint64 address = 0;
+        bool valid = false;
+    };
+    uint32 pipelineId_ = 0;
+    bool pipelineValid_ = false;
+    BoundSlot slots_[MAX_ROOT_SLOTS];
+    RenderCommand::VertexBuffer vertexBuffer_ = {};
+    bool vertexBufferValid_ = false;
+    RenderCommand::IndexBuffer indexBuffer_ = {};
+    bool indexBufferValid_ = false;
+};
+
+// 描画コマンドの列を実行するバックエンド
+class RenderCommandBackend {
+public:
+    virtual ~RenderCommandBackend() = default;
+
+    virtual void Execute(const RenderCommandStream& stream) = 0;
+};
+
+} // namespace UnoEngine
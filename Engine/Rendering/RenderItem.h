@@ -1,11 +1,13 @@
 #pragma once
 
-#include "../Graphics/Mesh.h"
-#include "../Graphics/Material.h"
 #include "../Math/Matrix.h"
 
 namespace UnoEngine {
 
+// ポインタしか持たないため前方宣言で済ませる（InstanceBatcherなどをD3D12無しでビルドできるようにする）
+class Mesh;
+class Material;
+
 struct RenderItem {
     Mesh* mesh = nullptr;
     Material* material = nullptr;
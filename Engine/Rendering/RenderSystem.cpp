@@ -1,42 +1,74 @@
 #include "RenderSystem.h"
+#include "RenderCommand.h"
 #include "SkinnedMeshRenderer.h"
 #include "../Graphics/MeshRenderer.h"
 #include "../Graphics/SkinnedMesh.h"
 #include "../Animation/AnimatorComponent.h"
 #include "../Core/Logger.h"
 #include "../Math/Math.h"
+#include "../Math/MatrixBatch.h"
 #include <algorithm>
 #include <cassert>
 
 namespace UnoEngine {
 
+namespace {
+
+bool IsTransparent(const Material* material) {
+    return material && material->GetData().opacity < 1.0f;
+}
+
+} // anonymous namespace
+
 std::vector<RenderItem> RenderSystem::CollectRenderables(Scene* scene, const RenderView& view) {
     assert(scene && "Scene is null");
     assert(view.camera && "Camera is null");
     
     std::vector<RenderItem> items;
-    
-    for (const auto& go : scene->GetGameObjects()) {
-        if (!go->IsActive()) continue;
-        
-        if (!PassesLayerMask(go->GetLayer(), view.layerMask)) continue;
+
+    meshCandidates_.clear();
+    candidateDepths_.clear();
+    cullingBounds_.Clear();
+    for (auto [go, transform, meshRenderer] : scene->Query<Transform, MeshRenderer>()) {
+        if (!go.IsActive()) continue;
         
-        auto* meshRenderer = go->GetComponent<MeshRenderer>();
-        if (!meshRenderer) continue;
+        if (!PassesLayerMask(go.GetLayer(), view.layerMask)) continue;
+
+        // メッシュが無ければ描画されないので、カリングの対象にも入れない
+        Mesh* mesh = meshRenderer.GetMesh();
+        if (!mesh) continue;
         
         RenderItem item;
-        item.mesh = meshRenderer->GetMesh();
-        item.material = meshRenderer->GetMaterial();
-        item.worldMatrix = go->GetTransform().GetWorldMatrix();
-        
-        items.push_back(item);
+        item.mesh = mesh;
+        item.material = meshRenderer.GetMaterial();
+        item.worldMatrix = transform.GetWorldMatrix();
+
+        const BoundingBox worldBounds = BoundingBox(mesh->GetBoundsMin(), mesh->GetBoundsMax()).Transform(item.worldMatrix);
+        cullingBounds_.Add(worldBounds);
+        candidateDepths_.push_back(ComputeViewDepth(view, worldBounds));
+        meshCandidates_.push_back(item);
+    }
+
+    lastCulledMeshCount_ = CullBounds(view);
+
+    // 見える物だけキーを作って並べ替える（キーが同じなら収集順）
+    drawKeys_.clear();
+    for (uint32 i = 0; i < static_cast<uint32>(meshCandidates_.size()); ++i) {
+        if (!visibility_[i]) continue;
+
+        const RenderItem& item = meshCandidates_[i];
+        const DrawPass pass = IsTransparent(item.material) ? DrawPass::Transparent : DrawPass::Opaque;
+        const uint64 key = DrawKey::Make(pass, view.sortOrder, RenderPipeline::StaticMesh,
+                                         item.material ? item.material->GetSortId() : 0, item.mesh->GetSortId(),
+                                         candidateDepths_[i]);
+        drawKeys_.push_back({ key, i });
+    }
+    RadixSortDrawKeys(drawKeys_, drawKeyScratch_);
+
+    items.reserve(drawKeys_.size());
+    for (const DrawKeyEntry& entry : drawKeys_) {
+        items.push_back(meshCandidates_[entry.index]);
     }
-    
-    // Sort by material for batching
-    std::sort(items.begin(), items.end(), 
-        [](const RenderItem& a, const RenderItem& b) {
-            return a.material < b.material;
-        });
     
     return items;
 }
@@ -46,36 +78,59 @@ std::vector<SkinnedRenderItem> RenderSystem::CollectSkinnedRenderables(Scene* sc
     assert(view.camera && "Camera is null");
     
     std::vector<SkinnedRenderItem> items;
-    
-    for (const auto& go : scene->GetGameObjects()) {
-        if (!go->IsActive()) continue;
-        
-        if (!PassesLayerMask(go->GetLayer(), view.layerMask)) continue;
+
+    skinnedRenderers_.clear();
+    skinnedWorldMatrices_.clear();
+
+    for (auto [go, transform, skinnedRenderer] : scene->Query<Transform, SkinnedMeshRenderer>()) {
+        if (!go.IsActive()) continue;
         
-        auto* skinnedRenderer = go->GetComponent<SkinnedMeshRenderer>();
-        if (!skinnedRenderer) continue;
+        if (!PassesLayerMask(go.GetLayer(), view.layerMask)) continue;
         
-        if (!skinnedRenderer->HasModel()) {
-            Logger::Warning("[描画] '{}' の SkinnedMeshRenderer にモデルがありません", go->GetName());
+        if (!skinnedRenderer.HasModel()) {
+            Logger::Warning("[描画] '{}' の SkinnedMeshRenderer にモデルがありません", go.GetName());
             continue;
         }
-        
+
+        skinnedRenderers_.push_back(&skinnedRenderer);
+        skinnedWorldMatrices_.push_back(transform.GetWorldMatrix());
+    }
+
+    // Get world matrix with coordinate system correction
+    const Matrix4x4 standUpRotation = SkinnedMeshRenderer::GetModelCorrection();
+    Math::MultiplyArray(standUpRotation, skinnedWorldMatrices_, skinnedWorldMatrices_);
+
+    cullingBounds_.Clear();
+    candidateDepths_.clear();
+    for (size_t i = 0; i < skinnedRenderers_.size(); ++i) {
+        const BoundingBox& bounds = skinnedRenderers_[i]->GetBounds();
+        const Vector3 center = bounds.GetCenter();
+        const Vector3 extents = bounds.GetExtents() * SkinnedMeshRenderer::CULLING_BOUNDS_SCALE;
+        const BoundingBox worldBounds = BoundingBox(center - extents, center + extents).Transform(skinnedWorldMatrices_[i]);
+        cullingBounds_.Add(worldBounds);
+        candidateDepths_.push_back(ComputeViewDepth(view, worldBounds));
+    }
+    lastCulledSkinnedCount_ = CullBounds(view);
+
+    skinnedCandidates_.clear();
+    drawKeys_.clear();
+
+    for (size_t i = 0; i < skinnedRenderers_.size(); ++i) {
+        if (!visibility_[i]) continue;
+
+        auto* skinnedRenderer = skinnedRenderers_[i];
+
         // Get bone matrices from animator
         const std::vector<BoneMatrixPair>* bonePairs = skinnedRenderer->GetBoneMatrixPairs();
         
-        // Get world matrix with coordinate system correction
-        // glTF models often need rotation to stand up
-        Matrix4x4 standUpRotation = Matrix4x4::RotationX(Math::PI / 2.0f);
-        Matrix4x4 worldMatrix = standUpRotation * go->GetTransform().GetWorldMatrix();
-        
         // Create render item for each mesh
         const auto& meshes = skinnedRenderer->GetMeshes();
-        Logger::Debug("[描画] '{}' から {}個のメッシュを収集", go->GetName(), meshes.size());
+        Logger::Debug("[描画] '{}' から {}個のメッシュを収集", skinnedRenderer->GetGameObject()->GetName(), meshes.size());
         
         for (const auto& mesh : meshes) {
             SkinnedRenderItem item;
             item.mesh = const_cast<SkinnedMesh*>(&mesh);
-            item.worldMatrix = worldMatrix;
+            item.worldMatrix = skinnedWorldMatrices_[i];
             item.material = skinnedRenderer->GetMaterial();
             
             // Fallback to mesh's own material if renderer doesn't have one
@@ -89,24 +144,62 @@ std::vector<SkinnedRenderItem> RenderSystem::CollectSkinnedRenderables(Scene* sc
             if (auto* animatorComp = skinnedRenderer->GetAnimator()) {
                 item.animator = animatorComp->GetAnimator();
             }
-            
-            items.push_back(item);
+
+            const bool transparent = skinnedRenderer->GetRenderQueue() >= RenderQueue::Transparent ||
+                                     IsTransparent(item.material);
+            const uint64 key = DrawKey::Make(transparent ? DrawPass::Transparent : DrawPass::Opaque, view.sortOrder,
+                                             RenderPipeline::SkinnedMesh, item.material ? item.material->GetSortId() : 0,
+                                             mesh.GetSortId(), candidateDepths_[i]);
+            drawKeys_.push_back({ key, static_cast<uint32>(skinnedCandidates_.size()) });
+            skinnedCandidates_.push_back(item);
         }
     }
+    RadixSortDrawKeys(drawKeys_, drawKeyScratch_);
+
+    items.reserve(drawKeys_.size());
+    for (const DrawKeyEntry& entry : drawKeys_) {
+        items.push_back(skinnedCandidates_[entry.index]);
+    }
     
     Logger::Debug("[描画] スキンメッシュ合計 {}個 収集完了", items.size());
     
-    // Sort by material for batching
-    std::sort(items.begin(), items.end(),
-        [](const SkinnedRenderItem& a, const SkinnedRenderItem& b) {
-            return a.material < b.material;
-        });
-    
     return items;
 }
 
 void RenderSystem::Clear() {
-    // Reserved for future cached data clearing
+    skinnedRenderers_.clear();
+    skinnedRenderers_.shrink_to_fit();
+    skinnedWorldMatrices_.clear();
+    skinnedWorldMatrices_.shrink_to_fit();
+    cullingBounds_ = CullingBoundsArray();
+    visibility_.clear();
+    visibility_.shrink_to_fit();
+    meshCandidates_.clear();
+    meshCandidates_.shrink_to_fit();
+    candidateDepths_.clear();
+    candidateDepths_.shrink_to_fit();
+    drawKeys_.clear();
+    drawKeys_.shrink_to_fit();
+    drawKeyScratch_.clear();
+    drawKeyScratch_.shrink_to_fit();
+    skinnedCandidates_.clear();
+    skinnedCandidates_.shrink_to_fit();
+}
+
+uint32 RenderSystem::CullBounds(const RenderView& view) {
+    const uint32 count = cullingBounds_.GetCount();
+    if (!frustumCullingEnabled_) {
+        visibility_.assign(count, 1);
+        return 0;
+    }
+
+    const Frustum frustum(view.camera->GetViewProjectionMatrix());
+    frustum.Cull(cullingBounds_, visibility_);
+    return count - static_cast<uint32>(std::count(visibility_.begin(), visibility_.end(), uint8(1)));
+}
+
+float RenderSystem::ComputeViewDepth(const RenderView& view, const BoundingBox& worldBounds) {
+    return (worldBounds.GetCenter() - view.camera->GetPosition()).Dot(view.camera->GetForward());
 }
 
 bool RenderSystem::PassesLayerMask(uint32 objectLayer, uint32 viewMask) const {
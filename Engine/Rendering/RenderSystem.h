@@ -3,9 +3,13 @@
 #include "../Core/Scene.h"
 #include "../Core/Camera.h"
 #include "RenderView.h"
+#include "../Graphics/Mesh.h"
+#include "../Graphics/Material.h"
 #include "RenderItem.h"
 #include "SkinnedRenderItem.h"
+#include "DrawKey.h"
 #include "../Math/Matrix.h"
+#include "../Math/Frustum.h"
 #include <vector>
 
 namespace UnoEngine {
@@ -17,17 +21,48 @@ public:
     RenderSystem() = default;
     ~RenderSystem() = default;
 
-    // Collect static mesh renderables
+    // Collect static mesh renderables, ordered by DrawKey (opaque front-to-back by state, then transparent back-to-front)
     std::vector<RenderItem> CollectRenderables(Scene* scene, const RenderView& view);
 
-    // Collect skinned mesh renderables (NEW)
+    // Collect skinned mesh renderables, ordered by DrawKey
     std::vector<SkinnedRenderItem> CollectSkinnedRenderables(Scene* scene, const RenderView& view);
 
     // Clear cached items
     void Clear();
 
+    // Frustum culling against the view camera (enabled by default)
+    void SetFrustumCullingEnabled(bool enabled) { frustumCullingEnabled_ = enabled; }
+    bool IsFrustumCullingEnabled() const { return frustumCullingEnabled_; }
+
+    // Number of objects rejected by frustum culling in the last CollectRenderables / CollectSkinnedRenderables call
+    uint32 GetLastCulledMeshCount() const { return lastCulledMeshCount_; }
+    uint32 GetLastCulledSkinnedCount() const { return lastCulledSkinnedCount_; }
+    uint32 GetLastCulledCount() const { return lastCulledMeshCount_ + lastCulledSkinnedCount_; }
+
 private:
     bool PassesLayerMask(uint32 objectLayer, uint32 viewMask) const;
+    // cullingBounds_の各箱をビューの視錐台で判定してvisibility_に書き出し、見えない数を返す
+    uint32 CullBounds(const RenderView& view);
+    // カメラの前方向に沿った箱の中心までの距離
+    static float ComputeViewDepth(const RenderView& view, const BoundingBox& worldBounds);
+
+    // CollectSkinnedRenderables用の作業バッファ（フレーム間で再利用）
+    std::vector<SkinnedMeshRenderer*> skinnedRenderers_;
+    std::vector<Matrix4x4> skinnedWorldMatrices_;
+
+    // 視錐台カリング用の作業バッファ（収集した順にワールド空間のAABBを入れる）
+    CullingBoundsArray cullingBounds_;
+    std::vector<uint8> visibility_;
+    std::vector<RenderItem> meshCandidates_;
+    std::vector<float> candidateDepths_;
+
+    // 描画順の並べ替え用の作業バッファ
+    std::vector<DrawKeyEntry> drawKeys_;
+    std::vector<DrawKeyEntry> drawKeyScratch_;
+    std::vector<SkinnedRenderItem> skinnedCandidates_;
+    bool frustumCullingEnabled_ = true;
+    uint32 lastCulledMeshCount_ = 0;
+    uint32 lastCulledSkinnedCount_ = 0;
 };
 
 } // namespace UnoEngine
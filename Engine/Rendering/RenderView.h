@@ -16,6 +16,10 @@ struct RenderView {
     /// レンダリング対象のレイヤーマスク
     /// ビット演算で複数レイヤーを指定可能（例: 0x00000001 = Layer 0のみ、0xFFFFFFFF = 全レイヤー）
     uint32 layerMask = 0xFFFFFFFF;
+
+    /// 描画キーのビュー番号（0〜15）
+    /// 複数のビューの描画を1つのキューに入れて並べる場合に、番号の小さいビューから描画されます
+    uint32 sortOrder = 0;
     
     /// ビューの識別名
     /// デバッグやプロファイリング時にビューを区別するために使用されます
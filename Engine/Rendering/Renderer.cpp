@@ -4,6 +4,7 @@
 #include "../Graphics/DirectionalLightComponent.h"
 #include "../Graphics/Shader.h"
 #include "../Animation/Animator.h"
+#include "../Math/MatrixBatch.h"
 #include <imgui.h>
 #include <Windows.h>
 
@@ -11,8 +12,16 @@ namespace UnoEngine {
 
 // Matrix4x4をFloat4x4に変換（転置して格納）
 static void StoreTransposedMatrix(Float4x4& dest, const Matrix4x4& src) {
-    Matrix4x4 transposed = src.Transpose();
-    transposed.ToFloatArray(reinterpret_cast<float*>(&dest));
+    Math::MatrixTranspose(src.GetData(), &dest.m[0][0]);
+}
+
+// メッシュの頂点・インデックスバッファを描画コマンドに積む（同じバッファならストリームが省く）
+static void RecordMeshBuffers(RenderCommandStream& stream, const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer) {
+    auto vbView = vertexBuffer.GetView();
+    stream.SetVertexBuffer(vbView.BufferLocation, vbView.SizeInBytes, vbView.StrideInBytes);
+    auto ibView = indexBuffer.GetView();
+    stream.SetIndexBuffer(ibView.BufferLocation, ibView.SizeInBytes,
+                          ibView.Format == DXGI_FORMAT_R16_UINT ? IndexFormat::UInt16 : IndexFormat::UInt32);
 }
 
 void Renderer::Initialize(GraphicsDevice* graphics, Window* window) {
@@ -39,7 +48,8 @@ void Renderer::Initialize(GraphicsDevice* graphics, Window* window) {
 
     skinnedPipeline_.Initialize(device, skinnedVS, skinnedPS, DXGI_FORMAT_R8G8B8A8_UNORM_SRGB);
 
-    constantBuffer_.Create(device, 512);  // フレーム内で複数ビュー×複数メッシュ分
+    viewBuffer_.Create(device, 16);        // 複数ビュー分
+    instanceBuffer_.Create(device, MAX_INSTANCES_PER_FRAME);
     lightBuffer_.Create(device, 16);       // 複数ビュー分
     materialBuffer_.Create(device, 512);   // フレーム内で複数ビュー×複数メッシュ分
     boneBuffer_.Create(device);
@@ -51,6 +61,12 @@ void Renderer::Initialize(GraphicsDevice* graphics, Window* window) {
     // StructuredBuffer for bone matrices (BoneMatrixPair)
     CreateBoneMatrixPairBuffer(device);
 
+    // 描画コマンドのバックエンド
+    commandBackend_.Initialize(graphics_);
+    commandBackend_.RegisterPipeline(RenderPipeline::StaticMesh, pipeline_.GetPipelineState(), pipeline_.GetRootSignature());
+    commandBackend_.RegisterPipeline(RenderPipeline::SkinnedMesh, skinnedPipeline_.GetPipelineState(),
+                                     skinnedPipeline_.GetRootSignature());
+
     imguiManager_ = MakeUnique<ImGuiManager>();
     imguiManager_->Initialize(graphics_, window_, 2);
 
@@ -61,12 +77,14 @@ void Renderer::Initialize(GraphicsDevice* graphics, Window* window) {
 
 void Renderer::BeginFrame() {
     // フレーム開始時にダイナミックバッファをリセット
-    constantBuffer_.Reset();
+    viewBuffer_.Reset();
+    instanceBuffer_.Reset();
     lightBuffer_.Reset();
     materialBuffer_.Reset();
     skinnedTransformBuffer_.Reset();
     skinnedMaterialBuffer_.Reset();
     currentBoneSlot_ = 0;
+    commandStats_.Reset();
 }
 
 void Renderer::Draw(const RenderView& view, const std::vector<RenderItem>& items, LightManager* lights, Scene* scene) {
@@ -94,50 +112,66 @@ void Renderer::UpdateLighting(const RenderView& view, LightManager* lights) {
 }
 
 void Renderer::RenderMeshes(const RenderView& view, const std::vector<RenderItem>& items) {
-    auto* cmdList = graphics_->GetCommandList();
     auto* heap = graphics_->GetSRVHeap();
 
-    cmdList->SetPipelineState(pipeline_.GetPipelineState());
-    cmdList->SetGraphicsRootSignature(pipeline_.GetRootSignature());
-
-    ID3D12DescriptorHeap* heaps[] = {heap};
-    cmdList->SetDescriptorHeaps(1, heaps);
-    cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    commandStream_.Reset();
+    commandStream_.SetPipeline(RenderPipeline::StaticMesh);
 
     // ライトバッファはUpdateLightingで更新済み
-    cmdList->SetGraphicsRootConstantBufferView(2, currentLightGpuAddr_);
+    commandStream_.SetConstantBuffer(2, currentLightGpuAddr_);
 
     auto viewMatrix = view.camera->GetViewMatrix();
     auto projection = view.camera->GetProjectionMatrix();
 
-    for (const auto& item : items) {
-        if (!item.mesh || !item.material) continue;
+    // ビュー・プロジェクションは全アイテム共通のため1回だけ設定する
+    ViewCB viewData;
+    StoreTransposedMatrix(viewData.view, viewMatrix);
+    StoreTransposedMatrix(viewData.projection, projection);
+    StoreTransposedMatrix(viewData.viewProjection, viewMatrix * projection);
+    commandStream_.SetConstantBuffer(0, viewBuffer_.Update(viewData));
+    commandStream_.AddUploadedBytes(sizeof(ViewCB));
+
+    // itemsは描画キーの順なので、同じメッシュ・マテリアルの連続した範囲を1回のインスタンス描画にする
+    instanceBatcher_.Build(items);
+    const auto& instances = instanceBatcher_.GetInstances();
+
+    D3D12_GPU_VIRTUAL_ADDRESS instanceGpuAddr = 0;
+    if (!instances.empty()) {
+        instanceGpuAddr = instanceBuffer_.Allocate(instances.data(), static_cast<uint32>(instances.size()));
+        if (instanceGpuAddr == 0) {
+            Logger::Warning("[Renderer] Max mesh instances ({}) exceeded, skipping {} instances",
+                            MAX_INSTANCES_PER_FRAME, instances.size());
+        } else {
+            commandStream_.AddUploadedBytes(sizeof(InstanceData) * instances.size());
+        }
+    }
 
-        TransformCB transformData;
-        auto mvp = item.worldMatrix * viewMatrix * projection;
-        StoreTransposedMatrix(transformData.world, item.worldMatrix);
-        StoreTransposedMatrix(transformData.view, viewMatrix);
-        StoreTransposedMatrix(transformData.projection, projection);
-        StoreTransposedMatrix(transformData.mvp, mvp);
-        D3D12_GPU_VIRTUAL_ADDRESS transformGpuAddr = constantBuffer_.Update(transformData);
-        cmdList->SetGraphicsRootConstantBufferView(0, transformGpuAddr);
-
-        cmdList->SetGraphicsRootDescriptorTable(1, item.material->GetAlbedoSRV(heap));
-
-        MaterialCB materialData;
-        const auto& matData = item.material->GetData();
-        materialData.albedo = Float3(matData.albedo[0], matData.albedo[1], matData.albedo[2]);
-        materialData.metallic = matData.metallic;
-        materialData.roughness = matData.roughness;
-        D3D12_GPU_VIRTUAL_ADDRESS materialGpuAddr = materialBuffer_.Update(materialData);
-        cmdList->SetGraphicsRootConstantBufferView(3, materialGpuAddr);
-
-        auto vbView = item.mesh->GetVertexBuffer().GetView();
-        cmdList->IASetVertexBuffers(0, 1, &vbView);
-        auto ibView = item.mesh->GetIndexBuffer().GetView();
-        cmdList->IASetIndexBuffer(&ibView);
-        cmdList->DrawIndexedInstanced(item.mesh->GetIndexBuffer().GetIndexCount(), 1, 0, 0, 0);
+    // マテリアルは変わった時だけ定数をアップロードし直す（頂点・インデックスバッファはストリームが省く）
+    const Material* boundMaterial = nullptr;
+
+    for (const auto& batch : instanceBatcher_.GetBatches()) {
+        if (instanceGpuAddr == 0) break;
+
+        commandStream_.SetShaderResource(4, instanceGpuAddr + batch.firstInstance * sizeof(InstanceData));
+
+        if (batch.material != boundMaterial) {
+            commandStream_.SetDescriptorTable(1, batch.material->GetAlbedoSRV(heap).ptr);
+
+            MaterialCB materialData;
+            const auto& matData = batch.material->GetData();
+            materialData.albedo = Float3(matData.albedo[0], matData.albedo[1], matData.albedo[2]);
+            materialData.metallic = matData.metallic;
+            materialData.roughness = matData.roughness;
+            commandStream_.SetConstantBuffer(3, materialBuffer_.Update(materialData));
+            commandStream_.AddUploadedBytes(sizeof(MaterialCB));
+            boundMaterial = batch.material;
+        }
+
+        RecordMeshBuffers(commandStream_, batch.mesh->GetVertexBuffer(), batch.mesh->GetIndexBuffer());
+        commandStream_.DrawIndexed(batch.mesh->GetIndexBuffer().GetIndexCount(), batch.instanceCount);
     }
+
+    ExecuteCommands();
 }
 
 void Renderer::SetupViewport() {
@@ -304,21 +338,21 @@ void Renderer::DrawSkinnedMeshes(const RenderView& view, const std::vector<Skinn
 }
 
 void Renderer::RenderSkinnedMeshes(const RenderView& view, const std::vector<SkinnedRenderItem>& items) {
-    auto* cmdList = graphics_->GetCommandList();
     auto* heap = graphics_->GetSRVHeap();
 
-    cmdList->SetPipelineState(skinnedPipeline_.GetPipelineState());
-    cmdList->SetGraphicsRootSignature(skinnedPipeline_.GetRootSignature());
-
-    ID3D12DescriptorHeap* heaps[] = {heap};
-    cmdList->SetDescriptorHeaps(1, heaps);
-    cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    commandStream_.Reset();
+    commandStream_.SetPipeline(RenderPipeline::SkinnedMesh);
 
     // ライトバッファはUpdateLightingで更新済み
-    cmdList->SetGraphicsRootConstantBufferView(2, currentLightGpuAddr_);
+    commandStream_.SetConstantBuffer(2, currentLightGpuAddr_);
 
     auto viewMatrix = view.camera->GetViewMatrix();
     auto projection = view.camera->GetProjectionMatrix();
+    auto viewProjection = viewMatrix * projection;
+
+    TransformCB transformData;
+    StoreTransposedMatrix(transformData.view, viewMatrix);
+    StoreTransposedMatrix(transformData.projection, projection);
 
     // 注意: ダイナミックバッファのリセットはRenderer::BeginFrame()で行われる
 
@@ -328,6 +362,10 @@ void Renderer::RenderSkinnedMeshes(const RenderView& view, const std::vector<Ski
         boneMatrixPairBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&mappedBoneData));
     }
 
+    // itemsは描画キーの順なので、マテリアルは変わった時だけ定数をアップロードし直す
+    const Material* boundMaterial = nullptr;
+    bool materialBound = false;
+
     for (const auto& item : items) {
         if (!item.mesh) continue;
 
@@ -343,34 +381,34 @@ void Renderer::RenderSkinnedMeshes(const RenderView& view, const std::vector<Ski
         }
 
         // Transform（ダイナミックバッファを使用）
-        TransformCB transformData;
-        auto mvp = item.worldMatrix * viewMatrix * projection;
+        auto mvp = item.worldMatrix * viewProjection;
         StoreTransposedMatrix(transformData.world, item.worldMatrix);
-        StoreTransposedMatrix(transformData.view, viewMatrix);
-        StoreTransposedMatrix(transformData.projection, projection);
         StoreTransposedMatrix(transformData.mvp, mvp);
-        auto transformGpuAddr = skinnedTransformBuffer_.Update(transformData);
-        cmdList->SetGraphicsRootConstantBufferView(0, transformGpuAddr);
+        commandStream_.SetConstantBuffer(0, skinnedTransformBuffer_.Update(transformData));
+        commandStream_.AddUploadedBytes(sizeof(TransformCB));
 
-        // Texture
-        if (item.material) {
-            cmdList->SetGraphicsRootDescriptorTable(4, item.material->GetAlbedoSRV(heap));
-        }
+        // Texture・Material（前のアイテムと同じマテリアルなら設定済み。nullptrも1つのマテリアルとして扱う）
+        if (!materialBound || item.material != boundMaterial) {
+            if (item.material) {
+                commandStream_.SetDescriptorTable(4, item.material->GetAlbedoSRV(heap).ptr);
+            }
 
-        // Material（ダイナミックバッファを使用）
-        MaterialCB materialData;
-        if (item.material) {
-            const auto& matData = item.material->GetData();
-            materialData.albedo = Float3(matData.albedo[0], matData.albedo[1], matData.albedo[2]);
-            materialData.metallic = matData.metallic;
-            materialData.roughness = matData.roughness;
-        } else {
-            materialData.albedo = Float3(1.0f, 1.0f, 1.0f);
-            materialData.metallic = 0.0f;
-            materialData.roughness = 0.5f;
+            MaterialCB materialData;
+            if (item.material) {
+                const auto& matData = item.material->GetData();
+                materialData.albedo = Float3(matData.albedo[0], matData.albedo[1], matData.albedo[2]);
+                materialData.metallic = matData.metallic;
+                materialData.roughness = matData.roughness;
+            } else {
+                materialData.albedo = Float3(1.0f, 1.0f, 1.0f);
+                materialData.metallic = 0.0f;
+                materialData.roughness = 0.5f;
+            }
+            commandStream_.SetConstantBuffer(3, skinnedMaterialBuffer_.Update(materialData));
+            commandStream_.AddUploadedBytes(sizeof(MaterialCB));
+            boundMaterial = item.material;
+            materialBound = true;
         }
-        auto materialGpuAddr = skinnedMaterialBuffer_.Update(materialData);
-        cmdList->SetGraphicsRootConstantBufferView(3, materialGpuAddr);
 
         // Bone matrices（現在のスロットに書き込み）
         if (mappedBoneData && item.boneMatrixPairs) {
@@ -379,34 +417,33 @@ void Renderer::RenderSkinnedMeshes(const RenderView& view, const std::vector<Ski
             // このスロットのオフセット
             BoneMatrixPair* slotData = mappedBoneData + (currentBoneSlot_ * MAX_BONES);
             
-            for (size_t i = 0; i < numBones; ++i) {
-                const auto& pair = (*item.boneMatrixPairs)[i];
-                // 転置した行列を格納
-                Matrix4x4 transposedSkeleton = pair.skeletonSpaceMatrix.Transpose();
-                Matrix4x4 transposedInvTranspose = pair.skeletonSpaceInverseTransposeMatrix.Transpose();
-                transposedSkeleton.ToFloatArray(reinterpret_cast<float*>(&slotData[i].skeletonSpaceMatrix));
-                transposedInvTranspose.ToFloatArray(reinterpret_cast<float*>(&slotData[i].skeletonSpaceInverseTransposeMatrix));
-            }
+            // 転置した行列を格納（BoneMatrixPairは行列2つの連続領域なので全行列を一括で転置コピー）
+            Math::MatrixTransposeArray((*item.boneMatrixPairs)[0].skeletonSpaceMatrix.GetData(), Math::MATRIX_FLOAT_STRIDE,
+                                       slotData[0].skeletonSpaceMatrix.GetData(), Math::MATRIX_FLOAT_STRIDE,
+                                       numBones * 2);
+            commandStream_.AddUploadedBytes(sizeof(BoneMatrixPair) * numBones);
             
             // このスロット用のSRVをバインド
-            cmdList->SetGraphicsRootDescriptorTable(1, boneMatrixPairSRVs_[currentBoneSlot_]);
+            commandStream_.SetDescriptorTable(1, boneMatrixPairSRVs_[currentBoneSlot_].ptr);
             currentBoneSlot_++;
         }
 
         // Draw
-        auto vbView = item.mesh->GetVertexBuffer().GetView();
-        cmdList->IASetVertexBuffers(0, 1, &vbView);
-        auto ibView = item.mesh->GetIndexBuffer().GetView();
-        cmdList->IASetIndexBuffer(&ibView);
-
-        uint32 indexCount = item.mesh->GetIndexBuffer().GetIndexCount();
-        cmdList->DrawIndexedInstanced(indexCount, 1, 0, 0, 0);
+        RecordMeshBuffers(commandStream_, item.mesh->GetVertexBuffer(), item.mesh->GetIndexBuffer());
+        commandStream_.DrawIndexed(item.mesh->GetIndexBuffer().GetIndexCount());
     }
 
     // ボーン行列バッファのアンマップ
     if (boneMatrixPairBuffer_) {
         boneMatrixPairBuffer_->Unmap(0, nullptr);
     }
+
+    ExecuteCommands();
+}
+
+void Renderer::ExecuteCommands() {
+    commandBackend_.Execute(commandStream_);
+    commandStats_.Execute(commandStream_);
 }
 
 void Renderer::CreateBoneMatrixPairBuffer(ID3D12Device* device) {
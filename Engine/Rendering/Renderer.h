@@ -5,7 +5,14 @@
 #include "../Graphics/SkinnedPipeline.h"
 #include "../Graphics/ConstantBuffer.h"
 #include "../Graphics/DynamicConstantBuffer.h"
+#include "../Graphics/DynamicStructuredBuffer.h"
+#include "../Graphics/Mesh.h"
+#include "../Graphics/Material.h"
 #include "RenderItem.h"
+#include "InstanceBatcher.h"
+#include "RenderCommand.h"
+#include "D3D12CommandBackend.h"
+#include "RecordingCommandBackend.h"
 #include "SkinnedRenderItem.h"
 #include "RenderView.h"
 #include "LightManager.h"
@@ -24,6 +31,13 @@ struct alignas(256) TransformCB {
     Float4x4 mvp;
 };
 
+// 通常メッシュ用のビューごとの定数（ワールド行列はインスタンスデータで渡す）
+struct alignas(256) ViewCB {
+    Float4x4 view;
+    Float4x4 projection;
+    Float4x4 viewProjection;
+};
+
 struct alignas(256) LightCB {
     Float3 directionalLightDirection;
     float padding0;
@@ -65,6 +79,9 @@ public:
     ImGuiManager* GetImGuiManager() { return imguiManager_.get(); }
     DebugRenderer* GetDebugRenderer() { return debugRenderer_.get(); }
 
+    // BeginFrameからの描画コマンドの集計（描画回数・ステートの切り替え・アップロード量）
+    const RenderCommandStats& GetCommandStats() const { return commandStats_.GetStats(); }
+
 protected:
     virtual void RenderUI(Scene* scene);
 
@@ -74,6 +91,8 @@ private:
     void RenderMeshes(const RenderView& view, const std::vector<RenderItem>& items);
     void RenderSkinnedMeshes(const RenderView& view, const std::vector<SkinnedRenderItem>& items);
     void CreateBoneMatrixPairBuffer(ID3D12Device* device);
+    // commandStream_をGPUに積み、集計にも加える
+    void ExecuteCommands();
 
 private:
     GraphicsDevice* graphics_ = nullptr;
@@ -86,7 +105,7 @@ private:
     DynamicConstantBuffer<MaterialCB> skinnedMaterialBuffer_;
     
     // 通常メッシュ用（DynamicConstantBufferで複数ビュー対応）
-    DynamicConstantBuffer<TransformCB> constantBuffer_;
+    DynamicConstantBuffer<ViewCB> viewBuffer_;
     DynamicConstantBuffer<LightCB> lightBuffer_;
     DynamicConstantBuffer<MaterialCB> materialBuffer_;
     ConstantBuffer<BoneMatricesCB> boneBuffer_;
@@ -101,6 +120,16 @@ private:
     uint32 boneMatrixPairSRVBaseIndex_ = 0;
     uint32 currentBoneSlot_ = 0;  // 現在使用中のスロット
 
+    // 通常メッシュのインスタンス描画（同じメッシュ・マテリアルの連続したアイテムを1回の描画にまとめる）
+    static constexpr uint32 MAX_INSTANCES_PER_FRAME = 16384;  // 1フレームで描画可能な通常メッシュの合計（全ビュー分）
+    DynamicStructuredBuffer<InstanceData> instanceBuffer_;
+    InstanceBatcher instanceBatcher_;
+
+    // メッシュの描画はcommandStream_に積んでからバックエンドで実行する
+    RenderCommandStream commandStream_;
+    D3D12CommandBackend commandBackend_;
+    RecordingCommandBackend commandStats_;
+
     UniquePtr<ImGuiManager> imguiManager_;
     UniquePtr<DebugRenderer> debugRenderer_;
 };
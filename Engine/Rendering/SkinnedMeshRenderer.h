@@ -2,6 +2,8 @@
 
 #include "MeshRendererBase.h"
 #include "../Resource/SkinnedModelImporter.h"
+#include "../Math/Matrix.h"
+#include "../Math/MathCommon.h"
 #include <string>
 #include <vector>
 
@@ -41,6 +43,12 @@ public:
     // Get model path for serialization
     const std::string& GetModelPath() const { return modelPath_; }
 
+    // Coordinate system correction applied before the world matrix (glTF models often need rotation to stand up)
+    static Matrix4x4 GetModelCorrection() { return Matrix4x4::RotationX(Math::PI / 2.0f); }
+
+    // Animated poses can leave the bind-pose bounds, so culling boxes are scaled up by this factor
+    static constexpr float CULLING_BOUNDS_SCALE = 1.5f;
+
 private:
     void LinkAnimator();
     void InitializeAnimator();
@@ -1,6 +1,8 @@
 #include "SkinnedModelImporter.h"
 #include "../Graphics/GraphicsDevice.h"
 #include "../Graphics/Material.h"
+#include "../Animation/CompressedAnimation.h"
+#include "../Core/Logger.h"
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
@@ -237,6 +239,7 @@ std::shared_ptr<Skeleton> ExtractSkeleton(const aiScene* scene,
     // (ogldevチュートリアル参照)
     Matrix4x4 rootTransform = ConvertMatrix(scene->mRootNode->mTransformation);
     skeleton->SetGlobalInverseTransform(rootTransform.Inverse());
+    skeleton->MarkDetailBonesByName();
 
     return skeleton;
 }
@@ -495,6 +498,19 @@ SkinnedModelData SkinnedModelImporter::Load(GraphicsDevice* graphics, ID3D12Grap
 
     result.animations = ExtractAnimations(scene, boneMapping);
 
+    // アニメーションを圧縮形式に変換し、元のキーとの差をログに出す
+    const AnimationCompressionSettings compressionSettings;
+    for (const auto& clip : result.animations) {
+        if (!result.skeleton) break;
+
+        AnimationCompressionReport report;
+        clip->Compress(*result.skeleton, compressionSettings, &report);
+        Logger::Info("[SkinnedModelImporter] アニメーション圧縮 {}: {:.1f} KB -> {:.1f} KB (キー {} -> {}, 定数トラック {}/{}), 最大位置誤差 {:.6f}",
+                     clip->GetName(), report.rawBytes / 1024.0, report.compressedBytes / 1024.0,
+                     report.rawKeyCount, report.compressedKeyCount, report.constantTrackCount, report.trackCount,
+                     report.maxPositionError);
+    }
+
     ProcessNode(scene->mRootNode, scene, graphics, commandList,
                baseDirectory, boneMapping, result.meshes);
 
@@ -43,7 +43,7 @@ bool SceneSerializer::SaveScene(const std::vector<std::unique_ptr<GameObject>>&
     }
 }
 
-bool SceneSerializer::LoadScene(const std::string& filepath, std::vector<std::unique_ptr<GameObject>>& outGameObjects) {
+bool SceneSerializer::LoadScene(const std::string& filepath, Scene& scene) {
     try {
         std::ifstream file(filepath);
         if (!file.is_open()) {
@@ -56,20 +56,20 @@ bool SceneSerializer::LoadScene(const std::string& filepath, std::vector<std::un
         file.close();
 
         // Clear existing objects
-        outGameObjects.clear();
+        scene.ClearGameObjects();
 
         // Load objects
         if (sceneJson.contains("objects")) {
             for (const auto& objJson : sceneJson["objects"]) {
                 auto gameObject = DeserializeGameObject(objJson);
                 if (gameObject) {
-                    outGameObjects.push_back(std::move(gameObject));
+                    scene.AddGameObject(std::move(gameObject));
                 }
             }
         }
 
         std::cout << "Scene loaded successfully: " << filepath << std::endl;
-        std::cout << "Loaded " << outGameObjects.size() << " objects" << std::endl;
+        std::cout << "Loaded " << scene.GetGameObjects().size() << " objects" << std::endl;
         return true;
 
     } catch (const std::exception& e) {
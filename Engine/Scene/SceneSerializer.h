@@ -20,9 +20,9 @@ public:
 
     /// JSONファイルからシーンをロード
     /// @param filepath ロードするJSONファイルパス
-    /// @param outGameObjects ロードしたGameObjectの格納先
+    /// @param scene ロード先のシーン（既存のGameObjectは破棄される）
     /// @return ロードが成功したかどうか
-    static bool LoadScene(const std::string& filepath, std::vector<std::unique_ptr<GameObject>>& outGameObjects);
+    static bool LoadScene(const std::string& filepath, Scene& scene);
 
 private:
     /// GameObject単体をJSONにシリアライズ
@@ -1,6 +1,7 @@
 #include "LuaScriptComponent.h"
 #include "../Core/GameObject.h"
 #include "../Core/Logger.h"
+#include "../Animation/AnimatorComponent.h"
 
 namespace UnoEngine {
 
@@ -31,23 +32,62 @@ void LuaScriptComponent::Start() {
         luaState_->CallStart();
         startCalledInLua_ = true;
     }
+
+    LinkAnimator();
 }
 
 void LuaScriptComponent::OnUpdate(float deltaTime) {
     // ホットリロードチェック
     CheckHotReload();
 
+    LinkAnimator();
+
     if (scriptLoaded_) {
         luaState_->CallUpdate(deltaTime);
     }
 }
 
 void LuaScriptComponent::OnDestroy() {
+    UnlinkAnimator();
+
     if (scriptLoaded_) {
         luaState_->CallOnDestroy();
     }
 }
 
+void LuaScriptComponent::LinkAnimator() {
+    AnimatorComponent* animator = GetGameObject()->GetComponent<AnimatorComponent>();
+    if (!animator) {
+        // 取り除かれたAnimatorのリスナーはAnimatorと一緒に破棄されている
+        animatorListenerId_ = 0;
+        return;
+    }
+
+    // リスナーのIDは全Animatorで重複しないため、見つからなければAnimatorが追加・付け替えされている
+    if (animatorListenerId_ != 0 && animator->GetAnimator()->HasEventListener(animatorListenerId_)) {
+        return;
+    }
+
+    // イベントはAnimationSystemの更新の後にメインスレッドで通知される
+    animatorListenerId_ = animator->GetAnimator()->AddEventListener([this](const FiredAnimationEvent& fired) {
+        if (scriptLoaded_) {
+            const AnimationEvent& event = *fired.event;
+            luaState_->CallAnimationEvent(event.name, event.floatParameter, event.intParameter, event.stringParameter);
+        }
+    });
+}
+
+void LuaScriptComponent::UnlinkAnimator() {
+    if (animatorListenerId_ == 0) {
+        return;
+    }
+
+    if (AnimatorComponent* animator = GetGameObject()->GetComponent<AnimatorComponent>()) {
+        animator->GetAnimator()->RemoveEventListener(animatorListenerId_);
+    }
+    animatorListenerId_ = 0;
+}
+
 void LuaScriptComponent::SetScriptPath(std::string_view path) {
     scriptPath_ = std::string(path);
     
@@ -46,6 +46,10 @@ public:
 private:
     // エンジンAPIをLuaに公開
     void BindEngineAPI();
+    // 同じGameObjectのAnimatorのイベントをOnAnimationEventへ渡す
+    // AnimatorComponentはStartの後に追加・付け替えされることがあるため、毎フレーム確かめてつなぎ直す
+    void LinkAnimator();
+    void UnlinkAnimator();
 
 private:
     std::unique_ptr<LuaState> luaState_;
@@ -53,6 +57,7 @@ private:
     bool scriptLoaded_ = false;
     bool awakeCalledInLua_ = false;
     bool startCalledInLua_ = false;
+    uint32 animatorListenerId_ = 0;
 };
 
 } // namespace UnoEngine
@@ -143,6 +143,10 @@ void LuaState::CallOnDestroy() {
     SafeCall("OnDestroy");
 }
 
+void LuaState::CallAnimationEvent(std::string_view name, float floatParameter, int32 intParameter, std::string_view stringParameter) {
+    SafeCall("OnAnimationEvent", std::string(name), floatParameter, intParameter, std::string(stringParameter));
+}
+
 std::vector<ScriptProperty> LuaState::GetPublicProperties() const {
     std::vector<ScriptProperty> properties;
 
@@ -340,5 +344,6 @@ void LuaState::SafeCall(std::string_view funcName, Args&&... args) {
 template void LuaState::SafeCall<>(std::string_view);
 template void LuaState::SafeCall<float>(std::string_view, float&&);
 template void LuaState::SafeCall<float&>(std::string_view, float&);
+template void LuaState::SafeCall<std::string, float&, int32&, std::string>(std::string_view, std::string&&, float&, int32&, std::string&&);
 
 } // namespace UnoEngine
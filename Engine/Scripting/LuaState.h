@@ -70,6 +70,8 @@ namespace UnoEngine {
 		void CallStart();
 		void CallUpdate(float deltaTime);
 		void CallOnDestroy();
+		// 同じGameObjectのAnimatorのイベント（OnAnimationEvent(name, floatParameter, intParameter, stringParameter)）
+		void CallAnimationEvent(std::string_view name, float floatParameter, int32 intParameter, std::string_view stringParameter);
 
 		// プロパティ操作
 		[[nodiscard]] std::vector<ScriptProperty> GetPublicProperties() const;
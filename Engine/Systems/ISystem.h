@@ -1,8 +1,11 @@
 #pragma once
 
+#include "SystemAccess.h"
+
 namespace UnoEngine {
 
 class Scene;
+class JobSystem;
 
 class ISystem {
 public:
@@ -10,15 +13,31 @@ public:
     
     virtual void OnSceneStart(Scene* scene) {}
     virtual void OnUpdate(Scene* scene, float deltaTime) = 0;
+    // 全システムのOnUpdateが終わった後、SystemManager::Updateを呼んだスレッド（メインスレッド）で優先度順に呼ばれる
+    // 他のシステムと並行しないため、宣言に関係なくシーンに触れてよい（Luaやオーディオへの通知など）
+    virtual void OnMainThreadUpdate(Scene* scene) {}
     virtual void OnSceneEnd(Scene* scene) {}
     
     virtual int GetPriority() const { return 100; }
+
+    // OnUpdateで読み書きするコンポーネント型を宣言する（登録時に一度だけ呼ばれる）
+    // 宣言が衝突しないシステム同士は並行して実行される。既定では他のシステムと並行させない
+    virtual void DeclareAccess(SystemAccess& access) const { access.Exclusive(); }
+    const SystemAccess& GetAccess() const { return access_; }
     
     bool IsEnabled() const { return enabled_; }
     void SetEnabled(bool enabled) { enabled_ = enabled; }
 
+protected:
+    // OnUpdate内の並列処理用（SystemManagerが設定する。未設定時はnullptr）
+    JobSystem* GetJobSystem() const { return jobSystem_; }
+
 private:
+    friend class SystemManager;
+
     bool enabled_ = true;
+    JobSystem* jobSystem_ = nullptr;
+    SystemAccess access_;
 };
 
 } // namespace UnoEngine
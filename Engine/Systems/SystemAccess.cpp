@@ -0,0 +1,96 @@
+#include "SystemAccess.h"
+#include "../Core/Logger.h"
+#include <algorithm>
+#include <cassert>
+
+namespace UnoEngine {
+
+namespace {
+
+// 現在のスレッドで実行中のシステム（またはそのシステムが投入したジョブ）の宣言
+thread_local SystemAccess::ValidationState t_currentValidation;
+
+} // namespace
+
+SystemAccess& SystemAccess::Read(std::type_index type) {
+    if (!Contains(reads_, type)) {
+        reads_.push_back(type);
+    }
+    return *this;
+}
+
+SystemAccess& SystemAccess::Write(std::type_index type) {
+    if (!Contains(writes_, type)) {
+        writes_.push_back(type);
+    }
+    return *this;
+}
+
+bool SystemAccess::CanRead(std::type_index type) const {
+    return exclusive_ || Contains(reads_, type) || Contains(writes_, type);
+}
+
+bool SystemAccess::CanWrite(std::type_index type) const {
+    return exclusive_ || Contains(writes_, type);
+}
+
+bool SystemAccess::ConflictsWith(const SystemAccess& other) const {
+    if (exclusive_ || other.exclusive_) return true;
+
+    for (const auto& type : writes_) {
+        if (Contains(other.reads_, type) || Contains(other.writes_, type)) return true;
+    }
+    for (const auto& type : other.writes_) {
+        if (Contains(reads_, type)) return true;
+    }
+    return false;
+}
+
+void SystemAccess::Clear() {
+    reads_.clear();
+    writes_.clear();
+    exclusive_ = false;
+    mainThread_ = false;
+}
+
+bool SystemAccess::Contains(const std::vector<std::type_index>& types, std::type_index type) {
+    return std::find(types.begin(), types.end(), type) != types.end();
+}
+
+SystemAccess::ValidationScope::ValidationScope(const SystemAccess& access, const char* systemName)
+    : ValidationScope(ValidationState{ &access, systemName }) {
+}
+
+SystemAccess::ValidationScope::ValidationScope(const ValidationState& state)
+    : previous_(t_currentValidation) {
+    t_currentValidation = state;
+}
+
+SystemAccess::ValidationScope::~ValidationScope() {
+    t_currentValidation = previous_;
+}
+
+SystemAccess::ValidationState SystemAccess::GetCurrentValidation() {
+    return t_currentValidation;
+}
+
+bool SystemAccess::ValidateComponentAccess(std::type_index type, bool write) {
+    const SystemAccess* access = t_currentValidation.access;
+    if (!access) return true;
+
+    if (write) {
+        if (access->CanWrite(type)) return true;
+        Logger::Error("[SystemAccess] {} が書き込みを宣言していないコンポーネント {} を書き込み可能な形で取得しました",
+                      t_currentValidation.systemName, type.name());
+        assert(false && "Component write access was not declared in ISystem::DeclareAccess");
+        return false;
+    }
+
+    if (access->CanRead(type)) return true;
+    Logger::Error("[SystemAccess] {} が宣言していないコンポーネント {} にアクセスしました",
+                  t_currentValidation.systemName, type.name());
+    assert(false && "Component access was not declared in ISystem::DeclareAccess");
+    return false;
+}
+
+} // namespace UnoEngine
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "../Core/Types.h"
+#include <type_traits>
+#include <typeindex>
+#include <vector>
+
+namespace UnoEngine {
+
+// システムがOnUpdateで読み書きするコンポーネント型の宣言
+// SystemManagerは宣言が衝突しない（同じ型に対する書き込みと読み書きがない）システム同士を並行実行する
+//
+// 何も宣言しないシステムはどのコンポーネントにも触れない扱いになる
+// シーン構造の変更（GameObjectの生成・破棄、AddComponentなど）を行うシステムはExclusive()を宣言すること
+// Luaやオーディオなど、メインスレッドからしか触れないものを使うシステムはMainThread()を宣言すること
+class SystemAccess {
+public:
+    template<typename T>
+    SystemAccess& Read() { return Read(std::type_index(typeid(T))); }
+
+    template<typename T>
+    SystemAccess& Write() { return Write(std::type_index(typeid(T))); }
+
+    SystemAccess& Read(std::type_index type);
+    SystemAccess& Write(std::type_index type);
+
+    // 他のすべてのシステムと並行させない
+    SystemAccess& Exclusive() { exclusive_ = true; return *this; }
+
+    // SystemManager::Updateを呼んだスレッド（メインスレッド）で実行する
+    // 他のシステムとは並行できるが、ワーカースレッドのジョブには出されない
+    SystemAccess& MainThread() { mainThread_ = true; return *this; }
+
+    bool IsExclusive() const { return exclusive_; }
+    bool IsMainThread() const { return mainThread_; }
+    bool CanRead(std::type_index type) const;
+    bool CanWrite(std::type_index type) const;
+
+    // 並行実行すると競合するか
+    bool ConflictsWith(const SystemAccess& other) const;
+
+    void Clear();
+
+    // デバッグビルドでの宣言チェック
+    // システムのOnUpdate実行中、宣言していない型のコンポーネントを取得するとエラーにする
+    // 現在のシステムはスレッドごとに持ち、JobSystemがジョブの投入時に取得して実行中だけ設定し直す
+    // （OnUpdateから投入したジョブはどのスレッドで実行されても投入したシステムの宣言で検査される）
+    struct ValidationState {
+        const SystemAccess* access = nullptr;
+        const char* systemName = nullptr;
+    };
+
+    class ValidationScope {
+    public:
+        ValidationScope(const SystemAccess& access, const char* systemName);
+        explicit ValidationScope(const ValidationState& state);
+        ~ValidationScope();
+
+        ValidationScope(const ValidationScope&) = delete;
+        ValidationScope& operator=(const ValidationScope&) = delete;
+
+    private:
+        ValidationState previous_;
+    };
+
+    static ValidationState GetCurrentValidation();
+
+    // GameObject::GetComponentやScene::Queryから呼ばれる（システム実行中でなければ何もしない）
+    // const付きの型での取得は読み取り、それ以外は書き込みとして宣言と照らし合わせる。許可されていればtrue
+    template<typename T>
+    static bool ValidateComponentAccess() {
+        return ValidateComponentAccess(std::type_index(typeid(T)), !std::is_const_v<T>);
+    }
+    static bool ValidateComponentAccess(std::type_index type, bool write);
+
+private:
+    static bool Contains(const std::vector<std::type_index>& types, std::type_index type);
+
+    std::vector<std::type_index> reads_;
+    std::vector<std::type_index> writes_;
+    bool exclusive_ = false;
+    bool mainThread_ = false;
+};
+
+} // namespace UnoEngine
@@ -1,9 +1,18 @@
 #include "SystemManager.h"
 #include "../Core/Scene.h"
+#include "../Core/JobSystem.h"
 #include <algorithm>
+#include <typeinfo>
 
 namespace UnoEngine {
 
+void SystemManager::SetJobSystem(JobSystem* jobSystem) {
+    jobSystem_ = jobSystem;
+    for (auto& system : systems_) {
+        system->jobSystem_ = jobSystem;
+    }
+}
+
 void SystemManager::OnSceneStart(Scene* scene) {
     SortSystems();
 
@@ -19,9 +28,17 @@ void SystemManager::Update(Scene* scene, float deltaTime) {
         SortSystems();
     }
 
+    // 有効/無効はフレームごとに変わり得るため毎フレーム組み直す（システム数は少ない）
+    BuildSchedule();
+
+    for (size_t wave = 0; wave + 1 < waveStarts_.size(); ++wave) {
+        RunWave(waveStarts_[wave], waveStarts_[wave + 1], scene, deltaTime);
+    }
+
+    // ウェーブの後のメインスレッドでの処理（ジョブはすべて終わっている）
     for (auto& system : systems_) {
         if (system && system->IsEnabled()) {
-            system->OnUpdate(scene, deltaTime);
+            system->OnMainThreadUpdate(scene);
         }
     }
 }
@@ -34,8 +51,95 @@ void SystemManager::OnSceneEnd(Scene* scene) {
     }
 }
 
+void SystemManager::BuildSchedule() {
+    scheduledSystems_.clear();
+    waveStarts_.clear();
+    systemWaves_.clear();
+
+    // 優先度順に並んだシステムを、衝突する先行システムの次のウェーブへ置く
+    std::vector<ISystem*>& enabled = scheduledSystems_;
+    for (auto& system : systems_) {
+        if (system && system->IsEnabled()) {
+            enabled.push_back(system.get());
+        }
+    }
+
+    uint32 waveCount = 0;
+    for (size_t i = 0; i < enabled.size(); ++i) {
+        uint32 wave = 0;
+        for (size_t j = 0; j < i; ++j) {
+            if (systemWaves_[j] >= wave && enabled[i]->GetAccess().ConflictsWith(enabled[j]->GetAccess())) {
+                wave = systemWaves_[j] + 1;
+            }
+        }
+        systemWaves_.push_back(wave);
+        waveCount = (std::max)(waveCount, wave + 1);
+    }
+
+    // ウェーブ順に安定に並べ替える（ウェーブ内は優先度順のまま）
+    std::vector<uint32> counts(waveCount + 1, 0);
+    for (uint32 wave : systemWaves_) {
+        ++counts[wave + 1];
+    }
+    for (uint32 wave = 0; wave < waveCount; ++wave) {
+        counts[wave + 1] += counts[wave];
+    }
+    waveStarts_.assign(counts.begin(), counts.end());
+
+    std::vector<ISystem*> ordered(enabled.size());
+    for (size_t i = 0; i < enabled.size(); ++i) {
+        ordered[counts[systemWaves_[i]]++] = enabled[i];
+    }
+    scheduledSystems_ = std::move(ordered);
+}
+
+void SystemManager::RunWave(uint32 begin, uint32 end, Scene* scene, float deltaTime) {
+    if (!jobSystem_ || jobSystem_->GetWorkerCount() == 0 || end - begin == 1) {
+        for (uint32 i = begin; i < end; ++i) {
+            RunSystem(scheduledSystems_[i], scene, deltaTime);
+        }
+        return;
+    }
+
+    // メインスレッド指定のシステムは呼び出しスレッドで実行し、それ以外をジョブに出す
+    // 指定が無いウェーブでは先頭を呼び出しスレッドで実行する
+    bool hasMainThreadSystem = false;
+    for (uint32 i = begin; i < end; ++i) {
+        if (scheduledSystems_[i]->GetAccess().IsMainThread()) {
+            hasMainThreadSystem = true;
+            break;
+        }
+    }
+    auto runsOnCaller = [&](uint32 index) {
+        return hasMainThreadSystem ? scheduledSystems_[index]->GetAccess().IsMainThread() : index == begin;
+    };
+
+    JobCounter counter;
+    for (uint32 i = begin; i < end; ++i) {
+        if (runsOnCaller(i)) continue;
+
+        ISystem* system = scheduledSystems_[i];
+        jobSystem_->Run([system, scene, deltaTime]() {
+            RunSystem(system, scene, deltaTime);
+        }, &counter);
+    }
+    for (uint32 i = begin; i < end; ++i) {
+        if (runsOnCaller(i)) {
+            RunSystem(scheduledSystems_[i], scene, deltaTime);
+        }
+    }
+    jobSystem_->Wait(counter);
+}
+
+void SystemManager::RunSystem(ISystem* system, Scene* scene, float deltaTime) {
+#ifdef _DEBUG
+    SystemAccess::ValidationScope scope(system->GetAccess(), typeid(*system).name());
+#endif
+    system->OnUpdate(scene, deltaTime);
+}
+
 void SystemManager::SortSystems() {
-    std::sort(systems_.begin(), systems_.end(),
+    std::stable_sort(systems_.begin(), systems_.end(),
         [](const std::unique_ptr<ISystem>& a, const std::unique_ptr<ISystem>& b) {
             return a->GetPriority() < b->GetPriority();
         });
@@ -9,6 +9,7 @@
 namespace UnoEngine {
 
 class Scene;
+class JobSystem;
 
 class SystemManager {
 public:
@@ -23,10 +24,18 @@ public:
     template<typename T>
     T* GetSystem() const;
 
+    // Job system handed to every registered system
+    void SetJobSystem(JobSystem* jobSystem);
+    JobSystem* GetJobSystem() const { return jobSystem_; }
+
     // Called when a scene starts
     void OnSceneStart(Scene* scene);
 
-    // Update all enabled systems in priority order
+    // Update all enabled systems in priority order.
+    // Systems whose declared accesses do not conflict run concurrently on the job system;
+    // conflicting systems keep their priority order.
+    // Must be called from the main thread: systems that declare MainThread() always run here,
+    // and OnMainThreadUpdate is called here for every enabled system after all waves finish.
     void Update(Scene* scene, float deltaTime);
 
     // Called when a scene ends
@@ -35,8 +44,18 @@ public:
 private:
     void SortSystems();
 
+    // Group enabled systems into waves; a system goes one wave after the last
+    // earlier system it conflicts with
+    void BuildSchedule();
+    void RunWave(uint32 begin, uint32 end, Scene* scene, float deltaTime);
+    static void RunSystem(ISystem* system, Scene* scene, float deltaTime);
+
 private:
     std::vector<std::unique_ptr<ISystem>> systems_;
+    std::vector<ISystem*> scheduledSystems_;  // wave order
+    std::vector<uint32> waveStarts_;          // index into scheduledSystems_, with end sentinel
+    std::vector<uint32> systemWaves_;         // scratch: wave of each enabled system
+    JobSystem* jobSystem_ = nullptr;
     bool needsSort_ = false;
 };
 
@@ -46,6 +65,8 @@ T* SystemManager::RegisterSystem(Args&&... args) {
 
     auto system = std::make_unique<T>(std::forward<Args>(args)...);
     T* ptr = system.get();
+    ptr->jobSystem_ = jobSystem_;
+    ptr->DeclareAccess(ptr->access_);
     systems_.push_back(std::move(system));
     needsSort_ = true;
     return ptr;
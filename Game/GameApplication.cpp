@@ -91,14 +91,18 @@ void GameApplication::OnRender() {
                 sceneView.layerMask = view.layerMask;
                 sceneView.viewName = "SceneView";
 
+                // カリングと描画順はカメラごとに決まるため、EditorCameraで集め直す
+                auto sceneItems = renderSystem_->CollectRenderables(scene, sceneView);
+                auto sceneSkinnedItems = renderSystem_->CollectSkinnedRenderables(scene, sceneView);
+
                 renderer_->DrawToTexture(
                     sceneViewTex->GetResource(),
                     sceneViewTex->GetRTVHandle(),
                     sceneViewTex->GetDSVHandle(),
                     sceneView,
-                    items,
+                    sceneItems,
                     lightManager_.get(),
-                    skinnedItems,
+                    sceneSkinnedItems,
                     true  // デバッグ描画有効
                 );
             }
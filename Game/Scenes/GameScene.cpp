@@ -35,7 +35,7 @@ void GameScene::OnLoad() {
     if (sceneFileExists) {
         // 保存されたシーンをロード
         Logger::Info("[シーン] 保存されたシーンをロード: {}", sceneFilePath);
-        if (!SceneSerializer::LoadScene(sceneFilePath, GetGameObjects())) {
+        if (!SceneSerializer::LoadScene(sceneFilePath, *this)) {
             Logger::Warning("[シーン] シーンのロードに失敗しました。デフォルトシーンを作成します。");
             // ロード失敗時はデフォルトシーンを作成
             SetupCamera();
@@ -52,12 +52,12 @@ void GameScene::OnLoad() {
             // 各モデルを個別にロード（複数モデルを1つのアップロードコンテキストで処理すると描画バグが発生）
             for (auto& obj : GetGameObjects()) {
                 if (obj->GetName() == "Player") {
-                    player_ = obj.get();
+                    player_ = obj->GetHandle();
                 }
                 // CameraComponentを持つオブジェクトを検出（名前に関係なく）
                 if (auto* cameraComp = obj->GetComponent<CameraComponent>()) {
                     if (cameraComp->IsMain() || !foundMainCamera) {
-                        mainCamera_ = obj.get();
+                        mainCamera_ = obj->GetHandle();
                         obj->SetDeletable(false);  // 削除不可フラグを復元
                         cameraComp->SetMain(true);
                         SetActiveCamera(cameraComp->GetCamera());
@@ -79,6 +79,7 @@ void GameScene::OnLoad() {
 
                         if (modelData) {
                             renderer->SetModel(modelData);
+                            GetSpatialIndex().MarkBoundsDirty(obj.get());
 
                             // Animatorを再初期化
                             auto* animator = obj->GetComponent<AnimatorComponent>();
@@ -93,7 +94,7 @@ void GameScene::OnLoad() {
                                 }
                             }
 
-                            animatedCharacter_ = obj.get();
+                            animatedCharacter_ = obj->GetHandle();
                             Logger::Info("[シーン] モデル再ロード完了: {}", modelPath);
                         } else {
                             Logger::Warning("[シーン] モデル再ロード失敗: {}", modelPath);
@@ -142,15 +143,16 @@ void GameScene::OnLoad() {
 
 void GameScene::SetupCamera() {
     // Main CameraをGameObjectとして作成
-    mainCamera_ = CreateGameObject("Main Camera");
-    mainCamera_->SetDeletable(false);  // 削除不可に設定
+    GameObject* mainCamera = CreateGameObject("Main Camera");
+    mainCamera_ = mainCamera->GetHandle();
+    mainCamera->SetDeletable(false);  // 削除不可に設定
 
     // 先にTransformを設定（CameraComponentを追加する前に）
-    mainCamera_->GetTransform().SetLocalPosition(Vector3(0.0f, 1.0f, -3.0f));
+    mainCamera->GetTransform().SetLocalPosition(Vector3(0.0f, 1.0f, -3.0f));
     // Z+方向を向くようにデフォルト回転（Identity）を使用
 
     // CameraComponentを追加（Awake()でTransformを同期）
-    auto* cameraComp = mainCamera_->AddComponent<CameraComponent>();
+    auto* cameraComp = mainCamera->AddComponent<CameraComponent>();
     cameraComp->SetMain(true);
     cameraComp->SetPerspective(60.0f * 0.0174533f, 16.0f / 9.0f, 0.1f, 1000.0f);
 
@@ -159,8 +161,9 @@ void GameScene::SetupCamera() {
 }
 
 void GameScene::SetupPlayer() {
-    player_ = CreateGameObject("Player");
-    player_->AddComponent<Player>();
+    GameObject* player = CreateGameObject("Player");
+    player_ = player->GetHandle();
+    player->AddComponent<Player>();
 }
 
 void GameScene::SetupLighting() {
@@ -201,14 +204,15 @@ void GameScene::SetupAnimatedCharacter() {
     if (lastDot != std::string::npos) {
         modelName = modelName.substr(0, lastDot);
     }
-    animatedCharacter_ = CreateGameObject(modelName);
+    GameObject* animatedCharacter = CreateGameObject(modelName);
+    animatedCharacter_ = animatedCharacter->GetHandle();
 
     // Add SkinnedMeshRenderer component
-    auto* renderer = animatedCharacter_->AddComponent<SkinnedMeshRenderer>();
+    auto* renderer = animatedCharacter->AddComponent<SkinnedMeshRenderer>();
     renderer->SetModel(modelData);
 
     // Add AnimatorComponent
-    auto* animator = animatedCharacter_->AddComponent<AnimatorComponent>();
+    auto* animator = animatedCharacter->AddComponent<AnimatorComponent>();
     
     // Initialize animator with skeleton and animations
     if (modelData->skeleton) {
@@ -254,11 +258,12 @@ void GameScene::OnUpdate(float deltaTime) {
     if (editorUI_.IsPlaying() && editorUI_.IsGameViewMouseLocked()) {
 #endif
         Camera* camera = GetActiveCamera();
-        if (camera && player_ && input_) {
+        GameObject* player = GetPlayer();
+        if (camera && player && input_) {
             auto* app = static_cast<GameApplication*>(GetApplication());
             auto* cameraSystem = app->GetCameraSystem();
             if (cameraSystem) {
-                auto* playerComp = player_->GetComponent<Player>();
+                auto* playerComp = player->GetComponent<Player>();
                 cameraSystem->Update(camera, playerComp, input_, deltaTime);
             }
         }
@@ -270,7 +275,7 @@ void GameScene::OnUpdate(float deltaTime) {
 void GameScene::OnImGui() {
 #ifdef _DEBUG
     EditorContext context;
-    context.player = player_;
+    context.player = GetPlayer();
     context.camera = GetActiveCamera();
     context.gameObjects = &GetGameObjects();
     context.fps = ImGui::GetIO().Framerate;
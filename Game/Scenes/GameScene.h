@@ -17,7 +17,8 @@ public:
     void OnRender(RenderView& view) override;
     void OnImGui() override;
 
-    GameObject* GetPlayer() const { return player_; }
+    // 破棄済みの場合はnullptr
+    GameObject* GetPlayer() const { return Resolve(player_); }
 
 #ifdef _DEBUG
     EditorUI* GetEditorUI() { return &editorUI_; }
@@ -29,9 +30,9 @@ private:
     void SetupPlayer();
     void SetupAnimatedCharacter();
 
-    GameObject* player_ = nullptr;
-    GameObject* animatedCharacter_ = nullptr;
-    GameObject* mainCamera_ = nullptr;
+    GameObjectHandle player_;
+    GameObjectHandle animatedCharacter_;
+    GameObjectHandle mainCamera_;
 
     // Model path for editor display
     std::string loadedModelPath_;
@@ -13,6 +13,7 @@ class CameraSystem : public ISystem {
 public:
     void OnUpdate(Scene* scene, float deltaTime) override;
     int GetPriority() const override { return 50; }
+    void DeclareAccess(SystemAccess& access) const override {}
     
     void Update(Camera* camera, Player* player, InputManager* input, float deltaTime);
 };
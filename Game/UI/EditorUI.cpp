@@ -14,6 +14,7 @@
 #include "../../Engine/Audio/AudioListener.h"
 #include "../../Engine/Audio/AudioClip.h"
 #include "../../Engine/Core/CameraComponent.h"
+#include "../../Engine/Core/Scene.h"
 #include <imgui.h>
 #include <imgui_internal.h>
 #include "../../Engine/UI/imgui_toggle.h"
@@ -65,6 +66,11 @@ namespace UnoEngine {
 	}
 
 	void EditorUI::Render(const EditorContext& context) {
+		// 前フレーム以降に破棄されたオブジェクトの選択を外す
+		if (selectedObject_ && (!scene_ || scene_->Resolve(selectedHandle_) != selectedObject_)) {
+			SetSelectedObject(nullptr);
+		}
+
 		// ImGuizmoフレーム開始
 		ImGuizmo::BeginFrame();
 
@@ -483,7 +489,7 @@ namespace UnoEngine {
 				if (gizmoSystem_.IsUsing() && !isGizmoActive_) {
 					isGizmoActive_ = true;
 					auto& transform = selectedObject_->GetTransform();
-					preGizmoSnapshot_.targetObject = selectedObject_;
+					preGizmoSnapshot_.target = selectedObject_->GetHandle();
 					preGizmoSnapshot_.position = transform.GetLocalPosition();
 					preGizmoSnapshot_.rotation = transform.GetLocalRotation();
 					preGizmoSnapshot_.scale = transform.GetLocalScale();
@@ -878,7 +884,7 @@ namespace UnoEngine {
 
 		// 選択解除ボタン
 		if (selectedObject_ && ImGui::SmallButton("Clear Selection")) {
-			selectedObject_ = nullptr;
+			SetSelectedObject(nullptr);
 		}
 		ImGui::SameLine();
 		if (context.gameObjects) {
@@ -957,7 +963,7 @@ namespace UnoEngine {
 
 					// シングルクリックで選択＋フォーカス
 					if (ImGui::IsItemClicked() && !ImGui::IsMouseDoubleClicked(0)) {
-						selectedObject_ = obj;
+						SetSelectedObject(obj);
 						FocusOnObject(obj);
 					}
 
@@ -984,7 +990,7 @@ namespace UnoEngine {
 							audioSource->SetClipPath(audioPath);
 							audioSource->LoadClip(audioPath);
 							consoleMessages_.push_back("[Audio] Set clip: " + std::filesystem::path(audioPath).filename().string());
-							selectedObject_ = obj;
+							SetSelectedObject(obj);
 						}
 					}
 					ImGui::EndDragDropTarget();
@@ -1007,20 +1013,16 @@ namespace UnoEngine {
 						ImGui::BeginDisabled();
 					}
 					if (ImGui::MenuItem("Delete", "DEL", false, canDelete)) {
-						if (gameObjects_ && canDelete) {
-							for (auto it = gameObjects_->begin(); it != gameObjects_->end(); ++it) {
-								if (it->get() == obj) {
-									consoleMessages_.push_back("[Editor] Deleted object: " + obj->GetName());
-									expandedObjects_.erase(obj);
-									gameObjects_->erase(it);
-									if (selectedObject_ == obj) {
-										selectedObject_ = nullptr;
-									}
-									if (renamingObject_ == obj) {
-										renamingObject_ = nullptr;
-									}
-									break;
-								}
+						if (scene_ && canDelete) {
+							// 破棄はシーンの更新時にまとめて行われる
+							consoleMessages_.push_back("[Editor] Deleted object: " + obj->GetName());
+							expandedObjects_.erase(obj);
+							scene_->DestroyGameObject(obj);
+							if (selectedObject_ == obj) {
+								SetSelectedObject(nullptr);
+							}
+							if (renamingObject_ == obj) {
+								renamingObject_ = nullptr;
 							}
 						}
 					}
@@ -1327,16 +1329,11 @@ namespace UnoEngine {
 		if (selectedObject_ && !renamingObject_ && ImGui::IsWindowFocused() && ImGui::IsKeyPressed(ImGuiKey_Delete)) {
 			if (!selectedObject_->IsDeletable()) {
 				consoleMessages_.push_back("[Editor] Cannot delete: " + selectedObject_->GetName() + " (protected)");
-			} else if (gameObjects_) {
-				for (auto it = gameObjects_->begin(); it != gameObjects_->end(); ++it) {
-					if (it->get() == selectedObject_) {
-						consoleMessages_.push_back("[Editor] Deleted object (DEL): " + selectedObject_->GetName());
-						expandedObjects_.erase(selectedObject_);
-						gameObjects_->erase(it);
-						selectedObject_ = nullptr;
-						break;
-					}
-				}
+			} else if (scene_) {
+				consoleMessages_.push_back("[Editor] Deleted object (DEL): " + selectedObject_->GetName());
+				expandedObjects_.erase(selectedObject_);
+				scene_->DestroyGameObject(selectedObject_);
+				SetSelectedObject(nullptr);
 			}
 		}
 
@@ -1618,14 +1615,13 @@ namespace UnoEngine {
 
 				// ダブルクリック: 新規GameObjectを作成してAudioSourceを追加
 				if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(0)) {
-					if (gameObjects_) {
+					if (scene_) {
 						std::string objectName = p.stem().string(); // 拡張子なしのファイル名
 						auto newObject = std::make_unique<GameObject>(objectName);
 						auto* audioSource = newObject->AddComponent<AudioSource>();
 						audioSource->SetClipPath(audioPath);
 						audioSource->LoadClip(audioPath);
-						selectedObject_ = newObject.get();
-						gameObjects_->push_back(std::move(newObject));
+						SetSelectedObject(scene_->AddGameObject(std::move(newObject)));
 						consoleMessages_.push_back("[Editor] Created AudioSource object: " + objectName);
 					}
 				}
@@ -1698,7 +1694,7 @@ namespace UnoEngine {
 				Stop();
 			} else {
 				// 編集モードでは選択をクリア
-				selectedObject_ = nullptr;
+				SetSelectedObject(nullptr);
 			}
 		}
 
@@ -1789,8 +1785,10 @@ namespace UnoEngine {
 		TransformSnapshot snapshot = undoStack_.top();
 		undoStack_.pop();
 
-		if (snapshot.targetObject) {
-			auto& transform = snapshot.targetObject->GetTransform();
+		// 記録後に破棄されたオブジェクトはハンドルが無効になる
+		GameObject* target = scene_ ? scene_->Resolve(snapshot.target) : nullptr;
+		if (target) {
+			auto& transform = target->GetTransform();
 			transform.SetLocalPosition(snapshot.position);
 			transform.SetLocalRotation(snapshot.rotation);
 			transform.SetLocalScale(snapshot.scale);
@@ -1821,16 +1819,18 @@ namespace UnoEngine {
 
 	// シーンロード
 	void EditorUI::LoadScene(const std::string& filepath) {
-		if (!gameObjects_) {
+		if (!scene_) {
 			consoleMessages_.push_back("[Editor] Error: No game objects container");
 			return;
 		}
 
-		if (SceneSerializer::LoadScene(filepath, *gameObjects_)) {
+		SetSelectedObject(nullptr);
+		if (SceneSerializer::LoadScene(filepath, *scene_)) {
 			consoleMessages_.push_back("[Editor] Scene loaded: " + filepath);
 			// ロード後、最初のオブジェクトを選択
-			if (!gameObjects_->empty()) {
-				selectedObject_ = (*gameObjects_)[0].get();
+			const auto& gameObjects = scene_->GetGameObjects();
+			if (!gameObjects.empty()) {
+				SetSelectedObject(gameObjects[0].get());
 			}
 		}
 		else {
@@ -1840,7 +1840,7 @@ namespace UnoEngine {
 
 	// モデルD&D処理（パスから）
 	void EditorUI::HandleModelDragDrop(const std::string& modelPath) {
-		if (!gameObjects_ || !resourceManager_) {
+		if (!scene_ || !resourceManager_) {
 			consoleMessages_.push_back("[Editor] Error: Cannot create object - missing dependencies");
 			return;
 		}
@@ -1919,7 +1919,7 @@ namespace UnoEngine {
 	// 遅延ロード処理
 	void EditorUI::ProcessPendingLoads() {
 		if (pendingModelLoads_.empty()) return;
-		if (!gameObjects_ || !resourceManager_) return;
+		if (!scene_ || !resourceManager_) return;
 
 		// 各モデルを個別に処理（複数モデルを1つのアップロードコンテキストで処理すると描画バグが発生するため）
 	for (const auto& modelPath : pendingModelLoads_) {
@@ -1964,11 +1964,8 @@ namespace UnoEngine {
 			renderer->SetModel(modelPath);  // まずパスを設定
 			renderer->SetModel(modelData);   // 次に実際のモデルデータを設定
 
-			// 選択状態にする
-			selectedObject_ = newObject.get();
-
-			// GameObjectsリストに追加
-			gameObjects_->push_back(std::move(newObject));
+			// シーンに追加して選択状態にする
+			SetSelectedObject(scene_->AddGameObject(std::move(newObject)));
 
 			// 重要: コンポーネントのStart()を呼んで初期化
 			// （再起動時はScene::ProcessPendingStarts()で呼ばれるが、D&D時は手動で呼ぶ必要がある）
@@ -2117,7 +2114,7 @@ namespace UnoEngine {
 
 	void EditorUI::PrepareSceneViewGizmos(DebugRenderer* debugRenderer) {
 		// DebugRendererがない場合は何もしない
-		if (!debugRenderer || !gameObjects_) {
+		if (!debugRenderer || !scene_) {
 			return;
 		}
 
@@ -2126,10 +2123,9 @@ namespace UnoEngine {
 			return;
 		}
 
-		// 全GameObjectをスキャンしてCameraComponentを持つものを探す
-		for (const auto& obj : *gameObjects_) {
-			auto* cameraComp = obj->GetComponent<CameraComponent>();
-			if (!cameraComp) continue;
+		// CameraComponentを持つGameObjectだけを列挙
+		for (auto [obj, camera] : scene_->Query<CameraComponent>()) {
+			auto* cameraComp = &camera;
 
 			// カメラの位置と向きを取得
 			Camera* cam = cameraComp->GetCamera();
@@ -2140,7 +2136,7 @@ namespace UnoEngine {
 			Vector3 camUp = cam->GetUp();
 
 			// カメラアイコンの色（選択中は黄色、通常は白）
-			Vector4 iconColor = (selectedObject_ == obj.get())
+			Vector4 iconColor = (selectedObject_ == &obj)
 				? Vector4(1.0f, 1.0f, 0.0f, 1.0f)  // 黄色（選択中）
 				: Vector4(1.0f, 1.0f, 1.0f, 1.0f); // 白（通常）
 
@@ -2149,7 +2145,7 @@ namespace UnoEngine {
 			debugRenderer->AddCameraIcon(camPos, camForward, camUp, iconScale, iconColor);
 
 			// 選択中のカメラはFrustumも描画
-			if (selectedObject_ == obj.get() || showCameraFrustum_) {
+			if (selectedObject_ == &obj || showCameraFrustum_) {
 				Vector3 nearCorners[4];
 				Vector3 farCorners[4];
 
@@ -2209,7 +2205,7 @@ namespace UnoEngine {
 
 	// スクリーン座標からレイを飛ばしてオブジェクトを選択
 	GameObject* EditorUI::PickObjectAtScreenPos(float screenX, float screenY) {
-		if (!gameObjects_ || !editorCamera_.GetCamera()) {
+		if (!scene_ || !editorCamera_.GetCamera()) {
 			return nullptr;
 		}
 
@@ -2256,81 +2252,9 @@ namespace UnoEngine {
 		Vector3 rayEnd(rayWorldFar.GetX(), rayWorldFar.GetY(), rayWorldFar.GetZ());
 		Vector3 rayDir = (rayEnd - rayOrigin).Normalize();
 
-		// 全オブジェクトとの交差判定
-		GameObject* closestObject = nullptr;
-		float closestDistance = std::numeric_limits<float>::max();
-
-		for (const auto& obj : *gameObjects_) {
-			if (!obj || !obj->IsActive()) continue;
-
-			// SkinnedMeshRendererを持つオブジェクトのバウンディングボックスを取得
-			auto* renderer = obj->GetComponent<SkinnedMeshRenderer>();
-			if (renderer && renderer->HasModel()) {
-				// ローカルバウンディングボックスを取得
-				BoundingBox localBounds = renderer->GetBounds();
-
-				// バウンディングボックスが無効な場合はデフォルトサイズを使用
-				if (!localBounds.IsValid()) {
-					localBounds = BoundingBox(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 2.0f, 1.0f));
-				}
-
-				// ワールド変換行列を取得
-				const Transform& transform = obj->GetTransform();
-				Matrix4x4 worldMatrix = transform.GetWorldMatrix();
-				Matrix4x4 invWorldMatrix = worldMatrix.Inverse();
-
-				// レイをローカル空間に変換
-				Vector4 localOrigin4 = invWorldMatrix.TransformVector4(Vector4(rayOrigin.GetX(), rayOrigin.GetY(), rayOrigin.GetZ(), 1.0f));
-				Vector4 localDir4 = invWorldMatrix.TransformVector4(Vector4(rayDir.GetX(), rayDir.GetY(), rayDir.GetZ(), 0.0f));
-
-				Vector3 localRayOrigin(localOrigin4.GetX(), localOrigin4.GetY(), localOrigin4.GetZ());
-				Vector3 localRayDir = Vector3(localDir4.GetX(), localDir4.GetY(), localDir4.GetZ()).Normalize();
-
-				// ローカル空間でレイとバウンディングボックスの交差判定
-				float tMin, tMax;
-				if (localBounds.IntersectsRay(localRayOrigin, localRayDir, tMin, tMax)) {
-					// ワールド空間での距離を計算
-					Vector3 hitPointLocal = localRayOrigin + localRayDir * tMin;
-					Vector4 hitPointWorld4 = worldMatrix.TransformVector4(Vector4(hitPointLocal.GetX(), hitPointLocal.GetY(), hitPointLocal.GetZ(), 1.0f));
-					Vector3 hitPointWorld(hitPointWorld4.GetX(), hitPointWorld4.GetY(), hitPointWorld4.GetZ());
-					float distance = (hitPointWorld - rayOrigin).Length();
-
-					if (distance < closestDistance) {
-						closestDistance = distance;
-						closestObject = obj.get();
-					}
-				}
-			}
-			else {
-				// メッシュがないオブジェクトはデフォルトバウンディングボックスで判定
-				BoundingBox defaultBounds(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 2.0f, 1.0f));
-
-				const Transform& transform = obj->GetTransform();
-				Matrix4x4 worldMatrix = transform.GetWorldMatrix();
-				Matrix4x4 invWorldMatrix = worldMatrix.Inverse();
-
-				Vector4 localOrigin4 = invWorldMatrix.TransformVector4(Vector4(rayOrigin.GetX(), rayOrigin.GetY(), rayOrigin.GetZ(), 1.0f));
-				Vector4 localDir4 = invWorldMatrix.TransformVector4(Vector4(rayDir.GetX(), rayDir.GetY(), rayDir.GetZ(), 0.0f));
-
-				Vector3 localRayOrigin(localOrigin4.GetX(), localOrigin4.GetY(), localOrigin4.GetZ());
-				Vector3 localRayDir = Vector3(localDir4.GetX(), localDir4.GetY(), localDir4.GetZ()).Normalize();
-
-				float tMin, tMax;
-				if (defaultBounds.IntersectsRay(localRayOrigin, localRayDir, tMin, tMax)) {
-					Vector3 hitPointLocal = localRayOrigin + localRayDir * tMin;
-					Vector4 hitPointWorld4 = worldMatrix.TransformVector4(Vector4(hitPointLocal.GetX(), hitPointLocal.GetY(), hitPointLocal.GetZ(), 1.0f));
-					Vector3 hitPointWorld(hitPointWorld4.GetX(), hitPointWorld4.GetY(), hitPointWorld4.GetZ());
-					float distance = (hitPointWorld - rayOrigin).Length();
-
-					if (distance < closestDistance) {
-						closestDistance = distance;
-						closestObject = obj.get();
-					}
-				}
-			}
-		}
-
-		return closestObject;
+		// 空間インデックスのBVHでレイが最初に当たるオブジェクトを探す
+		// （レンダラーの境界、無ければ既定の箱を、オブジェクトのローカル空間で判定する）
+		return scene_->GetSpatialIndex().RayCast(rayOrigin, rayDir);
 	}
 
 	// SceneViewでのクリック選択処理
@@ -2353,7 +2277,7 @@ namespace UnoEngine {
 
 				GameObject* picked = PickObjectAtScreenPos(mousePos.x, mousePos.y);
 				if (picked) {
-					selectedObject_ = picked;
+					SetSelectedObject(picked);
 					// オイラー角キャッシュをクリア（新しいオブジェクト選択時）
 					cachedEulerAngles_.clear();
 				}
@@ -27,7 +27,7 @@ class AudioSource;
 
 // Transform操作履歴
 struct TransformSnapshot {
-    GameObject* targetObject = nullptr;
+    GameObjectHandle target;  // 記録後に破棄された場合はScene::Resolveがnullptrを返す
     Vector3 position;
     Quaternion rotation;
     Vector3 scale;
@@ -116,7 +116,10 @@ public:
     GizmoSystem& GetGizmoSystem() { return gizmoSystem_; }
 
     // オブジェクト選択
-    void SetSelectedObject(GameObject* obj) { selectedObject_ = obj; }
+    void SetSelectedObject(GameObject* obj) {
+        selectedObject_ = obj;
+        selectedHandle_ = obj ? obj->GetHandle() : GameObjectHandle{};
+    }
     GameObject* GetSelectedObject() const { return selectedObject_; }
 
     // シーン保存/ロード
@@ -124,7 +127,7 @@ public:
     void LoadScene(const std::string& filepath);
 
     // GameObjectsリストへの参照を設定（保存/ロード用）
-    void SetGameObjects(std::vector<UniquePtr<GameObject>>* gameObjects) {
+    void SetGameObjects(const std::vector<UniquePtr<GameObject>>* gameObjects) {
         gameObjects_ = gameObjects;
         cachedEulerAngles_.clear();  // オイラー角キャッシュをクリア
     }
@@ -214,6 +217,7 @@ private:
 
     // 選択中のオブジェクト
     GameObject* selectedObject_ = nullptr;
+    GameObjectHandle selectedHandle_;  // selectedObject_の破棄検出用
 
     // Hierarchyリネーム用
     GameObject* renamingObject_ = nullptr;
@@ -265,7 +269,7 @@ private:
     void PerformUndo();
 
     // GameObjectsリスト（保存/ロード用）
-    std::vector<UniquePtr<GameObject>>* gameObjects_ = nullptr;
+    const std::vector<UniquePtr<GameObject>>* gameObjects_ = nullptr;
 
     // ResourceManager（モデル読み込み用）
     class ResourceManager* resourceManager_ = nullptr;
@@ -1,12 +1,19 @@
 // PBR Vertex Shader
 
-cbuffer Transform : register(b0) {
-    matrix world;
+// ビューごとに1回だけ設定する
+cbuffer View : register(b0) {
     matrix view;
     matrix projection;
-    matrix mvp;
+    matrix viewProjection;
+};
+
+// インスタンスごとのデータ（SV_InstanceIDで引く）
+struct InstanceData {
+    matrix world;
 };
 
+StructuredBuffer<InstanceData> gInstances : register(t1);
+
 struct VSInput {
     float3 position : POSITION;
     float3 normal : NORMAL;
@@ -20,15 +27,17 @@ struct VSOutput {
     float2 uv : TEXCOORD;
 };
 
-VSOutput main(VSInput input) {
+VSOutput main(VSInput input, uint instanceId : SV_InstanceID) {
     VSOutput output;
 
+    matrix world = gInstances[instanceId].world;
+
     // ワールド空間位置
     float4 worldPos = mul(float4(input.position, 1.0f), world);
     output.worldPos = worldPos.xyz;
 
     // クリップ空間位置
-    output.position = mul(float4(input.position, 1.0f), mvp);
+    output.position = mul(worldPos, viewProjection);
 
     // ワールド空間法線（正規化）
     output.normal = normalize(mul(input.normal, (float3x3)world));
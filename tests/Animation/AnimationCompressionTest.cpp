@@ -0,0 +1,169 @@
+#include "../TestFramework.h"
+#include "Engine/Animation/AnimationClip.h"
+#include "Engine/Animation/CompressedAnimation.h"
+#include "Engine/Animation/Skeleton.h"
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+// AnimationClip::Compressの回帰テスト
+// ベイク済みの（キーが密な）クリップを圧縮し、AnimationCompressionReportのサイズが元より小さいこと、
+// 位置誤差がスケルトンの大きさに対する許容誤差に収まることを確かめる
+// レポートの値だけでなく、同じ内容の圧縮していないクリップと実際にサンプリングして比べた誤差も確かめる
+
+using namespace UnoEngine;
+
+namespace {
+
+constexpr float TICKS_PER_SECOND = 1000.0f;
+constexpr float CLIP_DURATION_TICKS = 1000.0f;
+constexpr uint32 KEYS_PER_CHANNEL = 61;     // 60fpsでベイクしたクリップ
+
+// 背骨6本（0.2ずつ）と、4本目から分かれる左右の腕4本（0.15ずつ）
+constexpr uint32 SPINE_BONES = 6;
+constexpr uint32 ARM_BONES = 4;
+constexpr uint32 ARM_ROOT = 3;
+constexpr float SPINE_LENGTH = 0.2f;
+constexpr float ARM_LENGTH = 0.15f;
+// ルートから最も遠いボーン（腕の先端）までの距離 = 0.2 * 4 + 0.15 * 4
+constexpr float SKELETON_SIZE = SPINE_LENGTH * (ARM_ROOT + 1) + ARM_LENGTH * ARM_BONES;
+
+std::shared_ptr<Skeleton> CreateSkeleton() {
+    auto skeleton = std::make_shared<Skeleton>();
+    for (uint32 i = 0; i < SPINE_BONES; ++i) {
+        const int32 parent = i == 0 ? INVALID_BONE_INDEX : static_cast<int32>(i - 1);
+        skeleton->AddBone("Spine" + std::to_string(i), parent, Matrix4x4::Identity(),
+                          Matrix4x4::Translation(0.0f, i == 0 ? 0.0f : SPINE_LENGTH, 0.0f));
+    }
+    for (uint32 side = 0; side < 2; ++side) {
+        const float direction = side == 0 ? -1.0f : 1.0f;
+        for (uint32 i = 0; i < ARM_BONES; ++i) {
+            const int32 parent = i == 0 ? static_cast<int32>(ARM_ROOT) : static_cast<int32>(skeleton->GetBoneCount()) - 1;
+            skeleton->AddBone((side == 0 ? "LeftArm" : "RightArm") + std::to_string(i), parent, Matrix4x4::Identity(),
+                              Matrix4x4::Translation(direction * ARM_LENGTH, i == 0 ? SPINE_LENGTH : 0.0f, 0.0f));
+        }
+    }
+    return skeleton;
+}
+
+// 全ボーンが回転し、ルートだけが移動する。スケールは全キー同じ値（定数トラックになる）
+std::shared_ptr<AnimationClip> CreateClip(const Skeleton& skeleton) {
+    auto clip = std::make_shared<AnimationClip>();
+    clip->SetName("Baked");
+    clip->SetDuration(CLIP_DURATION_TICKS);
+    clip->SetTicksPerSecond(TICKS_PER_SECOND);
+
+    constexpr float TWO_PI = 6.28318530718f;
+    for (uint32 bone = 0; bone < skeleton.GetBoneCount(); ++bone) {
+        const Bone* info = skeleton.GetBone(static_cast<int32>(bone));
+        BoneAnimation channel;
+        channel.boneName = info->name;
+        const Vector3 axis = Vector3(std::sin(bone * 1.3f), std::cos(bone * 0.7f), 0.5f).Normalize();
+        const float amplitude = 0.2f + 0.1f * static_cast<float>(bone % 4);
+        const Vector3 bindPosition = info->localBindPose.TransformPoint(Vector3(0.0f, 0.0f, 0.0f));
+
+        for (uint32 k = 0; k < KEYS_PER_CHANNEL; ++k) {
+            const float phase = static_cast<float>(k) / (KEYS_PER_CHANNEL - 1);
+            const float time = phase * CLIP_DURATION_TICKS;
+            const float angle = amplitude * std::sin(TWO_PI * phase + bone * 0.25f);
+            channel.rotationKeys.push_back({ time, Quaternion::RotationAxis(axis, angle) });
+
+            const Vector3 sway = bone == 0 ? Vector3(0.05f * std::sin(TWO_PI * phase), 0.02f * std::sin(2.0f * TWO_PI * phase), 0.0f)
+                                           : Vector3(0.0f, 0.0f, 0.0f);
+            channel.positionKeys.push_back({ time, bindPosition + sway });
+            channel.scaleKeys.push_back({ time, Vector3(1.0f, 1.0f, 1.0f) });
+        }
+        clip->AddBoneAnimation(channel);
+    }
+    return clip;
+}
+
+// 2つのクリップをフレームの間も含めてサンプリングし、スケルトン空間でのボーン位置のずれの最大値を返す
+float MeasureMaxPositionError(const AnimationClip& expected, const AnimationClip& actual, const Skeleton& skeleton) {
+    constexpr uint32 STEPS = 997;   // キーの時刻に揃わないよう素数で分ける
+    std::vector<Matrix4x4> expectedLocal, actualLocal;
+    std::vector<Matrix4x4> expectedGlobal(skeleton.GetBoneCount());
+    std::vector<Matrix4x4> actualGlobal(skeleton.GetBoneCount());
+    float maxError = 0.0f;
+    for (uint32 step = 0; step <= STEPS; ++step) {
+        const float time = CLIP_DURATION_TICKS * static_cast<float>(step) / STEPS;
+        expected.Sample(time, skeleton, expectedLocal);
+        actual.Sample(time, skeleton, actualLocal);
+
+        const Vector3 origin(0.0f, 0.0f, 0.0f);
+        for (uint32 i = 0; i < skeleton.GetBoneCount(); ++i) {
+            // : Global = Local * Parent（親は子より前に並んでいる）
+            const int32 parent = skeleton.GetBone(static_cast<int32>(i))->parentIndex;
+            expectedGlobal[i] = parent == INVALID_BONE_INDEX ? expectedLocal[i] : expectedLocal[i] * expectedGlobal[parent];
+            actualGlobal[i] = parent == INVALID_BONE_INDEX ? actualLocal[i] : actualLocal[i] * actualGlobal[parent];
+            const float error = (expectedGlobal[i].TransformPoint(origin) - actualGlobal[i].TransformPoint(origin)).Length();
+            maxError = (std::max)(maxError, error);
+        }
+    }
+    return maxError;
+}
+
+} // namespace
+
+UNO_TEST(ReportShowsSmallerSizeWithinTolerance) {
+    const auto skeleton = CreateSkeleton();
+    const auto clip = CreateClip(*skeleton);
+    const auto original = CreateClip(*skeleton);
+
+    const AnimationCompressionSettings settings;
+    AnimationCompressionReport report;
+    clip->Compress(*skeleton, settings, &report);
+
+    UNO_CHECK(clip->IsCompressed());
+    UNO_CHECK(report.rawBytes > report.compressedBytes);
+    UNO_CHECK_EQ(report.trackCount, skeleton->GetBoneCount() * 3);
+    UNO_CHECK_EQ(report.rawKeyCount, skeleton->GetBoneCount() * 3 * KEYS_PER_CHANNEL);
+    UNO_CHECK(report.compressedKeyCount < report.rawKeyCount);
+    // スケールは全ボーン、位置はルート以外が定数トラックになる
+    UNO_CHECK(report.constantTrackCount >= skeleton->GetBoneCount() * 2 - 1);
+
+    const float tolerance = settings.positionTolerance * SKELETON_SIZE;
+    UNO_CHECK(report.maxPositionError <= tolerance);
+    UNO_CHECK(MeasureMaxPositionError(*original, *clip, *skeleton) <= tolerance);
+}
+
+UNO_TEST(ErrorFollowsTolerance) {
+    const auto skeleton = CreateSkeleton();
+    const auto original = CreateClip(*skeleton);
+
+    // 許容誤差を変えても、誤差はその範囲に収まり、緩くするほどサイズは小さくなる
+    size_t previousBytes = 0;
+    for (const float positionTolerance : { 0.0001f, 0.0005f, 0.002f, 0.01f }) {
+        AnimationCompressionSettings settings;
+        settings.positionTolerance = positionTolerance;
+
+        const auto clip = CreateClip(*skeleton);
+        AnimationCompressionReport report;
+        clip->Compress(*skeleton, settings, &report);
+
+        const float tolerance = positionTolerance * SKELETON_SIZE;
+        UNO_CHECK(report.rawBytes > report.compressedBytes);
+        UNO_CHECK(report.maxPositionError <= tolerance);
+        UNO_CHECK(MeasureMaxPositionError(*original, *clip, *skeleton) <= tolerance);
+        if (previousBytes != 0) {
+            UNO_CHECK(report.compressedBytes <= previousBytes);
+        }
+        previousBytes = report.compressedBytes;
+    }
+}
+
+UNO_TEST(SecondCompressIsIgnored) {
+    const auto skeleton = CreateSkeleton();
+    const auto clip = CreateClip(*skeleton);
+
+    AnimationCompressionReport first;
+    clip->Compress(*skeleton, AnimationCompressionSettings(), &first);
+
+    // 圧縮済みのクリップは元のキーを持たないので、2回目は何もせずレポートも書き換えない
+    AnimationCompressionReport second;
+    second.rawBytes = 123;
+    clip->Compress(*skeleton, AnimationCompressionSettings(), &second);
+    UNO_CHECK(clip->IsCompressed());
+    UNO_CHECK_EQ(second.rawBytes, static_cast<size_t>(123));
+}
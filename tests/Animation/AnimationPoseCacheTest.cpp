@@ -0,0 +1,193 @@
+#include "../TestFramework.h"
+#include "Engine/Animation/AnimationSystem.h"
+#include "Engine/Animation/AnimatorComponent.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/Scene.h"
+#include "Engine/Systems/SystemManager.h"
+#include <cmath>
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+
+// AnimationPoseCacheの回帰テスト
+// 同じスケルトン・同じクリップ・同じ時刻で再生する多数のAnimatorを、SystemManager経由でAnimationSystemのワーカースレッドの
+// 並列更新に通し、ポーズが1フレームに1回だけ計算されて全員に同じボーン行列が渡ること、
+// 再利用するパレットが別のAnimatorから参照されている間は書き換えられないことを確かめる
+
+using namespace UnoEngine;
+
+namespace {
+
+constexpr float TICKS_PER_SECOND = 30.0f;
+constexpr float CLIP_DURATION_TICKS = 30.0f;
+constexpr uint32 BONE_COUNT = 8;
+constexpr uint32 ANIMATOR_COUNT = 64;      // AnimationSystemがジョブに分ける数（PARALLEL_UPDATE_THRESHOLD）より十分多く
+constexpr uint32 WORKER_COUNT = 3;
+constexpr float FRAME_DELTA = 1.0f / 60.0f;
+
+class TestScene : public Scene {
+public:
+    void OnRender(RenderView&) override {}
+};
+
+std::shared_ptr<Skeleton> CreateSkeleton() {
+    auto skeleton = std::make_shared<Skeleton>();
+    skeleton->AddBone("Root", -1, Matrix4x4::Identity(), Matrix4x4::Translation(0.0f, 1.0f, 0.0f));
+    for (uint32 i = 1; i < BONE_COUNT; ++i) {
+        skeleton->AddBone("Bone" + std::to_string(i), static_cast<int32>(i - 1), Matrix4x4::Identity(),
+                          Matrix4x4::Translation(0.0f, 0.5f, 0.0f));
+    }
+    return skeleton;
+}
+
+// 各ボーンが揺れる1秒のクリップ（フレームごとにポーズが変わる）
+std::shared_ptr<AnimationClip> CreateClip(const Skeleton& skeleton) {
+    constexpr uint32 KEY_COUNT = 31;
+    constexpr float TWO_PI = 6.28318530718f;
+
+    auto clip = std::make_shared<AnimationClip>();
+    clip->SetName("Walk");
+    clip->SetDuration(CLIP_DURATION_TICKS);
+    clip->SetTicksPerSecond(TICKS_PER_SECOND);
+
+    for (uint32 bone = 0; bone < BONE_COUNT; ++bone) {
+        BoneAnimation channel;
+        channel.boneName = skeleton.GetBone(static_cast<int32>(bone))->name;
+        for (uint32 k = 0; k < KEY_COUNT; ++k) {
+            const float phase = static_cast<float>(k) / (KEY_COUNT - 1);
+            const float time = phase * CLIP_DURATION_TICKS;
+            channel.positionKeys.push_back({ time, skeleton.GetBone(static_cast<int32>(bone))->localBindPose.TransformPoint(Vector3(0.0f, 0.0f, 0.0f)) });
+            channel.rotationKeys.push_back(
+                { time, Quaternion::RotationAxis(Vector3(1.0f, 0.0f, 0.0f), 0.6f * std::sin(TWO_PI * phase + bone)) });
+        }
+        channel.scaleKeys.push_back({ 0.0f, Vector3(1.0f, 1.0f, 1.0f) });
+        clip->AddBoneAnimation(channel);
+    }
+    return clip;
+}
+
+bool SameMatrices(const std::vector<Matrix4x4>& a, const std::vector<Matrix4x4>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(Matrix4x4)) == 0;
+}
+
+class PoseCacheFixture {
+public:
+    PoseCacheFixture() : skeleton_(CreateSkeleton()), clip_(CreateClip(*skeleton_)) {
+        jobSystem_.Initialize(WORKER_COUNT);
+        systems_.SetJobSystem(&jobSystem_);
+        animationSystem_ = systems_.RegisterSystem<AnimationSystem>();
+    }
+
+    // startTime秒の位置から再生するAnimatorをcount個作る
+    std::vector<AnimatorComponent*> Spawn(uint32 count, float startTime) {
+        std::vector<AnimatorComponent*> animators;
+        for (uint32 i = 0; i < count; ++i) {
+            GameObject* go = scene_.CreateGameObject("Character");
+            AnimatorComponent* animator = go->AddComponent<AnimatorComponent>();
+            animator->Initialize(skeleton_, { clip_ });
+            animator->Play("Walk");
+            if (startTime > 0.0f) {
+                animator->UpdateAnimation(startTime);
+            }
+            animators.push_back(animator);
+        }
+        return animators;
+    }
+
+    void Update() { systems_.Update(&scene_, FRAME_DELTA); }
+
+    JobSystem& GetJobSystem() { return jobSystem_; }
+    const AnimationPoseCache& GetPoseCache() const { return animationSystem_->GetPoseCache(); }
+
+private:
+    std::shared_ptr<Skeleton> skeleton_;
+    std::shared_ptr<AnimationClip> clip_;
+    TestScene scene_;
+    JobSystem jobSystem_;
+    SystemManager systems_;
+    AnimationSystem* animationSystem_ = nullptr;
+};
+
+// 全員が先頭のAnimatorと同じボーン行列を共有しているか
+bool AllShareFirstPose(const std::vector<AnimatorComponent*>& animators) {
+    for (const AnimatorComponent* animator : animators) {
+        if (!animator->GetAnimator()->IsUsingSharedPose() ||
+            !SameMatrices(animator->GetBoneMatrices(), animators.front()->GetBoneMatrices())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+UNO_TEST(SameClipAndTimeComputesOnePose) {
+    PoseCacheFixture fixture;
+    const std::vector<AnimatorComponent*> animators = fixture.Spawn(ANIMATOR_COUNT, 0.0f);
+    UNO_CHECK(fixture.GetJobSystem().GetWorkerCount() > 0);
+
+    for (int frame = 0; frame < 30; ++frame) {
+        fixture.Update();
+        UNO_CHECK(AllShareFirstPose(animators));
+        UNO_CHECK_EQ(animators.front()->GetBoneMatrices().size(), static_cast<size_t>(BONE_COUNT));
+
+        // 統計はBeginFrameで更新されるため、2フレーム目からは直前のフレームの値になる
+        if (frame > 0) {
+            UNO_CHECK_EQ(fixture.GetPoseCache().GetLastFramePoseCount(), 1u);
+            UNO_CHECK_EQ(fixture.GetPoseCache().GetLastFrameRequestCount(), ANIMATOR_COUNT);
+        }
+    }
+}
+
+UNO_TEST(DifferentTimesComputeOnePosePerTime) {
+    PoseCacheFixture fixture;
+    const std::vector<AnimatorComponent*> groupA = fixture.Spawn(ANIMATOR_COUNT / 2, 0.0f);
+    const std::vector<AnimatorComponent*> groupB = fixture.Spawn(ANIMATOR_COUNT / 2, 0.25f);
+
+    for (int frame = 0; frame < 10; ++frame) {
+        fixture.Update();
+        UNO_CHECK(AllShareFirstPose(groupA));
+        UNO_CHECK(AllShareFirstPose(groupB));
+        UNO_CHECK(!SameMatrices(groupA.front()->GetBoneMatrices(), groupB.front()->GetBoneMatrices()));
+        if (frame > 0) {
+            UNO_CHECK_EQ(fixture.GetPoseCache().GetLastFramePoseCount(), 2u);
+        }
+    }
+}
+
+UNO_TEST(HeldPaletteIsNotRecycled) {
+    PoseCacheFixture fixture;
+    const std::vector<AnimatorComponent*> animators = fixture.Spawn(ANIMATOR_COUNT, 0.0f);
+    fixture.Update();
+
+    // 1体だけ更新を止めると、そのAnimatorは最後に受け取ったパレットを持ち続ける
+    AnimatorComponent* held = animators.back();
+    held->SetEnabled(false);
+    const std::vector<Matrix4x4> heldPose = held->GetBoneMatrices();
+    const Matrix4x4* heldPalette = held->GetBoneMatrices().data();
+
+    std::set<const Matrix4x4*> activePalettes;
+    for (int frame = 0; frame < 30; ++frame) {
+        fixture.Update();
+        const std::vector<Matrix4x4>& active = animators.front()->GetBoneMatrices();
+        activePalettes.insert(active.data());
+
+        // 他のAnimatorのポーズは進むが、止めたAnimatorのパレットは使い回されず内容も変わらない
+        UNO_CHECK(active.data() != heldPalette);
+        UNO_CHECK(!SameMatrices(active, heldPose));
+        UNO_CHECK(held->GetBoneMatrices().data() == heldPalette);
+        UNO_CHECK(SameMatrices(held->GetBoneMatrices(), heldPose));
+    }
+
+    // 誰も参照しなくなったパレットは再利用されるので、フレームごとに新しく確保し続けることはない
+    UNO_CHECK(activePalettes.size() <= 3);
+
+    // 再開すると止めた時刻から進み、他のAnimatorとは別の時刻のポーズをキャッシュから受け取る
+    held->SetEnabled(true);
+    fixture.Update();
+    UNO_CHECK(held->GetAnimator()->IsUsingSharedPose());
+    UNO_CHECK(!SameMatrices(held->GetBoneMatrices(), heldPose));
+    fixture.Update();
+    UNO_CHECK_EQ(fixture.GetPoseCache().GetLastFramePoseCount(), 2u);
+}
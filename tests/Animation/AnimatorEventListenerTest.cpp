@@ -0,0 +1,35 @@
+#include "../TestFramework.h"
+#include "Engine/Animation/Animator.h"
+#include <memory>
+
+// Animatorのイベントリスナーの登録・削除
+// LuaScriptComponentはHasEventListenerでAnimatorの付け替えを検出するため、IDがAnimator間で重複しないことを確かめる
+
+using namespace UnoEngine;
+
+UNO_TEST(ListenerIdsAreUniqueAcrossAnimators) {
+    auto first = std::make_unique<Animator>();
+    const uint32 firstId = first->AddEventListener([](const FiredAnimationEvent&) {});
+
+    // 作り直したAnimatorのリスナーは、前のAnimatorのIDと重ならない
+    first.reset();
+    Animator second;
+    const uint32 secondId = second.AddEventListener([](const FiredAnimationEvent&) {});
+    UNO_CHECK(firstId != secondId);
+    UNO_CHECK(!second.HasEventListener(firstId));
+    UNO_CHECK(second.HasEventListener(secondId));
+}
+
+UNO_TEST(RemoveWithForeignIdIsIgnored) {
+    Animator a;
+    Animator b;
+    const uint32 idA = a.AddEventListener([](const FiredAnimationEvent&) {});
+    const uint32 idB = b.AddEventListener([](const FiredAnimationEvent&) {});
+
+    b.RemoveEventListener(idA);
+    UNO_CHECK(b.HasEventListener(idB));
+
+    b.RemoveEventListener(idB);
+    UNO_CHECK(!b.HasEventListener(idB));
+    UNO_CHECK(a.HasEventListener(idA));
+}
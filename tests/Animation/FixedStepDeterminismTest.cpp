@@ -0,0 +1,292 @@
+#include "../TestFramework.h"
+#include "Engine/Animation/AnimationClock.h"
+#include "Engine/Animation/AnimatorComponent.h"
+#include "Engine/Animation/CompressedAnimation.h"
+#include <cmath>
+#include <iterator>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// 固定ステップ再生の決定性の回帰テスト
+// 記録した可変のフレーム時間をAnimationSystemと同じ手順（AnimationClock → UpdateAnimation → ルートモーション → イベント）で流し、
+// ポーズ・イベント・ルートモーションが実行ごと、およびフレームの区切り方を変えても同じになることを確かめる
+
+using namespace UnoEngine;
+
+namespace {
+
+// 実機で記録したフレーム時間（60Hz前後の揺れ、120Hzのフレーム、30Hzへの落ち込みを含む）
+// どのフレームもAnimationClockの1フレームの上限（4ステップ）に収まる
+constexpr float RECORDED_DELTAS[] = {
+    0.016667f, 0.016912f, 0.016421f, 0.017305f, 0.015988f, 0.016667f, 0.033402f, 0.016103f,
+    0.008333f, 0.008341f, 0.008329f, 0.016667f, 0.019874f, 0.013460f, 0.016667f, 0.050012f,
+    0.016667f, 0.016230f, 0.017104f, 0.016667f, 0.024991f, 0.008512f, 0.016667f, 0.016667f,
+    0.031250f, 0.002084f, 0.016667f, 0.018003f, 0.015331f, 0.016667f, 0.041667f, 0.016667f,
+};
+// クリップ（1秒）を何周かさせ、ループの境界のイベントも通す
+constexpr uint32 RECORDED_PASSES = 4;
+
+constexpr float TIME_STEP = 1.0f / 60.0f;
+constexpr float TICKS_PER_SECOND = 30.0f;
+constexpr float CLIP_DURATION_TICKS = 30.0f;
+constexpr uint32 BONE_COUNT = 4;
+
+struct EventRecord {
+    std::string name;
+    std::string state;
+    float weight;
+
+    bool operator==(const EventRecord& other) const {
+        return name == other.name && state == other.state &&
+               std::memcmp(&weight, &other.weight, sizeof(float)) == 0;
+    }
+};
+
+struct FrameRecord {
+    std::vector<BoneMatrixPair> palette;
+    std::vector<EventRecord> events;
+    Vector3 rootMotion;
+};
+
+std::shared_ptr<Skeleton> CreateSkeleton() {
+    auto skeleton = std::make_shared<Skeleton>();
+    skeleton->AddBone("Root", -1, Matrix4x4::Identity(), Matrix4x4::Translation(0.0f, 1.0f, 0.0f));
+    for (uint32 i = 1; i < BONE_COUNT; ++i) {
+        skeleton->AddBone("Bone" + std::to_string(i), static_cast<int32>(i - 1), Matrix4x4::Identity(),
+                          Matrix4x4::Translation(0.0f, 0.5f, 0.0f));
+    }
+    return skeleton;
+}
+
+// ルートが1周期でforwardだけ進み、各ボーンが揺れるクリップ。周期の途中にイベントを置く
+std::shared_ptr<AnimationClip> CreateClip(const Skeleton& skeleton, const std::string& name, float forward,
+                                          float swing) {
+    constexpr uint32 KEY_COUNT = 31;
+    constexpr float TWO_PI = 6.28318530718f;
+
+    auto clip = std::make_shared<AnimationClip>();
+    clip->SetName(name);
+    clip->SetDuration(CLIP_DURATION_TICKS);
+    clip->SetTicksPerSecond(TICKS_PER_SECOND);
+
+    for (uint32 bone = 0; bone < BONE_COUNT; ++bone) {
+        BoneAnimation channel;
+        channel.boneName = skeleton.GetBone(static_cast<int32>(bone))->name;
+        for (uint32 k = 0; k < KEY_COUNT; ++k) {
+            const float phase = static_cast<float>(k) / (KEY_COUNT - 1);
+            const float time = phase * CLIP_DURATION_TICKS;
+            const Vector3 position = bone == 0 ? Vector3(0.0f, 1.0f + 0.05f * std::sin(2.0f * TWO_PI * phase), forward * phase)
+                                               : Vector3(0.0f, 0.5f, 0.0f);
+            channel.positionKeys.push_back({ time, position });
+            channel.rotationKeys.push_back(
+                { time, Quaternion::RotationAxis(Vector3(1.0f, 0.0f, 0.0f), swing * std::sin(TWO_PI * phase + bone)) });
+        }
+        channel.scaleKeys.push_back({ 0.0f, Vector3(1.0f, 1.0f, 1.0f) });
+        clip->AddBoneAnimation(channel);
+    }
+
+    AnimationEvent footDown;
+    footDown.name = "FootDownLeft";
+    footDown.time = 0.0f;
+    clip->AddEvent(footDown);
+    footDown.name = "FootDownRight";
+    footDown.time = CLIP_DURATION_TICKS * 0.5f;
+    clip->AddEvent(footDown);
+    AnimationEvent sound;
+    sound.name = "Breath";
+    sound.time = CLIP_DURATION_TICKS * 0.8f;
+    clip->AddEvent(sound);
+
+    clip->Compress(skeleton, AnimationCompressionSettings());
+    return clip;
+}
+
+// deltasの各フレームを、AnimationSystem::OnUpdateと同じ順序で処理した結果を記録する
+std::vector<FrameRecord> Run(const std::vector<float>& deltas) {
+    const auto skeleton = CreateSkeleton();
+    const auto walk = CreateClip(*skeleton, "Walk", 1.2f, 0.4f);
+    const auto run = CreateClip(*skeleton, "Run", 3.1f, 0.9f);
+
+    AnimatorComponent component;
+    component.Initialize(skeleton, { walk, run });
+    Animator* animator = component.GetAnimator();
+    animator->SetRootMotionEnabled(true);
+    animator->SetRootMotionUpAxis(Vector3(0.0f, 1.0f, 0.0f));
+
+    std::vector<EventRecord> frameEvents;
+    animator->AddEventListener([&frameEvents](const FiredAnimationEvent& fired) {
+        frameEvents.push_back({ fired.event->name, fired.state->GetName(), fired.weight });
+    });
+
+    // 遷移中のルートモーション・イベントの重みも通るよう、最初の0.5秒でWalkからRunへ切り替える
+    component.Play("Walk");
+    animator->CrossFade("Run", 0.5f);
+
+    AnimationClock clock;
+    clock.SetTimeStep(TIME_STEP);
+
+    std::vector<FrameRecord> records;
+    records.reserve(deltas.size());
+    for (float delta : deltas) {
+        const AnimationClockFrame frame = clock.Advance(delta);
+        component.UpdateAnimation(frame.stepDelta, frame.stepCount, frame.interpolation);
+
+        FrameRecord record;
+        record.rootMotion = animator->ConsumeRootMotion();
+        frameEvents.clear();
+        animator->DispatchEvents();
+        record.events = frameEvents;
+        record.palette = component.GetBoneMatrixPairs();
+        records.push_back(std::move(record));
+    }
+    return records;
+}
+
+std::vector<float> RecordedDeltas() {
+    std::vector<float> deltas;
+    for (uint32 pass = 0; pass < RECORDED_PASSES; ++pass) {
+        deltas.insert(deltas.end(), std::begin(RECORDED_DELTAS), std::end(RECORDED_DELTAS));
+    }
+    return deltas;
+}
+
+// 各フレームをpartsの比率で分割する（比率は2の累乗の分数にして、分割後の和が元の値と正確に一致するようにする）
+std::vector<float> SplitDeltas(const std::vector<float>& deltas, const std::vector<float>& parts) {
+    std::vector<float> split;
+    for (float delta : deltas) {
+        for (float part : parts) {
+            split.push_back(delta * part);
+        }
+    }
+    return split;
+}
+
+bool SamePalette(const FrameRecord& a, const FrameRecord& b) {
+    return a.palette.size() == b.palette.size() &&
+           std::memcmp(a.palette.data(), b.palette.data(), a.palette.size() * sizeof(BoneMatrixPair)) == 0;
+}
+
+bool SameVector(const Vector3& a, const Vector3& b) {
+    return std::memcmp(&a, &b, sizeof(Vector3)) == 0;
+}
+
+uint32 CountEvents(const std::vector<FrameRecord>& records) {
+    uint32 count = 0;
+    for (const FrameRecord& record : records) count += static_cast<uint32>(record.events.size());
+    return count;
+}
+
+} // namespace
+
+UNO_TEST(ClockSplitsFramesIntoFixedSteps) {
+    AnimationClock clock;
+    clock.SetTimeStep(0.25f);
+
+    AnimationClockFrame frame = clock.Advance(0.125f);
+    UNO_CHECK_EQ(frame.stepCount, 0u);
+    UNO_CHECK_EQ(frame.stepDelta, 0.25f);
+    UNO_CHECK_EQ(frame.interpolation, 0.5f);
+
+    frame = clock.Advance(0.5f);
+    UNO_CHECK_EQ(frame.stepCount, 2u);
+    UNO_CHECK_EQ(frame.interpolation, 0.5f);
+
+    frame = clock.Advance(0.125f);
+    UNO_CHECK_EQ(frame.stepCount, 1u);
+    UNO_CHECK_EQ(frame.interpolation, 0.0f);
+}
+
+UNO_TEST(ClockDropsTimeBeyondMaxSteps) {
+    AnimationClock clock;
+    clock.SetTimeStep(0.25f);
+    clock.SetMaxStepsPerFrame(4);
+
+    AnimationClockFrame frame = clock.Advance(10.125f);
+    UNO_CHECK_EQ(frame.stepCount, 4u);
+    UNO_CHECK_EQ(frame.interpolation, 0.5f);
+
+    // 捨てた時間は次のフレームに持ち越さない
+    frame = clock.Advance(0.125f);
+    UNO_CHECK_EQ(frame.stepCount, 1u);
+    UNO_CHECK_EQ(frame.interpolation, 0.0f);
+}
+
+UNO_TEST(ClockWithoutTimeStepPassesFrameTimeThrough) {
+    AnimationClock clock;
+    clock.SetTimeStep(0.0f);
+    const AnimationClockFrame frame = clock.Advance(0.0375f);
+    UNO_CHECK_EQ(frame.stepCount, 1u);
+    UNO_CHECK_EQ(frame.stepDelta, 0.0375f);
+    UNO_CHECK_EQ(frame.interpolation, 1.0f);
+}
+
+UNO_TEST(RepeatedRunsAreBitIdentical) {
+    const std::vector<float> deltas = RecordedDeltas();
+    const std::vector<FrameRecord> first = Run(deltas);
+    const std::vector<FrameRecord> second = Run(deltas);
+
+    UNO_CHECK_EQ(first.size(), second.size());
+    // イベントが実際に発生していること（ループごとに3つ、約2秒分）
+    UNO_CHECK(CountEvents(first) >= 6u);
+
+    uint32 paletteMismatches = 0;
+    uint32 eventMismatches = 0;
+    uint32 rootMotionMismatches = 0;
+    for (size_t i = 0; i < first.size(); ++i) {
+        if (!SamePalette(first[i], second[i])) ++paletteMismatches;
+        if (!(first[i].events == second[i].events)) ++eventMismatches;
+        if (!SameVector(first[i].rootMotion, second[i].rootMotion)) ++rootMotionMismatches;
+    }
+    UNO_CHECK_EQ(paletteMismatches, 0u);
+    UNO_CHECK_EQ(eventMismatches, 0u);
+    UNO_CHECK_EQ(rootMotionMismatches, 0u);
+}
+
+UNO_TEST(FrameSplitsProduceTheSameStepResults) {
+    const std::vector<float> deltas = RecordedDeltas();
+    const std::vector<FrameRecord> reference = Run(deltas);
+
+    const std::vector<std::vector<float>> splits = {
+        { 0.5f, 0.5f },
+        { 0.25f, 0.25f, 0.5f },
+        { 0.125f, 0.125f, 0.25f, 0.5f },
+    };
+    for (const std::vector<float>& parts : splits) {
+        const std::vector<FrameRecord> split = Run(SplitDeltas(deltas, parts));
+        UNO_CHECK_EQ(split.size(), reference.size() * parts.size());
+
+        uint32 paletteMismatches = 0;
+        uint32 eventMismatches = 0;
+        uint32 rootMotionMismatches = 0;
+        Vector3 referenceTotal(0.0f, 0.0f, 0.0f);
+        Vector3 splitTotal(0.0f, 0.0f, 0.0f);
+        for (size_t i = 0; i < reference.size(); ++i) {
+            // 分割したフレームの最後は元のフレームと同じ時刻・同じ補間率になるので、ポーズはビット単位で一致する
+            const FrameRecord& last = split[(i + 1) * parts.size() - 1];
+            if (!SamePalette(reference[i], last)) ++paletteMismatches;
+
+            // 分割したフレームで通知されたイベントを順につなげると元のフレームのイベントと一致する
+            std::vector<EventRecord> events;
+            Vector3 motion(0.0f, 0.0f, 0.0f);
+            for (size_t p = 0; p < parts.size(); ++p) {
+                const FrameRecord& record = split[i * parts.size() + p];
+                events.insert(events.end(), record.events.begin(), record.events.end());
+                motion += record.rootMotion;
+            }
+            if (!(events == reference[i].events)) ++eventMismatches;
+
+            // ルートモーションはフレームごとの取り出しで丸めが入るため、分割した分の和はビット単位では一致しない
+            // Transformへ積み上げた位置の差が丸め誤差の範囲に収まることを確かめる
+            referenceTotal += reference[i].rootMotion;
+            splitTotal += motion;
+            const Vector3 difference = referenceTotal - splitTotal;
+            if (difference.Length() > 1e-5f) ++rootMotionMismatches;
+        }
+        UNO_CHECK_EQ(paletteMismatches, 0u);
+        UNO_CHECK_EQ(eventMismatches, 0u);
+        UNO_CHECK_EQ(rootMotionMismatches, 0u);
+        // 実際に前へ進んでいること
+        UNO_CHECK(referenceTotal.GetZ() > 1.0f);
+    }
+}
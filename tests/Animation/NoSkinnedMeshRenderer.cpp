@@ -0,0 +1,15 @@
+#include "Engine/Animation/AnimationSystem.h"
+
+// テスト用のビルドにはレンダラー（グラフィックスAPI）が無いため、どの物体もスキンメッシュを持たないものとして扱う
+// エンジンでは Engine/Animation/AnimationSystemRenderer.cpp がSkinnedMeshRendererから求める
+
+namespace UnoEngine {
+
+bool AnimationSystem::GetSkinnedModelInfo(const GameObject&, SkinnedModelInfo&) {
+    return false;
+}
+
+void AnimationSystem::DeclareRendererAccess(SystemAccess&) {
+}
+
+} // namespace UnoEngine
@@ -0,0 +1,158 @@
+#include "../TestFramework.h"
+#include "Engine/Core/JobSystem.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// JobSystemのジョブ内からのRun/Wait/ParallelFor（入れ子）、カウンタの完了、Shutdownでのキューの処理を確かめる
+// ワーカー数は0（その場で実行）から、入れ子の深さより少ない数まで変えて試す
+
+using namespace UnoEngine;
+
+namespace {
+
+const uint32 WORKER_COUNTS[] = { 0, 1, 3 };
+
+// 子ジョブを2つ投入して待つ、を深さdepthまで繰り返す。葉の数をleavesに足す
+void SpawnTree(JobSystem& jobs, uint32 depth, std::atomic<uint32>& leaves) {
+    if (depth == 0) {
+        leaves.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    JobCounter counter;
+    jobs.Run([&jobs, depth, &leaves] { SpawnTree(jobs, depth - 1, leaves); }, &counter);
+    jobs.Run([&jobs, depth, &leaves] { SpawnTree(jobs, depth - 1, leaves); }, &counter);
+    jobs.Wait(counter);
+    UNO_CHECK(counter.IsDone());
+}
+
+// ParallelForの各インデックスがちょうど1回ずつ処理されたか
+bool VisitedOnce(const std::vector<std::atomic<uint32>>& visits) {
+    for (const auto& visit : visits) {
+        if (visit.load() != 1) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+UNO_TEST(CounterIsDoneAfterWait) {
+    for (uint32 workerCount : WORKER_COUNTS) {
+        JobSystem jobs;
+        jobs.Initialize(workerCount);
+        UNO_CHECK_EQ(jobs.GetWorkerCount(), workerCount);
+
+        JobCounter counter;
+        UNO_CHECK(counter.IsDone());
+
+        std::atomic<uint32> executed{ 0 };
+        for (int i = 0; i < 1000; ++i) {
+            jobs.Run([&executed] { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+        }
+        jobs.Wait(counter);
+        UNO_CHECK(counter.IsDone());
+        UNO_CHECK_EQ(executed.load(), 1000u);
+
+        // 使い終わったカウンタを再び使える
+        jobs.Run([&executed] { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+        jobs.Wait(counter);
+        UNO_CHECK_EQ(executed.load(), 1001u);
+    }
+}
+
+UNO_TEST(JobsWithoutWorkersRunInline) {
+    JobSystem jobs;
+    jobs.Initialize(1);
+    jobs.Shutdown();
+    UNO_CHECK_EQ(jobs.GetWorkerCount(), 0u);
+
+    bool ran = false;
+    jobs.Run([&ran] { ran = true; });
+    UNO_CHECK(ran);
+}
+
+UNO_TEST(NestedRunAndWaitInsideJobs) {
+    // 待っているジョブの数（2^深さ）がスレッド数を大きく超えても、Wait中に他のジョブを処理するので止まらない
+    constexpr uint32 DEPTH = 8;
+    for (uint32 workerCount : WORKER_COUNTS) {
+        JobSystem jobs;
+        jobs.Initialize(workerCount);
+
+        std::atomic<uint32> leaves{ 0 };
+        JobCounter root;
+        jobs.Run([&jobs, &leaves] { SpawnTree(jobs, DEPTH, leaves); }, &root);
+        jobs.Wait(root);
+        UNO_CHECK_EQ(leaves.load(), 1u << DEPTH);
+    }
+}
+
+UNO_TEST(ParallelForCoversRangeOnce) {
+    const uint32 counts[] = { 0, 1, 7, 64, 1000, 4097 };
+    const uint32 grains[] = { 0, 1, 16, 5000 };
+    for (uint32 workerCount : WORKER_COUNTS) {
+        JobSystem jobs;
+        jobs.Initialize(workerCount);
+        for (uint32 count : counts) {
+            for (uint32 grain : grains) {
+                std::vector<std::atomic<uint32>> visits(count);
+                jobs.ParallelFor(count, grain, [&visits](uint32 begin, uint32 end) {
+                    for (uint32 i = begin; i < end; ++i) visits[i].fetch_add(1, std::memory_order_relaxed);
+                });
+                UNO_CHECK(VisitedOnce(visits));
+            }
+        }
+    }
+}
+
+UNO_TEST(NestedParallelForInsideJobs) {
+    constexpr uint32 OUTER = 16;
+    constexpr uint32 INNER = 256;
+    for (uint32 workerCount : WORKER_COUNTS) {
+        JobSystem jobs;
+        jobs.Initialize(workerCount);
+
+        std::vector<std::atomic<uint32>> visits(OUTER * INNER);
+        auto fill = [&jobs, &visits](uint32 begin, uint32 end) {
+            for (uint32 outer = begin; outer < end; ++outer) {
+                jobs.ParallelFor(INNER, 8, [&visits, outer](uint32 innerBegin, uint32 innerEnd) {
+                    for (uint32 i = innerBegin; i < innerEnd; ++i) {
+                        visits[outer * INNER + i].fetch_add(1, std::memory_order_relaxed);
+                    }
+                });
+            }
+        };
+
+        // ParallelForの中のParallelForと、ジョブの中のParallelFor
+        jobs.ParallelFor(OUTER, 1, fill);
+        UNO_CHECK(VisitedOnce(visits));
+
+        for (auto& visit : visits) visit.store(0);
+        JobCounter counter;
+        for (uint32 outer = 0; outer < OUTER; ++outer) {
+            jobs.Run([&fill, outer] { fill(outer, outer + 1); }, &counter);
+        }
+        jobs.Wait(counter);
+        UNO_CHECK(VisitedOnce(visits));
+    }
+}
+
+UNO_TEST(ShutdownDrainsQueuedJobs) {
+    for (uint32 workerCount : { 1u, 3u }) {
+        JobSystem jobs;
+        jobs.Initialize(workerCount);
+
+        // カウンタ無しで投入し、Waitせずに止める。ジョブの中から投入された子ジョブも実行される
+        std::atomic<uint32> executed{ 0 };
+        for (int i = 0; i < 200; ++i) {
+            jobs.Run([&jobs, &executed] {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                executed.fetch_add(1, std::memory_order_relaxed);
+                jobs.Run([&executed] { executed.fetch_add(1, std::memory_order_relaxed); });
+            });
+        }
+        jobs.Shutdown();
+        UNO_CHECK_EQ(jobs.GetWorkerCount(), 0u);
+        UNO_CHECK_EQ(executed.load(), 400u);
+    }
+}
@@ -0,0 +1,12 @@
+#include "Engine/Core/SpatialIndex.h"
+
+// テスト用のビルドにはレンダラー（グラフィックスAPI）が無いため、どの物体も既定の箱を使う
+// エンジンでは Engine/Core/SpatialIndexBounds.cpp がMeshRenderer・SkinnedMeshRendererから求める
+
+namespace UnoEngine {
+
+bool SpatialIndex::GetRendererBounds(const GameObject&, RendererBounds&) {
+    return false;
+}
+
+} // namespace UnoEngine
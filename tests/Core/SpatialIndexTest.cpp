@@ -0,0 +1,285 @@
+#include "../TestFramework.h"
+#include "Engine/Core/Scene.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+// SceneのSpatialIndexの問い合わせ（RayCast・QueryOverlap・QueryFrustum・FindNearest）が、
+// アクティブな全GameObjectの線形走査と同じ結果を返すことを、登録・移動・削除・Rebuildの後でそれぞれ確かめる
+// 移動してからUpdateTransformsの前にGetWorldMatrixで読んだ物体（行列は再計算済みだが移動は未通知）も含める
+//
+// レンダラーの無いビルドのため、境界はどの物体も既定の箱（SpatialIndex::GetDefaultBounds）になる
+
+using namespace UnoEngine;
+
+namespace {
+
+constexpr float WORLD_SIZE = 80.0f;
+constexpr int QUERY_COUNT = 60;
+
+class TestScene : public Scene {
+public:
+    void OnRender(RenderView&) override {}
+};
+
+class SpatialIndexFixture {
+public:
+    SpatialIndexFixture() : rng_(7) {
+        // 親は削除しない（子を連れて動かす）
+        for (int i = 0; i < 40; ++i) {
+            GameObject* parent = scene_.CreateGameObject("Parent");
+            Randomize(parent->GetTransform());
+            parents_.push_back(parent);
+        }
+    }
+
+    void Spawn(uint32 count) {
+        for (uint32 i = 0; i < count; ++i) {
+            GameObject* go = scene_.CreateGameObject("Object");
+            if (i % 8 == 0) {
+                go->GetTransform().SetParent(&parents_[rng_() % parents_.size()]->GetTransform());
+                go->GetTransform().SetLocalPosition(Vector3(Uniform(-5.0f, 5.0f), Uniform(-2.0f, 2.0f), Uniform(-5.0f, 5.0f)));
+            } else {
+                Randomize(go->GetTransform());
+            }
+            objects_.push_back(go);
+        }
+    }
+
+    // 移動（親を動かすと子も動く）。readWorldMatrixなら、UpdateTransformsより前にワールド行列を読む
+    void Move(uint32 count, bool readWorldMatrix) {
+        for (uint32 i = 0; i < count; ++i) {
+            Transform& transform = (i % 10 == 0) ? parents_[rng_() % parents_.size()]->GetTransform()
+                                                 : objects_[rng_() % objects_.size()]->GetTransform();
+            transform.SetLocalPosition(transform.GetLocalPosition() +
+                                       Vector3(Uniform(-10.0f, 10.0f), 0.0f, Uniform(-10.0f, 10.0f)));
+            transform.SetLocalRotation(Quaternion::RotationRollPitchYaw(0.0f, Uniform(-3.0f, 3.0f), 0.0f));
+            if (readWorldMatrix) {
+                transform.GetWorldMatrix();
+            }
+        }
+    }
+
+    void Destroy(uint32 count) {
+        for (uint32 i = 0; i < count && !objects_.empty(); ++i) {
+            const size_t index = rng_() % objects_.size();
+            scene_.DestroyGameObject(objects_[index]);
+            objects_[index] = objects_.back();
+            objects_.pop_back();
+        }
+    }
+
+    void Deactivate(uint32 count) {
+        for (uint32 i = 0; i < count; ++i) {
+            objects_[rng_() % objects_.size()]->SetActive(false);
+        }
+    }
+
+    // フレームの終わり（破棄の反映と、ワールド行列・空間インデックスの更新）
+    void EndFrame() {
+        scene_.OnUpdate(0.0f);
+        scene_.UpdateTransforms();
+    }
+
+    SpatialIndex& GetIndex() { return scene_.GetSpatialIndex(); }
+    uint32 GetObjectCount() const { return static_cast<uint32>(parents_.size() + objects_.size()); }
+
+    int CountMismatches() {
+        int mismatches = 0;
+        for (int query = 0; query < QUERY_COUNT; ++query) {
+            mismatches += CheckOverlap() ? 0 : 1;
+            mismatches += CheckRay() ? 0 : 1;
+            mismatches += CheckNearest() ? 0 : 1;
+        }
+        for (int query = 0; query < 10; ++query) {
+            mismatches += CheckFrustum() ? 0 : 1;
+        }
+        return mismatches;
+    }
+
+private:
+    float Uniform(float min, float max) { return std::uniform_real_distribution<float>(min, max)(rng_); }
+
+    void Randomize(Transform& transform) {
+        transform.SetLocalPosition(Vector3(Uniform(-WORLD_SIZE, WORLD_SIZE), Uniform(-5.0f, 5.0f), Uniform(-WORLD_SIZE, WORLD_SIZE)));
+        transform.SetLocalRotation(Quaternion::RotationRollPitchYaw(0.0f, Uniform(-3.0f, 3.0f), 0.0f));
+        const float scale = Uniform(0.5f, 2.0f);
+        transform.SetLocalScale(Vector3(scale, scale, scale));
+    }
+
+    // SpatialIndexと同じ求め方のワールド空間の箱
+    static BoundingBox WorldBounds(const GameObject& go) {
+        const BoundingBox local = SpatialIndex::GetDefaultBounds();
+        const Vector3 center = local.GetCenter();
+        const Vector3 extents = local.GetExtents();
+        return BoundingBox(center - extents, center + extents).Transform(go.GetTransform().GetWorldMatrix());
+    }
+
+    template<typename Predicate>
+    std::vector<GameObject*> LinearScan(Predicate&& predicate) const {
+        std::vector<GameObject*> result;
+        for (const auto& go : scene_.GetGameObjects()) {
+            if (go->IsActive() && predicate(WorldBounds(*go))) result.push_back(go.get());
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    bool CheckOverlap() {
+        const Vector3 center(Uniform(-WORLD_SIZE, WORLD_SIZE), 0.0f, Uniform(-WORLD_SIZE, WORLD_SIZE));
+        const float size = Uniform(2.0f, 15.0f);
+        const BoundingBox query(center - Vector3(size, size, size), center + Vector3(size, size, size));
+
+        std::vector<GameObject*> actual;
+        GetIndex().QueryOverlap(query, actual);
+        std::sort(actual.begin(), actual.end());
+        return actual == LinearScan([&](const BoundingBox& bounds) { return bounds.Intersects(query); });
+    }
+
+    bool CheckFrustum() {
+        const Vector3 eye(Uniform(-WORLD_SIZE, WORLD_SIZE), Uniform(5.0f, 30.0f), Uniform(-WORLD_SIZE, WORLD_SIZE));
+        const Vector3 target(Uniform(-WORLD_SIZE, WORLD_SIZE), 0.0f, Uniform(-WORLD_SIZE, WORLD_SIZE));
+        const Frustum frustum(Matrix4x4::LookAtLH(eye, target, Vector3(0.0f, 1.0f, 0.0f)) *
+                              Matrix4x4::PerspectiveFovLH(1.0f, 16.0f / 9.0f, 0.1f, 100.0f));
+
+        std::vector<GameObject*> actual;
+        GetIndex().QueryFrustum(frustum, actual);
+        std::sort(actual.begin(), actual.end());
+        return actual == LinearScan([&](const BoundingBox& bounds) { return frustum.Intersects(bounds); });
+    }
+
+    // SpatialIndex::RayCastと同じく、物体のローカル空間の箱で判定した当たりの距離
+    static bool RayDistance(const GameObject& go, const Vector3& origin, const Vector3& direction, float& outDistance) {
+        const Matrix4x4 world = go.GetTransform().GetWorldMatrix();
+        const Matrix4x4 worldToLocal = world.Inverse();
+        const Vector3 localOrigin = worldToLocal.TransformPoint(origin);
+        const Vector3 localDirection = worldToLocal.TransformDirection(direction).Normalize();
+
+        float tMin, tMax;
+        if (!SpatialIndex::GetDefaultBounds().IntersectsRay(localOrigin, localDirection, tMin, tMax)) return false;
+        outDistance = (world.TransformPoint(localOrigin + localDirection * tMin) - origin).Length();
+        return true;
+    }
+
+    bool CheckRay() {
+        const Vector3 origin(Uniform(-WORLD_SIZE, WORLD_SIZE), 50.0f, Uniform(-WORLD_SIZE, WORLD_SIZE));
+        const Vector3 direction = Vector3(Uniform(-0.5f, 0.5f), -1.0f, Uniform(-0.5f, 0.5f)).Normalize();
+        const float maxDistance = 200.0f;
+
+        float expectedDistance = maxDistance;
+        for (const auto& go : scene_.GetGameObjects()) {
+            float distance;
+            if (go->IsActive() && RayDistance(*go, origin, direction, distance) && distance < expectedDistance) {
+                expectedDistance = distance;
+            }
+        }
+
+        float actualDistance = maxDistance;
+        GameObject* hit = GetIndex().RayCast(origin, direction, maxDistance, &actualDistance);
+        if (!hit) return expectedDistance == maxDistance;
+        // 同じ距離の別の物体を返してもよい
+        return hit->IsActive() && std::abs(actualDistance - expectedDistance) <= 1e-3f;
+    }
+
+    bool CheckNearest() {
+        const Vector3 point(Uniform(-WORLD_SIZE, WORLD_SIZE), Uniform(-10.0f, 10.0f), Uniform(-WORLD_SIZE, WORLD_SIZE));
+        float expected = std::numeric_limits<float>::infinity();
+        for (const auto& go : scene_.GetGameObjects()) {
+            if (!go->IsActive()) continue;
+            const BoundingBox bounds = WorldBounds(*go);
+            const Vector3 closest(std::clamp(point.GetX(), bounds.min.GetX(), bounds.max.GetX()),
+                                  std::clamp(point.GetY(), bounds.min.GetY(), bounds.max.GetY()),
+                                  std::clamp(point.GetZ(), bounds.min.GetZ(), bounds.max.GetZ()));
+            expected = (std::min)(expected, (closest - point).Length());
+        }
+
+        float actual = -1.0f;
+        GameObject* nearest = GetIndex().FindNearest(point, std::numeric_limits<float>::max(), &actual);
+        return nearest && nearest->IsActive() && std::abs(actual - expected) <= 1e-4f;
+    }
+
+    TestScene scene_;
+    std::mt19937 rng_;
+    std::vector<GameObject*> parents_;
+    std::vector<GameObject*> objects_;
+};
+
+} // namespace
+
+UNO_TEST(QueriesMatchLinearScanAfterInsert) {
+    SpatialIndexFixture fixture;
+    // まとめての登録（Update内でツリーを作り直す）と、少数ずつの登録（1つずつ挿入する）
+    fixture.Spawn(1500);
+    fixture.EndFrame();
+    UNO_CHECK_EQ(fixture.GetIndex().GetCount(), fixture.GetObjectCount());
+    UNO_CHECK_EQ(fixture.CountMismatches(), 0);
+
+    for (int frame = 0; frame < 3; ++frame) {
+        fixture.Spawn(50);
+        fixture.EndFrame();
+    }
+    UNO_CHECK_EQ(fixture.GetIndex().GetCount(), fixture.GetObjectCount());
+    UNO_CHECK_EQ(fixture.CountMismatches(), 0);
+}
+
+UNO_TEST(QueriesMatchLinearScanAfterMove) {
+    SpatialIndexFixture fixture;
+    fixture.Spawn(1500);
+    fixture.EndFrame();
+    for (int frame = 0; frame < 5; ++frame) {
+        fixture.Move(200, false);
+        fixture.EndFrame();
+        UNO_CHECK_EQ(fixture.CountMismatches(), 0);
+    }
+}
+
+UNO_TEST(QueriesMatchLinearScanWhenMovedObjectsWereReadBeforeUpdate) {
+    // GetWorldMatrixが行列を先に計算し直しても、UpdateTransformsで移動が空間インデックスに反映される
+    SpatialIndexFixture fixture;
+    fixture.Spawn(1500);
+    fixture.EndFrame();
+    for (int frame = 0; frame < 5; ++frame) {
+        fixture.Move(200, true);
+        fixture.EndFrame();
+        UNO_CHECK_EQ(fixture.CountMismatches(), 0);
+    }
+}
+
+UNO_TEST(QueriesMatchLinearScanAfterRemove) {
+    SpatialIndexFixture fixture;
+    fixture.Spawn(1500);
+    fixture.EndFrame();
+
+    fixture.Destroy(300);
+    fixture.Deactivate(50);
+    fixture.EndFrame();
+    UNO_CHECK_EQ(fixture.GetIndex().GetCount(), fixture.GetObjectCount());
+    UNO_CHECK_EQ(fixture.CountMismatches(), 0);
+
+    // 同じフレームで生成・移動・破棄（空いたスロットの再利用）
+    fixture.Spawn(100);
+    fixture.Move(100, true);
+    fixture.Destroy(100);
+    fixture.EndFrame();
+    UNO_CHECK_EQ(fixture.GetIndex().GetCount(), fixture.GetObjectCount());
+    UNO_CHECK_EQ(fixture.CountMismatches(), 0);
+}
+
+UNO_TEST(QueriesMatchLinearScanAfterRebuild) {
+    SpatialIndexFixture fixture;
+    fixture.Spawn(1500);
+    fixture.EndFrame();
+    fixture.Move(500, false);
+    fixture.Destroy(100);
+    fixture.EndFrame();
+
+    fixture.GetIndex().Rebuild();
+    UNO_CHECK_EQ(fixture.GetIndex().GetCount(), fixture.GetObjectCount());
+    UNO_CHECK_EQ(fixture.CountMismatches(), 0);
+
+    fixture.Move(200, true);
+    fixture.EndFrame();
+    UNO_CHECK_EQ(fixture.CountMismatches(), 0);
+}
@@ -0,0 +1,239 @@
+#include "../TestFramework.h"
+#include "Engine/Math/BoundingVolumeTree.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// BoundingVolumeTreeの問い合わせ（QueryOverlap・QueryFrustum・RayCast・FindNearest）が、
+// 全要素の線形走査と同じ結果を返すことを、挿入・移動・削除・Rebuildの後でそれぞれ確かめる
+// ツリーは太った箱で返すため、SpatialIndexと同じく実際の箱での判定は呼び出し側（ここ）で行う
+
+using namespace UnoEngine;
+
+namespace {
+
+constexpr uint32 OBJECT_COUNT = 2000;
+constexpr float WORLD_SIZE = 120.0f;
+constexpr int QUERY_COUNT = 100;
+
+class TreeFixture {
+public:
+    explicit TreeFixture(uint32 seed) : rng_(seed) {}
+
+    BoundingBox RandomBox() {
+        const Vector3 center(Uniform(-WORLD_SIZE, WORLD_SIZE), Uniform(-10.0f, 10.0f), Uniform(-WORLD_SIZE, WORLD_SIZE));
+        const Vector3 extents(Uniform(0.2f, 3.0f), Uniform(0.2f, 3.0f), Uniform(0.2f, 3.0f));
+        return BoundingBox(center - extents, center + extents);
+    }
+
+    void Insert(uint32 count) {
+        for (uint32 i = 0; i < count; ++i) {
+            const BoundingBox box = RandomBox();
+            const uint32 index = static_cast<uint32>(boxes_.size());
+            boxes_.push_back(box);
+            alive_.push_back(true);
+            proxies_.push_back(tree_.CreateProxy(box, index));
+        }
+    }
+
+    // 小さな移動（太った箱に収まるものが多い）と大きな移動（挿入し直し）を混ぜる
+    void Move(uint32 count) {
+        for (uint32 i = 0; i < count; ++i) {
+            const uint32 index = rng_() % boxes_.size();
+            if (!alive_[index]) continue;
+            const float range = (i % 4 == 0) ? 30.0f : 0.3f;
+            const Vector3 delta(Uniform(-range, range), Uniform(-range, range) * 0.1f, Uniform(-range, range));
+            boxes_[index] = BoundingBox(boxes_[index].min + delta, boxes_[index].max + delta);
+            tree_.MoveProxy(proxies_[index], boxes_[index]);
+        }
+    }
+
+    void Remove(uint32 count) {
+        for (uint32 i = 0; i < count; ++i) {
+            const uint32 index = rng_() % boxes_.size();
+            if (!alive_[index]) continue;
+            tree_.DestroyProxy(proxies_[index]);
+            alive_[index] = false;
+        }
+    }
+
+    void Rebuild() { tree_.Rebuild(); }
+
+    uint32 GetAliveCount() const { return static_cast<uint32>(std::count(alive_.begin(), alive_.end(), true)); }
+    const BoundingVolumeTree& GetTree() const { return tree_; }
+
+    // 全問い合わせを線形走査と比べ、一致しなかった数を返す
+    int CountMismatches() {
+        int mismatches = 0;
+        for (int query = 0; query < QUERY_COUNT; ++query) {
+            mismatches += CheckOverlap() ? 0 : 1;
+            mismatches += CheckRay() ? 0 : 1;
+            mismatches += CheckNearest() ? 0 : 1;
+        }
+        for (int query = 0; query < 10; ++query) {
+            mismatches += CheckFrustum() ? 0 : 1;
+        }
+        return mismatches;
+    }
+
+private:
+    float Uniform(float min, float max) { return std::uniform_real_distribution<float>(min, max)(rng_); }
+
+    bool CheckOverlap() {
+        const Vector3 center(Uniform(-WORLD_SIZE, WORLD_SIZE), 0.0f, Uniform(-WORLD_SIZE, WORLD_SIZE));
+        const float size = Uniform(1.0f, 20.0f);
+        const BoundingBox query(center - Vector3(size, size, size), center + Vector3(size, size, size));
+
+        std::vector<uint32> expected;
+        for (uint32 i = 0; i < boxes_.size(); ++i) {
+            if (alive_[i] && boxes_[i].Intersects(query)) expected.push_back(i);
+        }
+        std::vector<uint32> actual;
+        tree_.QueryOverlap(query, [&](int32 proxy) {
+            const uint32 index = tree_.GetUserData(proxy);
+            if (boxes_[index].Intersects(query)) actual.push_back(index);
+            return true;
+        });
+        std::sort(actual.begin(), actual.end());
+        return actual == expected;
+    }
+
+    bool CheckFrustum() {
+        const Vector3 eye(Uniform(-WORLD_SIZE, WORLD_SIZE), Uniform(5.0f, 40.0f), Uniform(-WORLD_SIZE, WORLD_SIZE));
+        const Vector3 target(Uniform(-WORLD_SIZE, WORLD_SIZE), 0.0f, Uniform(-WORLD_SIZE, WORLD_SIZE));
+        const Frustum frustum(Matrix4x4::LookAtLH(eye, target, Vector3(0.0f, 1.0f, 0.0f)) *
+                              Matrix4x4::PerspectiveFovLH(1.0f, 16.0f / 9.0f, 0.1f, 150.0f));
+
+        std::vector<uint32> expected;
+        for (uint32 i = 0; i < boxes_.size(); ++i) {
+            if (alive_[i] && frustum.Intersects(boxes_[i])) expected.push_back(i);
+        }
+        std::vector<uint32> actual;
+        tree_.QueryFrustum(frustum, [&](int32 proxy) {
+            const uint32 index = tree_.GetUserData(proxy);
+            if (frustum.Intersects(boxes_[index])) actual.push_back(index);
+            return true;
+        });
+        std::sort(actual.begin(), actual.end());
+        return actual == expected;
+    }
+
+    // 最も近い当たりの距離が同じなら、同じ距離の別の箱を返してもよい
+    bool CheckRay() {
+        const Vector3 origin(Uniform(-WORLD_SIZE, WORLD_SIZE), Uniform(-5.0f, 5.0f), -WORLD_SIZE * 1.5f);
+        const Vector3 direction = Vector3(Uniform(-0.3f, 0.3f), Uniform(-0.05f, 0.05f), 1.0f).Normalize();
+        const float maxDistance = WORLD_SIZE * 4.0f;
+
+        float expectedDistance = maxDistance;
+        bool expectedHit = false;
+        for (uint32 i = 0; i < boxes_.size(); ++i) {
+            float tMin, tMax;
+            if (alive_[i] && boxes_[i].IntersectsRay(origin, direction, tMin, tMax) && tMin < expectedDistance) {
+                expectedDistance = tMin;
+                expectedHit = true;
+            }
+        }
+
+        float actualDistance = maxDistance;
+        bool actualHit = false;
+        tree_.RayCast(origin, direction, maxDistance, [&](int32 proxy, float currentMax) {
+            float tMin, tMax;
+            if (!boxes_[tree_.GetUserData(proxy)].IntersectsRay(origin, direction, tMin, tMax) || tMin >= currentMax) {
+                return currentMax;
+            }
+            actualDistance = tMin;
+            actualHit = true;
+            return tMin;
+        });
+        return actualHit == expectedHit && (!expectedHit || std::abs(actualDistance - expectedDistance) <= 1e-4f);
+    }
+
+    bool CheckNearest() {
+        const Vector3 point(Uniform(-WORLD_SIZE, WORLD_SIZE), Uniform(-20.0f, 20.0f), Uniform(-WORLD_SIZE, WORLD_SIZE));
+        auto distanceSq = [&](uint32 index) {
+            const BoundingBox& box = boxes_[index];
+            const Vector3 closest(std::clamp(point.GetX(), box.min.GetX(), box.max.GetX()),
+                                  std::clamp(point.GetY(), box.min.GetY(), box.max.GetY()),
+                                  std::clamp(point.GetZ(), box.min.GetZ(), box.max.GetZ()));
+            return (closest - point).LengthSq();
+        };
+
+        float expected = std::numeric_limits<float>::infinity();
+        for (uint32 i = 0; i < boxes_.size(); ++i) {
+            if (alive_[i]) expected = (std::min)(expected, distanceSq(i));
+        }
+
+        const int32 proxy = tree_.FindNearest(point, WORLD_SIZE * 10.0f,
+                                              [&](int32 candidate) { return distanceSq(tree_.GetUserData(candidate)); });
+        if (proxy == BoundingVolumeTree::NULL_NODE) return GetAliveCount() == 0;
+        return distanceSq(tree_.GetUserData(proxy)) == expected;
+    }
+
+    std::mt19937 rng_;
+    BoundingVolumeTree tree_;
+    std::vector<BoundingBox> boxes_;
+    std::vector<bool> alive_;
+    std::vector<int32> proxies_;
+};
+
+} // namespace
+
+UNO_TEST(QueriesMatchLinearScanAfterInsert) {
+    TreeFixture fixture(1);
+    fixture.Insert(OBJECT_COUNT);
+    UNO_CHECK_EQ(fixture.GetTree().GetProxyCount(), OBJECT_COUNT);
+    UNO_CHECK_EQ(fixture.CountMismatches(), 0);
+}
+
+UNO_TEST(QueriesMatchLinearScanAfterMove) {
+    TreeFixture fixture(2);
+    fixture.Insert(OBJECT_COUNT);
+    for (int frame = 0; frame < 5; ++frame) {
+        fixture.Move(OBJECT_COUNT / 5);
+        UNO_CHECK_EQ(fixture.CountMismatches(), 0);
+    }
+}
+
+UNO_TEST(QueriesMatchLinearScanAfterRemove) {
+    TreeFixture fixture(3);
+    fixture.Insert(OBJECT_COUNT);
+    fixture.Remove(OBJECT_COUNT / 3);
+    UNO_CHECK_EQ(fixture.GetTree().GetProxyCount(), fixture.GetAliveCount());
+    UNO_CHECK_EQ(fixture.CountMismatches(), 0);
+
+    // 削除で空いた節点を再利用する挿入
+    fixture.Insert(OBJECT_COUNT / 4);
+    fixture.Move(OBJECT_COUNT / 4);
+    UNO_CHECK_EQ(fixture.GetTree().GetProxyCount(), fixture.GetAliveCount());
+    UNO_CHECK_EQ(fixture.CountMismatches(), 0);
+}
+
+UNO_TEST(QueriesMatchLinearScanAfterRebuild) {
+    TreeFixture fixture(4);
+    fixture.Insert(OBJECT_COUNT);
+    fixture.Move(OBJECT_COUNT / 2);
+    fixture.Remove(OBJECT_COUNT / 10);
+
+    const float costBefore = fixture.GetTree().ComputeCost();
+    fixture.Rebuild();
+    UNO_CHECK_EQ(fixture.GetTree().GetProxyCount(), fixture.GetAliveCount());
+    UNO_CHECK(fixture.GetTree().ComputeCost() <= costBefore);
+    UNO_CHECK_EQ(fixture.CountMismatches(), 0);
+
+    // 作り直した後の移動・挿入
+    fixture.Move(OBJECT_COUNT / 4);
+    fixture.Insert(100);
+    UNO_CHECK_EQ(fixture.CountMismatches(), 0);
+}
+
+UNO_TEST(EmptyTreeReturnsNothing) {
+    BoundingVolumeTree tree;
+    UNO_CHECK_EQ(tree.GetHeight(), -1);
+
+    int calls = 0;
+    tree.QueryOverlap(BoundingBox(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f)), [&](int32) { ++calls; return true; });
+    tree.RayCast(Vector3(0.0f, 0.0f, -10.0f), Vector3(0.0f, 0.0f, 1.0f), 100.0f, [&](int32, float max) { ++calls; return max; });
+    UNO_CHECK_EQ(calls, 0);
+    UNO_CHECK_EQ(tree.FindNearest(Vector3(0.0f, 0.0f, 0.0f), 100.0f, [](int32) { return 0.0f; }), BoundingVolumeTree::NULL_NODE);
+}
@@ -0,0 +1,231 @@
+#include "../TestFramework.h"
+#include "Engine/Math/Matrix.h"
+#include "Engine/Math/MatrixKernels.h"
+#include "Engine/Math/Quaternion.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// MatrixKernels.h のSIMD実装（ビルド設定で選ばれたもの）をScalar::の参照実装と比べる
+// 乗算・転置・変換はビット単位で一致、逆行列・クォータニオン・法線行列は丸め誤差の範囲で一致すること
+
+using namespace UnoEngine;
+
+namespace {
+
+constexpr int RANDOM_CASES = 10000;
+// 逆行列など演算順序が異なるカーネルの許容誤差（値の大きさに対する相対誤差）
+constexpr double RELATIVE_TOLERANCE = 1e-4;
+// M * M^-1 は平行移動成分（最大100）とスケールの逆数（最大10）の積で誤差が増幅される
+constexpr double IDENTITY_TOLERANCE = 1e-3;
+
+struct Mat {
+    float m[16];
+};
+
+// 回転・非一様スケール・平行移動からなる、エンジンで実際に扱う形の行列
+Mat RandomAffine(std::mt19937& rng) {
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> scale(0.1f, 4.0f);
+    std::uniform_real_distribution<float> offset(-100.0f, 100.0f);
+
+    const Quaternion rotation = Quaternion(unit(rng), unit(rng), unit(rng), unit(rng)).Normalize();
+    const Matrix4x4 matrix = Matrix4x4::Scaling(scale(rng), scale(rng), scale(rng)) * rotation.ToMatrix() *
+                             Matrix4x4::Translation(offset(rng), offset(rng), offset(rng));
+    Mat result;
+    std::memcpy(result.m, matrix.GetData(), sizeof(result.m));
+    return result;
+}
+
+// 射影行列なども含む一般の行列
+Mat RandomGeneral(std::mt19937& rng) {
+    std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+    Mat result;
+    for (float& v : result.m) v = value(rng);
+    return result;
+}
+
+bool BitEqual(const float* a, const float* b, int count) {
+    return std::memcmp(a, b, sizeof(float) * count) == 0;
+}
+
+bool NearlyEqual(const float* a, const float* b, int count, double tolerance = RELATIVE_TOLERANCE) {
+    for (int i = 0; i < count; ++i) {
+        const double scale = (std::max)(1.0, std::fabs(static_cast<double>(b[i])));
+        if (std::fabs(static_cast<double>(a[i]) - b[i]) > tolerance * scale) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+UNO_TEST(MultiplyMatchesScalarBitExact) {
+    std::mt19937 rng(1);
+    int mismatches = 0;
+    for (int i = 0; i < RANDOM_CASES; ++i) {
+        const Mat a = (i & 1) ? RandomAffine(rng) : RandomGeneral(rng);
+        const Mat b = (i & 2) ? RandomAffine(rng) : RandomGeneral(rng);
+        float expected[16] = {}, actual[16] = {};
+        Math::Scalar::MatrixMultiply(a.m, b.m, expected);
+        Math::MatrixMultiply(a.m, b.m, actual);
+        if (!BitEqual(expected, actual, 16)) ++mismatches;
+    }
+    UNO_CHECK_EQ(mismatches, 0);
+}
+
+UNO_TEST(MultiplyAllowsOutputAliasingInput) {
+    std::mt19937 rng(2);
+    Mat a = RandomGeneral(rng);
+    const Mat b = RandomGeneral(rng);
+    float expected[16];
+    Math::Scalar::MatrixMultiply(a.m, b.m, expected);
+    Math::MatrixMultiply(a.m, b.m, a.m);
+    UNO_CHECK(BitEqual(expected, a.m, 16));
+}
+
+UNO_TEST(TransposeMatchesScalarBitExact) {
+    std::mt19937 rng(3);
+    int mismatches = 0;
+    for (int i = 0; i < RANDOM_CASES; ++i) {
+        const Mat a = RandomGeneral(rng);
+        float expected[16] = {}, actual[16] = {};
+        Math::Scalar::MatrixTranspose(a.m, expected);
+        Math::MatrixTranspose(a.m, actual);
+        if (!BitEqual(expected, actual, 16)) ++mismatches;
+    }
+    UNO_CHECK_EQ(mismatches, 0);
+}
+
+UNO_TEST(TransformsMatchScalarBitExact) {
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<float> value(-50.0f, 50.0f);
+    int mismatches = 0;
+    for (int i = 0; i < RANDOM_CASES; ++i) {
+        const Mat m = (i & 1) ? RandomAffine(rng) : RandomGeneral(rng);
+        const float v[4] = { value(rng), value(rng), value(rng), value(rng) };
+        float expected[4], actual[4];
+
+        Math::Scalar::TransformPoint(m.m, v, expected);
+        Math::TransformPoint(m.m, v, actual);
+        if (!BitEqual(expected, actual, 3)) ++mismatches;
+
+        Math::Scalar::TransformDirection(m.m, v, expected);
+        Math::TransformDirection(m.m, v, actual);
+        if (!BitEqual(expected, actual, 3)) ++mismatches;
+
+        Math::Scalar::TransformVector4(m.m, v, expected);
+        Math::TransformVector4(m.m, v, actual);
+        if (!BitEqual(expected, actual, 4)) ++mismatches;
+    }
+    UNO_CHECK_EQ(mismatches, 0);
+}
+
+UNO_TEST(InverseMatchesScalarWithinTolerance) {
+    std::mt19937 rng(5);
+    int mismatches = 0;
+    for (int i = 0; i < RANDOM_CASES; ++i) {
+        const Mat m = RandomAffine(rng);
+        float expected[16] = {}, actual[16] = {};
+        const bool expectedOk = Math::Scalar::MatrixInverse(m.m, expected);
+        const bool actualOk = Math::MatrixInverse(m.m, actual);
+        if (expectedOk != actualOk || (expectedOk && !NearlyEqual(actual, expected, 16))) ++mismatches;
+    }
+    UNO_CHECK_EQ(mismatches, 0);
+}
+
+UNO_TEST(InverseTimesMatrixIsIdentity) {
+    std::mt19937 rng(6);
+    const Matrix4x4 identity = Matrix4x4::Identity();
+    int mismatches = 0;
+    for (int i = 0; i < 1000; ++i) {
+        const Mat m = RandomAffine(rng);
+        Matrix4x4 matrix;
+        std::memcpy(matrix.GetData(), m.m, sizeof(m.m));
+        const Matrix4x4 product = matrix * matrix.Inverse();
+        if (!NearlyEqual(product.GetData(), identity.GetData(), 16, IDENTITY_TOLERANCE)) ++mismatches;
+    }
+    UNO_CHECK_EQ(mismatches, 0);
+}
+
+UNO_TEST(SingularInverseReturnsIdentity) {
+    Matrix4x4 singular = Matrix4x4::Scaling(1.0f, 0.0f, 1.0f);
+    const Matrix4x4 inverse = singular.Inverse();
+    UNO_CHECK(BitEqual(inverse.GetData(), Matrix4x4::Identity().GetData(), 16));
+
+    float out[16] = {};
+    UNO_CHECK(!Math::MatrixInverse(singular.GetData(), out));
+}
+
+UNO_TEST(QuaternionToMatrixMatchesScalarWithinTolerance) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    int mismatches = 0;
+    for (int i = 0; i < RANDOM_CASES; ++i) {
+        const Quaternion q = Quaternion(unit(rng), unit(rng), unit(rng), unit(rng)).Normalize();
+        const float components[4] = { q.GetX(), q.GetY(), q.GetZ(), q.GetW() };
+        float expected[16] = {}, actual[16] = {};
+        Math::Scalar::QuaternionToMatrix(components, expected);
+        Math::QuaternionToMatrix(components, actual);
+        if (!NearlyEqual(actual, expected, 16)) ++mismatches;
+    }
+    UNO_CHECK_EQ(mismatches, 0);
+}
+
+UNO_TEST(NormalMatrixMatchesScalarWithinTolerance) {
+    std::mt19937 rng(8);
+    int mismatches = 0;
+    for (int i = 0; i < RANDOM_CASES; ++i) {
+        const Mat m = RandomAffine(rng);
+        float expected[16] = {}, actual[16] = {};
+        Math::Scalar::MatrixNormal(m.m, expected);
+        Math::MatrixNormal(m.m, actual);
+        if (!NearlyEqual(actual, expected, 16)) ++mismatches;
+    }
+    UNO_CHECK_EQ(mismatches, 0);
+}
+
+UNO_TEST(ArrayKernelsMatchPerElementScalar) {
+    constexpr int COUNT = 257;  // SIMDの一括処理で端数が出る数
+    std::mt19937 rng(9);
+    std::vector<Mat> input(COUNT);
+    for (Mat& m : input) m = RandomAffine(rng);
+    const Mat rhs = RandomAffine(rng);
+
+    std::vector<Mat> actual(COUNT);
+    int mismatches = 0;
+
+    Math::MatrixMultiplyArray(input[0].m, 16, rhs.m, actual[0].m, 16, COUNT);
+    for (int i = 0; i < COUNT; ++i) {
+        float expected[16];
+        Math::Scalar::MatrixMultiply(input[i].m, rhs.m, expected);
+        if (!BitEqual(expected, actual[i].m, 16)) ++mismatches;
+    }
+
+    Math::MatrixInverseTransposeArray(input[0].m, 16, actual[0].m, 16, COUNT);
+    for (int i = 0; i < COUNT; ++i) {
+        float inverse[16] = {}, expected[16] = {};
+        Math::Scalar::MatrixInverse(input[i].m, inverse);
+        Math::Scalar::MatrixTranspose(inverse, expected);
+        if (!NearlyEqual(actual[i].m, expected, 16)) ++mismatches;
+    }
+
+    std::vector<float> points(COUNT * 3), transformed(COUNT * 3);
+    std::uniform_real_distribution<float> value(-50.0f, 50.0f);
+    for (float& p : points) p = value(rng);
+    Math::TransformPointArray(rhs.m, points.data(), 3, transformed.data(), 3, COUNT);
+    for (int i = 0; i < COUNT; ++i) {
+        float expected[3];
+        Math::Scalar::TransformPoint(rhs.m, &points[i * 3], expected);
+        if (!BitEqual(expected, &transformed[i * 3], 3)) ++mismatches;
+    }
+
+    UNO_CHECK_EQ(mismatches, 0);
+}
+
+UNO_TEST(ReportsSelectedBackend) {
+    std::printf("  SIMD backend: %s\n", Math::GetSimdBackendName());
+    UNO_CHECK(Math::GetSimdBackendName() != nullptr);
+}
@@ -0,0 +1,143 @@
+#include "../TestFramework.h"
+#include "Engine/Rendering/DrawKey.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// RadixSortDrawKeysの比較ソート（少数）と基数ソート（多数）の両方が、std::stable_sortと同じ並びになることを確かめる
+
+using namespace UnoEngine;
+
+namespace {
+
+enum class IndexOrder {
+    Sequential,  // RenderSystemと同じ 0, 1, 2, ...
+    Shuffled,    // 入力位置とindexが一致しない
+};
+
+// 不透明と半透明が混ざり、同じキーが何度も現れる入力
+std::vector<DrawKeyEntry> MakeMixedEntries(size_t count, IndexOrder order, uint32 seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<uint32> small(0, 3);
+    std::uniform_int_distribution<uint32> depthStep(0, 40);
+
+    std::vector<DrawKeyEntry> entries(count);
+    for (size_t i = 0; i < count; ++i) {
+        const DrawPass pass = (rng() % 4 == 0) ? DrawPass::Transparent : DrawPass::Opaque;
+        // 深度を粗い刻みにして、同じキーになる組み合わせを作る
+        const float depth = 0.5f * static_cast<float>(depthStep(rng));
+        entries[i].key = DrawKey::Make(pass, 0, small(rng) % 2, small(rng), small(rng), depth);
+        entries[i].index = static_cast<uint32>(i);
+    }
+    if (order == IndexOrder::Shuffled) {
+        std::vector<uint32> indices(count);
+        std::iota(indices.begin(), indices.end(), 0u);
+        std::shuffle(indices.begin(), indices.end(), rng);
+        for (size_t i = 0; i < count; ++i) entries[i].index = indices[i];
+    }
+    return entries;
+}
+
+std::vector<DrawKeyEntry> StableSorted(std::vector<DrawKeyEntry> entries) {
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const DrawKeyEntry& a, const DrawKeyEntry& b) { return a.key < b.key; });
+    return entries;
+}
+
+bool SameOrder(const std::vector<DrawKeyEntry>& a, const std::vector<DrawKeyEntry>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].key != b[i].key || a[i].index != b[i].index) return false;
+    }
+    return true;
+}
+
+// 比較ソートの上限（DrawKey.cppのCOMPARISON_SORT_THRESHOLD）の前後を含む要素数
+const size_t SORT_SIZES[] = { 0, 1, 2, 17, 255, 1023, 1024, 1025, 4096, 20000 };
+
+} // namespace
+
+UNO_TEST(SortMatchesStableSortForMixedKeys) {
+    std::vector<DrawKeyEntry> scratch;
+    for (IndexOrder order : { IndexOrder::Sequential, IndexOrder::Shuffled }) {
+        for (size_t count : SORT_SIZES) {
+            std::vector<DrawKeyEntry> entries = MakeMixedEntries(count, order, static_cast<uint32>(count) + 7);
+            const std::vector<DrawKeyEntry> expected = StableSorted(entries);
+            RadixSortDrawKeys(entries, scratch);
+            if (!SameOrder(entries, expected)) {
+                std::printf("  mismatch: count=%zu, %s indices\n", count,
+                            order == IndexOrder::Sequential ? "sequential" : "shuffled");
+                UNO_CHECK(false);
+            }
+        }
+    }
+}
+
+UNO_TEST(SortKeepsInputOrderWhenEveryDigitIsEqual) {
+    // 全桁が同じ値（どの桁も読み飛ばされる）でも、入力の並びのまま返す
+    std::vector<DrawKeyEntry> scratch;
+    for (size_t count : SORT_SIZES) {
+        std::vector<DrawKeyEntry> entries(count);
+        for (size_t i = 0; i < count; ++i) {
+            entries[i] = { DrawKey::MakeOpaque(1, 2, 3, 4, 5.0f), static_cast<uint32>(count - i) };
+        }
+        const std::vector<DrawKeyEntry> expected = entries;
+        RadixSortDrawKeys(entries, scratch);
+        UNO_CHECK(SameOrder(entries, expected));
+    }
+}
+
+UNO_TEST(SortHandlesSingleVaryingDigit) {
+    // 下位の1桁だけが異なり、残りの7桁は全要素で同じ
+    std::vector<DrawKeyEntry> scratch;
+    for (size_t count : { size_t(1000), size_t(5000) }) {
+        std::mt19937 rng(static_cast<uint32>(count));
+        std::vector<DrawKeyEntry> entries(count);
+        for (size_t i = 0; i < count; ++i) {
+            entries[i] = { 0xABCDEF0123456700ull | (rng() & 0xFF), static_cast<uint32>(i) };
+        }
+        const std::vector<DrawKeyEntry> expected = StableSorted(entries);
+        RadixSortDrawKeys(entries, scratch);
+        UNO_CHECK(SameOrder(entries, expected));
+    }
+}
+
+UNO_TEST(OpaqueBeforeTransparentAndTransparentBackToFront) {
+    const uint64 opaqueFar = DrawKey::MakeOpaque(0, 63, 65535, 65535, 1000.0f);
+    const uint64 transparentNear = DrawKey::MakeTransparent(0, 0, 0, 0, 1.0f);
+    const uint64 transparentFar = DrawKey::MakeTransparent(0, 0, 0, 0, 100.0f);
+    UNO_CHECK(opaqueFar < transparentNear);
+    UNO_CHECK(transparentFar < transparentNear);
+    UNO_CHECK(DrawKey::GetPass(opaqueFar) == DrawPass::Opaque);
+    UNO_CHECK(DrawKey::GetPass(transparentNear) == DrawPass::Transparent);
+
+    // 不透明は同じメッシュの中で手前から
+    UNO_CHECK(DrawKey::MakeOpaque(0, 0, 0, 0, 1.0f) < DrawKey::MakeOpaque(0, 0, 0, 0, 100.0f));
+}
+
+UNO_TEST(QuantizeDepthPreservesOrder) {
+    uint64 previous = 0;
+    int outOfOrder = 0;
+    for (float depth = 0.001f; depth < 100000.0f; depth *= 1.01f) {
+        const uint64 quantized = DrawKey::QuantizeDepth(depth);
+        if (quantized < previous) ++outOfOrder;
+        previous = quantized;
+    }
+    UNO_CHECK_EQ(outOfOrder, 0);
+
+    // 十分に離れた深度は別の値になる
+    UNO_CHECK(DrawKey::QuantizeDepth(1.0f) < DrawKey::QuantizeDepth(1.01f));
+    UNO_CHECK(DrawKey::QuantizeDepth(10.0f) < DrawKey::QuantizeDepth(20.0f));
+    UNO_CHECK(DrawKey::QuantizeDepth(std::numeric_limits<float>::max()) < (1ull << DrawKey::DEPTH_BITS));
+}
+
+UNO_TEST(QuantizeDepthMapsNonPositiveToZero) {
+    UNO_CHECK_EQ(DrawKey::QuantizeDepth(0.0f), 0u);
+    UNO_CHECK_EQ(DrawKey::QuantizeDepth(-0.0f), 0u);
+    UNO_CHECK_EQ(DrawKey::QuantizeDepth(-1.0f), 0u);
+    UNO_CHECK_EQ(DrawKey::QuantizeDepth(-std::numeric_limits<float>::infinity()), 0u);
+    UNO_CHECK_EQ(DrawKey::QuantizeDepth(std::numeric_limits<float>::quiet_NaN()), 0u);
+}
@@ -0,0 +1,151 @@
+#include "../TestFramework.h"
+#include "Engine/Rendering/InstanceBatcher.h"
+#include <cstring>
+#include <vector>
+
+// InstanceBatcherのまとめ方と、RenderItemの並びから直接転置したインスタンス行列を確かめる
+
+using namespace UnoEngine;
+
+namespace {
+
+// InstanceBatcherはメッシュ・マテリアルのポインタを比べるだけなので、実体の無いアドレスで代用する
+alignas(16) char g_resourceStorage[8];
+Mesh* MeshAt(int index) { return reinterpret_cast<Mesh*>(&g_resourceStorage[index]); }
+Material* MaterialAt(int index) { return reinterpret_cast<Material*>(&g_resourceStorage[4 + index]); }
+
+// 要素ごとに異なる値を持つ行列（転置の取り違えが分かるよう対称にしない）
+Matrix4x4 UniqueMatrix(int seed) {
+    Matrix4x4 matrix;
+    float* data = matrix.GetData();
+    for (int i = 0; i < 16; ++i) {
+        data[i] = static_cast<float>(seed * 100 + i);
+    }
+    return matrix;
+}
+
+bool IsTransposeOf(const InstanceData& instance, const Matrix4x4& world) {
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            if (instance.world.m[row][column] != world.GetElement(column, row)) return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+UNO_TEST(EmptyInputProducesNoBatches) {
+    InstanceBatcher batcher;
+    batcher.Build({});
+    UNO_CHECK(batcher.GetBatches().empty());
+    UNO_CHECK(batcher.GetInstances().empty());
+}
+
+UNO_TEST(ConsecutiveItemsWithSameMeshAndMaterialAreGrouped) {
+    std::vector<RenderItem> items;
+    for (int i = 0; i < 5; ++i) {
+        items.emplace_back(MeshAt(0), MaterialAt(0), UniqueMatrix(i));
+    }
+
+    InstanceBatcher batcher;
+    batcher.Build(items);
+    UNO_CHECK_EQ(batcher.GetBatches().size(), 1u);
+    UNO_CHECK_EQ(batcher.GetBatches()[0].firstInstance, 0u);
+    UNO_CHECK_EQ(batcher.GetBatches()[0].instanceCount, 5u);
+    UNO_CHECK_EQ(batcher.GetInstances().size(), 5u);
+}
+
+UNO_TEST(RunsSplitOnMeshOrMaterialChange) {
+    // メッシュが変わる、マテリアルが変わる、元の組み合わせに戻る（並びは変えないので別のバッチになる）
+    const std::vector<RenderItem> items = {
+        { MeshAt(0), MaterialAt(0), UniqueMatrix(0) },
+        { MeshAt(0), MaterialAt(0), UniqueMatrix(1) },
+        { MeshAt(1), MaterialAt(0), UniqueMatrix(2) },
+        { MeshAt(1), MaterialAt(1), UniqueMatrix(3) },
+        { MeshAt(1), MaterialAt(1), UniqueMatrix(4) },
+        { MeshAt(1), MaterialAt(1), UniqueMatrix(5) },
+        { MeshAt(0), MaterialAt(0), UniqueMatrix(6) },
+    };
+
+    InstanceBatcher batcher;
+    batcher.Build(items);
+    const auto& batches = batcher.GetBatches();
+    UNO_CHECK_EQ(batches.size(), 4u);
+    if (batches.size() != 4u) return;
+
+    const uint32 expectedFirst[] = { 0, 2, 3, 6 };
+    const uint32 expectedCount[] = { 2, 1, 3, 1 };
+    const int expectedMesh[] = { 0, 1, 1, 0 };
+    const int expectedMaterial[] = { 0, 0, 1, 0 };
+    for (size_t i = 0; i < batches.size(); ++i) {
+        UNO_CHECK_EQ(batches[i].firstInstance, expectedFirst[i]);
+        UNO_CHECK_EQ(batches[i].instanceCount, expectedCount[i]);
+        UNO_CHECK(batches[i].mesh == MeshAt(expectedMesh[i]));
+        UNO_CHECK(batches[i].material == MaterialAt(expectedMaterial[i]));
+    }
+    UNO_CHECK_EQ(batcher.GetInstances().size(), items.size());
+}
+
+UNO_TEST(ItemsWithoutMeshOrMaterialAreSkipped) {
+    const std::vector<RenderItem> items = {
+        { nullptr, MaterialAt(0), UniqueMatrix(0) },
+        { MeshAt(0), MaterialAt(0), UniqueMatrix(1) },
+        { MeshAt(0), nullptr, UniqueMatrix(2) },
+        { MeshAt(0), MaterialAt(0), UniqueMatrix(3) },
+        { nullptr, nullptr, UniqueMatrix(4) },
+    };
+
+    InstanceBatcher batcher;
+    batcher.Build(items);
+    const auto& batches = batcher.GetBatches();
+    // 飛ばしたアイテムをはさむと同じ組み合わせでも別のバッチになり、インスタンスは詰めて並ぶ
+    UNO_CHECK_EQ(batches.size(), 2u);
+    UNO_CHECK_EQ(batcher.GetInstances().size(), 2u);
+    if (batches.size() != 2u || batcher.GetInstances().size() != 2u) return;
+
+    UNO_CHECK_EQ(batches[0].firstInstance, 0u);
+    UNO_CHECK_EQ(batches[0].instanceCount, 1u);
+    UNO_CHECK_EQ(batches[1].firstInstance, 1u);
+    UNO_CHECK_EQ(batches[1].instanceCount, 1u);
+    UNO_CHECK(IsTransposeOf(batcher.GetInstances()[0], items[1].worldMatrix));
+    UNO_CHECK(IsTransposeOf(batcher.GetInstances()[1], items[3].worldMatrix));
+}
+
+UNO_TEST(InstanceWorldIsTransposedItemMatrix) {
+    // RenderItemの並びをストライドで辿って転置しているため、長い範囲・複数のバッチで要素ごとに確かめる
+    std::vector<RenderItem> items;
+    for (int i = 0; i < 37; ++i) {
+        items.emplace_back(MeshAt(i / 10), MaterialAt(0), UniqueMatrix(i));
+    }
+
+    InstanceBatcher batcher;
+    batcher.Build(items);
+    UNO_CHECK_EQ(batcher.GetBatches().size(), 4u);
+    UNO_CHECK_EQ(batcher.GetInstances().size(), items.size());
+
+    uint32 mismatches = 0;
+    for (const InstanceBatch& batch : batcher.GetBatches()) {
+        for (uint32 i = 0; i < batch.instanceCount; ++i) {
+            const uint32 index = batch.firstInstance + i;
+            if (!IsTransposeOf(batcher.GetInstances()[index], items[index].worldMatrix)) ++mismatches;
+        }
+    }
+    UNO_CHECK_EQ(mismatches, 0u);
+}
+
+UNO_TEST(RebuildReplacesPreviousResult) {
+    InstanceBatcher batcher;
+    std::vector<RenderItem> items(8, RenderItem(MeshAt(0), MaterialAt(0), UniqueMatrix(1)));
+    batcher.Build(items);
+
+    items.resize(3);
+    items[1].mesh = MeshAt(1);
+    batcher.Build(items);
+    UNO_CHECK_EQ(batcher.GetBatches().size(), 3u);
+    UNO_CHECK_EQ(batcher.GetInstances().size(), 3u);
+
+    batcher.Clear();
+    UNO_CHECK(batcher.GetBatches().empty());
+    UNO_CHECK(batcher.GetInstances().empty());
+}
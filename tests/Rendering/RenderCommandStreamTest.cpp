@@ -0,0 +1,217 @@
+#include "../TestFramework.h"
+#include "Engine/Rendering/RenderCommand.h"
+#include "Engine/Rendering/RecordingCommandBackend.h"
+#include <cstdint>
+#include <vector>
+
+// RenderCommandStreamの重複除去とRecordingCommandBackendの集計を、デバイス無しで確かめる
+
+using namespace UnoEngine;
+
+namespace {
+
+// Renderer::RenderMeshes と同じ順序・ルートパラメータ番号で積むためのバッチ
+// アドレスはメッシュ・マテリアル番号から作った架空の値
+struct TestBatch {
+    uint32 mesh;
+    uint32 material;
+    uint32 instanceCount;
+};
+
+constexpr uint64 LIGHT_CB_ADDRESS = 0x1000;
+constexpr uint64 VIEW_CB_ADDRESS = 0x2000;
+constexpr uint64 INSTANCE_BUFFER_ADDRESS = 0x100000;
+constexpr uint32 VIEW_CB_SIZE = 3 * 64;
+constexpr uint32 INSTANCE_SIZE = 64;
+constexpr uint32 MATERIAL_CB_SIZE = 32;
+constexpr uint32 INDEX_COUNT_PER_MESH = 36;
+
+uint64 VertexBufferAddress(uint32 mesh) { return 0x10000000ull + mesh * 0x10000ull; }
+uint64 IndexBufferAddress(uint32 mesh) { return 0x20000000ull + mesh * 0x10000ull; }
+uint64 MaterialSrvHandle(uint32 material) { return 0x30000000ull + material * 0x40ull; }
+uint64 MaterialCbAddress(uint32 material) { return 0x40000000ull + material * 0x100ull; }
+
+void RecordBatches(RenderCommandStream& stream, const std::vector<TestBatch>& batches) {
+    stream.Reset();
+    stream.SetPipeline(RenderPipeline::StaticMesh);
+    stream.SetConstantBuffer(2, LIGHT_CB_ADDRESS);
+    stream.SetConstantBuffer(0, VIEW_CB_ADDRESS);
+    stream.AddUploadedBytes(VIEW_CB_SIZE);
+
+    uint32 totalInstances = 0;
+    for (const TestBatch& batch : batches) totalInstances += batch.instanceCount;
+    stream.AddUploadedBytes(static_cast<uint64>(totalInstances) * INSTANCE_SIZE);
+
+    uint32 firstInstance = 0;
+    uint32 boundMaterial = UINT32_MAX;
+    for (const TestBatch& batch : batches) {
+        stream.SetShaderResource(4, INSTANCE_BUFFER_ADDRESS + firstInstance * INSTANCE_SIZE);
+
+        if (batch.material != boundMaterial) {
+            stream.SetDescriptorTable(1, MaterialSrvHandle(batch.material));
+            stream.SetConstantBuffer(3, MaterialCbAddress(batch.material));
+            stream.AddUploadedBytes(MATERIAL_CB_SIZE);
+            boundMaterial = batch.material;
+        }
+
+        stream.SetVertexBuffer(VertexBufferAddress(batch.mesh), 0x8000, 48);
+        stream.SetIndexBuffer(IndexBufferAddress(batch.mesh), INDEX_COUNT_PER_MESH * 4, IndexFormat::UInt32);
+        stream.DrawIndexed(INDEX_COUNT_PER_MESH, batch.instanceCount);
+        firstInstance += batch.instanceCount;
+    }
+}
+
+uint32 CountCommands(const RenderCommandStream& stream, RenderCommandType type) {
+    uint32 count = 0;
+    for (const RenderCommand& command : stream.GetCommands()) {
+        if (command.type == type) ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+UNO_TEST(KnownBatchListProducesExpectedCommands) {
+    // 描画キー順に並んだ4バッチ: メッシュBが2回続き、マテリアルは1回だけ切り替わる
+    const std::vector<TestBatch> batches = {
+        { 0, 0, 10 },
+        { 1, 0, 5 },
+        { 1, 1, 1 },
+        { 0, 1, 4 },
+    };
+
+    RenderCommandStream stream;
+    RecordBatches(stream, batches);
+
+    // パイプライン1 + ライト・ビュー2 + インスタンスSRV4 + マテリアル(テーブル+CB)2組 + VB/IB3組 + 描画4
+    UNO_CHECK_EQ(stream.GetCommands().size(), 1u + 2u + 4u + 4u + 6u + 4u);
+    UNO_CHECK_EQ(CountCommands(stream, RenderCommandType::SetPipeline), 1u);
+    UNO_CHECK_EQ(CountCommands(stream, RenderCommandType::SetShaderResource), 4u);
+    UNO_CHECK_EQ(CountCommands(stream, RenderCommandType::SetDescriptorTable), 2u);
+    UNO_CHECK_EQ(CountCommands(stream, RenderCommandType::SetVertexBuffer), 3u);
+    UNO_CHECK_EQ(CountCommands(stream, RenderCommandType::SetIndexBuffer), 3u);
+    UNO_CHECK_EQ(CountCommands(stream, RenderCommandType::DrawIndexed), 4u);
+
+    // 3バッチ目はメッシュが同じなのでVB・IBの設定が省かれる
+    UNO_CHECK_EQ(stream.GetRedundantCount(), 2u);
+    UNO_CHECK_EQ(stream.GetUploadedBytes(), VIEW_CB_SIZE + 20ull * INSTANCE_SIZE + 2ull * MATERIAL_CB_SIZE);
+
+    // 描画コマンドはバッチの順番・インスタンス数のまま
+    std::vector<uint32> instanceCounts;
+    for (const RenderCommand& command : stream.GetCommands()) {
+        if (command.type == RenderCommandType::DrawIndexed) {
+            UNO_CHECK_EQ(command.draw.indexCount, INDEX_COUNT_PER_MESH);
+            instanceCounts.push_back(command.draw.instanceCount);
+        }
+    }
+    UNO_CHECK(instanceCounts == std::vector<uint32>({ 10, 5, 1, 4 }));
+}
+
+UNO_TEST(RecordingBackendAccumulatesStats) {
+    const std::vector<TestBatch> batches = {
+        { 0, 0, 10 },
+        { 1, 0, 5 },
+        { 1, 1, 1 },
+        { 0, 1, 4 },
+    };
+
+    RenderCommandStream stream;
+    RecordBatches(stream, batches);
+
+    RecordingCommandBackend backend;
+    backend.SetKeepCommands(true);
+    backend.Execute(stream);
+
+    const RenderCommandStats& stats = backend.GetStats();
+    UNO_CHECK_EQ(stats.pipelineChanges, 1u);
+    UNO_CHECK_EQ(stats.bindingChanges, 2u + 4u + 4u);
+    UNO_CHECK_EQ(stats.vertexBufferChanges, 3u);
+    UNO_CHECK_EQ(stats.indexBufferChanges, 3u);
+    UNO_CHECK_EQ(stats.drawCalls, 4u);
+    UNO_CHECK_EQ(stats.instances, 20u);
+    UNO_CHECK_EQ(stats.indices, 20ull * INDEX_COUNT_PER_MESH);
+    UNO_CHECK_EQ(stats.uploadedBytes, stream.GetUploadedBytes());
+    UNO_CHECK_EQ(stats.redundantStateChanges, 2u);
+    UNO_CHECK_EQ(stats.GetStateChanges(), 1u + 10u + 3u + 3u);
+    UNO_CHECK_EQ(backend.GetCommands().size(), stream.GetCommands().size());
+
+    // 同じストリームをもう一度実行すると加算される
+    backend.Execute(stream);
+    UNO_CHECK_EQ(backend.GetStats().drawCalls, 8u);
+    UNO_CHECK_EQ(backend.GetStats().redundantStateChanges, 4u);
+    UNO_CHECK_EQ(backend.GetCommands().size(), stream.GetCommands().size() * 2);
+
+    backend.Reset();
+    UNO_CHECK_EQ(backend.GetStats().drawCalls, 0u);
+    UNO_CHECK(backend.GetCommands().empty());
+}
+
+UNO_TEST(PipelineSwitchInvalidatesRootSlots) {
+    RenderCommandStream stream;
+    stream.SetPipeline(RenderPipeline::StaticMesh);
+    stream.SetConstantBuffer(0, 0x100);
+    stream.SetDescriptorTable(1, 0x200);
+    stream.SetVertexBuffer(0x1000, 256, 32);
+    stream.SetConstantBuffer(0, 0x100);  // 重複
+    UNO_CHECK_EQ(stream.GetCommands().size(), 4u);
+    UNO_CHECK_EQ(stream.GetRedundantCount(), 1u);
+
+    // ルートシグネチャが変わるので同じ値でも設定し直す
+    stream.SetPipeline(RenderPipeline::SkinnedMesh);
+    stream.SetConstantBuffer(0, 0x100);
+    stream.SetDescriptorTable(1, 0x200);
+    UNO_CHECK_EQ(stream.GetCommands().size(), 7u);
+    UNO_CHECK_EQ(stream.GetRedundantCount(), 1u);
+
+    // 頂点バッファはルートパラメータではないのでパイプラインを切り替えても有効なまま
+    stream.SetVertexBuffer(0x1000, 256, 32);
+    UNO_CHECK_EQ(stream.GetCommands().size(), 7u);
+    UNO_CHECK_EQ(stream.GetRedundantCount(), 2u);
+
+    // 同じパイプラインの再設定は省かれ、設定済みのスロットも無効にならない
+    stream.SetPipeline(RenderPipeline::SkinnedMesh);
+    stream.SetConstantBuffer(0, 0x100);
+    UNO_CHECK_EQ(stream.GetCommands().size(), 7u);
+    UNO_CHECK_EQ(stream.GetRedundantCount(), 4u);
+
+    UNO_CHECK(stream.GetCommands()[4].type == RenderCommandType::SetPipeline);
+    UNO_CHECK_EQ(stream.GetCommands()[4].pipeline.id, RenderPipeline::SkinnedMesh);
+}
+
+UNO_TEST(SameSlotDifferentBindingTypeIsNotRedundant) {
+    RenderCommandStream stream;
+    stream.SetPipeline(RenderPipeline::StaticMesh);
+    stream.SetConstantBuffer(4, 0x100);
+    stream.SetShaderResource(4, 0x100);
+    UNO_CHECK_EQ(stream.GetCommands().size(), 3u);
+    UNO_CHECK_EQ(stream.GetRedundantCount(), 0u);
+}
+
+UNO_TEST(ResetClearsCommandsAndBoundState) {
+    RenderCommandStream stream;
+    stream.SetPipeline(RenderPipeline::StaticMesh);
+    stream.SetConstantBuffer(0, 0x100);
+    stream.SetConstantBuffer(0, 0x100);
+    stream.AddUploadedBytes(128);
+
+    stream.Reset();
+    UNO_CHECK(stream.GetCommands().empty());
+    UNO_CHECK_EQ(stream.GetRedundantCount(), 0u);
+    UNO_CHECK_EQ(stream.GetUploadedBytes(), 0u);
+
+    // 前のフレームの状態を引き継がないので、同じ値でもコマンドが積まれる
+    stream.SetPipeline(RenderPipeline::StaticMesh);
+    stream.SetConstantBuffer(0, 0x100);
+    UNO_CHECK_EQ(stream.GetCommands().size(), 2u);
+    UNO_CHECK_EQ(stream.GetRedundantCount(), 0u);
+}
+
+UNO_TEST(EmptyDrawIsDropped) {
+    RenderCommandStream stream;
+    stream.SetPipeline(RenderPipeline::StaticMesh);
+    stream.SetVertexBuffer(0x1000, 256, 32);
+    stream.SetIndexBuffer(0x2000, 72, IndexFormat::UInt16);
+    stream.DrawIndexed(36, 0);
+    stream.DrawIndexed(0, 1);
+    UNO_CHECK_EQ(CountCommands(stream, RenderCommandType::DrawIndexed), 0u);
+}
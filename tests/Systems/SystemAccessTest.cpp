@@ -0,0 +1,131 @@
+#include "../TestFramework.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Systems/SystemAccess.h"
+#include <atomic>
+#include <thread>
+
+// SystemAccessの宣言チェック（デバッグビルドのみ）を確かめる
+//   - 読み取り（const付きの型）と書き込みを別々に照らし合わせる
+//   - システムが投入したジョブは、どのスレッドで実行されても投入したシステムの宣言で検査される
+//   - Waitの中で盗んだジョブには、待っているシステムの宣言が引き継がれない
+// このテストは_DEBUGを定義したJobSystem/SystemAccessとリンクする（不一致はassertせずfalseで確かめる）
+
+using namespace UnoEngine;
+
+namespace {
+
+struct ReadOnlyComponent {};
+struct WrittenComponent {};
+struct UndeclaredComponent {};
+
+SystemAccess MakeAccess() {
+    SystemAccess access;
+    access.Read<ReadOnlyComponent>().Write<WrittenComponent>();
+    return access;
+}
+
+// 宣言どおりの結果になるか（ReadOnlyは読み取りのみ、Writtenは読み書き、Undeclaredは不可）
+bool MatchesDeclaration() {
+    return SystemAccess::ValidateComponentAccess<const ReadOnlyComponent>() &&
+           !SystemAccess::ValidateComponentAccess<ReadOnlyComponent>() &&
+           SystemAccess::ValidateComponentAccess<const WrittenComponent>() &&
+           SystemAccess::ValidateComponentAccess<WrittenComponent>() &&
+           !SystemAccess::ValidateComponentAccess<const UndeclaredComponent>() &&
+           !SystemAccess::ValidateComponentAccess<UndeclaredComponent>();
+}
+
+// システム実行中でない（何でも許可される）か
+bool Unrestricted() {
+    return SystemAccess::GetCurrentValidation().access == nullptr &&
+           SystemAccess::ValidateComponentAccess<UndeclaredComponent>();
+}
+
+} // namespace
+
+UNO_TEST(ReadAndWriteAreCheckedSeparately) {
+    UNO_CHECK(Unrestricted());
+
+    const SystemAccess access = MakeAccess();
+    {
+        SystemAccess::ValidationScope scope(access, "TestSystem");
+        UNO_CHECK(MatchesDeclaration());
+    }
+    UNO_CHECK(Unrestricted());
+
+    SystemAccess exclusive;
+    exclusive.Exclusive();
+    SystemAccess::ValidationScope scope(exclusive, "ExclusiveSystem");
+    UNO_CHECK(SystemAccess::ValidateComponentAccess<UndeclaredComponent>());
+}
+
+UNO_TEST(JobsRunUnderSubmittingSystem) {
+    const SystemAccess access = MakeAccess();
+    for (uint32 workerCount : { 0u, 1u, 3u }) {
+        JobSystem jobs;
+        jobs.Initialize(workerCount);
+
+        std::atomic<int> mismatches{ 0 };
+        {
+            SystemAccess::ValidationScope scope(access, "TestSystem");
+
+            // ParallelForのチャンクはワーカー・呼び出しスレッドのどちらで実行されてもシステムの宣言で検査される
+            jobs.ParallelFor(256, 1, [&mismatches](uint32, uint32) {
+                if (!MatchesDeclaration()) mismatches.fetch_add(1);
+                std::this_thread::yield();
+            });
+
+            JobCounter counter;
+            for (int i = 0; i < 64; ++i) {
+                jobs.Run([&mismatches] {
+                    if (!MatchesDeclaration()) mismatches.fetch_add(1);
+                }, &counter);
+            }
+            jobs.Wait(counter);
+        }
+        UNO_CHECK_EQ(mismatches.load(), 0);
+
+        // システムの外から投入したジョブは検査されない
+        JobCounter counter;
+        jobs.Run([&mismatches] {
+            if (!Unrestricted()) mismatches.fetch_add(1);
+        }, &counter);
+        jobs.Wait(counter);
+        UNO_CHECK_EQ(mismatches.load(), 0);
+    }
+}
+
+UNO_TEST(StolenJobDoesNotInheritWaitingSystem) {
+    JobSystem jobs;
+    jobs.Initialize(1);
+
+    // ワーカーを塞いでおき、システムの外から投入したジョブを呼び出しスレッドのWaitで実行させる
+    std::atomic<bool> blockerStarted{ false };
+    std::atomic<bool> releaseBlocker{ false };
+    JobCounter blocker;
+    jobs.Run([&] {
+        blockerStarted = true;
+        while (!releaseBlocker) std::this_thread::yield();
+    }, &blocker);
+    while (!blockerStarted) std::this_thread::yield();
+
+    bool ranUnrestricted = false;
+    std::thread::id executedOn;
+    JobCounter outside;
+    jobs.Run([&] {
+        ranUnrestricted = Unrestricted();
+        executedOn = std::this_thread::get_id();
+    }, &outside);
+
+    const SystemAccess access = MakeAccess();
+    {
+        SystemAccess::ValidationScope scope(access, "WaitingSystem");
+        jobs.Wait(outside);
+        // 盗んだジョブが終わったら、待っていたシステムの宣言に戻る
+        UNO_CHECK(MatchesDeclaration());
+    }
+    UNO_CHECK(executedOn == std::this_thread::get_id());
+    UNO_CHECK(ranUnrestricted);
+
+    releaseBlocker = true;
+    jobs.Wait(blocker);
+}
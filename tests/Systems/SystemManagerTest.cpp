@@ -0,0 +1,153 @@
+#include "../TestFramework.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Systems/SystemManager.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// SystemManagerのウェーブ実行で、MainThread()を宣言したシステムが必ず呼び出しスレッドで実行されること、
+// OnMainThreadUpdateが全システムのOnUpdateの後に呼び出しスレッドで優先度順に呼ばれることを確かめる
+
+using namespace UnoEngine;
+
+namespace {
+
+// 宣言の衝突しない（何も書き込まない）システム。実行したスレッドを記録する
+template<int Index>
+class RecordingSystem : public ISystem {
+public:
+    explicit RecordingSystem(bool mainThread) : mainThread_(mainThread) {}
+
+    void OnUpdate(Scene*, float) override {
+        threadId_ = std::this_thread::get_id();
+        ++updateCount_;
+        // 他のシステムのジョブがワーカーに取られるよう少し時間をかける
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    void DeclareAccess(SystemAccess& access) const override {
+        if (mainThread_) access.MainThread();
+    }
+
+    std::thread::id GetThreadId() const { return threadId_; }
+    int GetUpdateCount() const { return updateCount_; }
+
+private:
+    bool mainThread_;
+    std::thread::id threadId_;
+    int updateCount_ = 0;
+};
+
+// ワーカーで実行されるシステム。OnUpdateの終わった数と、OnMainThreadUpdateが呼ばれたときの様子を記録する
+class PostUpdateSystem : public ISystem {
+public:
+    PostUpdateSystem(int priority, std::atomic<int>& finishedUpdates, std::vector<int>& postUpdateOrder)
+        : priority_(priority), finishedUpdates_(finishedUpdates), postUpdateOrder_(postUpdateOrder) {}
+
+    void OnUpdate(Scene*, float) override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        finishedUpdates_.fetch_add(1);
+    }
+
+    void OnMainThreadUpdate(Scene*) override {
+        threadId_ = std::this_thread::get_id();
+        finishedUpdatesSeen_ = finishedUpdates_.load();
+        postUpdateOrder_.push_back(priority_);
+    }
+
+    // 宣言の衝突しないシステム同士（同じウェーブでジョブとして実行される）
+    void DeclareAccess(SystemAccess&) const override {}
+    int GetPriority() const override { return priority_; }
+
+    std::thread::id GetThreadId() const { return threadId_; }
+    int GetFinishedUpdatesSeen() const { return finishedUpdatesSeen_; }
+
+private:
+    int priority_;
+    std::atomic<int>& finishedUpdates_;
+    std::vector<int>& postUpdateOrder_;
+    std::thread::id threadId_;
+    int finishedUpdatesSeen_ = 0;
+};
+
+} // namespace
+
+UNO_TEST(MainThreadSystemsRunOnCaller) {
+    JobSystem jobSystem;
+    jobSystem.Initialize(3);
+
+    SystemManager manager;
+    manager.SetJobSystem(&jobSystem);
+    auto* worker0 = manager.RegisterSystem<RecordingSystem<0>>(false);
+    auto* main0 = manager.RegisterSystem<RecordingSystem<1>>(true);
+    auto* worker1 = manager.RegisterSystem<RecordingSystem<2>>(false);
+    auto* main1 = manager.RegisterSystem<RecordingSystem<3>>(true);
+
+    const std::thread::id callerId = std::this_thread::get_id();
+    int mainThreadMisses = 0;
+    for (int frame = 0; frame < 50; ++frame) {
+        manager.Update(nullptr, 1.0f / 60.0f);
+        if (main0->GetThreadId() != callerId) ++mainThreadMisses;
+        if (main1->GetThreadId() != callerId) ++mainThreadMisses;
+    }
+    UNO_CHECK_EQ(mainThreadMisses, 0);
+
+    // 全システムが毎フレーム1回ずつ実行されている
+    UNO_CHECK_EQ(worker0->GetUpdateCount(), 50);
+    UNO_CHECK_EQ(worker1->GetUpdateCount(), 50);
+    UNO_CHECK_EQ(main0->GetUpdateCount(), 50);
+    UNO_CHECK_EQ(main1->GetUpdateCount(), 50);
+
+    jobSystem.Shutdown();
+}
+
+UNO_TEST(MainThreadDeclarationDoesNotSerializeWave) {
+    SystemAccess mainThread;
+    mainThread.MainThread();
+    SystemAccess other;
+    UNO_CHECK(!mainThread.ConflictsWith(other));
+    UNO_CHECK(mainThread.IsMainThread());
+
+    mainThread.Clear();
+    UNO_CHECK(!mainThread.IsMainThread());
+}
+
+UNO_TEST(MainThreadUpdateRunsOnCallerAfterAllSystems) {
+    JobSystem jobSystem;
+    jobSystem.Initialize(3);
+
+    std::atomic<int> finishedUpdates{ 0 };
+    std::vector<int> postUpdateOrder;
+
+    SystemManager manager;
+    manager.SetJobSystem(&jobSystem);
+    // 登録順と優先度順を変えておく
+    auto* late = manager.RegisterSystem<PostUpdateSystem>(30, finishedUpdates, postUpdateOrder);
+    auto* early = manager.RegisterSystem<PostUpdateSystem>(10, finishedUpdates, postUpdateOrder);
+    auto* middle = manager.RegisterSystem<PostUpdateSystem>(20, finishedUpdates, postUpdateOrder);
+    auto* disabled = manager.RegisterSystem<PostUpdateSystem>(40, finishedUpdates, postUpdateOrder);
+    disabled->SetEnabled(false);
+
+    const std::thread::id callerId = std::this_thread::get_id();
+    for (int frame = 1; frame <= 20; ++frame) {
+        postUpdateOrder.clear();
+        manager.Update(nullptr, 1.0f / 60.0f);
+
+        UNO_CHECK(early->GetThreadId() == callerId);
+        UNO_CHECK(middle->GetThreadId() == callerId);
+        UNO_CHECK(late->GetThreadId() == callerId);
+
+        // 最初に呼ばれた時点で、このフレームの全システムのOnUpdateが終わっている
+        UNO_CHECK_EQ(early->GetFinishedUpdatesSeen(), frame * 3);
+
+        UNO_CHECK_EQ(postUpdateOrder.size(), size_t(3));
+        if (postUpdateOrder.size() == 3) {
+            UNO_CHECK_EQ(postUpdateOrder[0], 10);
+            UNO_CHECK_EQ(postUpdateOrder[1], 20);
+            UNO_CHECK_EQ(postUpdateOrder[2], 30);
+        }
+    }
+
+    jobSystem.Shutdown();
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// 外部ライブラリを使わない最小限のテストランナー
+// UNO_TEST で登録した関数をTestMain.cppのmainが順に実行し、失敗したCHECKの数を終了コードにする
+//
+//   UNO_TEST(MatrixMultiplyMatchesScalar) {
+//       UNO_CHECK(a == b);
+//       UNO_CHECK_NEAR(x, y, 1e-5f);
+//   }
+
+namespace UnoEngine {
+namespace Test {
+
+struct TestCase {
+    const char* name;
+    void (*function)();
+};
+
+inline std::vector<TestCase>& GetRegistry() {
+    static std::vector<TestCase> registry;
+    return registry;
+}
+
+inline int& GetFailureCount() {
+    static int failureCount = 0;
+    return failureCount;
+}
+
+struct Registrar {
+    Registrar(const char* name, void (*function)()) { GetRegistry().push_back({ name, function }); }
+};
+
+inline void ReportFailure(const char* file, int line, const char* expression) {
+    ++GetFailureCount();
+    std::printf("  %s:%d: CHECK failed: %s\n", file, line, expression);
+}
+
+// 全テストを実行し、失敗したCHECKの数を返す
+inline int RunAll() {
+    int failedTests = 0;
+    for (const TestCase& test : GetRegistry()) {
+        const int before = GetFailureCount();
+        test.function();
+        const bool passed = GetFailureCount() == before;
+        std::printf("[%s] %s\n", passed ? "  OK  " : " FAIL ", test.name);
+        if (!passed) ++failedTests;
+    }
+    std::printf("%zu tests, %d failed\n", GetRegistry().size(), failedTests);
+    return GetFailureCount();
+}
+
+} // namespace Test
+} // namespace UnoEngine
+
+#define UNO_TEST(name)                                                              \
+    static void name();                                                             \
+    static ::UnoEngine::Test::Registrar name##Registrar(#name, &name);              \
+    static void name()
+
+#define UNO_CHECK(condition)                                                        \
+    do {                                                                            \
+        if (!(condition)) ::UnoEngine::Test::ReportFailure(__FILE__, __LINE__, #condition); \
+    } while (0)
+
+#define UNO_CHECK_EQ(actual, expected) UNO_CHECK((actual) == (expected))
+
+#define UNO_CHECK_NEAR(actual, expected, tolerance) \
+    UNO_CHECK(std::fabs(static_cast<double>(actual) - static_cast<double>(expected)) <= (tolerance))
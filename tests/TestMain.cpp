@@ -0,0 +1,5 @@
+#include "TestFramework.h"
+
+int main() {
+    return UnoEngine::Test::RunAll() == 0 ? 0 : 1;
+}
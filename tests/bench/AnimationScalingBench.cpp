@@ -0,0 +1,182 @@
+#include "Engine/Animation/AnimatorComponent.h"
+#include "Engine/Animation/CompressedAnimation.h"
+#include "Engine/Core/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// AnimationSystemの並列更新（Animatorごとのジョブ）がコア数に応じてどれだけ速くなるかを測る（ctestでは実行しない）
+// 1スレッドの直列ループと、ワーカー数を変えたJobSystem::ParallelForで同じ更新を行い、1フレームあたりの時間を比べる
+//
+//   ./AnimationScalingBench [Animator数=1000] [フレーム数=200]
+//
+// glTFの読み込み（assimp）はWindows向けのビルドにしか無いため、walk.gltfと同じ65本のボーン階層と
+// 同じ長さ・キー数のクリップをここで生成して使う
+
+using namespace UnoEngine;
+
+namespace {
+
+// walk.gltf（Mixamo）のボーン階層：背骨・首・頭、左右の腕と指4本×5、左右の脚
+constexpr int32 WALK_BONE_PARENTS[] = {
+    -1, 0, 1, 2, 3, 4, 5,                                                // Hips〜HeadTop_End
+    3, 7, 8, 9, 10, 11, 12, 13, 10, 15, 16, 17, 10, 19, 20, 21,         // 左腕・親指・人差し指・中指
+    10, 23, 24, 25, 10, 27, 28, 29,                                      // 左薬指・小指
+    3, 31, 32, 33, 34, 35, 36, 37, 34, 39, 40, 41, 34, 43, 44, 45,      // 右腕・親指・人差し指・中指
+    34, 47, 48, 49, 34, 51, 52, 53,                                      // 右薬指・小指
+    0, 55, 56, 57, 58,                                                   // 左脚
+    0, 60, 61, 62, 63,                                                   // 右脚
+};
+constexpr uint32 BONE_COUNT = sizeof(WALK_BONE_PARENTS) / sizeof(WALK_BONE_PARENTS[0]);
+static_assert(BONE_COUNT == 65, "walk.gltf has 65 bones");
+
+// walk.gltfのクリップと同じ長さ（1000 ticks/秒で約1.03秒）とキー数
+constexpr float CLIP_DURATION_TICKS = 1033.33f;
+constexpr float TICKS_PER_SECOND = 1000.0f;
+constexpr uint32 KEYS_PER_CHANNEL = 62;
+
+constexpr float FRAME_DELTA = 1.0f / 60.0f;
+
+std::shared_ptr<Skeleton> CreateWalkSkeleton() {
+    auto skeleton = std::make_shared<Skeleton>();
+    for (uint32 i = 0; i < BONE_COUNT; ++i) {
+        const Matrix4x4 bindPose = Matrix4x4::Translation(0.0f, i == 0 ? 1.0f : 0.1f, 0.0f);
+        skeleton->AddBone("Bone" + std::to_string(i), WALK_BONE_PARENTS[i], Matrix4x4::Identity(), bindPose);
+    }
+    return skeleton;
+}
+
+// 全ボーンが回転し、腰だけが移動する1周期のクリップ
+std::shared_ptr<AnimationClip> CreateWalkClip(const Skeleton& skeleton) {
+    auto clip = std::make_shared<AnimationClip>();
+    clip->SetName("Walk");
+    clip->SetDuration(CLIP_DURATION_TICKS);
+    clip->SetTicksPerSecond(TICKS_PER_SECOND);
+
+    constexpr float TWO_PI = 6.28318530718f;
+    for (uint32 bone = 0; bone < BONE_COUNT; ++bone) {
+        BoneAnimation channel;
+        channel.boneName = skeleton.GetBone(static_cast<int32>(bone))->name;
+        const Vector3 axis = Vector3(std::sin(bone * 1.3f), std::cos(bone * 0.7f), 0.5f).Normalize();
+        const float amplitude = 0.2f + 0.3f * static_cast<float>(bone % 5) / 4.0f;
+
+        for (uint32 k = 0; k < KEYS_PER_CHANNEL; ++k) {
+            const float phase = static_cast<float>(k) / (KEYS_PER_CHANNEL - 1);
+            const float time = phase * CLIP_DURATION_TICKS;
+            const float angle = amplitude * std::sin(TWO_PI * phase + bone * 0.25f);
+            channel.rotationKeys.push_back({ time, Quaternion::RotationAxis(axis, angle) });
+
+            const Vector3 bindPosition(0.0f, bone == 0 ? 1.0f : 0.1f, 0.0f);
+            const Vector3 sway = bone == 0 ? Vector3(0.02f * std::sin(TWO_PI * phase), 0.03f * std::sin(2.0f * TWO_PI * phase), 0.0f)
+                                           : Vector3(0.0f, 0.0f, 0.0f);
+            channel.positionKeys.push_back({ time, bindPosition + sway });
+        }
+        channel.scaleKeys.push_back({ 0.0f, Vector3(1.0f, 1.0f, 1.0f) });
+        clip->AddBoneAnimation(channel);
+    }
+
+    clip->Compress(skeleton, AnimationCompressionSettings());
+    return clip;
+}
+
+std::vector<std::unique_ptr<AnimatorComponent>> CreateAnimators(uint32 count, const std::shared_ptr<Skeleton>& skeleton,
+                                                               const std::shared_ptr<AnimationClip>& clip) {
+    std::vector<std::unique_ptr<AnimatorComponent>> animators;
+    animators.reserve(count);
+    for (uint32 i = 0; i < count; ++i) {
+        auto animator = std::make_unique<AnimatorComponent>();
+        animator->Initialize(skeleton, { clip });
+        animator->Play("Walk");
+        // 全員が同じ時刻のポーズにならないよう再生位置をずらす
+        animator->UpdateAnimation(static_cast<float>(i % 97) * 0.01f);
+        animators.push_back(std::move(animator));
+    }
+    return animators;
+}
+
+// AnimationSystem::OnUpdateと同じ形で1フレーム分を更新する（jobSystemがnullptrなら直列）
+void UpdateFrame(std::vector<std::unique_ptr<AnimatorComponent>>& animators, JobSystem* jobSystem) {
+    const uint32 count = static_cast<uint32>(animators.size());
+    if (!jobSystem) {
+        for (auto& animator : animators) {
+            animator->UpdateAnimation(FRAME_DELTA, 1, 1.0f);
+        }
+        return;
+    }
+
+    const uint32 grainSize = (std::max)(1u, count / (jobSystem->GetThreadCount() * 4));
+    jobSystem->ParallelFor(count, grainSize, [&animators](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i) {
+            animators[i]->UpdateAnimation(FRAME_DELTA, 1, 1.0f);
+        }
+    });
+}
+
+// 直列で更新した結果とボーン行列がビット単位で一致しないAnimatorの数
+uint32 CountMismatches(const std::vector<std::unique_ptr<AnimatorComponent>>& expected,
+                       const std::vector<std::unique_ptr<AnimatorComponent>>& actual) {
+    uint32 mismatches = 0;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        const auto& a = expected[i]->GetBoneMatrixPairs();
+        const auto& b = actual[i]->GetBoneMatrixPairs();
+        if (a.size() != b.size() || std::memcmp(a.data(), b.data(), a.size() * sizeof(BoneMatrixPair)) != 0) {
+            ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const uint32 animatorCount = argc > 1 ? static_cast<uint32>(std::atoi(argv[1])) : 1000;
+    const uint32 frameCount = argc > 2 ? static_cast<uint32>(std::atoi(argv[2])) : 200;
+
+    const auto skeleton = CreateWalkSkeleton();
+    const auto clip = CreateWalkClip(*skeleton);
+
+    const uint32 hardwareThreads = (std::max)(1u, std::thread::hardware_concurrency());
+    std::printf("animators: %u, bones: %u, frames: %u, hardware threads: %u\n",
+                animatorCount, BONE_COUNT, frameCount, hardwareThreads);
+    std::printf("%8s %12s %9s %11s\n", "threads", "ms/frame", "speedup", "mismatches");
+
+    // 基準：ジョブシステムを使わない直列の更新
+    auto serial = CreateAnimators(animatorCount, skeleton, clip);
+    UpdateFrame(serial, nullptr);  // ウォームアップ
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 frame = 0; frame < frameCount; ++frame) {
+        UpdateFrame(serial, nullptr);
+    }
+    const double serialMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frameCount;
+    std::printf("%8s %12.3f %8.2fx %11s\n", "serial", serialMs, 1.0, "-");
+
+    // スレッド数（呼び出し元 + ワーカー）を2から2倍ずつ増やし、最後にハードウェアのスレッド数で測る
+    // （シングルコアの環境でもジョブに分けるオーバーヘッドが分かるよう、2スレッドは必ず測る）
+    std::vector<uint32> threadCounts;
+    for (uint32 threads = 2; threads < hardwareThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back((std::max)(hardwareThreads, 2u));
+
+    for (uint32 threads : threadCounts) {
+        JobSystem jobSystem;
+        jobSystem.Initialize(threads - 1);
+
+        auto animators = CreateAnimators(animatorCount, skeleton, clip);
+        UpdateFrame(animators, &jobSystem);
+        start = std::chrono::steady_clock::now();
+        for (uint32 frame = 0; frame < frameCount; ++frame) {
+            UpdateFrame(animators, &jobSystem);
+        }
+        const double ms =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frameCount;
+
+        std::printf("%8u %12.3f %8.2fx %11u\n", threads, ms, serialMs / ms, CountMismatches(serial, animators));
+        jobSystem.Shutdown();
+    }
+    return 0;
+}
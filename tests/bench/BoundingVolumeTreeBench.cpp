@@ -0,0 +1,194 @@
+#include "Engine/Math/BoundingVolumeTree.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// BoundingVolumeTreeの問い合わせと、全要素の線形走査の時間を比べる（ctestでは実行しない）
+// 1k/10k/100kの箱について、登録・Rebuild・移動のコストと、視錐台・箱・レイ・最近傍の1回あたりの時間を表示する
+// 結果が線形走査と異なる場合は終了コード1で終わる
+//
+//   ./BoundingVolumeTreeBench
+
+using namespace UnoEngine;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::mt19937 g_rng(1);
+
+float Uniform(float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(g_rng);
+}
+
+float DistanceSq(const BoundingBox& box, const Vector3& point) {
+    const Vector3 closest(std::clamp(point.GetX(), box.min.GetX(), box.max.GetX()),
+                          std::clamp(point.GetY(), box.min.GetY(), box.max.GetY()),
+                          std::clamp(point.GetZ(), box.min.GetZ(), box.max.GetZ()));
+    return (closest - point).LengthSq();
+}
+
+bool RunSize(uint32 count) {
+    // 密度が一定になるよう、要素数に応じて世界を広げる（高さ方向は薄い）
+    const float worldSize = std::cbrt(static_cast<float>(count)) * 10.0f;
+    std::vector<BoundingBox> boxes(count);
+    for (BoundingBox& box : boxes) {
+        const Vector3 center(Uniform(-worldSize, worldSize), Uniform(-worldSize, worldSize) * 0.2f, Uniform(-worldSize, worldSize));
+        const Vector3 extents(Uniform(0.2f, 2.0f), Uniform(0.2f, 2.0f), Uniform(0.2f, 2.0f));
+        box = BoundingBox(center - extents, center + extents);
+    }
+
+    BoundingVolumeTree tree;
+    std::vector<int32> proxies(count);
+    Clock::time_point start = Clock::now();
+    for (uint32 i = 0; i < count; ++i) proxies[i] = tree.CreateProxy(boxes[i], i);
+    const double insertMs = ElapsedMs(start);
+    const float insertCost = tree.ComputeCost();
+
+    start = Clock::now();
+    tree.Rebuild();
+    const double rebuildMs = ElapsedMs(start);
+    std::printf("N=%u: insert %.2f ms (cost %.1f), rebuild %.2f ms (cost %.1f, height %d)\n", count, insertMs,
+                insertCost, rebuildMs, tree.ComputeCost(), tree.GetHeight());
+
+    // 毎フレーム5%の箱が少し動く
+    constexpr int MOVE_FRAMES = 20;
+    uint32 reinserted = 0;
+    start = Clock::now();
+    for (int frame = 0; frame < MOVE_FRAMES; ++frame) {
+        for (uint32 k = 0; k < count / 20; ++k) {
+            const uint32 i = g_rng() % count;
+            const Vector3 delta(Uniform(-0.5f, 0.5f), 0.0f, Uniform(-0.5f, 0.5f));
+            boxes[i] = BoundingBox(boxes[i].min + delta, boxes[i].max + delta);
+            reinserted += tree.MoveProxy(proxies[i], boxes[i]) ? 1 : 0;
+        }
+    }
+    std::printf("  move   : %.3f ms/frame (%u of %u reinserted, cost %.1f)\n", ElapsedMs(start) / MOVE_FRAMES,
+                reinserted, count / 20 * MOVE_FRAMES, tree.ComputeCost());
+
+    bool matched = true;
+
+    // 視錐台
+    const Frustum frustum(Matrix4x4::LookAtLH(Vector3(0.0f, 5.0f, -worldSize), Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f)) *
+                          Matrix4x4::PerspectiveFovLH(1.0f, 16.0f / 9.0f, 0.1f, worldSize));
+    constexpr int FRUSTUM_QUERIES = 100;
+    size_t linearVisible = 0, treeVisible = 0;
+    start = Clock::now();
+    for (int query = 0; query < FRUSTUM_QUERIES; ++query) {
+        linearVisible = 0;
+        for (const BoundingBox& box : boxes) linearVisible += frustum.Intersects(box) ? 1 : 0;
+    }
+    const double linearFrustumMs = ElapsedMs(start) / FRUSTUM_QUERIES;
+    start = Clock::now();
+    for (int query = 0; query < FRUSTUM_QUERIES; ++query) {
+        treeVisible = 0;
+        tree.QueryFrustum(frustum, [&](int32 proxy) {
+            treeVisible += frustum.Intersects(boxes[tree.GetUserData(proxy)]) ? 1 : 0;
+            return true;
+        });
+    }
+    const double treeFrustumMs = ElapsedMs(start) / FRUSTUM_QUERIES;
+    std::printf("  frustum: linear %8.4f ms, bvh %8.4f ms (x%.1f), visible %zu\n", linearFrustumMs, treeFrustumMs,
+                linearFrustumMs / treeFrustumMs, treeVisible);
+    matched &= linearVisible == treeVisible;
+
+    // 箱・レイ・最近傍は同じ1000個の問い合わせで比べる
+    constexpr int QUERIES = 1000;
+    std::vector<BoundingBox> overlapQueries(QUERIES);
+    std::vector<Vector3> rayOrigins(QUERIES), rayDirections(QUERIES), points(QUERIES);
+    for (int query = 0; query < QUERIES; ++query) {
+        const Vector3 center(Uniform(-worldSize, worldSize), 0.0f, Uniform(-worldSize, worldSize));
+        overlapQueries[query] = BoundingBox(center - Vector3(3.0f, 3.0f, 3.0f), center + Vector3(3.0f, 3.0f, 3.0f));
+        rayOrigins[query] = Vector3(Uniform(-worldSize, worldSize), Uniform(-worldSize, worldSize) * 0.2f, -worldSize * 1.5f);
+        rayDirections[query] = Vector3(Uniform(-0.3f, 0.3f), Uniform(-0.1f, 0.1f), 1.0f).Normalize();
+        points[query] = Vector3(Uniform(-worldSize, worldSize), 0.0f, Uniform(-worldSize, worldSize));
+    }
+
+    size_t linearHits = 0, treeHits = 0;
+    start = Clock::now();
+    for (const BoundingBox& query : overlapQueries) {
+        for (const BoundingBox& box : boxes) linearHits += box.Intersects(query) ? 1 : 0;
+    }
+    const double linearOverlapMs = ElapsedMs(start) / QUERIES;
+    start = Clock::now();
+    for (const BoundingBox& query : overlapQueries) {
+        tree.QueryOverlap(query, [&](int32 proxy) {
+            treeHits += boxes[tree.GetUserData(proxy)].Intersects(query) ? 1 : 0;
+            return true;
+        });
+    }
+    const double treeOverlapMs = ElapsedMs(start) / QUERIES;
+    std::printf("  overlap: linear %8.4f ms, bvh %8.4f ms (x%.1f), hits %zu\n", linearOverlapMs, treeOverlapMs,
+                linearOverlapMs / treeOverlapMs, treeHits);
+    matched &= linearHits == treeHits;
+
+    const float maxDistance = worldSize * 4.0f;
+    std::vector<float> linearRay(QUERIES, maxDistance), treeRay(QUERIES, maxDistance);
+    start = Clock::now();
+    for (int query = 0; query < QUERIES; ++query) {
+        for (const BoundingBox& box : boxes) {
+            float tMin, tMax;
+            if (box.IntersectsRay(rayOrigins[query], rayDirections[query], tMin, tMax) && tMin < linearRay[query]) {
+                linearRay[query] = tMin;
+            }
+        }
+    }
+    const double linearRayMs = ElapsedMs(start) / QUERIES;
+    start = Clock::now();
+    for (int query = 0; query < QUERIES; ++query) {
+        tree.RayCast(rayOrigins[query], rayDirections[query], maxDistance, [&](int32 proxy, float currentMax) {
+            float tMin, tMax;
+            if (!boxes[tree.GetUserData(proxy)].IntersectsRay(rayOrigins[query], rayDirections[query], tMin, tMax) ||
+                tMin >= currentMax) {
+                return currentMax;
+            }
+            treeRay[query] = tMin;
+            return tMin;
+        });
+    }
+    const double treeRayMs = ElapsedMs(start) / QUERIES;
+    int rayMismatches = 0;
+    for (int query = 0; query < QUERIES; ++query) {
+        if (std::abs(linearRay[query] - treeRay[query]) > 1e-4f) ++rayMismatches;
+    }
+    std::printf("  ray    : linear %8.4f ms, bvh %8.4f ms (x%.1f)\n", linearRayMs, treeRayMs, linearRayMs / treeRayMs);
+    matched &= rayMismatches == 0;
+
+    std::vector<float> linearNearest(QUERIES, std::numeric_limits<float>::infinity()), treeNearest(QUERIES, -1.0f);
+    start = Clock::now();
+    for (int query = 0; query < QUERIES; ++query) {
+        for (const BoundingBox& box : boxes) linearNearest[query] = (std::min)(linearNearest[query], DistanceSq(box, points[query]));
+    }
+    const double linearNearestMs = ElapsedMs(start) / QUERIES;
+    start = Clock::now();
+    for (int query = 0; query < QUERIES; ++query) {
+        const int32 proxy = tree.FindNearest(points[query], worldSize * 10.0f, [&](int32 candidate) {
+            return DistanceSq(boxes[tree.GetUserData(candidate)], points[query]);
+        });
+        if (proxy != BoundingVolumeTree::NULL_NODE) treeNearest[query] = DistanceSq(boxes[tree.GetUserData(proxy)], points[query]);
+    }
+    const double treeNearestMs = ElapsedMs(start) / QUERIES;
+    std::printf("  nearest: linear %8.4f ms, bvh %8.4f ms (x%.1f)\n", linearNearestMs, treeNearestMs,
+                linearNearestMs / treeNearestMs);
+    matched &= linearNearest == treeNearest;
+
+    if (!matched) std::printf("  MISMATCH against linear scan\n");
+    return matched;
+}
+
+} // namespace
+
+int main() {
+    bool matched = true;
+    for (uint32 count : { 1000u, 10000u, 100000u }) {
+        matched &= RunSize(count);
+    }
+    return matched ? 0 : 1;
+}
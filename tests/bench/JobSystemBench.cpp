@@ -0,0 +1,104 @@
+#include "Engine/Core/JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// JobSystemの固定コストとParallelForのスケーリングを測る（ctestでは実行しない）
+//   1. 空のジョブのRun/Waitにかかる時間（まとめて投入して1回Wait、1つずつ投入してWait）
+//   2. ワーカー数を変えたParallelForの時間と、ワーカー0（呼び出しスレッドのみ）に対する速度比
+//
+//   ./JobSystemBench [ジョブ数=100000] [ParallelForの要素数=1000000] [最大ワーカー数=ハードウェアスレッド数-1]
+
+using namespace UnoEngine;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// 最初の1回を除いた数回の最短時間
+template<typename Function>
+double MeasureMs(int repeat, Function&& function) {
+    function();
+    double best = 1e30;
+    for (int i = 0; i < repeat; ++i) {
+        const Clock::time_point start = Clock::now();
+        function();
+        best = (std::min)(best, ElapsedMs(start));
+    }
+    return best;
+}
+
+void MeasureEmptyJobs(uint32 workerCount, uint32 jobCount) {
+    JobSystem jobs;
+    jobs.Initialize(workerCount);
+
+    const double batchMs = MeasureMs(5, [&] {
+        JobCounter counter;
+        for (uint32 i = 0; i < jobCount; ++i) jobs.Run([] {}, &counter);
+        jobs.Wait(counter);
+    });
+
+    const double singleMs = MeasureMs(5, [&] {
+        for (uint32 i = 0; i < jobCount; ++i) {
+            JobCounter counter;
+            jobs.Run([] {}, &counter);
+            jobs.Wait(counter);
+        }
+    });
+
+    std::printf("  workers %2u : batch %7.1f ns/job, run+wait %7.1f ns/job\n", workerCount,
+                batchMs * 1e6 / jobCount, singleMs * 1e6 / jobCount);
+}
+
+// 要素ごとに少し計算の重い処理（メモリ帯域ではなく計算で律速させる）
+void Work(std::vector<float>& values, uint32 begin, uint32 end) {
+    for (uint32 i = begin; i < end; ++i) {
+        float x = static_cast<float>(i) * 0.001f;
+        for (int k = 0; k < 16; ++k) x = std::sqrt(x * x + 1.0f) * 0.5f;
+        values[i] = x;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const uint32 jobCount = argc > 1 ? static_cast<uint32>(std::atoi(argv[1])) : 100000;
+    const uint32 elementCount = argc > 2 ? static_cast<uint32>(std::atoi(argv[2])) : 1000000;
+    const uint32 hardwareThreads = (std::max)(std::thread::hardware_concurrency(), 1u);
+    const uint32 maxWorkers = argc > 3 ? static_cast<uint32>(std::atoi(argv[3])) : hardwareThreads - 1;
+
+    std::printf("hardware threads: %u, max workers: %u\n", hardwareThreads, maxWorkers);
+
+    std::printf("empty jobs (%u)\n", jobCount);
+    for (uint32 workerCount = 0; workerCount <= maxWorkers; workerCount = workerCount ? workerCount * 2 : 1) {
+        MeasureEmptyJobs(workerCount, jobCount);
+    }
+
+    std::printf("ParallelFor (%u elements)\n", elementCount);
+    std::vector<float> values(elementCount);
+    const uint32 grainSizes[] = { 256, 4096 };
+    for (uint32 grainSize : grainSizes) {
+        double baselineMs = 0.0;
+        for (uint32 workerCount = 0; workerCount <= maxWorkers; workerCount = workerCount ? workerCount * 2 : 1) {
+            JobSystem jobs;
+            jobs.Initialize(workerCount);
+            const double ms = MeasureMs(5, [&] {
+                jobs.ParallelFor(elementCount, grainSize,
+                                 [&values](uint32 begin, uint32 end) { Work(values, begin, end); });
+            });
+            if (workerCount == 0) baselineMs = ms;
+            std::printf("  grain %5u, threads %2u : %8.2f ms (x%.2f)\n", grainSize, jobs.GetThreadCount(), ms,
+                        baselineMs / ms);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "Engine/Math/MatrixKernels.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// 行列カーネルのマイクロベンチマーク（ctestでは実行しない）
+// Scalar::の参照実装と、ビルド設定で選ばれたSIMD実装の1要素あたりの時間を並べて表示する
+//
+//   ./MatrixKernelsBench [要素数]
+
+using namespace UnoEngine;
+
+namespace {
+
+constexpr int REPEAT = 50;
+
+// 最適化で計算が消えないように結果を書き込む先
+volatile float g_sink = 0.0f;
+
+template <typename Function>
+double MeasureNsPerElement(size_t count, Function&& function) {
+    function();  // ウォームアップ
+    double best = 1e30;
+    for (int i = 0; i < REPEAT; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const auto end = std::chrono::steady_clock::now();
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        if (ns < best) best = ns;
+    }
+    return best / static_cast<double>(count);
+}
+
+void PrintRow(const char* name, double scalarNs, double simdNs) {
+    std::printf("%-28s %10.2f %10.2f %8.2fx\n", name, scalarNs, simdNs, scalarNs / simdNs);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t count = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 4096;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+    std::vector<float> a(count * 16), b(count * 16), out(count * 16);
+    std::vector<float> points(count * 3), outPoints(count * 3);
+    for (float& v : a) v = value(rng);
+    for (float& v : b) v = value(rng);
+    for (float& v : points) v = value(rng);
+    // 逆行列の入力は対角を大きくして正則にしておく
+    for (size_t i = 0; i < count; ++i) {
+        for (int d = 0; d < 4; ++d) a[i * 16 + d * 5] += 40.0f;
+    }
+
+    std::printf("backend: %s, elements: %zu\n", Math::GetSimdBackendName(), count);
+    std::printf("%-28s %10s %10s %9s\n", "kernel (ns/element)", "scalar", "simd", "speedup");
+
+    PrintRow("MatrixMultiply",
+        MeasureNsPerElement(count, [&] {
+            for (size_t i = 0; i < count; ++i) Math::Scalar::MatrixMultiply(&a[i * 16], &b[i * 16], &out[i * 16]);
+        }),
+        MeasureNsPerElement(count, [&] {
+            for (size_t i = 0; i < count; ++i) Math::MatrixMultiply(&a[i * 16], &b[i * 16], &out[i * 16]);
+        }));
+
+    PrintRow("MatrixMultiplyArray",
+        MeasureNsPerElement(count, [&] {
+            for (size_t i = 0; i < count; ++i) Math::Scalar::MatrixMultiply(&a[i * 16], &b[0], &out[i * 16]);
+        }),
+        MeasureNsPerElement(count, [&] {
+            Math::MatrixMultiplyArray(a.data(), 16, b.data(), out.data(), 16, count);
+        }));
+
+    PrintRow("MatrixTranspose",
+        MeasureNsPerElement(count, [&] {
+            for (size_t i = 0; i < count; ++i) Math::Scalar::MatrixTranspose(&a[i * 16], &out[i * 16]);
+        }),
+        MeasureNsPerElement(count, [&] {
+            for (size_t i = 0; i < count; ++i) Math::MatrixTranspose(&a[i * 16], &out[i * 16]);
+        }));
+
+    PrintRow("MatrixInverse",
+        MeasureNsPerElement(count, [&] {
+            for (size_t i = 0; i < count; ++i) Math::Scalar::MatrixInverse(&a[i * 16], &out[i * 16]);
+        }),
+        MeasureNsPerElement(count, [&] {
+            for (size_t i = 0; i < count; ++i) Math::MatrixInverse(&a[i * 16], &out[i * 16]);
+        }));
+
+    PrintRow("MatrixInverseTransposeArray",
+        MeasureNsPerElement(count, [&] {
+            for (size_t i = 0; i < count; ++i) {
+                float inv[16] = {};
+                Math::Scalar::MatrixInverse(&a[i * 16], inv);
+                Math::Scalar::MatrixTranspose(inv, &out[i * 16]);
+            }
+        }),
+        MeasureNsPerElement(count, [&] {
+            Math::MatrixInverseTransposeArray(a.data(), 16, out.data(), 16, count);
+        }));
+
+    PrintRow("QuaternionToMatrix",
+        MeasureNsPerElement(count, [&] {
+            for (size_t i = 0; i < count; ++i) Math::Scalar::QuaternionToMatrix(&a[i * 16], &out[i * 16]);
+        }),
+        MeasureNsPerElement(count, [&] {
+            for (size_t i = 0; i < count; ++i) Math::QuaternionToMatrix(&a[i * 16], &out[i * 16]);
+        }));
+
+    PrintRow("TransformPointArray",
+        MeasureNsPerElement(count, [&] {
+            for (size_t i = 0; i < count; ++i) Math::Scalar::TransformPoint(&b[0], &points[i * 3], &outPoints[i * 3]);
+        }),
+        MeasureNsPerElement(count, [&] {
+            Math::TransformPointArray(b.data(), points.data(), 3, outPoints.data(), 3, count);
+        }));
+
+    g_sink = out[0] + outPoints[0];
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include "Engine/Core/Scene.h"
+#include "Engine/Core/Component.h"
+#include "Engine/Core/PoolAllocator.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+// GameObject・Componentのプール確保（PoolAllocator）の効果を測る（ctestでは実行しない）
+//   1. シーンでのGameObjectの生成・破棄を繰り返し、時間とPoolAllocator::GetStats()を表示する
+//      （ラウンドを重ねてもチャンクの確保が増えず、シーンの破棄後にReleaseUnusedMemoryで使用中が0になること）
+//   2. 同じサイズの確保・解放の並びを、プール導入前の通常のoperator new/deleteとプールで比べる
+//
+//   ./PoolAllocatorBench [GameObject数=100000] [ラウンド数=5]
+
+using namespace UnoEngine;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+class BenchScene : public Scene {
+public:
+    void OnRender(RenderView&) override {}
+};
+
+// 大きさの異なるコンポーネント（別々のサイズクラスに入る）
+class SmallComponent : public Component {
+    float value_ = 0.0f;
+};
+
+class MediumComponent : public Component {
+    float values_[24] = {};
+};
+
+class LargeComponent : public Component {
+    float values_[96] = {};
+};
+
+void PrintStats(const char* label, double ms) {
+    const PoolAllocator::Stats stats = PoolAllocator::GetStats();
+    std::printf("  %-22s %8.2f ms | allocations %9llu, chunks %5llu, live %7u, reserved %7.2f MB\n", label, ms,
+                static_cast<unsigned long long>(stats.allocations),
+                static_cast<unsigned long long>(stats.chunkAllocations), stats.liveBlocks,
+                stats.reservedBytes / (1024.0 * 1024.0));
+}
+
+// 全部生成してから全部破棄する
+double SpawnDespawnAll(BenchScene& scene, uint32 count) {
+    const Clock::time_point start = Clock::now();
+    for (uint32 i = 0; i < count; ++i) {
+        GameObject* go = scene.CreateGameObject();
+        go->AddComponent<SmallComponent>();
+        if (i % 2 == 0) go->AddComponent<MediumComponent>();
+        if (i % 8 == 0) go->AddComponent<LargeComponent>();
+    }
+    scene.ClearGameObjects();
+    return ElapsedMs(start);
+}
+
+// 生成と破棄が入り混じる（毎フレーム数百個ずつ入れ替わる）
+double Churn(BenchScene& scene, uint32 count) {
+    constexpr uint32 PER_FRAME = 500;
+    std::mt19937 rng(1);
+    std::vector<GameObject*> live;
+    live.reserve(count);
+
+    const Clock::time_point start = Clock::now();
+    for (uint32 spawned = 0; spawned < count; spawned += PER_FRAME) {
+        for (uint32 i = 0; i < PER_FRAME; ++i) {
+            GameObject* go = scene.CreateGameObject();
+            go->AddComponent<SmallComponent>();
+            if (rng() % 2) go->AddComponent<MediumComponent>();
+            live.push_back(go);
+        }
+        for (uint32 i = 0; i < PER_FRAME / 2 && !live.empty(); ++i) {
+            const size_t index = rng() % live.size();
+            scene.DestroyGameObject(live[index]);
+            live[index] = live.back();
+            live.pop_back();
+        }
+        scene.OnUpdate(0.0f);
+    }
+    scene.ClearGameObjects();
+    return ElapsedMs(start);
+}
+
+// 同じサイズの並びで、確保・解放だけを比べる
+struct AllocationFunctions {
+    const char* name;
+    void* (*allocate)(size_t);
+    void (*deallocate)(void*, size_t);
+};
+
+void* HeapAllocate(size_t size) { return ::operator new(size); }
+void HeapDeallocate(void* ptr, size_t) { ::operator delete(ptr); }
+
+double MeasureAllocations(const AllocationFunctions& functions, const std::vector<size_t>& sizes, int rounds) {
+    std::vector<void*> blocks(sizes.size());
+    std::vector<size_t> order(sizes.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), std::mt19937(2));
+
+    const Clock::time_point start = Clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (size_t i = 0; i < sizes.size(); ++i) blocks[i] = functions.allocate(sizes[i]);
+        // 生成順とは異なる順で破棄する
+        for (size_t i : order) functions.deallocate(blocks[i], sizes[i]);
+    }
+    return ElapsedMs(start) / rounds;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const uint32 count = argc > 1 ? static_cast<uint32>(std::atoi(argv[1])) : 100000;
+    const int rounds = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    std::printf("GameObject %zu bytes, components %zu / %zu / %zu bytes\n", sizeof(GameObject),
+                sizeof(SmallComponent), sizeof(MediumComponent), sizeof(LargeComponent));
+
+    std::printf("scene spawn/despawn (%u GameObjects)\n", count);
+    {
+        BenchScene scene;
+        for (int round = 0; round < rounds; ++round) {
+            char label[32];
+            std::snprintf(label, sizeof(label), "all, round %d", round + 1);
+            PrintStats(label, SpawnDespawnAll(scene, count));
+        }
+        for (int round = 0; round < rounds; ++round) {
+            char label[32];
+            std::snprintf(label, sizeof(label), "churn, round %d", round + 1);
+            PrintStats(label, Churn(scene, count));
+        }
+    }
+    PoolAllocator::ReleaseUnusedMemory();
+    PrintStats("after scene unload", 0.0);
+
+    // GameObject1つにつき、本体・Small・半数にMedium・1/8にLargeの確保
+    std::vector<size_t> sizes;
+    sizes.reserve(count * 2);
+    for (uint32 i = 0; i < count; ++i) {
+        sizes.push_back(sizeof(GameObject));
+        sizes.push_back(sizeof(SmallComponent));
+        if (i % 2 == 0) sizes.push_back(sizeof(MediumComponent));
+        if (i % 8 == 0) sizes.push_back(sizeof(LargeComponent));
+    }
+
+    std::printf("allocate/free only (%zu blocks)\n", sizes.size());
+    const AllocationFunctions heap{ "operator new (before)", HeapAllocate, HeapDeallocate };
+    const AllocationFunctions pool{ "PoolAllocator (after)", PoolAllocator::Allocate, PoolAllocator::Deallocate };
+    for (const AllocationFunctions* functions : { &heap, &pool }) {
+        MeasureAllocations(*functions, sizes, 1);
+        std::printf("  %-22s %8.2f ms\n", functions->name, MeasureAllocations(*functions, sizes, rounds));
+    }
+    PoolAllocator::ReleaseUnusedMemory();
+    PrintStats("after release", 0.0);
+    return 0;
+}